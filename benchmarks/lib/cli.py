@@ -23,6 +23,7 @@ __all__ = [
     'add_benchmarks',
     'add_color',
     'add_constraints',
+    'add_counters',
     'add_help',
     'add_history_mandatory',
     'add_history_optional',
@@ -200,6 +201,16 @@ def add_constraints(arg):
         """
     )
 
+def add_counters(arg):
+    arg.add_argument(
+        '-P', '--perf-counters', dest='counters', action='store_true',
+        help="""
+        Ask the benchmarks to also capture hardware performance counters (cycles, instructions, cache misses and branch
+        misses) and show them below the timing results.  This requires Linux and a sufficiently permissive setting of
+        /proc/sys/kernel/perf_event_paranoid.  Where counters are not available, only timings are reported.
+        """
+    )
+
 def add_verbose(arg):
     arg.add_argument(
         '-V', '--verbose', action='store_true',
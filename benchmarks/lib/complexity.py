@@ -0,0 +1,62 @@
+#! /usr/bin/python3
+#! -*- coding:utf-8; mode:python; -*-
+
+# Copyright (C) 2016 Moritz Klammler <moritz.klammler@student.kit.edu>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+# documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+# permit persons to whom the Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+# Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS
+# OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+# OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+__all__ = [
+    'fit_power_law',
+]
+
+import math
+
+def fit_power_law(points):
+    """
+    @brief
+        Fits a power law <var>t</var> = <var>c</var> <var>n</var><sup><var>k</var></sup> to a series of measurements.
+
+    The fit is a least-squares regression of log(<var>t</var>) against log(<var>n</var>) so the exponent is the slope of
+    the regression line.  The standard error of the exponent can only be estimated if there are at least three points;
+    otherwise it is reported as zero.
+
+        >>> (k, err) = fit_power_law([(10, 3.0e-6), (100, 3.0e-4), (1000, 3.0e-2)])
+        >>> (round(k, 6), round(err, 6))
+        (2.0, 0.0)
+
+    @param points : [(int, float)]
+        pairs of problem size <var>n</var> and mean execution time <var>t</var> (both must be positive)
+
+    @returns (float, float)
+        exponent <var>k</var> and its standard error
+
+    @raises ValueError
+        if there are fewer than two distinct problem sizes or any value is not positive
+
+    """
+    if any(n <= 0 or t <= 0.0 for (n, t) in points):
+        raise ValueError("Cannot fit a power law to non-positive values")
+    xs = [ math.log(n) for (n, t) in points ]
+    ys = [ math.log(t) for (n, t) in points ]
+    m = len(points)
+    xbar = sum(xs) / m if m > 0 else math.nan
+    ybar = sum(ys) / m if m > 0 else math.nan
+    sxx = sum((x - xbar)**2 for x in xs)
+    if not sxx > 0.0:
+        raise ValueError("Need at least two distinct problem sizes to fit a power law")
+    slope = sum((x - xbar) * (y - ybar) for (x, y) in zip(xs, ys)) / sxx
+    if m < 3:
+        return (slope, 0.0)
+    residual = sum((y - ybar - slope * (x - xbar))**2 for (x, y) in zip(xs, ys))
+    return (slope, math.sqrt(residual / (m - 2) / sxx))
@@ -70,11 +70,11 @@ class Reporter(object):
             'ns' : 1.0e-9,
         }[unit]
 
-    def print_header(self):
+    def print_header(self, mean=None, stdev=None):
         print(self.__separator)
         print('{} {:<20s}{:>12s}{:>12s}{:>8s}{:>12s}   {:s}{}'.format(
             self.__ansi.BOLD,
-            "id", "mean / " + self.__unit, "stdev / " + self.__unit, "N",
+            "id", mean or "mean / " + self.__unit, stdev or "stdev / " + self.__unit, "N",
             "trend", "description",
             self.__ansi.NOBOLD
         ))
@@ -112,6 +112,38 @@ class Reporter(object):
                 trendon, trend, trendoff, short_description
             ))
 
+    def print_exponent(self, name, exponent, error, n, trend=None, alerted=None):
+        short_name = self.__shorten_name(name)
+        if trend is None:
+            (trendon, trendtext, trendoff) = ('', '{:>12s}'.format('n/a'), '')
+        else:
+            if alerted or alerted is None and trend >= 1.0:
+                trendon = self.__ansi.RED
+            elif trend <= -1.0:
+                trendon = self.__ansi.GREEN
+            else:
+                trendon = self.__ansi.NOCOLOR
+            (trendtext, trendoff) = ('{:+12.2f}'.format(trend), self.__ansi.NOCOLOR)
+        print(' {:20s}{:>12s}{:>12s}{:8d}{}{}{}'.format(
+            short_name, '{:.3f}'.format(exponent), '{:.3f}'.format(error), n, trendon, trendtext, trendoff
+        ))
+
+    def print_counters(self, name, counters):
+        cycles = counters.get('cycles')
+        instructions = counters.get('instructions')
+        words = list()
+        if cycles is not None:
+            words.append('{:.3g} cycles'.format(cycles))
+        if instructions is not None:
+            words.append('{:.3g} instructions'.format(instructions))
+            if cycles:
+                words.append('IPC {:.2f}'.format(instructions / cycles))
+            for key in ['cache-misses', 'branch-misses']:
+                if key in counters and instructions:
+                    words.append('{:.2f} {:s} / 1k instr'.format(1000.0 * counters[key] / instructions, key))
+        if words:
+            print(' {:20s}   {:s}'.format('', ', '.join(words)))
+
     def print_error(self, message, name=None):
         ansion = self.__ansi.BOLD + self.__ansi.RED
         ansioff = self.__ansi.NOBOLD + self.__ansi.NOCOLOR
@@ -22,6 +22,7 @@ all = [
     'Failure',
     'Result',
     'TimeoutFailure',
+    'get_trend',
 ]
 
 import datetime
@@ -31,22 +32,36 @@ import time
 
 class Result(object):
 
-    def __init__(self, mean : float, stdev : float, n : int, reason : str = None):
+    def __init__(self, mean : float, stdev : float, n : int, reason : str = None, counters : dict = None):
         self.mean = mean
         self.stdev = stdev
         self.n = n
         self.reason = reason
+        self.counters = counters if counters is not None else dict()
 
     @classmethod
     def from_string(cls, text):
+        """
+        Parses a result line in the format `MEAN STDEV N [KEY=VALUE ...]` where the optional trailing key-value pairs
+        are hardware performance counters (averaged per run) that are stored in the `counters` attribute.
+
+        >>> r = Result.from_string("1.5E-03  2.0E-04  10  cycles=4.2E+06  cache-misses=1.0E+03")
+        >>> (r.mean, r.stdev, r.n, sorted(r.counters.items()))
+        (0.0015, 0.0002, 10, [('cache-misses', 1000.0), ('cycles', 4200000.0)])
+
+        """
         try:
-            (w0, w1, w2) = text.split()
+            (w0, w1, w2, *extra) = text.split()
             mean = float(w0)
             stdev = float(w1)
             n = int(w2)
+            counters = dict()
+            for word in extra:
+                (key, value) = word.split('=', 1)
+                counters[key] = float(value)
         except ValueError:
-            raise ValueError("Benchmark result string not in format '%g %g %d'")
-        return cls(mean, stdev, n)
+            raise ValueError("Benchmark result string not in format '%g %g %d [%s=%g ...]'")
+        return cls(mean, stdev, n, counters=counters)
 
 class CollectionRunner(object):
 
@@ -54,6 +69,7 @@ class CollectionRunner(object):
         assert constraints is not None
         self.constraints = constraints
         self.logger = logger if logger is not None else lambda x : None
+        self.results = dict()
 
     def run_collection(self, config, histo, report, selection=None, update=False, alert=None, constraints=None):
         assert None not in [config, histo, report]
@@ -78,6 +94,7 @@ class CollectionRunner(object):
             try:
                 res = self._run_single(key, bench)
                 successes.add(key)
+                self.results[key] = res
             except Failure as e:
                 failures.add(key)
                 report.print_error(str(e), name=key)
@@ -86,11 +103,13 @@ class CollectionRunner(object):
             if update:
                 histo.register(key, description)
                 histo.append(key, res.mean, res.stdev, res.n)
-            trend = _get_trend((res.mean, res.stdev), baseline)
+            trend = get_trend((res.mean, res.stdev), baseline)
             alerted = None if None in [alert, trend] else (trend >= alert)
             if alerted:
                 alerts.add(key)
             report.print_row(key, res, trend=trend, alerted=alerted, description=description)
+            if res.counters:
+                report.print_counters(key, res.counters)
             if res.reason is not None:
                 report.print_warning(res.reason, name=key)
         report.print_footer()
@@ -136,7 +155,8 @@ class Constraints(object):
                  repetitions  : int   = None,
                  quantile     : float = None,
                  significance : float = None,
-                 warmup       : int   = None):
+                 warmup       : int   = None,
+                 counters     : bool  = False):
         assert timeout is None or timeout > 0.0
         self.__timeout = timeout
         assert repetitions is None or repetitions > 3
@@ -147,6 +167,7 @@ class Constraints(object):
         self.__significance = significance
         assert warmup >= 0
         self.__warmup = warmup
+        self.__counters = bool(counters)
 
     @property
     def timeout(self):
@@ -168,6 +189,10 @@ class Constraints(object):
     def warmup(self):
         return self.__warmup
 
+    @property
+    def counters(self):
+        return self.__counters
+
     def as_environment(self, env : dict = None, hexfloat : bool = False) -> dict:
         ftos = float.hex if hexfloat else str
         if env is None:
@@ -179,9 +204,11 @@ class Constraints(object):
         env['BENCHMARK_QUANTILE'] = ftos(self.__quantile)
         env['BENCHMARK_SIGNIFICANCE'] = ftos(self.__significance)
         env['BENCHMARK_WARMUP'] = str(self.__warmup)
+        if self.__counters:
+            env['BENCHMARK_COUNTERS'] = '1'
         return env
 
-def _get_trend(current, best=None):
+def get_trend(current, best=None):
     """
     @brief
         Computes the trend of a benchmark compared to its historical best result and determines whether this is
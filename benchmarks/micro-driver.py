@@ -17,6 +17,7 @@
 # OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 import argparse
+import collections
 import os.path
 import subprocess
 import sys
@@ -26,10 +27,15 @@ import time
 from lib.cli import (
     TerminalSizeHack,
     add_argument_groups,
+    add_counters,
     regretful_epilog,
     use_color,
 )
 
+from lib.complexity import (
+    fit_power_law,
+)
+
 from lib.fancy import (
     Reporter,
 )
@@ -50,6 +56,7 @@ from lib.runner import (
     Failure,
     Result,
     TimeoutFailure,
+    get_trend,
 )
 
 def main(args):
@@ -60,12 +67,14 @@ def main(args):
         Runs micro-benchmarks.  Micro-benchmarks are small programs that execute a certain component of the library and
         measure its performance.  This script only orchestrates those programs; it doesn't do any timings or statistics
         on its own.  This is expected to be done by the executed programs which shall print their results in a suitable
-        format.
+        format.  The only exception are benchmarks that sweep over a range of problem sizes.  For them, an empirical
+        complexity exponent is fitted to the results and reported as a pseudo-benchmark NAME-exponent.
         """,
         epilog=regretful_epilog,
         add_help=False,
     )
-    add_argument_groups(ap)
+    (pos, ess, sta, sup) = add_argument_groups(ap)
+    add_counters(sta)
     with TerminalSizeHack():
         ns = ap.parse_args(args)
     reporter = Reporter(use_color(ns.color), unit='us')
@@ -76,7 +85,8 @@ def main(args):
         repetitions=ns.repetitions,
         quantile=ns.quantile,
         significance=ns.significance,
-        warmup=ns.warmup
+        warmup=ns.warmup,
+        counters=ns.counters
     )
     if ns.info:
         reporter.print_info()
@@ -103,6 +113,23 @@ def main(args):
 
 class MicroManifestLoader(ManifestLoader):
 
+    def load(self, filename):
+        config = super().load(filename)
+        expanded = dict()
+        for (name, stanza) in config.items():
+            if 'sweep' not in stanza:
+                expanded[name] = stanza
+                continue
+            for (label, size) in stanza['sweep'].items():
+                substitute = lambda s : s.replace('{n}', str(size))
+                expanded[name + '-' + label] = {
+                    'description' : substitute(stanza.get('description', "")) or None,
+                    'command' : list(map(substitute, stanza['command'])),
+                    'family' : name,
+                    'size' : size,
+                }
+        return expanded
+
     def _validate_stanza(self, name, definition):
         if 'command' not in definition:
             raise InvalidManifestError(name + ": The 'command' attribute is required")
@@ -115,6 +142,13 @@ class MicroManifestLoader(ManifestLoader):
                     raise InvalidManifestError(name + "." + key + ": Expected an array of strings")
                 if not value or not value[0].strip():
                     raise InvalidManifestError(name + "." + key + ": Command cannot be empty")
+            elif key == 'sweep':
+                if type(value) is not dict or not value:
+                    raise InvalidManifestError(name + "." + key + ": Expected a non-empty object")
+                if not all(type(n) is int and n > 0 for n in value.values()):
+                    raise InvalidManifestError(name + "." + key + ": Problem sizes must be positive integers")
+                if not any('{n}' in s for s in definition.get('command', [])):
+                    raise InvalidManifestError(name + "." + key + ": Command does not use the problem size '{n}'")
             elif type(key) is str:
                 raise InvalidManifestError(name + "." + key + ": Unknown attribute")
             else:
@@ -125,6 +159,50 @@ class MicroCollectionRunner(CollectionRunner):
     def __init__(self, constraints=None, logger=None):
         super().__init__(constraints=constraints, logger=logger)
 
+    def run_collection(self, config, histo, report, selection=None, update=False, alert=None, constraints=None):
+        families = collections.defaultdict(list)
+        for (key, stanza) in sorted(config.items(), key=(lambda kv : kv[1].get('size', 0))):
+            if 'family' in stanza:
+                families[stanza['family']].append(key)
+        if selection:
+            selection = [ k for name in selection for k in families.get(name, [ name ]) ]
+        status = super().run_collection(
+            config, histo, report, selection=selection, update=update, alert=alert, constraints=constraints
+        )
+        return status + self.__report_complexity(config, families, histo, report, update=update, alert=alert)
+
+    def __report_complexity(self, config, families, histo, report, update=False, alert=None):
+        alerts = 0
+        fits = list()
+        for (family, keys) in sorted(families.items()):
+            points = [ (config[k]['size'], self.results[k].mean) for k in keys if k in self.results ]
+            if len(points) < 2:
+                continue
+            try:
+                fits.append((family + '-exponent', *fit_power_law(points), len(points)))
+            except ValueError as e:
+                report.print_warning(str(e), name=family)
+        if not fits:
+            return 0
+        report.print_prolog("Empirical complexity exponents of {:d} sweeps:".format(len(fits)))
+        report.print_header(mean="exponent", stdev="error")
+        for (name, exponent, error, n) in fits:
+            baseline = None
+            if histo is not None:
+                baseline = histo.get_best(name)
+                if update:
+                    histo.register(name, "empirical complexity exponent (not a time)")
+                    histo.append(name, exponent, error, n)
+            trend = get_trend((exponent, error), baseline)
+            alerted = None if None in [alert, trend] else (trend >= alert)
+            alerts += bool(alerted)
+            report.print_exponent(name, exponent, error, n, trend=trend, alerted=alerted)
+        report.print_footer()
+        if histo is not None and alert is not None:
+            report.print_epilog("{:6d} complexity alerts (threshold was {:.2f} sigma)".format(alerts, alert))
+        report.print_epilog("")
+        return alerts
+
     def _run_single(self, name, stanza):
         runner = MicroBenchmarkRunner(stanza, constraints=self.constraints, logger=self.logger)
         return runner.run()
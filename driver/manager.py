@@ -37,6 +37,7 @@ from .errors import *
 from .resources import *
 from .tools import *
 from .utility import *
+from .worker import *
 from .xjson import *
 
 DATA_ROOT_TAG_FILE = 'DATADIR.TAG'
@@ -52,6 +53,7 @@ class Manager(object):
         self.__timeout = timeout
         self.__db_connection = None
         self.__old_cwd = None
+        self.__worker = None
         _register_sqlite_types()
 
     @property
@@ -138,6 +140,9 @@ class Manager(object):
         return self
 
     def __exit__(self, *args):
+        if self.__worker is not None:
+            self.__worker.close()
+            self.__worker = None
         if self.__db_connection is not None:
             logging.debug("Closing database connection")
             self.__db_connection.close()
@@ -304,7 +309,12 @@ class Manager(object):
         logging.debug("Executing command {!r} ...".format(cmd))
         t0 = time.time()
         try:
-            result = subprocess.run(cmd, **kwargs)
+            worker = self.__get_worker(stdin, stdout)
+            if worker is not None:
+                workerenv = { 'MSC_RANDOM_SEED' : subenv['MSC_RANDOM_SEED'] } if deterministic else None
+                result = worker.run(cmd, stdin=_get_stdin_filename(stdin), env=workerenv, timeout=self.timeout)
+            else:
+                result = subprocess.run(cmd, **kwargs)
         except subprocess.TimeoutExpired:
             logging.error("Command did not complete until timeout ({:.3f} seconds) expired".format(self.timeout))
             raise RecoverableError("External program was killed")
@@ -336,6 +346,8 @@ class Manager(object):
             try:
                 meta = load_xjson_string(jsontext)
                 if meta is None: raise RecoverableError("External tool produced no JSON output")
+                if isinstance(meta, dict) and 'profile' in meta:
+                    self.__record_profile(cmd[0], meta.pop('profile'))
                 return meta
             except XJsonError as e:
                 _log_data(jsondata)
@@ -416,12 +428,35 @@ class Manager(object):
             raise exception("Prefix {!s} is ambiguous (matches {:d} {:s}s)".format(prefix, len(rows), what))
         return get_one(get_one(rows))
 
+    def __get_worker(self, stdin, stdout):
+        if stdout is not None or _get_stdin_filename(stdin) is False or not use_worker_eh():
+            return None
+        if self.__worker is None:
+            self.__worker = WorkerClient(os.path.join(self.abs_bindir, 'src', 'utility', 'graphstudy-worker'))
+        return self.__worker
+
     def __record_exec_time(self, program, time):
         tool = os.path.basename(program)
         assert type(tool) is str
         assert type(time) is float
         self.sql_insert('ToolPerformance', tool=tool, time=time)
 
+    def __record_profile(self, program, profile):
+        tool = os.path.basename(program)
+        try:
+            nodes = profile['nodes']
+            phases = [ ('wall', profile['wall']) ]
+            phases.extend((name, data['time']) for (name, data) in profile['phases'].items())
+            peak = profile['rusage']['maxrss'] if profile['rusage'] is not None else None
+        except (KeyError, TypeError, AttributeError):
+            logging.warning("Ignoring malformed profile in meta output of {!r}".format(tool))
+            return
+        with self.sql_ctx as curs:
+            for (phase, time) in phases:
+                self.sql_insert_curs(curs, 'ToolProfile', tool=tool, nodes=nodes, phase=phase, time=time)
+            if peak is not None:
+                self.sql_insert_curs(curs, 'ToolMemory', tool=tool, nodes=nodes, peak=peak)
+
 def _log_data(data, description="Bogus data"):
     logging.notice(description + " was {:d} bytes long".format(len(data)))
     try:
@@ -435,6 +470,18 @@ def _log_data(data, description="Bogus data"):
         with os.fdopen(dumpfd, 'wb') as ostr:
             ostr.write(data)
 
+def _get_stdin_filename(stdin):
+    # Returns the name of the file that `stdin` refers to, `None` for no input or `False` if it is not a named file.
+    if stdin is None or stdin is False:
+        return None
+    name = getattr(stdin, 'name', None)
+    if not isinstance(name, str) or not os.path.isfile(name):
+        return False
+    try:
+        return name if stdin.tell() == 0 else False
+    except OSError:
+        return False
+
 def _handle_popen_stdin(kwargs, stdin):
     assert 'stdin' not in kwargs
     assert 'input' not in kwargs
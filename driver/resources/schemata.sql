@@ -155,3 +155,16 @@ CREATE TABLE IF NOT EXISTS `ToolPerformance` (
     `tool` TEXT NOT NULL,
     `time` REAL NOT NULL CHECK (`time` >= 0.0)
 );
+
+CREATE TABLE IF NOT EXISTS `ToolProfile` (
+    `tool`  TEXT    NOT NULL,
+    `nodes` INTEGER CHECK (`nodes` ISNULL OR `nodes` >= 0),
+    `phase` TEXT    NOT NULL,
+    `time`  REAL    NOT NULL CHECK (`time` >= 0.0)
+);
+
+CREATE TABLE IF NOT EXISTS `ToolMemory` (
+    `tool`  TEXT    NOT NULL,
+    `nodes` INTEGER CHECK (`nodes` ISNULL OR `nodes` >= 0),
+    `peak`  INTEGER NOT NULL CHECK (`peak` >= 0)
+);
@@ -63,6 +63,72 @@
             </tr>
           </xsl:for-each>
         </table>
+        <xsl:if test="profile">
+          <h2>Time per Phase</h2>
+          <p>
+            These numbers are only collected for tools that were run with <code>MSC_PROFILE</code> set.  The relative
+            time is the share of the accumulated wall time of the tool for graphs of the same size.  Phases may nest.
+          </p>
+          <table class="pretty">
+            <tr>
+              <th class="clicksort" data-sort-type="s">Tool</th>
+              <th class="clicksort" data-sort-type="s">Graph Size</th>
+              <th class="clicksort" data-sort-type="s">Phase</th>
+              <th class="clicksort" data-sort-type="d">Calls</th>
+              <th class="clicksort" data-sort-type="f">Relative</th>
+              <th class="clicksort" data-sort-type="f">Median</th>
+              <th class="clicksort" data-sort-type="f">Mean</th>
+            </tr>
+            <tr>
+              <th>&#x2014;</th>
+              <th>&#x2014;</th>
+              <th>&#x2014;</th>
+              <th>1</th>
+              <th>%</th>
+              <th>H:MM:SS</th>
+              <th>H:MM:SS</th>
+            </tr>
+            <xsl:for-each select="profile">
+              <tr>
+                <td><xsl:value-of select="@tool" /></td>
+                <td><xsl:value-of select="@size" /></td>
+                <td><xsl:value-of select="@phase" /></td>
+                <td class="number-int"     ><xsl:value-of select="cnt" /></td>
+                <td class="number-percent" ><xsl:value-of select="rel" /></td>
+                <td class="number-duration"><xsl:value-of select="med" /></td>
+                <td class="number-duration"><xsl:value-of select="avg" /></td>
+              </tr>
+            </xsl:for-each>
+          </table>
+        </xsl:if>
+        <xsl:if test="memory">
+          <h2>Peak Memory Usage</h2>
+          <table class="pretty">
+            <tr>
+              <th class="clicksort" data-sort-type="s">Tool</th>
+              <th class="clicksort" data-sort-type="s">Graph Size</th>
+              <th class="clicksort" data-sort-type="d">Calls</th>
+              <th class="clicksort" data-sort-type="f">Median</th>
+              <th class="clicksort" data-sort-type="f">Maximum</th>
+            </tr>
+            <tr>
+              <th>&#x2014;</th>
+              <th>&#x2014;</th>
+              <th>1</th>
+              <th>MiB</th>
+              <th>MiB</th>
+            </tr>
+            <xsl:for-each select="memory">
+              <tr>
+                <td><xsl:value-of select="@tool" /></td>
+                <td><xsl:value-of select="@size" /></td>
+                <td class="number-int"  ><xsl:value-of select="cnt" /></td>
+                <td class="number-fixed"><xsl:value-of select="med" /></td>
+                <td class="number-fixed"><xsl:value-of select="max" /></td>
+              </tr>
+            </xsl:for-each>
+          </table>
+        </xsl:if>
       </body>
     </html>
   </xsl:template>
@@ -0,0 +1,141 @@
+#! /usr/bin/python3
+#! -*- coding:utf-8; mode:python; -*-
+
+# Copyright (C) 2018 Karlsruhe Institute of Technology
+# Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+# warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with this program.  If not, see
+# <http://www.gnu.org/licenses/>.
+
+__all__ = [ 'WORKER_ENVVAR', 'WorkerClient', 'use_worker_eh' ]
+
+import json
+import logging
+import os
+import subprocess
+
+WORKER_ENVVAR = 'MSC_WORKER'
+
+_USE_WORKER = None
+
+def use_worker_eh():
+    global _USE_WORKER
+    if _USE_WORKER is None:
+        _USE_WORKER = False
+        envval = os.getenv(WORKER_ENVVAR)
+        if envval is not None:
+            try:
+                _USE_WORKER = (int(envval) > 0)
+            except ValueError:
+                logging.warning("Ignoing bogous value of environment variable {!s}={!r}".format(WORKER_ENVVAR, envval))
+            else:
+                if _USE_WORKER:
+                    logging.info("Tools will be run by a persistent worker process ({!s}={!r})"
+                                 .format(WORKER_ENVVAR, envval))
+    return _USE_WORKER
+
+class WorkerClient(object):
+
+    """
+    Client for the `graphstudy-worker` program which runs the command-line tools without starting a new process for
+    each call.  The worker process is started lazily and restarted if it goes away.  The results of `run` mimic those
+    of `subprocess.run` so the client can be used as a drop-in replacement for it.
+    """
+
+    def __init__(self, executable):
+        self.__executable = executable
+        self.__process = None
+        self.__counter = 0
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    @property
+    def executable(self):
+        return self.__executable
+
+    def close(self):
+        if self.__process is not None:
+            logging.debug("Shutting down worker process {:d} ...".format(self.__process.pid))
+            self.__process.stdin.close()
+            self.__process.wait()
+            self.__process.stdout.close()
+            self.__process = None
+
+    def run(self, cmd, stdin=None, env=None, timeout=None):
+        """
+        Runs the tool `os.path.basename(cmd[0])` with the arguments `cmd[1:]`.  Standard input is connected to the file
+        named `stdin` or to `/dev/null` if it is `None`.  The mapping `env` may specify additional environment
+        variables.  If the tool exceeds the `timeout` (in seconds), a `subprocess.TimeoutExpired` exception is raised
+        and if the worker cannot be communicated with, an `OSError`.  Otherwise, a `subprocess.CompletedProcess` with
+        the captured output is returned.  Like `subprocess.run`, the return code is negative if the tool was killed by
+        a signal.
+        """
+        self.__counter += 1
+        request = {
+            'id'   : str(self.__counter),
+            'tool' : os.path.basename(cmd[0]),
+            'args' : list(cmd[1:]),
+        }
+        if stdin is not None:
+            request['stdin'] = os.path.abspath(stdin)
+        if env:
+            request['environ'] = dict(env)
+        if timeout is not None:
+            request['timeout'] = float(timeout)
+        response = self.__exchange(request)
+        if response['error'] is not None:
+            raise OSError("Worker cannot run {!r}: {!s}".format(request['tool'], response['error']))
+        if response['id'] != request['id']:
+            self.__abandon()
+            raise OSError("Worker responded out of order")
+        stdout = response['stdout'].encode('latin-1')
+        stderr = response['stderr'].encode('latin-1')
+        if response['timeout']:
+            raise subprocess.TimeoutExpired(cmd, timeout, output=stdout, stderr=stderr)
+        returncode = response['status'] if response['status'] is not None else -response['signal']
+        return subprocess.CompletedProcess(cmd, returncode, stdout=stdout, stderr=stderr)
+
+    def __exchange(self, request):
+        if self.__process is None:
+            logging.debug("Starting worker process {!r} ...".format(self.__executable))
+            self.__process = subprocess.Popen(
+                [ self.__executable ], stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL
+            )
+        try:
+            self.__process.stdin.write(json.dumps(request).encode() + b'\n')
+            self.__process.stdin.flush()
+            line = self.__process.stdout.readline()
+        except OSError:
+            self.__abandon()
+            raise
+        if not line:
+            self.__abandon()
+            raise OSError("Worker process exited unexpectedly")
+        try:
+            return json.loads(line.decode('ascii'))
+        except (UnicodeError, ValueError) as e:
+            self.__abandon()
+            raise OSError("Cannot parse response from worker: {!s}".format(e))
+
+    def __abandon(self):
+        if self.__process is not None:
+            self.__process.kill()
+            self.__process.wait()
+            for stream in [ self.__process.stdin, self.__process.stdout ]:
+                try:
+                    stream.close()
+                except OSError:
+                    pass
+            self.__process = None
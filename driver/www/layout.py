@@ -34,6 +34,7 @@ from ..utility import *
 from .impl_common import *
 
 _THUMBNAIL_SIZE = 200
+_PICTURE_SIZE = 1000
 
 _INTER_INFO_KEYS = [ 'id', 'method', 'parent1st', 'parent2nd', 'rate' ]
 _WORSE_INFO_KEYS = [ 'id', 'method', 'parent', 'rate' ]
@@ -209,20 +210,14 @@ def _serve_picture(this, layoutid : Id, format : str = None, preview : bool = Fa
             cmd.append('--axis-color=#{:06X}'.format(SECONDARY_COLOR))
         cmd.append('--node-color=#{:06X}'.format(colors[0]))
         cmd.append('--edge-color=#{:06X}'.format(colors[1]))
+        if format == 'PNG':
+            cmd.append('--png={:d}'.format(_THUMBNAIL_SIZE if preview else _PICTURE_SIZE))
         cmd.append(row['file'])
         try:
             data = this.server.graphstudy_manager.call_graphstudy_tool(cmd, stdout=True)
-            _offer_picture_to_cache(data, layoutid, format='SVG', preview=preview, princomp=princomp)
+            _offer_picture_to_cache(data, layoutid, format=format, preview=preview, princomp=princomp)
         except RecoverableError as e:
             raise HttpError(http.HTTPStatus.INTERNAL_SERVER_ERROR, "Cannot visualize layout: {!s}".format(e))
-        conversion = _get_conversion_command_from_svg(format, preview=preview)
-        if conversion is not None:
-            try:
-                data = this.server.graphstudy_manager.call_image_magick(conversion, stdin=data, stdout=True)
-            except RecoverableError as e:
-                raise HttpError(http.HTTPStatus.INTERNAL_SERVER_ERROR,
-                                "Cannot convert SVG to {:s}: {!s}".format(format, e))
-            _offer_picture_to_cache(data, layoutid, format=format, preview=preview, princomp=princomp)
     this.send_response(http.HTTPStatus.OK)
     this.send_header('Content-Length', str(len(data)))
     this.send_header('Content-Type', '{:s}; charset="{:s}"'.format(mimetype, charset))
@@ -230,23 +225,6 @@ def _serve_picture(this, layoutid : Id, format : str = None, preview : bool = Fa
     this.wfile.write(data)
     this.wfile.flush()
 
-def _get_conversion_command_from_svg(fmt, preview=False):
-    # https://www.imagemagick.org/Usage/thumbnails/#pad
-    if fmt == 'SVG':
-        return None
-    argspec = '{:s}:-'
-    src = argspec.format('svg')
-    dst = argspec.format(fmt.lower())
-    geometry = '{0:d}x{0:d}'.format(_THUMBNAIL_SIZE)
-    return [
-        src,
-        '-thumbnail', geometry,
-        '-gravity', 'center',
-        '-background', 'white',
-        '-extent', geometry,
-        dst
-    ] if preview else [ src, dst ]
-
 def _check_graphics_format(fmt):
     if not isinstance(fmt, str):
         raise TypeError("Graphics format specification must be str type")
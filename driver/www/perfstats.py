@@ -23,6 +23,7 @@ import math
 import statistics
 
 from . import *
+from ..constants import *
 from ..utility import *
 
 def serve(self, url):
@@ -37,6 +38,17 @@ def serve(self, url):
             append_child(tl, 'max').text = fmtnum(values[4])
             append_child(tl, 'med').text = fmtnum(values[5])
             append_child(tl, 'avg').text = fmtnum(values[6])
+    for (tool, size, phase, *values) in sorted(_get_profile_stats_cooked(self)):
+        with Child(root, 'profile', tool=tool, size=size, phase=phase) as pf:
+            append_child(pf, 'cnt').text = fmtnum(values[0])
+            append_child(pf, 'rel').text = fmtnum(values[1])
+            append_child(pf, 'med').text = fmtnum(values[2])
+            append_child(pf, 'avg').text = fmtnum(values[3])
+    for (tool, size, *values) in sorted(_get_memory_stats_cooked(self)):
+        with Child(root, 'memory', tool=tool, size=size) as mm:
+            append_child(mm, 'cnt').text = fmtnum(values[0])
+            append_child(mm, 'med').text = fmtnum(values[1])
+            append_child(mm, 'max').text = fmtnum(values[2])
     self.send_tree_xml(ET.ElementTree(root), transform='/xslt/perfstats.xsl')
 
 def _get_perf_stats_cooked(self):
@@ -60,3 +72,26 @@ def _get_perf_stats_raw(self):
     for row in self.server.graphstudy_manager.sql_select('ToolPerformance'):
         result[row['tool']].append(row['time'])
     return result
+
+def _classify_nodes(nodes):
+    return GraphSizes.classify(nodes).name if nodes is not None else ''
+
+def _get_profile_stats_cooked(self):
+    phasetimes = collections.defaultdict(list)
+    for row in self.server.graphstudy_manager.sql_select('ToolProfile'):
+        phasetimes[(row['tool'], _classify_nodes(row['nodes']), row['phase'])].append(row['time'])
+    result = list()
+    for ((tool, size, phase), times) in phasetimes.items():
+        walltime = sum(phasetimes.get((tool, size, 'wall'), []))
+        _cnt = len(times)
+        _rel = sum(times) / walltime if walltime > 0.0 else math.nan
+        _med = statistics.median(times)
+        _avg = statistics.mean(times)
+        result.append((tool, size, phase, _cnt, _rel, _med, _avg))
+    return result
+
+def _get_memory_stats_cooked(self):
+    peaks = collections.defaultdict(list)
+    for row in self.server.graphstudy_manager.sql_select('ToolMemory'):
+        peaks[(row['tool'], _classify_nodes(row['nodes']))].append(row['peak'] / 2**20)
+    return [ (tool, size, len(mibs), statistics.median(mibs), max(mibs)) for ((tool, size), mibs) in peaks.items() ]
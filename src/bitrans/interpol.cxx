@@ -18,9 +18,13 @@
 #  include <config.h>
 #endif
 
+#include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -29,18 +33,24 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
+#include "data_analysis.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "interpolation.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
 #include "ogdf_fix.hxx"
+#include "pairwise.hxx"
+#include "planner.hxx"
 #include "point.hxx"
 #include "princomp.hxx"
 #include "random.hxx"
+#include "rlimits.hxx"
 #include "stochastic.hxx"
 #include "useful.hxx"
 
@@ -61,6 +71,15 @@ namespace /*anonymous*/
         return coords;
     }
 
+    std::vector<msc::point2d> get_all_coordinates(const ogdf_vertex_coordinates& coords)
+    {
+        auto all = std::vector<msc::point2d>{};
+        for (auto it = coords.begin(); it != coords.end(); ++it) {
+            all.push_back(*it);
+        }
+        return all;
+    }
+
     template <typename EngineT>
     msc::point2d
     get_principial_layout(EngineT& engine, const ogdf::GraphAttributes& attrs, ogdf_vertex_coordinates& principial)
@@ -166,6 +185,21 @@ namespace /*anonymous*/
             return inter;
         }
 
+        const ogdf::Graph& graph() const noexcept
+        {
+            return *_lhs_pl->graphOf();
+        }
+
+        std::vector<msc::point2d> lhs_coordinates() const
+        {
+            return get_all_coordinates(*_lhs_pl);
+        }
+
+        std::vector<msc::point2d> rhs_coordinates() const
+        {
+            return get_all_coordinates(*_rhs_pl);
+        }
+
     private:
 
         std::unique_ptr<ogdf_vertex_coordinates> _lhs_pl{};
@@ -173,10 +207,28 @@ namespace /*anonymous*/
 
     };  // class linear_interpolator
 
+    struct cli_parameters : msc::cli_parameters_interpolation
+    {
+        msc::kernels kernel{msc::kernels::boxed};
+        std::vector<double> width{};
+        std::vector<int> bins{};
+        std::optional<int> points{};
+        msc::fused_outputs fused{};
+    };
+
     struct application final
     {
-        msc::cli_parameters_interpolation parameters{};
+        cli_parameters parameters{};
         void operator()() const;
+
+    private:
+
+        bool want_matrix() const noexcept;
+        bool want_fused() const noexcept;
+        msc::data_analyzer make_analyzer() const;
+        void analyze_fused(const msc::interpolated_properties& props,
+                           const ogdf::GraphAttributes& attrs,
+                           msc::json_object& subinfo) const;
     };
 
     msc::json_object get_info(const std::string& seed)
@@ -199,6 +251,49 @@ namespace /*anonymous*/
         return info;
     }
 
+    bool application::want_matrix() const noexcept
+    {
+        return (this->parameters.fused.tension.terminal() != msc::terminals::null) || this->parameters.fused.stress;
+    }
+
+    bool application::want_fused() const noexcept
+    {
+        return (this->parameters.fused.rdf_global.terminal() != msc::terminals::null) || this->want_matrix();
+    }
+
+    msc::data_analyzer application::make_analyzer() const
+    {
+        if (std::max(this->parameters.width.size(), this->parameters.bins.size()) > 1) {
+            throw std::invalid_argument{"Only a single bin / filter width or bin count can be used for interpolation"};
+        }
+        auto analyzer = msc::data_analyzer{this->parameters.kernel};
+        analyzer.set_width(msc::get_item(this->parameters.width, 0));
+        analyzer.set_bins(msc::get_item(this->parameters.bins, 0));
+        analyzer.set_points(this->parameters.points);
+        return analyzer;
+    }
+
+    void application::analyze_fused(const msc::interpolated_properties& props,
+                                    const ogdf::GraphAttributes& attrs,
+                                    msc::json_object& subinfo) const
+    {
+        const auto& fused = this->parameters.fused;
+        subinfo.update(msc::analyze_interpolated_properties(
+            props,
+            this->make_analyzer(),
+            msc::expand_filename_rate(fused.rdf_global, props.rate),
+            msc::expand_filename_rate(fused.tension, props.rate),
+            fused.stress
+        ));
+        if (fused.stress) {
+            // The stress program picks up the moments from the cache so it doesn't have to compute them again.
+            if (const auto key = msc::get_property_cache_key("stress", attrs)) {
+                const auto& moments = props.moments;
+                msc::store_cached_values(*key, {moments.count, moments.linear, moments.quadratic});
+            }
+        }
+    }
+
     void application::operator()() const
     {
         auto rndeng = std::mt19937{};
@@ -207,12 +302,59 @@ namespace /*anonymous*/
         auto [graph2nd, attrs2nd] = msc::load_layout(this->parameters.input2nd);
         const auto interpolator = linear_interpolator{rndeng, *attrs1st, *attrs2nd, this->parameters.clever};
         auto info = get_info(seed);
+        const auto& rates = this->parameters.rate;
+        const auto distances = (this->parameters.fused.rdf_global.terminal() != msc::terminals::null);
+        // All requested properties of the interpolated layouts are evaluated in a single pass over the node pairs for
+        // as many rates as the memory budget allows.
+        auto matrix = std::unique_ptr<msc::distance_matrix>{};
+        auto budget = msc::get_memory_budget();
+        if (this->want_matrix()) {
+            const auto plan = msc::plan_pairwise_distances(
+                interpolator.graph(), {msc::strategies::full, msc::strategies::compact, msc::strategies::external}
+            );
+            matrix = msc::get_pairwise_shortest_paths(interpolator.graph(), plan.strategy);
+            info["distances"] = msc::get_distance_plan_info(plan);
+            if ((budget = plan.budget)) {
+                *budget -= std::min(*budget, plan.footprint);
+            }
+        }
+        const auto batch = this->want_fused()
+            ? msc::get_interpolation_batch_size(
+                static_cast<std::size_t>(interpolator.graph().numberOfNodes()),
+                rates.size(),
+                distances,
+                matrix != nullptr,
+                budget
+            )
+            : std::max(rates.size(), std::size_t{1});
         auto data = msc::json_array{};
-        for (const auto rate : this->parameters.rate) {
-            const auto dest = this->parameters.expand_filename(rate);
-            const auto inter = interpolator(rate);
-            msc::store_layout(*inter, dest);
-            data.push_back(get_subinfo(*inter, rate, dest.filename()));
+        for (std::size_t first = 0; first < rates.size(); first += batch) {
+            const auto last = std::min(rates.size(), first + batch);
+            auto fused = std::vector<msc::interpolated_properties>{};
+            if (this->want_fused()) {
+                fused = msc::evaluate_interpolation(
+                    interpolator.graph(),
+                    interpolator.lhs_coordinates(),
+                    interpolator.rhs_coordinates(),
+                    std::vector<double>(std::begin(rates) + first, std::begin(rates) + last),
+                    matrix.get(),
+                    distances
+                );
+            }
+            for (std::size_t i = first; i < last; ++i) {
+                const auto rate = rates[i];
+                const auto dest = this->parameters.expand_filename(rate);
+                const auto inter = interpolator(rate);
+                msc::store_layout(*inter, dest);
+                auto subinfo = get_subinfo(*inter, rate, dest.filename());
+                if (!fused.empty()) {
+                    this->analyze_fused(fused[i - first], *inter, subinfo);
+                }
+                data.push_back(std::move(subinfo));
+            }
+        }
+        if (this->want_fused()) {
+            info["passes"] = msc::json_size{(rates.size() + batch - 1) / batch};
         }
         info["data"] = std::move(data);
         msc::print_meta(info, this->parameters.meta);
@@ -226,5 +368,12 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Linear interpolation between layouts.");
+    app.help.push_back(
+        "If --rdf-global, --tension or --stress is given, the respective property is computed for all interpolated"
+        " layouts in a single pass over the pairs of nodes, which is much faster than analyzing each layout on its own."
+        "  If the pairwise data for all rates does not fit into the memory budget, the rates are split into as few passes"
+        " as necessary.  The results are written to the meta data and any '%' in the file names is substituted like it"
+        " is for the layouts.  The --kernel, --width, --bins and --points options apply to the RDF and the tension."
+    );
     return app(argc, argv);
 }
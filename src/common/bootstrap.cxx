@@ -0,0 +1,118 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "bootstrap.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include "concurrency.hxx"
+#include "histogram.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        double get_reference_binwidth(const std::vector<std::vector<double>>& groups)
+        {
+            auto values = std::vector<double>{};
+            for (const auto& group : groups) {
+                values.insert(std::end(values), std::begin(group), std::end(group));
+            }
+            if (values.size() < 3) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            const auto [lo, hi] = std::minmax_element(std::begin(values), std::end(values));
+            if (!(*lo < *hi)) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return histogram{values}.binwidth();
+        }
+
+        double get_entropy(const std::vector<double>& values, const double binwidth)
+        {
+            return histogram{values, binwidth}.entropy();
+        }
+
+        double get_standard_deviation(const std::vector<double>& values) noexcept
+        {
+            if (values.size() < 2) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            auto sum = 0.0;
+            for (const auto x : values) {
+                sum += x;
+            }
+            const auto mean = sum / values.size();
+            auto squares = 0.0;
+            for (const auto x : values) {
+                squares += (x - mean) * (x - mean);
+            }
+            return std::sqrt(squares / (values.size() - 1));
+        }
+
+    }  // namespace /*anonymous*/
+
+    bootstrap_error get_bootstrap_error(const std::vector<std::vector<double>>& groups,
+                                        const philox_engine& engine,
+                                        const std::size_t replicas)
+    {
+        auto error = bootstrap_error{};
+        const auto binwidth = get_reference_binwidth(groups);
+        if ((groups.size() < 2) || !(binwidth > 0.0) || !std::isfinite(binwidth)) {
+            return error;
+        }
+        auto means = std::vector<double>(replicas, NAN);
+        auto entropies = std::vector<double>(replicas, NAN);
+        parallel_for(replicas, [&](const std::size_t r){
+            auto rndeng = engine.substream(r);
+            auto rnddst = std::uniform_int_distribution<std::size_t>{0, groups.size() - 1};
+            auto values = std::vector<double>{};
+            for (auto i = std::size_t{}; i < groups.size(); ++i) {
+                const auto& group = groups[rnddst(rndeng)];
+                values.insert(std::end(values), std::begin(group), std::end(group));
+            }
+            if (values.size() >= 3) {
+                means[r] = std::accumulate(std::begin(values), std::end(values), 0.0) / values.size();
+                entropies[r] = get_entropy(values, binwidth);
+            }
+        });
+        const auto isnan = [](const double x){ return std::isnan(x); };
+        means.erase(std::remove_if(std::begin(means), std::end(means), isnan), std::end(means));
+        entropies.erase(std::remove_if(std::begin(entropies), std::end(entropies), isnan), std::end(entropies));
+        error.mean = get_standard_deviation(means);
+        error.entropy = get_standard_deviation(entropies);
+        error.replicas = means.size();
+        return error;
+    }
+
+    void assign_bootstrap_error(const bootstrap_error& error, json_object& info)
+    {
+        info["mean-error"] = json_real{error.mean};
+        info["entropy-error"] = json_real{error.entropy};
+        info["bootstrap-replicas"] = json_size{error.replicas};
+    }
+
+}  // namespace msc
@@ -0,0 +1,133 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ * @file bootstrap.hxx
+ *
+ * @brief
+ *     Bootstrap error estimates for statistics computed from a sample of source nodes.
+ *
+ * When a property is estimated from the pairs of nodes that involve a random subset of source nodes (landmarks), the
+ * values obtained for the same source are correlated.  The error of the estimate is therefore obtained by resampling
+ * whole groups of values (one group per source) with replacement rather than individual values.
+ *
+ */
+
+#ifndef MSC_BOOTSTRAP_HXX
+#define MSC_BOOTSTRAP_HXX
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "json.hxx"
+#include "random.hxx"
+
+namespace msc
+{
+
+    /** @brief Number of bootstrap replicas that are drawn by default.  */
+    inline constexpr std::size_t default_bootstrap_replicas = 32;
+
+    /**
+     * @brief
+     *     Standard errors of statistics as estimated by the bootstrap.
+     *
+     */
+    struct bootstrap_error
+    {
+
+        /** @brief Standard error of the mean.  */
+        double mean{NAN};
+
+        /** @brief Standard error of the entropy of a histogram with the bin width of the original sample.  */
+        double entropy{NAN};
+
+        /** @brief Number of replicas the errors were estimated from.  */
+        std::size_t replicas{};
+
+    };
+
+    /**
+     * @brief
+     *     Collects the values from a range of node pairs into groups of values that share the same first node.
+     *
+     * Consecutive pairs with the same first node are put into the same group, which is what is wanted for a range
+     * obtained from a `distance_matrix` that uses `strategies::sampled`.  Nodes without any pairs in the range (for
+     * example, because the predicate rejected all of them) do not get a group.
+     *
+     * @tparam PairIterT
+     *     `node_pair_iterator` type with a value type that is convertible to `double`
+     *
+     * @param first
+     *     iterator to the first pair
+     *
+     * @param last
+     *     iterator after the last pair
+     *
+     * @returns
+     *     values grouped by first node
+     *
+     */
+    template <typename PairIterT>
+    std::vector<std::vector<double>> group_by_first_node(PairIterT first, PairIterT last);
+
+    /**
+     * @brief
+     *     Estimates the standard errors of the mean and entropy of a sample by resampling groups of values.
+     *
+     * If there are fewer than two groups or fewer than three values, the errors cannot be estimated and are NaN.
+     *
+     * The replicas are drawn concurrently and replica <var>r</var> draws from `engine.substream(r)`, so the result
+     * does not depend on the number of threads.
+     *
+     * @param groups
+     *     sample grouped by source
+     *
+     * @param engine
+     *     engine to derive the random streams from
+     *
+     * @param replicas
+     *     number of bootstrap replicas to draw
+     *
+     * @returns
+     *     estimated errors
+     *
+     */
+    bootstrap_error get_bootstrap_error(const std::vector<std::vector<double>>& groups,
+                                        const philox_engine& engine,
+                                        std::size_t replicas = default_bootstrap_replicas);
+
+    /**
+     * @brief
+     *     Assigns the estimated errors as `mean-error`, `entropy-error` and `bootstrap-replicas` to `info`.
+     *
+     * @param error
+     *     estimated errors
+     *
+     * @param info
+     *     data structure to assign to
+     *
+     */
+    void assign_bootstrap_error(const bootstrap_error& error, json_object& info);
+
+}  // namespace msc
+
+#define MSC_INCLUDED_FROM_BOOTSTRAP_HXX
+#include "bootstrap.txx"
+#undef MSC_INCLUDED_FROM_BOOTSTRAP_HXX
+
+#endif  // !defined(MSC_BOOTSTRAP_HXX)
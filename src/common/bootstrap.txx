@@ -0,0 +1,40 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef MSC_INCLUDED_FROM_BOOTSTRAP_HXX
+#  error "Never `#include <bootstrap.txx>` directly; `#include <bootstrap.hxx>` instead"
+#endif
+
+namespace msc
+{
+
+    template <typename PairIterT>
+    std::vector<std::vector<double>> group_by_first_node(PairIterT first, const PairIterT last)
+    {
+        auto groups = std::vector<std::vector<double>>{};
+        auto current = decltype(first.nodes().first){};
+        for (; first != last; ++first) {
+            if (const auto v1 = first.nodes().first; (v1 != current) || groups.empty()) {
+                current = v1;
+                groups.emplace_back();
+            }
+            groups.back().push_back(*first);
+        }
+        return groups;
+    }
+
+}  // namespace msc
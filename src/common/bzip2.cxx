@@ -0,0 +1,442 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "bzip2.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include <boost/iostreams/compose.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+
+#include "concurrency.hxx"
+
+namespace msc
+{
+
+    namespace detail::bzip2
+    {
+
+        namespace /*anonymous*/
+        {
+
+            namespace io = boost::iostreams;
+
+            // Magic numbers that start a block and end a stream respectively (48 bits each, not byte-aligned).
+            constexpr std::uint64_t block_magic = 0x314159265359;
+            constexpr std::uint64_t end_magic = 0x177245385090;
+            constexpr std::uint64_t magic_mask = 0xffffffffffff;
+            constexpr std::size_t magic_bits = 48;
+            constexpr std::size_t crc_bits = 32;
+
+            // Maximum amount of uncompressed data in a block (at the highest compression level).
+            constexpr std::size_t chunk_size = 900000;
+
+            constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            std::uint64_t read_bits(const std::string& data, const std::size_t first, const std::size_t count) noexcept
+            {
+                auto value = std::uint64_t{};
+                for (auto pos = first; pos < first + count; ++pos) {
+                    const auto byte = static_cast<unsigned char>(data[pos / 8]);
+                    value = (value << 1) | ((byte >> (7 - pos % 8)) & 1U);
+                }
+                return value;
+            }
+
+            // Returns the position of the first magic number (of either kind) that starts at or after bit `from`.
+            std::size_t find_magic(const std::string& data, const std::size_t from) noexcept
+            {
+                auto window = std::uint64_t{};
+                for (auto i = from / 8; i < data.size(); ++i) {
+                    window = (window << 8) | static_cast<unsigned char>(data[i]);
+                    for (auto k = 8; k-- > 0;) {
+                        const auto last = 8 * i + 7 - k;
+                        if (last + 1 < from + magic_bits) {
+                            continue;
+                        }
+                        const auto candidate = (window >> k) & magic_mask;
+                        if ((candidate == block_magic) || (candidate == end_magic)) {
+                            return last + 1 - magic_bits;
+                        }
+                    }
+                }
+                return npos;
+            }
+
+            std::string extract_bits(const std::string& data, const std::size_t first, const std::size_t last)
+            {
+                const auto length = last - first;
+                const auto base = first / 8;
+                const auto shift = first % 8;
+                auto bytes = std::string((length + 7) / 8, '\0');
+                for (std::size_t i = 0; i < bytes.size(); ++i) {
+                    const auto hi = static_cast<unsigned>(static_cast<unsigned char>(data[base + i]));
+                    const auto lo = (base + i + 1 < data.size())
+                        ? static_cast<unsigned>(static_cast<unsigned char>(data[base + i + 1]))
+                        : 0U;
+                    bytes[i] = static_cast<char>(((hi << shift) | (lo >> (8 - shift))) & 0xffU);
+                }
+                if (const auto rest = length % 8) {
+                    bytes.back() = static_cast<char>(static_cast<unsigned char>(bytes.back()) & (0xffU << (8 - rest)));
+                }
+                return bytes;
+            }
+
+            class bit_writer final
+            {
+            public:
+
+                void put(const std::uint64_t value, const std::size_t count)
+                {
+                    for (auto i = count; i-- > 0;) {
+                        if (_length % 8 == 0) {
+                            _bytes.push_back('\0');
+                        }
+                        if ((value >> i) & 1U) {
+                            _bytes.back() = static_cast<char>(_bytes.back() | (0x80 >> (_length % 8)));
+                        }
+                        _length += 1;
+                    }
+                }
+
+                // The bits after `length` in the last byte of `bytes` must be zero.
+                void append(const std::string& bytes, const std::size_t length)
+                {
+                    const auto shift = _length % 8;
+                    if (shift == 0) {
+                        _bytes.append(bytes, 0, (length + 7) / 8);
+                    } else {
+                        for (std::size_t i = 0; i < (length + 7) / 8; ++i) {
+                            const auto byte = static_cast<unsigned>(static_cast<unsigned char>(bytes[i]));
+                            const auto back = static_cast<unsigned>(static_cast<unsigned char>(_bytes.back()));
+                            _bytes.back() = static_cast<char>(back | (byte >> shift));
+                            _bytes.push_back(static_cast<char>((byte << (8 - shift)) & 0xffU));
+                        }
+                    }
+                    _length += length;
+                    _bytes.resize((_length + 7) / 8);
+                }
+
+                std::size_t length() const noexcept
+                {
+                    return _length;
+                }
+
+                std::string release() noexcept
+                {
+                    _length = 0;
+                    return std::move(_bytes);
+                }
+
+            private:
+
+                std::string _bytes{};
+                std::size_t _length{};
+
+            };  // class bit_writer
+
+            std::uint32_t block_crc(const unpacker::piece& block) noexcept
+            {
+                return static_cast<std::uint32_t>(read_bits(block.bits, magic_bits, crc_bits));
+            }
+
+            unpacker::piece merge(unpacker::piece lhs, const unpacker::piece& rhs)
+            {
+                auto writer = bit_writer{};
+                writer.append(lhs.bits, lhs.length);
+                writer.append(rhs.bits, rhs.length);
+                lhs.length = writer.length();
+                lhs.bits = writer.release();
+                lhs.last = rhs.last;
+                lhs.stream_crc = rhs.stream_crc;
+                return lhs;
+            }
+
+            // Wraps the blocks into a stream of their own.  The combined CRC of a stream with a single block equals the
+            // CRC of that block.  A piece that was cut short by a fake magic number within the compressed data fails
+            // to decode, which is how such pieces are detected.
+            std::optional<std::string> try_decode(const unpacker::piece& blocks)
+            {
+                auto writer = bit_writer{};
+                for (const auto c : {'B', 'Z', 'h', blocks.level}) {
+                    writer.put(static_cast<unsigned char>(c), 8);
+                }
+                writer.append(blocks.bits, blocks.length);
+                writer.put(end_magic, magic_bits);
+                writer.put(block_crc(blocks), crc_bits);
+                const auto stream = writer.release();
+                auto output = std::string{};
+                try {
+                    io::copy(
+                        io::compose(io::bzip2_decompressor{}, io::array_source{stream.data(), stream.size()}),
+                        io::back_inserter(output)
+                    );
+                } catch (const io::bzip2_error&) {
+                    return std::nullopt;
+                }
+                return output;
+            }
+
+            std::string compress_chunk(const char *const data, const std::size_t size)
+            {
+                auto output = std::string{};
+                io::copy(io::array_source{data, size}, io::compose(io::bzip2_compressor{}, io::back_inserter(output)));
+                return output;
+            }
+
+        }  // namespace /*anonymous*/
+
+        unpacker::unpacker(const std::size_t jobs) :
+            _jobs{(jobs > 0) ? jobs : default_concurrency()}, _buffer(64 * 1024)
+        {
+        }
+
+        char* unpacker::buffer() noexcept
+        {
+            return _buffer.data();
+        }
+
+        std::size_t unpacker::buffer_size() const noexcept
+        {
+            return _buffer.size();
+        }
+
+        void unpacker::feed(const char *const data, const std::size_t size)
+        {
+            _input.append(data, size);
+            this->scan();
+            if ((_pieces.size() >= _jobs) && (!_stalled || (_pieces.size() > 1))) {
+                this->decode();
+            }
+        }
+
+        void unpacker::finish()
+        {
+            _finished = true;
+            this->scan();
+            if (_streams == 0) {
+                throw io::bzip2_error{io::bzip2::unexpected_eof};
+            }
+            this->decode();
+        }
+
+        std::size_t unpacker::take(char *const dst, const std::size_t size) noexcept
+        {
+            const auto count = std::min(size, _output.size() - _offset);
+            std::memcpy(dst, _output.data() + _offset, count);
+            _offset += count;
+            if (_offset == _output.size()) {
+                _output.clear();
+                _offset = 0;
+            }
+            return count;
+        }
+
+        bool unpacker::exhausted() const noexcept
+        {
+            return _finished && _pieces.empty() && _output.empty();
+        }
+
+        void unpacker::scan()
+        {
+            const auto total = 8 * _input.size();
+            while (true) {
+                if (!_in_stream) {
+                    const auto offset = _start / 8;
+                    if (_input.size() < offset + 4) {
+                        if (!_finished || ((_input.size() == offset) && (_streams > 0))) {
+                            break;
+                        }
+                        throw io::bzip2_error{io::bzip2::unexpected_eof};
+                    }
+                    const auto level = _input[offset + 3];
+                    if ((_input.compare(offset, 3, "BZh") != 0) || (level < '1') || (level > '9')) {
+                        throw io::bzip2_error{io::bzip2::data_error_magic};
+                    }
+                    _in_stream = true;
+                    _level = level;
+                    _streams += 1;
+                    _start += 32;
+                    _cursor = _start;
+                    continue;
+                }
+                if (total < _start + magic_bits + crc_bits) {
+                    if (_finished) {
+                        throw io::bzip2_error{io::bzip2::unexpected_eof};
+                    }
+                    break;
+                }
+                const auto magic = read_bits(_input, _start, magic_bits);
+                if (magic == end_magic) {
+                    // This can only happen for an empty stream.
+                    if (read_bits(_input, _start + magic_bits, crc_bits) != 0) {
+                        throw io::bzip2_error{io::bzip2::data_error};
+                    }
+                    _in_stream = false;
+                    _start = 8 * ((_start + magic_bits + crc_bits + 7) / 8);
+                    continue;
+                }
+                if (magic != block_magic) {
+                    throw io::bzip2_error{io::bzip2::data_error_magic};
+                }
+                const auto next = find_magic(_input, std::max(_cursor, _start + magic_bits));
+                if (next == npos) {
+                    if (_finished) {
+                        throw io::bzip2_error{io::bzip2::unexpected_eof};
+                    }
+                    _cursor = std::max(_cursor, (total >= magic_bits) ? total - magic_bits + 1 : 0);
+                    break;
+                }
+                auto block = piece{};
+                block.level = _level;
+                block.length = next - _start;
+                block.bits = extract_bits(_input, _start, next);
+                if (read_bits(_input, next, magic_bits) == block_magic) {
+                    _pieces.push_back(std::move(block));
+                    _start = next;
+                    _cursor = next + magic_bits;
+                    continue;
+                }
+                // The magic number that ends the stream could also be a coincidence within the compressed data.  It
+                // is only accepted if it is followed by the end of the input or the header of another stream.
+                const auto after = (next + magic_bits + crc_bits + 7) / 8;
+                if ((_input.size() < after + 4) && !_finished) {
+                    _cursor = next;
+                    break;
+                }
+                const auto at_end = (_input.size() == after);
+                const auto at_header = (_input.size() >= after + 4) && (_input.compare(after, 3, "BZh") == 0)
+                    && (_input[after + 3] >= '1') && (_input[after + 3] <= '9');
+                if (!at_end && !at_header) {
+                    _cursor = next + 1;
+                    continue;
+                }
+                block.last = true;
+                block.stream_crc = static_cast<std::uint32_t>(read_bits(_input, next + magic_bits, crc_bits));
+                _pieces.push_back(std::move(block));
+                _in_stream = false;
+                _start = 8 * after;
+                _cursor = _start;
+            }
+            if (const auto drop = _start / 8; 2 * drop > _input.size()) {
+                _input.erase(0, drop);
+                _start -= 8 * drop;
+                _cursor -= 8 * drop;
+            }
+        }
+
+        void unpacker::decode()
+        {
+            const auto count = _pieces.size();
+            auto results = std::vector<std::optional<std::string>>(count);
+            parallel_for(count, [this, &results](const std::size_t i){ results[i] = try_decode(_pieces[i]); }, _jobs);
+            auto remaining = std::deque<piece>{};
+            for (std::size_t i = 0; i < count; ++i) {
+                auto current = std::move(_pieces[i]);
+                auto result = std::move(results[i]);
+                // A piece that cannot be decoded on its own was cut short by a fake block magic number.
+                while (!result && !current.last && (i + 1 < count)) {
+                    current = merge(std::move(current), _pieces[++i]);
+                    result = try_decode(current);
+                }
+                if (!result) {
+                    if (current.last || _finished) {
+                        throw io::bzip2_error{io::bzip2::data_error};
+                    }
+                    remaining.push_back(std::move(current));
+                    break;
+                }
+                _combined = ((_combined << 1) | (_combined >> 31)) ^ block_crc(current);
+                if (current.last) {
+                    if (_combined != current.stream_crc) {
+                        throw io::bzip2_error{io::bzip2::data_error};
+                    }
+                    _combined = 0;
+                }
+                _output.append(*result);
+            }
+            _stalled = !remaining.empty();
+            _pieces = std::move(remaining);
+        }
+
+        packer::packer(const std::size_t jobs) : _jobs{(jobs > 0) ? jobs : default_concurrency()}
+        {
+        }
+
+        void packer::put(const char *const data, const std::size_t size)
+        {
+            _input.append(data, size);
+            if (_input.size() >= _jobs * chunk_size) {
+                this->compress(false);
+            }
+        }
+
+        void packer::finish()
+        {
+            this->compress(true);
+            _started = false;
+        }
+
+        std::string packer::take()
+        {
+            auto output = std::string{};
+            output.swap(_output);
+            return output;
+        }
+
+        void packer::compress(const bool final)
+        {
+            auto count = final ? (_input.size() + chunk_size - 1) / chunk_size : _input.size() / chunk_size;
+            if (final && !_started) {
+                count = std::max(count, std::size_t{1});
+            }
+            auto results = std::vector<std::string>(count);
+            parallel_for(count, [this, &results](const std::size_t i){
+                const auto offset = i * chunk_size;
+                const auto size = std::min(chunk_size, _input.size() - offset);
+                results[i] = compress_chunk(_input.data() + offset, size);
+            }, _jobs);
+            for (const auto& result : results) {
+                _output.append(result);
+            }
+            _input.erase(0, std::min(_input.size(), count * chunk_size));
+            _started = _started || (count > 0);
+        }
+
+    }  // namespace detail::bzip2
+
+    parallel_bzip2_decompressor::parallel_bzip2_decompressor(const std::size_t jobs) :
+        _unpacker{std::make_shared<detail::bzip2::unpacker>(jobs)}
+    {
+    }
+
+    parallel_bzip2_compressor::parallel_bzip2_compressor(const std::size_t jobs) :
+        _packer{std::make_shared<detail::bzip2::packer>(jobs)}
+    {
+    }
+
+}  // namespace msc
@@ -0,0 +1,185 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file bzip2.hxx
+ *
+ * @brief
+ *     Filters for (de)compressing bzip2 data on multiple threads.
+ *
+ * bzip2 compresses its input in independent blocks of at most 900 kB.  The decompressor locates the block boundaries
+ * by scanning for the (bit-aligned) block magic numbers, wraps each block into a stream of its own and decompresses
+ * these streams on multiple threads.  The compressor splits its input into chunks of the size of a block and writes
+ * each chunk as a separate bzip2 stream.  Multiple concatenated streams are valid bzip2 data that can be read by the
+ * standard `bzip2` program.
+ *
+ * Both filters can be used with Boost.Iostreams in place of `boost::iostreams::bzip2_decompressor` and
+ * `boost::iostreams::bzip2_compressor` respectively.  Errors are reported via `boost::iostreams::bzip2_error` as
+ * well.
+ *
+ */
+
+#ifndef MSC_BZIP2_HXX
+#define MSC_BZIP2_HXX
+
+#include <cstddef>
+#include <ios>
+#include <memory>
+
+#include <boost/iostreams/categories.hpp>
+
+namespace msc
+{
+
+    namespace detail::bzip2
+    {
+        class unpacker;
+        class packer;
+    }  // namespace detail::bzip2
+
+    /**
+     * @brief
+     *     Boost.Iostreams input filter that decompresses bzip2 data on multiple threads.
+     *
+     * Copies of a filter share their state.
+     *
+     */
+    class parallel_bzip2_decompressor final
+    {
+    public:
+
+        /** @brief Character type of the filter.  */
+        using char_type = char;
+
+        /** @brief Category of the filter.  */
+        struct category : boost::iostreams::multichar_input_filter_tag { };
+
+        /**
+         * @brief
+         *     Creates a new filter.
+         *
+         * @param jobs
+         *     maximum number of threads to use or zero to use `default_concurrency()`
+         *
+         */
+        explicit parallel_bzip2_decompressor(std::size_t jobs = 0);
+
+        /**
+         * @brief
+         *     Reads up to `n` bytes of decompressed data.
+         *
+         * @param src
+         *     source to read compressed data from
+         *
+         * @param s
+         *     buffer to store the decompressed data in
+         *
+         * @param n
+         *     size of the buffer
+         *
+         * @returns
+         *     number of bytes read or -1 at the end of the data
+         *
+         * @throws boost::iostreams::bzip2_error
+         *     if the compressed data is invalid
+         *
+         */
+        template <typename SourceT>
+        std::streamsize read(SourceT& src, char* s, std::streamsize n);
+
+    private:
+
+        /** @brief Shared state of the filter.  */
+        std::shared_ptr<detail::bzip2::unpacker> _unpacker;
+
+    };  // class parallel_bzip2_decompressor
+
+    /**
+     * @brief
+     *     Boost.Iostreams output filter that compresses bzip2 data on multiple threads.
+     *
+     * The output is a sequence of bzip2 streams that each hold up to 900 kB of uncompressed data.  Copies of a filter
+     * share their state.
+     *
+     */
+    class parallel_bzip2_compressor final
+    {
+    public:
+
+        /** @brief Character type of the filter.  */
+        using char_type = char;
+
+        /** @brief Category of the filter.  */
+        struct category : boost::iostreams::multichar_output_filter_tag, boost::iostreams::closable_tag { };
+
+        /**
+         * @brief
+         *     Creates a new filter.
+         *
+         * @param jobs
+         *     maximum number of threads to use or zero to use `default_concurrency()`
+         *
+         */
+        explicit parallel_bzip2_compressor(std::size_t jobs = 0);
+
+        /**
+         * @brief
+         *     Compresses `n` bytes of data.
+         *
+         * Compressed data is written to `dst` in batches that have enough chunks to keep all threads busy.
+         *
+         * @param dst
+         *     sink to write the compressed data to
+         *
+         * @param s
+         *     data to compress
+         *
+         * @param n
+         *     number of bytes to compress
+         *
+         * @returns
+         *     `n`
+         *
+         */
+        template <typename SinkT>
+        std::streamsize write(SinkT& dst, const char* s, std::streamsize n);
+
+        /**
+         * @brief
+         *     Compresses and writes all remaining data.
+         *
+         * @param dst
+         *     sink to write the compressed data to
+         *
+         */
+        template <typename SinkT>
+        void close(SinkT& dst);
+
+    private:
+
+        /** @brief Shared state of the filter.  */
+        std::shared_ptr<detail::bzip2::packer> _packer;
+
+    };  // class parallel_bzip2_compressor
+
+}  // namespace msc
+
+#define MSC_INCLUDED_FROM_BZIP2_HXX
+#include "bzip2.txx"
+#undef MSC_INCLUDED_FROM_BZIP2_HXX
+
+#endif  // !defined(MSC_BZIP2_HXX)
@@ -0,0 +1,159 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef MSC_INCLUDED_FROM_BZIP2_HXX
+#  error "Never `#include <bzip2.txx>` directly, `#include <bzip2.hxx>` instead"
+#endif
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/operations.hpp>
+
+namespace msc
+{
+
+    namespace detail::bzip2
+    {
+
+        /** @brief Incremental decompressor that does the actual work for `parallel_bzip2_decompressor`.  */
+        class unpacker final
+        {
+        public:
+
+            explicit unpacker(std::size_t jobs);
+
+            char* buffer() noexcept;
+
+            std::size_t buffer_size() const noexcept;
+
+            void feed(const char* data, std::size_t size);
+
+            void finish();
+
+            std::size_t take(char* dst, std::size_t size) noexcept;
+
+            bool exhausted() const noexcept;
+
+            // A bit string holding a single block (starting with its magic number) or a run of consecutive blocks.
+            struct piece
+            {
+                std::string bits{};
+                std::size_t length{};
+                char level{};
+                bool last{};
+                std::uint32_t stream_crc{};
+            };
+
+        private:
+
+            void scan();
+
+            void decode();
+
+            std::size_t _jobs{};
+            std::vector<char> _buffer{};    // for reading from the source
+            std::string _input{};           // compressed data that is not yet part of a piece
+            std::size_t _start{};           // bit offset into _input where the current block or stream starts
+            std::size_t _cursor{};          // bit offset into _input where the search for magic numbers resumes
+            bool _in_stream{};              // whether the header of the current stream was read
+            char _level{};                  // block size digit from the header of the current stream
+            std::size_t _streams{};         // number of streams encountered so far
+            bool _finished{};               // whether the end of the compressed data was reached
+            std::deque<piece> _pieces{};    // pieces that were not decoded yet
+            bool _stalled{};                // whether the first piece failed to decode and awaits its successor
+            std::uint32_t _combined{};      // combined CRC of the blocks of the current stream so far
+            std::string _output{};          // decompressed data that was not taken yet
+            std::size_t _offset{};          // number of bytes of _output that were taken
+
+        };  // class unpacker
+
+        /** @brief Incremental compressor that does the actual work for `parallel_bzip2_compressor`.  */
+        class packer final
+        {
+        public:
+
+            explicit packer(std::size_t jobs);
+
+            void put(const char* data, std::size_t size);
+
+            void finish();
+
+            std::string take();
+
+        private:
+
+            void compress(bool final);
+
+            std::size_t _jobs{};
+            std::string _input{};           // uncompressed data that was not compressed yet
+            std::string _output{};          // compressed data that was not taken yet
+            bool _started{};                // whether any stream was produced since the last call to finish
+
+        };  // class packer
+
+        template <typename SinkT>
+        void write_all(SinkT& dst, const std::string& data)
+        {
+            auto offset = std::streamsize{};
+            const auto size = static_cast<std::streamsize>(data.size());
+            while (offset < size) {
+                offset += boost::iostreams::write(dst, data.data() + offset, size - offset);
+            }
+        }
+
+    }  // namespace detail::bzip2
+
+    template <typename SourceT>
+    std::streamsize parallel_bzip2_decompressor::read(SourceT& src, char *const s, const std::streamsize n)
+    {
+        auto& unpacker = *_unpacker;
+        while (true) {
+            if (const auto count = unpacker.take(s, static_cast<std::size_t>(n)); count > 0) {
+                return static_cast<std::streamsize>(count);
+            }
+            if (unpacker.exhausted()) {
+                return -1;
+            }
+            const auto size = static_cast<std::streamsize>(unpacker.buffer_size());
+            const auto count = boost::iostreams::read(src, unpacker.buffer(), size);
+            if (count < 0) {
+                unpacker.finish();
+            } else {
+                unpacker.feed(unpacker.buffer(), static_cast<std::size_t>(count));
+            }
+        }
+    }
+
+    template <typename SinkT>
+    std::streamsize parallel_bzip2_compressor::write(SinkT& dst, const char *const s, const std::streamsize n)
+    {
+        _packer->put(s, static_cast<std::size_t>(n));
+        detail::bzip2::write_all(dst, _packer->take());
+        return n;
+    }
+
+    template <typename SinkT>
+    void parallel_bzip2_compressor::close(SinkT& dst)
+    {
+        _packer->finish();
+        detail::bzip2::write_all(dst, _packer->take());
+    }
+
+}  // namespace msc
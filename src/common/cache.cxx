@@ -0,0 +1,481 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "cache.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "file.hxx"
+#include "fingerprint.hxx"
+#include "io.hxx"
+#include "iosupp.hxx"
+#include "json.hxx"
+#include "random.hxx"
+#include "strings.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        constexpr auto analysis_magic = std::string_view{"msc-analysis-1"};
+        constexpr auto lineage_magic = std::string_view{"msc-lineage-1"};
+        constexpr auto values_magic = std::string_view{"msc-values-1"};
+
+        // Writes a primitive JSON value as a line "SECTION TYPE KEY VALUE" where VALUE extends to the end of the line.
+        // Real numbers are written in hexadecimal so they are restored exactly.
+        struct analysis_writer final
+        {
+            std::ostream* os{};
+            std::string_view section{};
+            std::string_view key{};
+
+            void operator()(const json_null& /*value*/) const
+            {
+                _line("null");
+            }
+
+            void operator()(const json_text& value) const
+            {
+                if (value.value.find('\n') != std::string::npos) {
+                    throw std::invalid_argument{"Cannot cache text that spans multiple lines"};
+                }
+                _line("text") << value.value;
+            }
+
+            void operator()(const json_bool& value) const
+            {
+                _line("bool") << (value.value ? "true" : "false");
+            }
+
+            void operator()(const json_real& value) const
+            {
+                _line("real") << std::hexfloat << value.value << std::defaultfloat;
+            }
+
+            void operator()(const json_size& value) const
+            {
+                _line("size") << value.value;
+            }
+
+            void operator()(const json_diff& value) const
+            {
+                _line("diff") << value.value;
+            }
+
+            void operator()(const json_array& /*value*/) const
+            {
+                throw std::invalid_argument{"Cannot cache structured meta-data"};
+            }
+
+            void operator()(const json_object& /*value*/) const
+            {
+                throw std::invalid_argument{"Cannot cache structured meta-data"};
+            }
+
+        private:
+
+            std::ostream& _line(const std::string_view type) const
+            {
+                if (key.empty() || (key.find_first_of(" \n") != std::string_view::npos)) {
+                    throw std::invalid_argument{"Cannot cache meta-data with this key"};
+                }
+                return (*os << '\n' << section << ' ' << type << ' ' << key << ' ');
+            }
+
+        };  // struct analysis_writer
+
+        void write_analysis_section(std::ostream& os, const std::string_view section, const json_object& obj)
+        {
+            for (const auto& [key, value] : obj) {
+                if ((section == "subinfo") && (key == "filename")) {
+                    continue;
+                }
+                std::visit(analysis_writer{&os, section, key}, value);
+            }
+        }
+
+        json_any read_analysis_value(const std::string_view type, const std::string& text)
+        {
+            const auto first = text.c_str();
+            const auto last = first + text.size();
+            auto end = static_cast<char*>(nullptr);
+            if (type == "null") {
+                return json_null{};
+            } else if (type == "text") {
+                return json_text{text};
+            } else if ((type == "bool") && ((text == "true") || (text == "false"))) {
+                return json_bool{text == "true"};
+            } else if (type == "real") {
+                const auto value = std::strtod(first, &end);
+                if ((end == last) && !text.empty()) {
+                    return json_real{value};
+                }
+            } else if (type == "size") {
+                const auto value = std::strtoull(first, &end, 10);
+                if ((end == last) && !text.empty()) {
+                    return json_size{static_cast<std::size_t>(value)};
+                }
+            } else if (type == "diff") {
+                const auto value = std::strtoll(first, &end, 10);
+                if ((end == last) && !text.empty()) {
+                    return json_diff{static_cast<std::ptrdiff_t>(value)};
+                }
+            }
+            throw std::invalid_argument{"Malformed value in cached analysis"};
+        }
+
+        void copy_file_contents(const std::string& source, const std::string& destination)
+        {
+            auto istr = std::ifstream{source, std::ios::binary};
+            auto ostr = std::ofstream{destination, std::ios::binary | std::ios::trunc};
+            if (!istr || !ostr) {
+                throw std::runtime_error{concat("Cannot copy ", source, " to ", destination)};
+            }
+            if (istr.peek() != std::ifstream::traits_type::eof()) {
+                ostr << istr.rdbuf();
+            }
+            ostr.close();
+            if (!ostr) {
+                throw std::runtime_error{concat("Cannot copy ", source, " to ", destination)};
+            }
+        }
+
+        // Writes the text to a unique temporary file first and then moves it into place so other processes never see a
+        // partially written entry.
+        void store_text_atomically(const std::string& filename, const std::string& text)
+        {
+            auto rnddev = std::random_device{};
+            const auto tempname = concat(filename, ".", random_hex_string(rnddev, 8), ".tmp");
+            auto ostr = std::ofstream{tempname};
+            ostr << text;
+            ostr.close();
+            if (!ostr || (std::rename(tempname.c_str(), filename.c_str()) != 0)) {
+                std::remove(tempname.c_str());
+            }
+        }
+
+    }  // namespace /*anonymous*/
+
+    std::optional<std::string> get_cache_directory()
+    {
+        if (const auto envval = std::getenv("MSC_CACHE_DIR")) {
+            if (*envval != '\0') {
+                return std::string{envval};
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::string> get_cache_filename(const std::string_view key)
+    {
+        if (const auto directory = get_cache_directory()) {
+            return concat(*directory, "/", key);
+        }
+        return std::nullopt;
+    }
+
+    bool load_cached_layout(const std::string_view key, ogdf::GraphAttributes& attrs)
+    {
+        const auto filename = get_cache_filename(concat(key, ".xml.gz"));
+        if (!filename || !std::ifstream{*filename}) {
+            return false;
+        }
+        try {
+            const auto [graph, cached] = load_layout(input_file::from_filename(*filename));
+            if (graph_fingerprint(*graph) != graph_fingerprint(attrs.constGraph())) {
+                return false;
+            }
+            auto byindex = std::vector<ogdf::node>(graph->maxNodeIndex() + 1);
+            for (const auto v : graph->nodes) {
+                byindex[v->index()] = v;
+            }
+            for (const auto v : attrs.constGraph().nodes) {
+                attrs.x(v) = cached->x(byindex[v->index()]);
+                attrs.y(v) = cached->y(byindex[v->index()]);
+            }
+            return true;
+        } catch (const std::exception& /*e*/) {
+            return false;
+        }
+    }
+
+    void store_cached_layout(const std::string_view key, const ogdf::GraphAttributes& attrs) noexcept
+    {
+        try {
+            const auto filename = get_cache_filename(concat(key, ".xml.gz"));
+            if (!filename) {
+                return;
+            }
+            // Write to a unique temporary file first and then move it into place so other processes never see a
+            // partially written entry.
+            auto rnddev = std::random_device{};
+            const auto tempname = concat(*filename, ".", random_hex_string(rnddev, 8), ".tmp.gz");
+            store_layout(attrs, output_file::from_filename(tempname));
+            if (std::rename(tempname.c_str(), filename->c_str()) != 0) {
+                std::remove(tempname.c_str());
+            }
+        } catch (const std::exception& /*e*/) {
+            // A cache that cannot be written to is not an error.
+        }
+    }
+
+    std::optional<std::string> get_property_cache_key(const std::string_view producer,
+                                                      const ogdf::GraphAttributes& attrs)
+    {
+        if (!get_cache_directory()) {
+            return std::nullopt;
+        }
+        return get_property_cache_key(producer, isometry_fingerprint(attrs));
+    }
+
+    std::optional<std::string> get_property_cache_key(const std::string_view producer,
+                                                      const std::string_view fingerprint)
+    {
+        if (!get_cache_directory()) {
+            return std::nullopt;
+        }
+        return concat(producer, "-", fingerprint);
+    }
+
+    std::optional<std::vector<double>> load_cached_values(const std::string_view key)
+    {
+        const auto filename = get_cache_filename(concat(key, ".values"));
+        if (!filename) {
+            return std::nullopt;
+        }
+        auto istr = std::ifstream{*filename};
+        auto line = std::string{};
+        if (!std::getline(istr, line) || (line != values_magic)) {
+            return std::nullopt;
+        }
+        auto values = std::vector<double>{};
+        while (std::getline(istr, line)) {
+            const auto first = line.c_str();
+            auto last = static_cast<char*>(nullptr);
+            values.push_back(std::strtod(first, &last));
+            if (line.empty() || (last != first + line.size())) {
+                return std::nullopt;
+            }
+        }
+        return values;
+    }
+
+    void store_cached_values(const std::string_view key, const std::vector<double>& values) noexcept
+    {
+        try {
+            const auto filename = get_cache_filename(concat(key, ".values"));
+            if (!filename) {
+                return;
+            }
+            auto ostr = std::ostringstream{};
+            ostr << values_magic << '\n' << std::hexfloat;
+            for (const auto value : values) {
+                ostr << value << '\n';
+            }
+            store_text_atomically(*filename, ostr.str());
+        } catch (const std::exception& /*e*/) {
+            // A cache that cannot be written to is not an error.
+        }
+    }
+
+    void store_cached_lineage(const ogdf::GraphAttributes& parent,
+                              const ogdf::GraphAttributes& child,
+                              const std::vector<ogdf::node>& moved,
+                              const double scale) noexcept
+    {
+        try {
+            const auto filename = get_cache_filename(concat("layout-", isometry_fingerprint(child), ".lineage"));
+            if (!filename) {
+                return;
+            }
+            const auto fingerprint = isometry_fingerprint(parent);
+            const auto parentkey = concat("layout-", fingerprint);
+            if (!std::ifstream{concat(*get_cache_filename(parentkey), ".xml.gz")}) {
+                store_cached_layout(parentkey, parent);
+            }
+            auto ostr = std::ostringstream{};
+            ostr << lineage_magic << '\n' << fingerprint << '\n' << std::hexfloat << scale << '\n' << moved.size();
+            for (const auto v : moved) {
+                ostr << ' ' << v->index();
+            }
+            ostr << '\n';
+            store_text_atomically(*filename, ostr.str());
+        } catch (const std::exception& /*e*/) {
+            // A cache that cannot be written to is not an error.
+        }
+    }
+
+    std::optional<layout_lineage> load_cached_lineage(const ogdf::GraphAttributes& child, ogdf::GraphAttributes& parent)
+    {
+        const auto filename = get_cache_filename(concat("layout-", isometry_fingerprint(child), ".lineage"));
+        if (!filename) {
+            return std::nullopt;
+        }
+        auto istr = std::ifstream{*filename};
+        auto line = std::string{};
+        auto scale = std::string{};
+        auto count = std::size_t{};
+        auto lineage = layout_lineage{};
+        if (!std::getline(istr, line) || (line != lineage_magic) || !(istr >> lineage.parent >> scale >> count)) {
+            return std::nullopt;
+        }
+        lineage.scale = std::strtod(scale.c_str(), nullptr);
+        if (!std::isfinite(lineage.scale) || !(lineage.scale > 0.0)) {
+            return std::nullopt;
+        }
+        const auto& graph = child.constGraph();
+        auto byindex = std::vector<ogdf::node>(static_cast<std::size_t>(graph.maxNodeIndex() + 1));
+        for (const auto v : graph.nodes) {
+            byindex[static_cast<std::size_t>(v->index())] = v;
+        }
+        for (auto i = std::size_t{}; i < count; ++i) {
+            auto index = std::size_t{};
+            if (!(istr >> index) || (index >= byindex.size()) || (byindex[index] == nullptr)) {
+                return std::nullopt;
+            }
+            lineage.moved.push_back(byindex[index]);
+        }
+        if (!load_cached_layout(concat("layout-", lineage.parent), parent)) {
+            return std::nullopt;
+        }
+        return lineage;
+    }
+
+    bool load_cached_analysis(const std::string_view key,
+                              json_object& info,
+                              json_object& subinfo,
+                              const output_file& dst)
+    {
+        const auto filename = get_cache_filename(concat(key, ".analysis"));
+        if (!filename) {
+            return false;
+        }
+        try {
+            auto istr = std::ifstream{*filename};
+            auto line = std::string{};
+            if (!std::getline(istr, line) || (line != analysis_magic)) {
+                return false;
+            }
+            auto terminal = std::string{};
+            auto compression = std::string{};
+            if (!std::getline(istr, line) || !(std::istringstream{line} >> terminal >> compression)) {
+                return false;
+            }
+            if (dst.terminal() == terminals::file) {
+                if ((terminal != name(terminals::file)) || (compression != name(dst.compression()))) {
+                    return false;
+                }
+            } else if (dst.terminal() != terminals::null) {
+                return false;
+            }
+            auto cachedinfo = json_object{};
+            auto cachedsubinfo = json_object{};
+            while (std::getline(istr, line)) {
+                auto iss = std::istringstream{line};
+                auto section = std::string{};
+                auto type = std::string{};
+                auto field = std::string{};
+                auto text = std::string{};
+                if (!(iss >> section >> type >> field) || (iss.get() != ' ')) {
+                    return false;
+                }
+                std::getline(iss, text);
+                auto value = read_analysis_value(type, text);
+                if (section == "info") {
+                    cachedinfo[field] = std::move(value);
+                } else if (section == "subinfo") {
+                    cachedsubinfo[field] = std::move(value);
+                } else {
+                    return false;
+                }
+            }
+            if (dst.terminal() == terminals::file) {
+                await_deferred_writes(dst);
+                copy_file_contents(concat(*filename, ".", compression), dst.filename());
+            }
+            cachedsubinfo["filename"] = make_json(dst.filename());
+            info.update(std::move(cachedinfo));
+            subinfo.update(std::move(cachedsubinfo));
+            return true;
+        } catch (const std::exception& /*e*/) {
+            return false;
+        }
+    }
+
+    void store_cached_analysis(const std::string_view key,
+                               const json_object& info,
+                               const json_object& subinfo,
+                               const output_file& src) noexcept
+    {
+        try {
+            if ((src.terminal() != terminals::file) && (src.terminal() != terminals::null)) {
+                return;
+            }
+            const auto filename = get_cache_filename(concat(key, ".analysis"));
+            if (!filename) {
+                return;
+            }
+            auto ostr = std::ostringstream{};
+            ostr << analysis_magic << '\n' << name(src.terminal()) << ' ' << name(src.compression());
+            write_analysis_section(ostr, "info", info);
+            write_analysis_section(ostr, "subinfo", subinfo);
+            ostr << '\n';
+            // Like for layouts, both files are first written under unique temporary names.  The data (which is kept
+            // separately for each compression) is moved into place before the meta-data so an entry is never found
+            // without its data.
+            auto rnddev = std::random_device{};
+            const auto tempname = concat(*filename, ".", random_hex_string(rnddev, 8), ".tmp");
+            if (src.terminal() == terminals::file) {
+                // The data might still be written in the background and must not be cached if that failed.
+                if (!await_deferred_writes(src)) {
+                    return;
+                }
+                const auto datafile = concat(*filename, ".", name(src.compression()));
+                const auto tempdata = concat(tempname, ".", name(src.compression()));
+                copy_file_contents(src.filename(), tempdata);
+                if (std::rename(tempdata.c_str(), datafile.c_str()) != 0) {
+                    std::remove(tempdata.c_str());
+                    return;
+                }
+            }
+            store_text_atomically(*filename, ostr.str());
+        } catch (const std::exception& /*e*/) {
+            // A cache that cannot be written to is not an error.
+        }
+    }
+
+}  // namespace msc
@@ -0,0 +1,284 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file cache.hxx
+ *
+ * @brief
+ *     Optional on-disk cache for intermediate results that are expensive to recompute.
+ *
+ * The cache is disabled unless the environment variable `MSC_CACHE_DIR` names a directory.  Entries are identified by
+ * a key which must be a valid file name and should include a fingerprint of whatever the entry depends on.  The cache
+ * is strictly best-effort: an entry that is missing, unreadable or does not match the expectation is treated just like
+ * a cache miss and failure to store an entry is silently ignored.  Entries are written atomically so concurrent
+ * processes may share the same directory.
+ *
+ */
+
+#ifndef MSC_CACHE_HXX
+#define MSC_CACHE_HXX
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ogdf_fwd.hxx"
+
+namespace msc
+{
+
+    struct json_object;
+    struct output_file;
+
+    /**
+     * @brief
+     *     Returns the cache directory as specified by the environment variable `MSC_CACHE_DIR`.
+     *
+     * @returns
+     *     name of the cache directory or `std::nullopt` if caching is disabled
+     *
+     */
+    std::optional<std::string> get_cache_directory();
+
+    /**
+     * @brief
+     *     Returns the name of the file that backs the cache entry with the given key.
+     *
+     * @param key
+     *     key of the cache entry (including a suffix, if desired)
+     *
+     * @returns
+     *     file name or `std::nullopt` if caching is disabled
+     *
+     */
+    std::optional<std::string> get_cache_filename(std::string_view key);
+
+    /**
+     * @brief
+     *     Loads the coordinates of a cached layout into an existing layout.
+     *
+     * The cached layout must be for a graph with the same `graph_fingerprint` as `attrs.constGraph()`.  Nodes are
+     * matched by their index.  If no such entry exists, `attrs` is not modified.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @param attrs
+     *     layout to update (must have the `nodeGraphics` attribute)
+     *
+     * @returns
+     *     whether the layout was found in the cache
+     *
+     */
+    bool load_cached_layout(std::string_view key, ogdf::GraphAttributes& attrs);
+
+    /**
+     * @brief
+     *     Stores a layout in the cache.
+     *
+     * This function does nothing if caching is disabled or the entry cannot be written.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @param attrs
+     *     layout to store
+     *
+     */
+    void store_cached_layout(std::string_view key, const ogdf::GraphAttributes& attrs) noexcept;
+
+    /**
+     * @brief
+     *     Returns a key under which a tool may cache properties of a layout that are invariant under isometries.
+     *
+     * The key combines the name of the tool with the `isometry_fingerprint` of the layout so congruent layouts (for
+     * example, a layout and a rotated copy of it) share their cache entries.
+     *
+     * @param producer
+     *     name of the tool that computes the property
+     *
+     * @param attrs
+     *     layout the property is computed for
+     *
+     * @returns
+     *     cache key or `std::nullopt` if caching is disabled
+     *
+     */
+    std::optional<std::string> get_property_cache_key(std::string_view producer, const ogdf::GraphAttributes& attrs);
+
+    /**
+     * @brief
+     *     Returns a key under which a tool may cache properties of a layout with the given `isometry_fingerprint`.
+     *
+     * @param producer
+     *     name of the tool that computes the property
+     *
+     * @param fingerprint
+     *     `isometry_fingerprint` of the layout
+     *
+     * @returns
+     *     cache key or `std::nullopt` if caching is disabled
+     *
+     */
+    std::optional<std::string> get_property_cache_key(std::string_view producer, std::string_view fingerprint);
+
+    /**
+     * @brief
+     *     Loads a cached sequence of real numbers.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @returns
+     *     cached values or `std::nullopt` if no such entry exists
+     *
+     */
+    std::optional<std::vector<double>> load_cached_values(std::string_view key);
+
+    /**
+     * @brief
+     *     Stores a sequence of real numbers in the cache.
+     *
+     * The values are stored exactly.  This function does nothing if caching is disabled or the entry cannot be written.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @param values
+     *     values to store
+     *
+     */
+    void store_cached_values(std::string_view key, const std::vector<double>& values) noexcept;
+
+    /**
+     * @brief
+     *     Record of how a layout was derived from another one by moving some of its nodes.
+     *
+     */
+    struct layout_lineage
+    {
+        /** @brief `isometry_fingerprint` of the parent layout.  */
+        std::string parent{};
+
+        /** @brief Factor by which the distance between any two nodes that did not move was scaled.  */
+        double scale{1.0};
+
+        /** @brief Nodes that (may) have moved.  */
+        std::vector<ogdf::node> moved{};
+    };
+
+    /**
+     * @brief
+     *     Stores in the cache how a layout was derived from another one and the parent layout itself.
+     *
+     * Apart from the `moved` nodes, the child layout must be congruent to the parent layout scaled by `scale`.  Both
+     * layouts must be of the same graph.  This function does nothing if caching is disabled or the entries cannot be
+     * written.
+     *
+     * @param parent
+     *     layout the child was derived from
+     *
+     * @param child
+     *     derived layout
+     *
+     * @param moved
+     *     nodes that (may) have moved
+     *
+     * @param scale
+     *     factor by which the distances between nodes that did not move were scaled
+     *
+     */
+    void store_cached_lineage(const ogdf::GraphAttributes& parent,
+                              const ogdf::GraphAttributes& child,
+                              const std::vector<ogdf::node>& moved,
+                              double scale) noexcept;
+
+    /**
+     * @brief
+     *     Looks up how a layout was derived from another one and loads the coordinates of the parent layout.
+     *
+     * If no lineage or parent layout is cached for `child`, `parent` is not modified.
+     *
+     * @param child
+     *     derived layout
+     *
+     * @param parent
+     *     layout of the same graph to update with the coordinates of the parent layout
+     *
+     * @returns
+     *     lineage of the layout (with nodes from the graph of `child`) or `std::nullopt` if it is not known
+     *
+     */
+    std::optional<layout_lineage> load_cached_lineage(const ogdf::GraphAttributes& child,
+                                                      ogdf::GraphAttributes& parent);
+
+    /**
+     * @brief
+     *     Loads the result of a cached statistical analysis.
+     *
+     * The cached output is copied to `dst` and the cached meta-data is merged into `info` and `subinfo` except that
+     * `subinfo["filename"]` is set to the name of `dst`.  Only entries that were stored for an output with the same
+     * terminal and compression can be loaded, except that an output to the null terminal can use any entry.  If no
+     * such entry exists, nothing is modified.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @param info
+     *     meta-data object to augment with the cached information
+     *
+     * @param subinfo
+     *     meta-data object to augment with the cached information
+     *
+     * @param dst
+     *     output file to restore
+     *
+     * @returns
+     *     whether the analysis was found in the cache
+     *
+     */
+    bool load_cached_analysis(std::string_view key, json_object& info, json_object& subinfo, const output_file& dst);
+
+    /**
+     * @brief
+     *     Stores the result of a statistical analysis in the cache.
+     *
+     * Only the output to a regular file or the null terminal can be cached and only meta-data with primitive values.
+     * This function does nothing if caching is disabled or the entry cannot be written.
+     *
+     * @param key
+     *     key of the cache entry
+     *
+     * @param info
+     *     meta-data about the analysis
+     *
+     * @param subinfo
+     *     meta-data about the analysis
+     *
+     * @param src
+     *     output file that was written by the analysis
+     *
+     */
+    void store_cached_analysis(std::string_view key,
+                               const json_object& info,
+                               const json_object& subinfo,
+                               const output_file& src) noexcept;
+
+}  // namespace msc
+
+#endif  // !defined(MSC_CACHE_HXX)
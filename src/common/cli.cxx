@@ -32,8 +32,11 @@
 #include <iostream>
 #include <optional>
 #include <ostream>
+#include <stdexcept>
+#include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 #if __has_include(<unistd.h>)
 #  include <unistd.h>
@@ -49,6 +52,8 @@
 
 #include <ogdf/basic/Logger.h>
 
+#include "iosupp.hxx"
+#include "profile.hxx"
 #include "rlimits.hxx"
 #include "useful.hxx"
 
@@ -384,10 +389,12 @@ namespace msc
             }
             set_resource_limits();
             ogdf::Logger::setWorldStream(std::clog);
+            reset_profile();
         }
 
         void after_main()
         {
+            finish_deferred_writes();
             check_stdio(std::cin, std::cout);
         }
 
@@ -436,35 +443,30 @@ namespace msc
         return text;
     }
 
-    namespace /*anonymous*/
+    output_file expand_filename_rate(const output_file& pattern, const double rate)
     {
-
-        output_file expand_filename_rate(const output_file& dst, const double rate)
-        {
-            assert((rate >= 0.0) && (rate <= 1.0));
-            const auto digits = 5;
-            const auto multiply = std::pow(10.0, digits - 1);
-            const auto thisstep = static_cast<int>(std::round(multiply * rate));
-            auto formatted = std::to_string(thisstep);
-            formatted.insert(0, digits - formatted.length(), '0');
-            auto thefile = output_file{};
-            if (dst.terminal() == terminals::file) {
-                auto expanded = std::string{};
-                for (const auto c : dst.filename()) {
-                    if (c == '%') {
-                        expanded.append(formatted);
-                    } else {
-                        expanded.push_back(c);
-                    }
+        assert((rate >= 0.0) && (rate <= 1.0));
+        const auto digits = 5;
+        const auto multiply = std::pow(10.0, digits - 1);
+        const auto thisstep = static_cast<int>(std::round(multiply * rate));
+        auto formatted = std::to_string(thisstep);
+        formatted.insert(0, digits - formatted.length(), '0');
+        auto thefile = output_file{};
+        if (pattern.terminal() == terminals::file) {
+            auto expanded = std::string{};
+            for (const auto c : pattern.filename()) {
+                if (c == '%') {
+                    expanded.append(formatted);
+                } else {
+                    expanded.push_back(c);
                 }
-                thefile.assign<terminals::file>(expanded, dst.compression());
-            } else {
-                thefile.assign(dst);
             }
-            return thefile;
+            thefile.assign<terminals::file>(expanded, pattern.compression());
+        } else {
+            thefile.assign(pattern);
         }
-
-    } // namespace /*anonymous*/
+        return thefile;
+    }
 
     output_file cli_parameters_interpolation::expand_filename(const double degree) const
     {
@@ -529,4 +531,38 @@ namespace msc
         return thefile;
     }
 
+    output_file expand_filename_batch(const output_file& pattern, const std::size_t index)
+    {
+        auto thefile = output_file{};
+        if (pattern.terminal() == terminals::file) {
+            auto expanded = pattern.filename();
+            const auto pos = expanded.find('%');
+            if (pos == std::string::npos) {
+                throw std::invalid_argument{"Output file name template needs a '%' character in batch mode"};
+            }
+            expanded.replace(pos, 1, std::to_string(index));
+            thefile.assign<terminals::file>(expanded, pattern.compression());
+        } else {
+            thefile.assign(pattern);
+        }
+        return thefile;
+    }
+
+    std::vector<input_file> read_batch_list(const input_file& src)
+    {
+        auto stream = boost::iostreams::filtering_istream{};
+        const auto name = prepare_stream(stream, src);
+        auto inputs = std::vector<input_file>{};
+        auto line = std::string{};
+        while (std::getline(stream, line)) {
+            if (!line.empty() && (line.front() != '#')) {
+                inputs.push_back(input_file::from_filename(line));
+            }
+        }
+        if (stream.bad() || !stream.eof()) {
+            report_io_error(name, "Cannot read list of input files");
+        }
+        return inputs;
+    }
+
 }  // namespace msc
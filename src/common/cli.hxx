@@ -49,6 +49,23 @@ namespace msc
         fit_scale   = 2,  ///< fit quadratic parabola against scale using default node distance and report minimum
     };
 
+    /**
+     * @brief
+     *     Properties of interpolated layouts that are evaluated for all rates at once (see `evaluate_interpolation`).
+     *
+     */
+    struct fused_outputs
+    {
+        /** @brief Output data file (pattern) for the global RDF.  */
+        output_file rdf_global{};
+
+        /** @brief Output data file (pattern) for the tension.  */
+        output_file tension{};
+
+        /** @brief Whether or not to compute the stress.  */
+        bool stress{};
+    };
+
     /**
      * @brief
      *     Base-class for command-line interfaces.
@@ -140,6 +157,15 @@ namespace msc
      *     <td>optional</td>
      *   </tr>
      *   <tr>
+     *     <td></td>
+     *     <td>`--batch`</td>
+     *     <td>`batch`</td>
+     *     <td>`input_file`</td>
+     *     <td>null terminal</td>
+     *     <td>optional, runs the application once for each input file listed (see `read_batch_list`) and reports
+     *     errors per input</td>
+     *   </tr>
+     *   <tr>
      *     <td>`-f`</td>
      *     <td>`--format`</td>
      *     <td>`format`</td>
@@ -212,6 +238,14 @@ namespace msc
      *     <td>boolean flag</td>
      *   </tr>
      *   <tr>
+     *     <td></td>
+     *     <td>`--stream`</td>
+     *     <td>`stream`</td>
+     *     <td>`bool`</td>
+     *     <td>`false`</td>
+     *     <td>boolean flag</td>
+     *   </tr>
+     *   <tr>
      *     <td>`-a`</td>
      *     <td>`--algorithm`</td>
      *     <td>`algorithm`</td>
@@ -228,6 +262,30 @@ namespace msc
      *     <td>always added together with `--algorithm`</td>
      *   </tr>
      *   <tr>
+     *     <td>`-a`</td>
+     *     <td>`--algorithm`</td>
+     *     <td>`algorithm`</td>
+     *     <td>`std::vector&lt;#algorithms&gt;`</td>
+     *     <td>empty</td>
+     *     <td>mandatory, may be passed one or more times</td>
+     *   </tr>
+     *   <tr>
+     *     <td>`-R`</td>
+     *     <td>`--replicas`</td>
+     *     <td>`replicas`</td>
+     *     <td>`int`</td>
+     *     <td><var>N</var> &gt; 0</td>
+     *     <td>optional</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
+     *     <td>`--warm-start`</td>
+     *     <td>`warm_start`</td>
+     *     <td>`bool`</td>
+     *     <td>`false`</td>
+     *     <td>boolean flag</td>
+     *   </tr>
+     *   <tr>
      *     <td>`-d`</td>
      *     <td>`--distribution`</td>
      *     <td>`distribution`</td>
@@ -332,6 +390,14 @@ namespace msc
      *     <td>zero or more non-negative real values</td>
      *   </tr>
      *   <tr>
+     *     <td>`-L`</td>
+     *     <td>`--landmarks`</td>
+     *     <td>`landmarks`</td>
+     *     <td>`std::optional&lt;int&gt;`</td>
+     *     <td>`std::nullopt`</td>
+     *     <td>optional</td>
+     *   </tr>
+     *   <tr>
      *     <td>`-c`</td>
      *     <td>`--clever`</td>
      *     <td>`clever`</td>
@@ -357,6 +423,30 @@ namespace msc
      *   </tr>
      *   <tr>
      *     <td></td>
+     *     <td>`--rdf-global`</td>
+     *     <td>`fused`</td>
+     *     <td>`msc::fused_outputs`</td>
+     *     <td>null terminal</td>
+     *     <td>optional, always added together with `--tension` and `--stress`</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
+     *     <td>`--tension`</td>
+     *     <td>`fused`</td>
+     *     <td>`msc::fused_outputs`</td>
+     *     <td>null terminal</td>
+     *     <td>optional, always added together with `--rdf-global` and `--stress`</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
+     *     <td>`--stress`</td>
+     *     <td>`fused`</td>
+     *     <td>`msc::fused_outputs`</td>
+     *     <td>`false`</td>
+     *     <td>boolean flag, always added together with `--rdf-global` and `--tension`</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
      *     <td>`--node-color`</td>
      *     <td>`node_color`</td>
      *     <td>`ogdf::Color`</td>
@@ -381,6 +471,30 @@ namespace msc
      *   </tr>
      *   <tr>
      *     <td></td>
+     *     <td>`--png`</td>
+     *     <td>`png`</td>
+     *     <td>`std::optional&lt;int&gt;`</td>
+     *     <td>`std::nullopt`</td>
+     *     <td>optional, cannot be combined with `--tikz`</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
+     *     <td>`--tiles`</td>
+     *     <td>`tiles`</td>
+     *     <td>`std::string`</td>
+     *     <td>empty</td>
+     *     <td>optional, cannot be combined with `--tikz`</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
+     *     <td>`--socket`</td>
+     *     <td>`socket`</td>
+     *     <td>`std::string`</td>
+     *     <td>empty</td>
+     *     <td>optional</td>
+     *   </tr>
+     *   <tr>
+     *     <td></td>
      *     <td>`--help`</td>
      *     <td></td>
      *     <td></td>
@@ -667,6 +781,9 @@ namespace msc
         /** @brief List of numbers of evaluation points.  */
         std::optional<int> points{};
 
+        /** @brief File that lists input layout files to process in turn (batch mode).  */
+        input_file batch{};
+
         /**
          * @brief
          *     Returns the number of iterations to be performed.
@@ -693,6 +810,7 @@ namespace msc
         input_file input{"-"};
         //output_file output{"-"};
         output_file meta{};
+        input_file batch{};
     };
 
     /**
@@ -715,6 +833,26 @@ namespace msc
      */
     output_file expand_filename(const output_file& pattern, std::size_t iteration);
 
+    /**
+     * @brief
+     *     Constructs a file name by replacing each `%` in `pattern.filename()` by a string representation of `rate`.
+     *
+     * This is how the output files of the interpolation and worsening programs are named.  Like `expand_filename`,
+     * this function returns a verbatim copy of `pattern` unless `pattern.terminal() == terminals::file`.  The
+     * behavior is undefined unless `0 <= rate <= 1`.
+     *
+     * @param pattern
+     *     file name pattern (including zero or more `%` characters)
+     *
+     * @param rate
+     *     rate to substitute
+     *
+     * @returns
+     *     expanded file name
+     *
+     */
+    output_file expand_filename_rate(const output_file& pattern, double rate);
+
     /**
      * @brief
      *     Constructs a file name by replacing the first and second `%` in `pattern.filename()` by a string
@@ -741,6 +879,47 @@ namespace msc
      */
     output_file expand_filename(const output_file& pattern, std::size_t major, std::size_t minor);
 
+    /**
+     * @brief
+     *     Constructs a file name for the input with the given index in batch mode by replacing only the first `%` in
+     *     `pattern.filename()` by a string representation of `index`.
+     *
+     * Any further `%` characters are preserved so the result can be expanded once more by the application.  This
+     * function returns a verbatim copy of `pattern` unless `pattern.terminal() == terminals::file`.
+     *
+     * @param pattern
+     *     file name pattern (including at least one `%` character)
+     *
+     * @param index
+     *     zero-based index of the input
+     *
+     * @returns
+     *     expanded file name
+     *
+     * @throws std::invalid_argument
+     *     if the file name contains no `%` character (so the outputs would overwrite each other)
+     *
+     */
+    output_file expand_filename_batch(const output_file& pattern, std::size_t index);
+
+    /**
+     * @brief
+     *     Reads the list of input files for batch mode.
+     *
+     * The list contains one file name per line.  Empty lines and lines starting with a `#` are ignored.
+     *
+     * @param src
+     *     file to read the list from
+     *
+     * @returns
+     *     input files in the order they are listed
+     *
+     * @throws std::system_error
+     *     if the list cannot be read
+     *
+     */
+    std::vector<input_file> read_batch_list(const input_file& src);
+
 }  // namespace msc
 
 #define MSC_INCLUDED_FROM_CLI_HXX
@@ -23,6 +23,7 @@
 #include <exception>
 #include <iostream>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -35,7 +36,10 @@
 #include "enums/fileformats.hxx"
 #include "enums/kernels.hxx"
 #include "enums/projections.hxx"
+#include "io.hxx"
+#include "meta.hxx"
 #include "point.hxx"
+#include "profile.hxx"
 #include "strings.hxx"
 
 namespace msc
@@ -282,6 +286,37 @@ namespace msc
 
         };  // struct option_meta
 
+        template <typename CliResT, typename = void>
+        struct option_batch : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_batch<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::batch), input_file>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add([[maybe_unused]] CliResT& results, po::options_description& description)
+            {
+                assert(results.batch.terminal() == terminals::null);
+                description.add_options()(
+                    "batch", po::value<std::string>()->value_name("LIST"),
+                    "process each input file listed in LIST (one per line) in turn; the first '%' in the output file"
+                    " name is substituted by the index of the input and each input produces one line of meta data;"
+                    " inputs that fail are reported in their meta data and don't stop the batch"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("batch")) {
+                    if (varmap.count("input")) {
+                        throw po::error{"The '--batch' option cannot be combined with an input file"};
+                    }
+                    results.batch.assign_from_spec(varmap["batch"].as<std::string>());
+                }
+            }
+
+        };  // struct option_batch
+
         template <typename CliResT, typename = void>
         struct option_format : basic_option_handler<CliResT> { };
 
@@ -496,6 +531,25 @@ namespace msc
 
         };  // struct option_symmetric
 
+        template <typename CliResT, typename = void>
+        struct option_stream : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_stream<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::stream), bool>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.stream == false);
+                description.add_options()(
+                    "stream", po::bool_switch(&results.stream),
+                    "write nodes and edges directly to the output as they are generated (for huge graphs)"
+                );
+            }
+
+        };  // struct option_stream
+
         template <typename CliResT, typename = void>
         struct option_algorithm : basic_option_handler<CliResT> { };
 
@@ -539,6 +593,95 @@ namespace msc
 
         };  // struct option_algorithm
 
+        template <typename CliResT, typename = void>
+        struct option_algorithm_list : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_algorithm_list
+        <
+            CliResT,
+            std::enable_if_t<std::is_same_v<decltype(CliResT::algorithm), std::vector<algorithms>>>
+        > : basic_option_handler<CliResT>
+        {
+
+            static void add([[maybe_unused]] CliResT& results, po::options_description& description)
+            {
+                assert(results.algorithm.empty());
+                description.add_options()(
+                    "algorithm,a", po::value<std::vector<std::string>>()->value_name("SPEC")->required(),
+                    "select layouting algorithm (required, may be repeated to compute multiple layouts)"
+                );
+                description.add_options()("show-algorithms", "show a list of the available algorithms and exit");
+            }
+
+            static void handle_before(CliResT& /*results*/, po::variables_map& varmap)
+            {
+                if (varmap.count("show-algorithms")) {
+                    for (const auto algo : all_algorithms()) {
+                        std::cout << name(algo) << '\n';
+                    }
+                    throw system_exit{};
+                }
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                for (const auto& name : varmap["algorithm"].as<std::vector<std::string>>()) {
+                    results.algorithm.push_back(value_of_algorithms(name));
+                }
+            }
+
+        };  // struct option_algorithm_list
+
+        template <typename CliResT, typename = void>
+        struct option_replicas : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_replicas<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::replicas), int>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.replicas > 0);
+                const auto helptext = concat(
+                    "compute N layouts with independent random seeds for each algorithm ",
+                    "(default: N = ", std::to_string(results.replicas), ")"
+                );
+                description.add_options()(
+                    "replicas,R", po::value<int>(&results.replicas)->value_name("N"),
+                    helptext.c_str()
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& /*varmap*/)
+            {
+                if (results.replicas <= 0) {
+                    throw po::error{"The number of replicas must be a positive integer"};
+                }
+            }
+
+        };  // struct option_replicas
+
+        template <typename CliResT, typename = void>
+        struct option_warm_start : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_warm_start<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::warm_start), bool>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.warm_start == false);
+                description.add_options()(
+                    "warm-start", po::bool_switch(&results.warm_start),
+                    "refine FMMM layouts from a quick coarse placement that may be cached (see below)"
+                );
+            }
+
+        };  // struct option_warm_start
+
         template <typename CliResT, typename = void>
         struct option_distribution : basic_option_handler<CliResT> { };
 
@@ -848,6 +991,42 @@ namespace msc
 
         };  // struct option_vicinity
 
+        template <typename CliResT, typename = void>
+        struct option_landmarks : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_landmarks
+        <
+            CliResT,
+            std::enable_if_t<std::is_same_v<decltype(CliResT::landmarks), std::optional<int>>>
+        > : basic_option_handler<CliResT>
+        {
+
+            static void add([[maybe_unused]] CliResT& results, po::options_description& description)
+            {
+                assert(!results.landmarks.has_value());
+                description.add_options()(
+                    "landmarks,L",
+                    po::value<int>()->value_name("K"),
+                    "estimate the property from the shortest paths from K random nodes only (default: use all nodes"
+                    " unless they don't fit into memory)"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("landmarks")) {
+                    const auto value = varmap["landmarks"].as<int>();
+                    if (value > 0) {
+                        results.landmarks = value;
+                    } else {
+                        throw po::error{"The number of landmarks must be a positive integer"};
+                    }
+                }
+            }
+
+        };  // struct option_landmarks
+
         template <typename CliResT, typename = void>
         struct option_major : basic_option_handler<CliResT> { };
 
@@ -941,6 +1120,45 @@ namespace msc
 
         };  // struct option_stress_modus
 
+        template <typename CliResT, typename = void>
+        struct option_fused : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_fused<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::fused), fused_outputs>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.fused.rdf_global.terminal() == terminals::null);
+                assert(results.fused.tension.terminal() == terminals::null);
+                assert(results.fused.stress == false);
+                description.add_options()(
+                    "rdf-global", po::value<std::string>()->value_name("FILE"),
+                    "also compute the global RDF of each interpolated layout and write it to FILE"
+                );
+                description.add_options()(
+                    "tension", po::value<std::string>()->value_name("FILE"),
+                    "also compute the tension of each interpolated layout and write it to FILE"
+                );
+                description.add_options()(
+                    "stress", po::bool_switch(&results.fused.stress),
+                    "also compute the stress of each interpolated layout"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("rdf-global")) {
+                    results.fused.rdf_global.assign_from_spec(varmap["rdf-global"].as<std::string>());
+                }
+                if (varmap.count("tension")) {
+                    results.fused.tension.assign_from_spec(varmap["tension"].as<std::string>());
+                }
+            }
+
+        };  // struct option_fused
+
         inline void add_color_option(const char *const name,
                                      po::options_description& description,
                                      ogdf::Color& color,
@@ -1041,6 +1259,98 @@ namespace msc
 
         };  // struct option_tikz
 
+        template <typename CliResT, typename = void>
+        struct option_png : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_png<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::png), std::optional<int>>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add([[maybe_unused]] CliResT& results, po::options_description& description)
+            {
+                assert(!results.png.has_value());
+                description.add_options()(
+                    "png", po::value<int>()->value_name("SIZE"),
+                    "output a PNG image of SIZE x SIZE pixels instead of SVG data"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("png")) {
+                    if (varmap.count("tikz") && varmap["tikz"].as<bool>()) {
+                        throw po::error{"The '--png' option cannot be combined with '--tikz'"};
+                    }
+                    const auto value = varmap["png"].as<int>();
+                    if (value > 0) {
+                        results.png = value;
+                    } else {
+                        throw po::error{"The image size must be a positive integer"};
+                    }
+                }
+            }
+
+        };  // struct option_png
+
+        template <typename CliResT, typename = void>
+        struct option_tiles : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_tiles<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::tiles), std::string>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.tiles.empty());
+                description.add_options()(
+                    "tiles", po::value<std::string>(&results.tiles)->value_name("DIR"),
+                    "also write a pyramid of PNG tiles into the existing directory DIR (tiles that already exist are"
+                    " not drawn again)"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("tiles")) {
+                    if (varmap.count("tikz") && varmap["tikz"].as<bool>()) {
+                        throw po::error{"The '--tiles' option cannot be combined with '--tikz'"};
+                    }
+                    if (results.tiles.empty()) {
+                        throw po::error{"The tile directory name must not be empty"};
+                    }
+                }
+            }
+
+        };  // struct option_tiles
+
+        template <typename CliResT, typename = void>
+        struct option_socket : basic_option_handler<CliResT> { };
+
+        template <typename CliResT>
+        struct option_socket<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::socket), std::string>>>
+            : basic_option_handler<CliResT>
+        {
+
+            static void add(CliResT& results, po::options_description& description)
+            {
+                assert(results.socket.empty());
+                description.add_options()(
+                    "socket", po::value<std::string>(&results.socket)->value_name("FILE"),
+                    "listen on the Unix domain socket FILE instead of using the standard streams"
+                );
+            }
+
+            static void handle_after(CliResT& results, po::variables_map& varmap)
+            {
+                if (varmap.count("socket") && results.socket.empty()) {
+                    throw po::error{"The socket file name must not be empty"};
+                }
+            }
+
+        };  // struct option_socket
+
         using all_arguments_handler = argument_handler<
             argument_input, argument_input_1st, argument_input_2nd
         >;
@@ -1049,6 +1359,7 @@ namespace msc
             option_output,
             option_output_layout,
             option_meta,
+            option_batch,
             option_format,
             option_layout_2,
             option_layout_3,
@@ -1057,7 +1368,11 @@ namespace msc
             option_torus,
             option_hyperdim,
             option_symmetric,
+            option_stream,
             option_algorithm,
+            option_algorithm_list,
+            option_replicas,
+            option_warm_start,
             option_distribution,
             option_projection,
             option_rate,
@@ -1067,14 +1382,19 @@ namespace msc
             option_points,
             option_component,
             option_vicinity,
+            option_landmarks,
             option_major,
             option_minor,
             option_clever,
             option_stress_modus,
+            option_fused,
             option_node_color,
             option_edge_color,
             option_axis_color,
-            option_tikz
+            option_tikz,
+            option_png,
+            option_tiles,
+            option_socket
         >;
 
         void add_version_and_help(po::options_description& options);
@@ -1105,6 +1425,70 @@ namespace msc
             all_arguments_handler::handle_after(results, varmap);
         }
 
+        template <typename CliResT>
+        auto expand_batch_output(CliResT& results, const std::size_t index, int)
+            -> std::enable_if_t<std::is_same_v<decltype(CliResT::output), output_file>>
+        {
+            results.output = expand_filename_batch(results.output, index);
+        }
+
+        template <typename CliResT>
+        void expand_batch_output(CliResT&, std::size_t, long) noexcept { }
+
+        template <typename CliResT, typename = void>
+        struct batch_driver
+        {
+            template <typename AppT>
+            static void run(AppT& app, const std::string& /*prog*/)
+            {
+                app();
+            }
+        };
+
+        // The layouts for the upcoming inputs are loaded in the background while the application works on the current
+        // one.  The application itself is still run sequentially on the calling thread.  If it fails for an input, the
+        // error is reported in the meta data for that input and the batch continues with the next one.
+        template <typename CliResT>
+        struct batch_driver<CliResT, std::enable_if_t<std::is_same_v<decltype(CliResT::batch), input_file>>>
+        {
+            template <typename AppT>
+            static void run(AppT& app, const std::string& prog)
+            {
+                if (app.parameters.batch.terminal() == terminals::null) {
+                    app();
+                    return;
+                }
+                const auto original = app.parameters;
+                const auto inputs = read_batch_list(original.batch);
+                auto meta = meta_batch{original.meta};
+                auto failures = std::size_t{};
+                const auto prefetcher = layout_prefetcher{inputs};
+                for (std::size_t i = 0; i < inputs.size(); ++i) {
+                    app.parameters = original;
+                    app.parameters.input = inputs[i];
+                    expand_batch_output(app.parameters, i, 0);
+                    meta.select(i, inputs[i]);
+                    reset_profile();
+                    try {
+                        app();
+                    } catch (const system_exit& /*e*/) {
+                        throw;
+                    } catch (const std::exception& e) {
+                        std::cerr << prog << ": error: " << inputs[i].filename() << ": " << e.what() << std::endl;
+                        meta.report_error(e.what());
+                        failures += 1;
+                    }
+                }
+                app.parameters = original;
+                meta.finish();
+                if (failures > 0) {
+                    throw std::runtime_error{
+                        std::to_string(failures) + " of " + std::to_string(inputs.size()) + " inputs failed"
+                    };
+                }
+            }
+        };
+
         void init_cli_base(cli_base& cli);
         void before_main();
         void after_main();
@@ -1125,7 +1509,7 @@ namespace msc
         try {
             detail::cli::cli_impl_parse_args(*this, _app.parameters, argc, argv);
             detail::cli::before_main();
-            _app();
+            detail::cli::batch_driver<decltype(_app.parameters)>::run(_app, prog);
             detail::cli::after_main();
             return EXIT_SUCCESS;
         } catch (const detail::cli::system_exit& e) {
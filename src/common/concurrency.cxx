@@ -0,0 +1,55 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "concurrency.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include "strings.hxx"
+#include "useful.hxx"
+
+namespace msc
+{
+
+    std::size_t default_concurrency()
+    {
+        if (const auto envval = std::getenv("MSC_JOBS")) {
+            const auto value = parse_decimal_number(envval).value_or(0);
+            if (value <= 0) {
+                throw std::invalid_argument{
+                    concat("Environment variable MSC_JOBS must be set to a positive integer: ", envval)
+                };
+            }
+            return static_cast<std::size_t>(value);
+        }
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    std::mutex& legacy_random_mutex() noexcept
+    {
+        static auto mutex = std::mutex{};
+        return mutex;
+    }
+
+}  // namespace msc
@@ -0,0 +1,102 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file concurrency.hxx
+ *
+ * @brief
+ *     Minimal facilities for processing independent work items on multiple threads.
+ *
+ * Neither OGDF nor the C library give any guarantees about their global state (most notably the random number
+ * generators behind `std::rand` and `ogdf::randomNumber`) when accessed from multiple threads.  Code that calls into
+ * such functions concurrently has to synchronize itself.  This component provides a single global mutex for that
+ * purpose so independent parts of the code base at least agree on which lock to take.
+ *
+ */
+
+#ifndef MSC_CONCURRENCY_HXX
+#define MSC_CONCURRENCY_HXX
+
+#include <cstddef>
+#include <mutex>
+
+namespace msc
+{
+
+    /**
+     * @brief
+     *     Returns the maximum number of worker threads that should be used by default.
+     *
+     * If the environment variable `MSC_JOBS` is set to a positive decimal integer, that value is returned.  Otherwise,
+     * the number of hardware threads is returned or 1 if that cannot be determined.
+     *
+     * @returns
+     *     default number of worker threads
+     *
+     * @throws std::invalid_argument
+     *     if `MSC_JOBS` is set but cannot be parsed as a positive integer
+     *
+     */
+    std::size_t default_concurrency();
+
+    /**
+     * @brief
+     *     Returns a reference to the global mutex that protects the legacy random number generators.
+     *
+     * Any code that re-seeds or draws from `std::rand` (or calls library code that does so) while other threads might
+     * be running must hold this lock while doing so.
+     *
+     * @returns
+     *     reference to a mutex with static storage duration
+     *
+     */
+    std::mutex& legacy_random_mutex() noexcept;
+
+    /**
+     * @brief
+     *     Invokes `func(i)` for each `i` in the half-open interval [0, `count`) using up to `jobs` threads.
+     *
+     * Work items are distributed dynamically so items may be processed in any order and on any thread.  If `jobs` is
+     * zero, `default_concurrency()` threads will be used.  No more threads than `count` will be started and if only
+     * a single thread would be used, all items are processed on the calling thread.
+     *
+     * If any invocation of `func` throws an exception, no further items are started and after all threads have been
+     * joined, the exception thrown by the item with the lowest index is re-thrown.
+     *
+     * @tparam FuncT
+     *     callable type that accepts a `std::size_t` argument
+     *
+     * @param count
+     *     number of work items
+     *
+     * @param func
+     *     callable to invoke on each item (must be safe to call concurrently)
+     *
+     * @param jobs
+     *     maximum number of threads to use or zero to use the default
+     *
+     */
+    template <typename FuncT>
+    void parallel_for(std::size_t count, FuncT&& func, std::size_t jobs = 0);
+
+}  // namespace msc
+
+#define MSC_INCLUDED_FROM_CONCURRENCY_HXX
+#include "concurrency.txx"
+#undef MSC_INCLUDED_FROM_CONCURRENCY_HXX
+
+#endif  // !defined(MSC_CONCURRENCY_HXX)
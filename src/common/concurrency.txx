@@ -0,0 +1,79 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef MSC_INCLUDED_FROM_CONCURRENCY_HXX
+#  error "Never `#include <concurrency.txx>` directly, `#include <concurrency.hxx>` instead"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace msc
+{
+
+    template <typename FuncT>
+    void parallel_for(const std::size_t count, FuncT&& func, const std::size_t jobs)
+    {
+        const auto threads = std::min(count, (jobs > 0) ? jobs : default_concurrency());
+        if (threads <= 1) {
+            for (auto i = std::size_t{}; i < count; ++i) {
+                func(i);
+            }
+            return;
+        }
+        auto next = std::atomic<std::size_t>{0};
+        auto failed = std::atomic<bool>{false};
+        auto errors = std::vector<std::exception_ptr>(count);
+        const auto worker = [&](){
+            while (!failed.load()) {
+                const auto i = next.fetch_add(1);
+                if (i >= count) {
+                    break;
+                }
+                try {
+                    func(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                    failed.store(true);
+                }
+            }
+        };
+        auto pool = std::vector<std::thread>{};
+        pool.reserve(threads - 1);
+        try {
+            for (auto t = std::size_t{1}; t < threads; ++t) {
+                pool.emplace_back(worker);
+            }
+        } catch (...) {
+            // If we cannot start as many threads as we'd like, we make do with what we have.
+        }
+        worker();
+        for (auto& thrd : pool) {
+            thrd.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+}  // namespace msc
@@ -21,10 +21,16 @@
 #include "data_analysis.hxx"
 
 #include <cmath>
+#include <ios>
+#include <random>
+#include <sstream>
 
+#include "cache.hxx"
 #include "json.hxx"
+#include "random.hxx"
 #include "regression.hxx"
 #include "stochastic.hxx"
+#include "strings.hxx"
 
 namespace msc
 {
@@ -77,6 +83,30 @@ namespace msc
         subinfo["filename"] = make_json(_output.filename());
     }
 
+    std::optional<std::string> data_analyzer::_get_cache_entry() const
+    {
+        if (!_cache_key || !get_cache_directory()) {
+            return std::nullopt;
+        }
+        auto params = std::ostringstream{};
+        const auto put = [&params](const auto& value){
+            if (value) {
+                params << *value;
+            }
+            params << ';';
+        };
+        params << std::hexfloat;
+        put(_lower);
+        put(_upper);
+        put(_width);
+        put(_bins);
+        put(_points);
+        const auto text = params.str();
+        auto seedseq = std::seed_seq(std::cbegin(text), std::cend(text));
+        auto rndeng = std::mt19937{seedseq};
+        return concat(*_cache_key, "-", name(_kernel), "-", random_hex_string(rndeng, 8));
+    }
+
     std::vector<std::pair<double, double>> initialize_entropies()
     {
         return {};
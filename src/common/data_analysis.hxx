@@ -73,9 +73,10 @@ namespace msc
          *
          * 1. If there are less than three events, it immediately returns `false` and has no effect.  This step
          *    (which is always performed) exercises at most 3 iterator increments.
-         * 2. Otherwise, if `get_kernel()` is `kernels::raw`, aggregates all events into a vector and outputs it to the
-         *    specified destination as raw list of numbers in a format Gnuplot can understand with a commented header at
-         *    the top of the file (see `#write_events`).  This step exercises exactly <var>n</var> iterator increments.
+         * 2. Otherwise, if `get_kernel()` is `kernels::raw`, computes a summary of the events in a first pass and then
+         *    outputs them to the specified destination in a second pass as raw list of numbers in a format Gnuplot can
+         *    understand with a commented header at the top of the file (see `#write_events`).  The events are never
+         *    held in memory all at once.  This step exercises exactly 2 &sdot; <var>n</var> iterator increments.
          * 3. Otherwise, if `get_kernel()` is `kernels::boxed`, a `msc::histogram` from the range `[first, last)` will
          *    be constructed.  If `get_width().has_value() && !get_bins().has_value()` then `#get_width().value()` will
          *    be used as fixed bin width.  Likewise, if `!get_width().has_value() && get_bins().has_value()` then
@@ -106,6 +107,10 @@ namespace msc
          *    and maybe other attributes specific to the applied kernel.
          * 7. If all this is done, `true` is returned.
          *
+         * If a cache key was set (see `#set_cache_key`) and the cache holds an analysis for it with the same
+         * parameters, the output and meta-data are restored from the cache instead and none of the above steps is
+         * performed.
+         *
          * @tparam FwdIterT
          *     forward iterator type
          *
@@ -366,6 +371,31 @@ namespace msc
          */
         void set_output(output_file dst);
 
+        /**
+         * @brief
+         *     Returns the currently selected cache key (if any).
+         *
+         * @returns
+         *     currently selected cache key
+         *
+         */
+        const std::optional<std::string>& get_cache_key() const noexcept;
+
+        /**
+         * @brief
+         *     Sets (or clears) the key that identifies the data that is going to be analyzed.
+         *
+         * If a key is set and caching is enabled (see `get_cache_directory`), the output and meta-data of each
+         * successful analysis are stored in the cache under the key and the current parameters.  A later analysis with
+         * the same key and parameters then restores them from the cache without even looking at the data.  Therefore,
+         * the key must change whenever the data might change.
+         *
+         * @param key
+         *     key that identifies the data (see `get_property_cache_key`)
+         *
+         */
+        void set_cache_key(std::optional<std::string> key = std::nullopt);
+
     private:
 
         /** @brief Kernel to use for analysis.  */
@@ -389,8 +419,16 @@ namespace msc
         /** @brief Data output file.  */
         output_file _output{};
 
+        /** @brief Key that identifies the data in the cache.  */
+        std::optional<std::string> _cache_key{};
+
 #ifndef MSC_PARSED_BY_DOXYGEN
 
+        template <typename FwdIterT>
+        bool _analyze_uncached(FwdIterT first, FwdIterT last, json_object& info, json_object& subinfo) const;
+
+        std::optional<std::string> _get_cache_entry() const;
+
         void _update_info(json_object& info, json_object& subinfo, const histogram& histo) const;
 
         void _update_info(json_object& info,
@@ -25,8 +25,11 @@
 #include <utility>
 #include <vector>
 
+#include "cache.hxx"
 #include "histogram.hxx"
 #include "io.hxx"
+#include "json.hxx"
+#include "profile.hxx"
 #include "sliding.hxx"
 #include "stochastic.hxx"
 #include "useful.hxx"
@@ -91,6 +94,32 @@ namespace msc
                                                      json_object& info,
                                                      json_object& subinfo) const
     {
+        const auto entry = _get_cache_entry();
+        if (!entry) {
+            return _analyze_uncached(first, last, info, subinfo);
+        }
+        if (load_cached_analysis(*entry, info, subinfo, _output)) {
+            return true;
+        }
+        // Only the information added by this analysis must go into the cache.
+        auto freshinfo = json_object{};
+        auto freshsubinfo = json_object{};
+        if (!_analyze_uncached(first, last, freshinfo, freshsubinfo)) {
+            return false;
+        }
+        store_cached_analysis(*entry, freshinfo, freshsubinfo, _output);
+        info.update(std::move(freshinfo));
+        subinfo.update(std::move(freshsubinfo));
+        return true;
+    }
+
+    template <typename FwdIterT>
+    bool data_analyzer::_analyze_uncached(const FwdIterT first,
+                                          const FwdIterT last,
+                                          json_object& info,
+                                          json_object& subinfo) const
+    {
+        const auto timer = profile_timer{"analysis"};
         // TODO: It would be so much better to split this into a switch statement with a single return per case that
         //       calls a dedicated subroutine to perform the actual work.
         if (detail::data_analysis::distance_less_than_three(first, last)) {
@@ -134,9 +163,13 @@ namespace msc
             const auto maxy = std::max_element(std::begin(density), std::end(density), compy)->second;
             _update_info(info, subinfo, summary, sigma, density.size(), entropy, std::make_pair(maxx, maxy));
         } else if (_kernel == kernels::raw) {
-            const auto events = std::vector<double>{first, last};
-            const auto summary = get_stochastic_summary(events);
-            write_events(events, summary, _output);
+            // The events are formatted straight into the output so the memory needed doesn't depend on their number.
+            const auto summary = get_stochastic_summary(first, last);
+            auto writer = event_writer{summary, _output};
+            for (auto it = first; it != last; ++it) {
+                writer(*it);
+            }
+            writer.finish();
             _update_info(info, subinfo, summary);
         } else {
             reject_invalid_enumeration(_kernel, "msc::kernels");
@@ -223,4 +256,14 @@ namespace msc
         _output = std::move(dst);
     }
 
+    inline const std::optional<std::string>& data_analyzer::get_cache_key() const noexcept
+    {
+        return _cache_key;
+    }
+
+    inline void data_analyzer::set_cache_key(std::optional<std::string> key)
+    {
+        _cache_key = std::move(key);
+    }
+
 }  // namespace msc
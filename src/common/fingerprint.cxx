@@ -20,19 +20,138 @@
 
 #include "fingerprint.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <random>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "normalizer.hxx"
+#include "point.hxx"
 #include "random.hxx"
 
 namespace msc
 {
 
+    namespace /*anonymous*/
+    {
+
+        // The mixing below follows the algorithm that the ISO C++ standard specifies for `std::seed_seq::generate`,
+        // unrolled so that each value is consumed as soon as it is added.
+        constexpr auto mix_size = std::size_t{std::mt19937::state_size};
+        constexpr auto mix_t = std::size_t{11};
+        constexpr auto mix_p = (mix_size - mix_t) / 2;
+        constexpr auto mix_q = mix_p + mix_t;
+
+        constexpr std::uint32_t mix_tempered(const std::uint32_t x) noexcept
+        {
+            return x ^ (x >> 27);
+        }
+
+        // Seed sequence that hands out a state that was computed ahead of time.
+        struct precomputed_seed_sequence
+        {
+            using result_type = std::uint32_t;
+
+            std::array<std::uint32_t, mix_size> state{};
+
+            template <typename RandomIterT>
+            void generate(const RandomIterT first, const RandomIterT last) const
+            {
+                assert(static_cast<std::size_t>(last - first) == state.size());
+                std::copy(std::begin(state), std::end(state), first);
+            }
+        };
+
+        // Tells whether `p` is to the left (1) or to the right (-1) of the line from `a` to `b` or on it (0), treating
+        // distances up to `tolerance` as zero.
+        int get_side_of_line(const point2d& a, const point2d& b, const point2d& p, const double tolerance) noexcept
+        {
+            const auto u = b - a;
+            const auto v = p - a;
+            const auto length = abs(u);
+            if (!(length > tolerance)) {
+                return 0;
+            }
+            const auto offset = (u.x() * v.y() - u.y() * v.x()) / length;
+            return (offset > tolerance) - (offset < -tolerance);
+        }
+
+    }  // namespace /*anonymous*/
+
+    fingerprint_builder::fingerprint_builder(const std::size_t count) noexcept : _count{count}
+    {
+        _state.fill(0x8b8b8b8bU);
+        const auto r1 = std::uint32_t{1664525U} * mix_tempered(_state[0] ^ _state[mix_p] ^ _state[mix_size - 1]);
+        const auto r2 = static_cast<std::uint32_t>(r1 + count);
+        _state[mix_p] += r1;
+        _state[mix_q] += r2;
+        _state[0] = r2;
+    }
+
+    void fingerprint_builder::add(const int value) noexcept
+    {
+        _feed(static_cast<std::uint32_t>(value));
+    }
+
+    void fingerprint_builder::add(const double value) noexcept
+    {
+        // This is the same conversion that `std::seed_seq` applies to its input values.
+        _feed(static_cast<std::uint32_t>(value));
+    }
+
+    void fingerprint_builder::_feed(const std::uint32_t value) noexcept
+    {
+        const auto k = ++_added;
+        const auto kn = k % mix_size;
+        const auto kpn = (k + mix_p) % mix_size;
+        const auto kqn = (k + mix_q) % mix_size;
+        const auto r1 = std::uint32_t{1664525U} * mix_tempered(_state[kn] ^ _state[kpn] ^ _state[(k - 1) % mix_size]);
+        const auto r2 = static_cast<std::uint32_t>(r1 + kn + value);
+        _state[kpn] += r1;
+        _state[kqn] += r2;
+        _state[kn] = r2;
+    }
+
+    std::string fingerprint_builder::finish() const
+    {
+        if (_added != _count) {
+            throw std::logic_error{"Number of values added to fingerprint does not match the announced count"};
+        }
+        auto seq = precomputed_seed_sequence{_state};
+        auto& state = seq.state;
+        const auto m = std::max(_count + 1, mix_size);
+        for (auto k = _count + 1; k < m; ++k) {
+            const auto kn = k % mix_size;
+            const auto kpn = (k + mix_p) % mix_size;
+            const auto kqn = (k + mix_q) % mix_size;
+            const auto r1 = std::uint32_t{1664525U} * mix_tempered(state[kn] ^ state[kpn] ^ state[(k - 1) % mix_size]);
+            const auto r2 = static_cast<std::uint32_t>(r1 + kn);
+            state[kpn] += r1;
+            state[kqn] += r2;
+            state[kn] = r2;
+        }
+        for (auto k = m; k < m + mix_size; ++k) {
+            const auto kn = k % mix_size;
+            const auto kpn = (k + mix_p) % mix_size;
+            const auto kqn = (k + mix_q) % mix_size;
+            const auto arg = static_cast<std::uint32_t>(state[kn] + state[kpn] + state[(k - 1) % mix_size]);
+            const auto r3 = std::uint32_t{1566083941U} * mix_tempered(arg);
+            const auto r4 = static_cast<std::uint32_t>(r3 - kn);
+            state[kpn] ^= r3;
+            state[kqn] ^= r4;
+            state[kn] = r4;
+        }
+        auto rndeng = std::mt19937{seq};
+        return random_hex_string(rndeng);
+    }
+
     std::string graph_fingerprint(const ogdf::Graph& graph)
     {
         auto thevalues = std::vector<int>{};
@@ -70,4 +189,57 @@ namespace msc
         return random_hex_string(rndeng);
     }
 
+    std::string isometry_fingerprint(const ogdf::GraphAttributes& attrs)
+    {
+        assert(attrs.has(ogdf::GraphAttributes::nodeGraphics));
+        const auto& graph = attrs.constGraph();
+        const auto quantum = 1.0E-6 * default_node_distance;
+        auto thevalues = std::vector<std::uint32_t>{};
+        const auto append = [&thevalues, quantum](const double distance){
+            const auto quantized = static_cast<std::uint64_t>(std::llround(distance / quantum));
+            thevalues.push_back(static_cast<std::uint32_t>(quantized));
+            thevalues.push_back(static_cast<std::uint32_t>(quantized >> 32));
+        };
+        thevalues.push_back(graph.numberOfNodes());
+        thevalues.push_back(graph.numberOfEdges());
+        for (const auto edge : graph.edges) {
+            thevalues.push_back(edge->source()->index());
+            thevalues.push_back(edge->target()->index());
+        }
+        auto centroid = point2d{};
+        for (const auto node : graph.nodes) {
+            centroid += point2d{attrs.x(node), attrs.y(node)};
+        }
+        if (!graph.empty()) {
+            centroid /= graph.numberOfNodes();
+        }
+        // Unless they happen to be collinear, the distances to the centroid and to the two preceding nodes pin down the
+        // position of each node relative to the ones before it and are invariant under any isometry of the layout.  If
+        // they are collinear (as is common in grid layouts), they leave open on which side of that line the node is,
+        // so we also record the side of the line through the two preceding nodes.  To stay invariant under
+        // reflections, the side is taken relative to the first node that was not on such a line.
+        auto previous = std::vector<point2d>{};
+        auto orientation = 0;
+        for (const auto node : graph.nodes) {
+            const auto current = point2d{attrs.x(node), attrs.y(node)};
+            thevalues.push_back(node->index());
+            append(distance(current, centroid));
+            for (const auto& other : previous) {
+                append(distance(current, other));
+            }
+            if (previous.size() == 2) {
+                const auto side = get_side_of_line(previous.front(), previous.back(), current, quantum);
+                if (orientation == 0) {
+                    orientation = side;
+                }
+                thevalues.push_back(static_cast<std::uint32_t>(1 + side * orientation));
+                previous.erase(previous.begin());
+            }
+            previous.push_back(current);
+        }
+        auto seedseq = std::seed_seq(std::cbegin(thevalues), std::cend(thevalues));
+        auto rndeng = std::mt19937{seedseq};
+        return random_hex_string(rndeng);
+    }
+
 }  // namespace msc
@@ -25,6 +25,10 @@
 #ifndef MSC_FINGERPRINT_HXX
 #define MSC_FINGERPRINT_HXX
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
 #include <string>
 
 #include "ogdf_fwd.hxx"
@@ -64,6 +68,98 @@ namespace msc
      */
     std::string layout_fingerprint(const ogdf::GraphAttributes& attrs);
 
+    /**
+     * @brief
+     *     Returns a fixed-length string that only depends on the given layout up to rotation, reflection and
+     *     translation and is unlikely to collide with the ID returned for any layout that is not congruent.
+     *
+     * Layouts that only differ by such an isometry (like the input and output of the `rotate` tool) get the same ID
+     * as long as their coordinates agree to within about a millionth of `default_node_distance`.  Properties that only
+     * depend on the graph and the distances between nodes may therefore be shared between layouts with the same ID.
+     * Scaling the layout changes the ID.
+     *
+     * @param attrs
+     *     layout to obtain an ID for
+     *
+     * @returns
+     *     almost unique ID for the congruence class of the layout
+     *
+     */
+    std::string isometry_fingerprint(const ogdf::GraphAttributes& attrs);
+
+    /**
+     * @brief
+     *     Computes a fingerprint from values that are fed one at a time.
+     *
+     * Feeding the same values in the same order as `graph_fingerprint` or `layout_fingerprint` use internally produces
+     * the same fingerprint as these functions do.  This allows computing the fingerprint of a graph or layout that is
+     * never held in memory as a whole.  The total number of values has to be known in advance but the memory used
+     * does not depend on it.
+     *
+     */
+    class fingerprint_builder final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Prepares for receiving exactly `count` values.
+         *
+         * @param count
+         *     total number of values that will be added
+         *
+         */
+        explicit fingerprint_builder(std::size_t count) noexcept;
+
+        /**
+         * @brief
+         *     Adds an integer value.
+         *
+         * @param value
+         *     next value
+         *
+         */
+        void add(int value) noexcept;
+
+        /**
+         * @brief
+         *     Adds a floating-point value.
+         *
+         * @param value
+         *     next value
+         *
+         */
+        void add(double value) noexcept;
+
+        /**
+         * @brief
+         *     Returns the fingerprint of all values that were added.
+         *
+         * @returns
+         *     almost unique ID for the sequence of values
+         *
+         * @throws std::logic_error
+         *     if the number of values added so far does not match the number announced to the constructor
+         *
+         */
+        std::string finish() const;
+
+    private:
+
+        /** @brief Mixing state, equivalent to the output of `std::seed_seq::generate` for `std::mt19937`.  */
+        std::array<std::uint32_t, std::mt19937::state_size> _state{};
+
+        /** @brief Number of values announced to the constructor.  */
+        std::size_t _count{};
+
+        /** @brief Number of values added so far.  */
+        std::size_t _added{};
+
+        /** @brief Mixes the next value into the state.  */
+        void _feed(std::uint32_t value) noexcept;
+
+    };  // class fingerprint_builder
+
 }  // namespace msc
 
 #endif  // !defined(MSC_FINGERPRINT_HXX)
@@ -0,0 +1,160 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "graphml.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "iosupp.hxx"
+#include "normalizer.hxx"
+
+namespace msc
+{
+
+    graphml_writer::graphml_writer(const output_file& dst, const bool layout) : _layout{layout}
+    {
+        _name = prepare_stream(_stream, dst);
+        _stream.precision(std::numeric_limits<double>::max_digits10);
+        _stream << "<?xml version=\"1.0\"?>\n";
+        _stream << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n";
+        if (_layout) {
+            for (const auto key : {"x", "y", "width", "height"}) {
+                _stream << "  <key for=\"node\" attr.name=\"" << key << "\" attr.type=\"double\""
+                        << " id=\"" << key << "\"/>\n";
+            }
+        }
+        _stream << "  <graph id=\"G\" edgedefault=\"undirected\">\n";
+        _check();
+    }
+
+    void graphml_writer::expect(const long nodes, const long edges)
+    {
+        assert((nodes >= 0) && (edges >= 0));
+        if ((_nodes > 0) || (_edges > 0)) {
+            throw std::logic_error{"The size of the graph must be announced before the first node is added"};
+        }
+        _expected_nodes = nodes;
+        _expected_edges = edges;
+        // The values are the same (and in the same order) as the ones that `graph_fingerprint` and
+        // `layout_fingerprint` use.  Since nodes are numbered consecutively, their indices are known in advance.
+        _graphfp.emplace(static_cast<std::size_t>(2 + nodes + 2 * edges));
+        _graphfp->add(static_cast<int>(nodes));
+        _graphfp->add(static_cast<int>(edges));
+        for (auto i = 0L; i < nodes; ++i) {
+            _graphfp->add(static_cast<int>(i));
+        }
+        if (_layout) {
+            _layoutfp.emplace(static_cast<std::size_t>(2 * nodes + 4 * edges));
+            _coords.reserve(static_cast<std::size_t>(nodes));
+        }
+    }
+
+    long graphml_writer::add_node()
+    {
+        assert(!_layout);
+        if ((_expected_nodes >= 0) && (_nodes >= _expected_nodes)) {
+            throw std::logic_error{"More nodes added than announced"};
+        }
+        _stream << "    <node id=\"" << _nodes << "\"/>\n";
+        return _nodes++;
+    }
+
+    long graphml_writer::add_node(const double x, const double y)
+    {
+        assert(_layout);
+        if ((_expected_nodes >= 0) && (_nodes >= _expected_nodes)) {
+            throw std::logic_error{"More nodes added than announced"};
+        }
+        if (_layoutfp) {
+            _layoutfp->add(x);
+            _layoutfp->add(y);
+            _coords.emplace_back(x, y);
+        }
+        if (_nodes == 0) {
+            _sw = _ne = point2d{x, y};
+        }
+        _sw = point2d{std::min(_sw.x(), x), std::min(_sw.y(), y)};
+        _ne = point2d{std::max(_ne.x(), x), std::max(_ne.y(), y)};
+        _stream << "    <node id=\"" << _nodes << "\">"
+                << "<data key=\"x\">" << x << "</data>"
+                << "<data key=\"y\">" << y << "</data>"
+                << "<data key=\"width\">" << default_node_size << "</data>"
+                << "<data key=\"height\">" << default_node_size << "</data>"
+                << "</node>\n";
+        return _nodes++;
+    }
+
+    void graphml_writer::add_edge(const long source, const long target)
+    {
+        assert((source >= 0) && (source < _nodes));
+        assert((target >= 0) && (target < _nodes));
+        if ((_expected_edges >= 0) && (_edges >= _expected_edges)) {
+            throw std::logic_error{"More edges added than announced"};
+        }
+        if (_graphfp) {
+            _graphfp->add(static_cast<int>(source));
+            _graphfp->add(static_cast<int>(target));
+        }
+        if (_layoutfp) {
+            if (_nodes < _expected_nodes) {
+                throw std::logic_error{"All nodes of a layout must be added before the first edge"};
+            }
+            for (const auto v : {source, target}) {
+                const auto& p = _coords[static_cast<std::size_t>(v)];
+                _layoutfp->add(p.x());
+                _layoutfp->add(p.y());
+            }
+        }
+        _stream << "    <edge id=\"" << _edges << "\" source=\"" << source << "\" target=\"" << target << "\"/>\n";
+        _edges += 1;
+    }
+
+    void graphml_writer::close()
+    {
+        if ((_expected_nodes >= 0) && ((_nodes != _expected_nodes) || (_edges != _expected_edges))) {
+            throw std::logic_error{"Numbers of nodes and edges added do not match the announced ones"};
+        }
+        _stream << "  </graph>\n";
+        _stream << "</graphml>\n";
+        _stream.flush();
+        _check();
+        _stream.reset();
+        if (_graphfp) {
+            _graphid = _graphfp->finish();
+        }
+        if (_layoutfp) {
+            _layoutid = _layoutfp->finish();
+        }
+        _coords = std::vector<point2d>{};
+    }
+
+    void graphml_writer::_check()
+    {
+        if (!_stream.good()) {
+            report_io_error(_name, "Cannot write graph data");
+        }
+    }
+
+}  // namespace msc
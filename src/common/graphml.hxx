@@ -0,0 +1,281 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file graphml.hxx
+ *
+ * @brief
+ *     Incremental output of graphs and layouts in GraphML format.
+ *
+ * The functions in `io.hxx` need the complete graph in memory before anything can be written.  This component allows
+ * generators to write nodes and edges directly as they are produced so graphs that would not fit into memory as an
+ * `ogdf::Graph` can still be created.  The output can be read back by `load_graph` and `load_layout`.
+ *
+ */
+
+#ifndef MSC_GRAPHML_HXX
+#define MSC_GRAPHML_HXX
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "file.hxx"
+#include "fingerprint.hxx"
+#include "point.hxx"
+
+namespace msc
+{
+
+    /**
+     * @brief
+     *     Writes a graph or layout in GraphML format one node and edge at a time.
+     *
+     * Nodes are identified by consecutive integers in the order they were added, starting at zero.  Edges may be
+     * interleaved with nodes in any way as long as both of their end-points have already been added.  When the graph
+     * is read back, the order of nodes and edges will be the same as the order in which they were added.
+     *
+     * The document is only complete after `close` has been called.  If the object is destroyed without calling
+     * `close` (for example, because an exception was thrown), the output will be truncated.
+     *
+     */
+    class graphml_writer final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Opens the destination and writes the GraphML header.
+         *
+         * @param dst
+         *     file to write to
+         *
+         * @param layout
+         *     whether nodes will have coordinates
+         *
+         * @throws std::system_error
+         *     if the destination cannot be opened or written to
+         *
+         */
+        graphml_writer(const output_file& dst, bool layout);
+
+        /** @brief Copying is not allowed. */
+        graphml_writer(const graphml_writer& other) = delete;
+
+        /** @brief Copying is not allowed. */
+        graphml_writer& operator=(const graphml_writer& other) = delete;
+
+        /**
+         * @brief
+         *     Announces the final number of nodes and edges so the fingerprints can be computed along the way.
+         *
+         * This function must be called before the first node is added.  After it was called, the writer computes the
+         * same graph fingerprint (and, for layouts, layout fingerprint) as `graph_fingerprint` and
+         * `layout_fingerprint` would for the graph or layout read back from the file.  This requires memory for the
+         * coordinates of the nodes (but not for the edges) and, for layouts, that all nodes are added before the first
+         * edge.
+         *
+         * @param nodes
+         *     total number of nodes that will be added
+         *
+         * @param edges
+         *     total number of edges that will be added
+         *
+         * @throws std::logic_error
+         *     if nodes were already added
+         *
+         */
+        void expect(long nodes, long edges);
+
+        /**
+         * @brief
+         *     Adds a node without coordinates.
+         *
+         * The behavior is undefined unless the writer was constructed with `layout == false`.
+         *
+         * @returns
+         *     ID of the new node
+         *
+         */
+        long add_node();
+
+        /**
+         * @brief
+         *     Adds a node with coordinates.
+         *
+         * The behavior is undefined unless the writer was constructed with `layout == true`.
+         *
+         * @param x
+         *     horizontal coordinate of the node
+         *
+         * @param y
+         *     vertical coordinate of the node
+         *
+         * @returns
+         *     ID of the new node
+         *
+         */
+        long add_node(double x, double y);
+
+        /**
+         * @brief
+         *     Adds an edge between two nodes that were already added.
+         *
+         * @param source
+         *     ID of the first node
+         *
+         * @param target
+         *     ID of the second node
+         *
+         */
+        void add_edge(long source, long target);
+
+        /**
+         * @brief
+         *     Completes the document and flushes all output.
+         *
+         * @throws std::system_error
+         *     if the data cannot be written
+         *
+         * @throws std::logic_error
+         *     if the numbers of nodes and edges don't match what was announced via `expect`
+         *
+         */
+        void close();
+
+        /**
+         * @brief
+         *     Returns the fingerprint of the graph.
+         *
+         * @returns
+         *     graph fingerprint or `std::nullopt` if `expect` was not called or the writer was not closed yet
+         *
+         */
+        const std::optional<std::string>& graph_fingerprint() const noexcept
+        {
+            return _graphid;
+        }
+
+        /**
+         * @brief
+         *     Returns the fingerprint of the layout.
+         *
+         * @returns
+         *     layout fingerprint or `std::nullopt` if `expect` was not called, the writer was not closed yet or nodes
+         *     have no coordinates
+         *
+         */
+        const std::optional<std::string>& layout_fingerprint() const noexcept
+        {
+            return _layoutid;
+        }
+
+        /**
+         * @brief
+         *     Returns the number of nodes added so far.
+         *
+         * @returns
+         *     number of nodes
+         *
+         */
+        long nodes() const noexcept
+        {
+            return _nodes;
+        }
+
+        /**
+         * @brief
+         *     Returns the number of edges added so far.
+         *
+         * @returns
+         *     number of edges
+         *
+         */
+        long edges() const noexcept
+        {
+            return _edges;
+        }
+
+        /**
+         * @brief
+         *     Returns the size of the bounding box of all nodes added so far.
+         *
+         * The result is the same as `get_bounding_box_size` would return for the final layout.
+         *
+         * @returns
+         *     width and height of the bounding box
+         *
+         */
+        point2d bounding_box_size() const noexcept
+        {
+            return _ne - _sw;
+        }
+
+    private:
+
+        /** @brief Output stream with all the filters that were requested. */
+        boost::iostreams::filtering_ostream _stream{};
+
+        /** @brief Informal name of the output file. */
+        std::string _name{};
+
+        /** @brief Whether nodes have coordinates. */
+        bool _layout{};
+
+        /** @brief Number of nodes added so far. */
+        long _nodes{};
+
+        /** @brief Number of edges added so far. */
+        long _edges{};
+
+        /** @brief South-western corner of the bounding box. */
+        point2d _sw{};
+
+        /** @brief North-eastern corner of the bounding box. */
+        point2d _ne{};
+
+        /** @brief Announced number of nodes (negative unless `expect` was called). */
+        long _expected_nodes{-1};
+
+        /** @brief Announced number of edges (negative unless `expect` was called). */
+        long _expected_edges{-1};
+
+        /** @brief Builder for the graph fingerprint. */
+        std::optional<fingerprint_builder> _graphfp{};
+
+        /** @brief Builder for the layout fingerprint. */
+        std::optional<fingerprint_builder> _layoutfp{};
+
+        /** @brief Coordinates of the nodes added so far (only kept for the layout fingerprint). */
+        std::vector<point2d> _coords{};
+
+        /** @brief Graph fingerprint once known. */
+        std::optional<std::string> _graphid{};
+
+        /** @brief Layout fingerprint once known. */
+        std::optional<std::string> _layoutid{};
+
+        /** @brief Throws an exception if the stream has gone bad. */
+        void _check();
+
+    };  // class graphml_writer
+
+}  // namespace msc
+
+#endif  // !defined(MSC_GRAPHML_HXX)
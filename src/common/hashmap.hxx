@@ -0,0 +1,299 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file hashmap.hxx
+ *
+ * @brief
+ *     A simple open-addressing hash map for small trivially copyable keys and values.
+ *
+ */
+
+#ifndef MSC_HASHMAP_HXX
+#define MSC_HASHMAP_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace msc
+{
+
+    /**
+     * @brief
+     *     Scrambles the bits of an integer such that each input bit affects every output bit.
+     *
+     * This is the finalizer of the SplitMix64 generator.  It is a bijection.
+     *
+     * @param x
+     *     integer to scramble
+     *
+     * @returns
+     *     scrambled integer
+     *
+     */
+    constexpr std::uint64_t mix_bits(std::uint64_t x) noexcept
+    {
+        x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief
+     *     Hash function for integers and fixed-size arrays of integers.
+     *
+     * Unlike `std::hash`, which is the identity for integers on most implementations, this hash function mixes all
+     * bits so it is suitable for tables with power-of-two sizes.
+     *
+     * @tparam T
+     *     integral type or `std::array` of an integral type
+     *
+     */
+    template <typename T, typename = void>
+    struct integer_hash;
+
+    /** @brief Specialization for integral types. */
+    template <typename T>
+    struct integer_hash<T, std::enable_if_t<std::is_integral_v<T>>>
+    {
+        constexpr std::size_t operator()(const T value) const noexcept
+        {
+            return static_cast<std::size_t>(mix_bits(static_cast<std::uint64_t>(value)));
+        }
+    };
+
+    /** @brief Specialization for arrays of integral types. */
+    template <typename T, std::size_t N>
+    struct integer_hash<std::array<T, N>, std::enable_if_t<std::is_integral_v<T>>>
+    {
+        constexpr std::size_t operator()(const std::array<T, N>& values) const noexcept
+        {
+            auto seed = std::uint64_t{N};
+            for (const auto value : values) {
+                seed = mix_bits(seed ^ static_cast<std::uint64_t>(value)) + UINT64_C(0x9e3779b97f4a7c15);
+            }
+            return static_cast<std::size_t>(seed);
+        }
+    };
+
+    /**
+     * @brief
+     *     Hash map that stores its entries in a single flat array and resolves collisions by linear probing.
+     *
+     * Entries can only be inserted but never removed (except by clearing the whole map).  Pointers to values are
+     * invalidated by any insertion that causes the map to grow.  The order of iteration is unspecified.
+     *
+     * @tparam KeyT
+     *     key type (should be cheap to copy)
+     *
+     * @tparam ValueT
+     *     value type (must be default-constructible)
+     *
+     * @tparam HashT
+     *     hash function for keys
+     *
+     * @tparam EqualT
+     *     equality predicate for keys
+     *
+     */
+    template
+    <
+        typename KeyT,
+        typename ValueT,
+        typename HashT = integer_hash<KeyT>,
+        typename EqualT = std::equal_to<KeyT>
+    >
+    class open_hash_map final
+    {
+    public:
+
+        /** @brief Type of the keys. */
+        using key_type = KeyT;
+
+        /** @brief Type of the mapped values. */
+        using mapped_type = ValueT;
+
+        /** @brief Type of an entry. */
+        using value_type = std::pair<KeyT, ValueT>;
+
+        /**
+         * @brief
+         *     Creates an empty map.
+         *
+         */
+        open_hash_map() = default;
+
+        /**
+         * @brief
+         *     Creates an empty map that can hold at least `capacity` entries without growing.
+         *
+         * @param capacity
+         *     number of entries to reserve space for
+         *
+         */
+        explicit open_hash_map(std::size_t capacity);
+
+        /**
+         * @brief
+         *     Returns the number of entries in the map.
+         *
+         * @returns
+         *     number of entries
+         *
+         */
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        /**
+         * @brief
+         *     Tells whether the map is empty.
+         *
+         * @returns
+         *     whether there are no entries
+         *
+         */
+        bool empty() const noexcept
+        {
+            return (_size == 0);
+        }
+
+        /**
+         * @brief
+         *     Removes all entries but keeps the allocated memory.
+         *
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief
+         *     Makes sure that at least `capacity` entries can be held without growing.
+         *
+         * @param capacity
+         *     number of entries to reserve space for
+         *
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief
+         *     Looks up the value for a key.
+         *
+         * @param key
+         *     key to look up
+         *
+         * @returns
+         *     pointer to the value or `nullptr` if there is no entry for `key`
+         *
+         */
+        ValueT* find(const KeyT& key) noexcept;
+
+        /**
+         * @brief
+         *     Looks up the value for a key.
+         *
+         * @param key
+         *     key to look up
+         *
+         * @returns
+         *     pointer to the value or `nullptr` if there is no entry for `key`
+         *
+         */
+        const ValueT* find(const KeyT& key) const noexcept;
+
+        /**
+         * @brief
+         *     Tells whether there is an entry for a key.
+         *
+         * @param key
+         *     key to look up
+         *
+         * @returns
+         *     whether there is an entry for `key`
+         *
+         */
+        bool contains(const KeyT& key) const noexcept
+        {
+            return (find(key) != nullptr);
+        }
+
+        /**
+         * @brief
+         *     Inserts an entry unless there is already one for the key.
+         *
+         * @param key
+         *     key of the entry
+         *
+         * @param value
+         *     value to insert if there is no entry for `key` yet
+         *
+         * @returns
+         *     pointer to the value for `key` and whether it was inserted
+         *
+         */
+        std::pair<ValueT*, bool> try_emplace(const KeyT& key, ValueT value = ValueT{});
+
+        /**
+         * @brief
+         *     Calls `func(key, value)` for each entry in unspecified order.
+         *
+         * @param func
+         *     callback
+         *
+         */
+        template <typename FuncT>
+        void for_each(FuncT&& func) const;
+
+    private:
+
+        /** @brief Storage for the entries, the size is always zero or a power of two. */
+        std::vector<value_type> _slots{};
+
+        /** @brief Whether the slot at the same index is occupied. */
+        std::vector<unsigned char> _used{};
+
+        /** @brief Number of occupied slots. */
+        std::size_t _size{};
+
+        /** @brief Hash function. */
+        HashT _hash{};
+
+        /** @brief Equality predicate. */
+        EqualT _equal{};
+
+        /** @brief Returns the index of the slot that holds `key` or of the empty slot where it would be put. */
+        std::size_t _probe(const KeyT& key) const noexcept;
+
+        /** @brief Moves all entries into a new table with `slots` slots. */
+        void _rehash(std::size_t slots);
+
+    };  // class open_hash_map
+
+}  // namespace msc
+
+#define MSC_INCLUDED_FROM_HASHMAP_HXX
+#include "hashmap.txx"
+#undef MSC_INCLUDED_FROM_HASHMAP_HXX
+
+#endif  // !defined(MSC_HASHMAP_HXX)
@@ -0,0 +1,139 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef MSC_INCLUDED_FROM_HASHMAP_HXX
+#  error "Never `#include <hashmap.txx>` directly, `#include <hashmap.hxx>` instead"
+#endif
+
+#include <cassert>
+
+namespace msc
+{
+
+    namespace detail::hashmap
+    {
+
+        // The table is grown whenever it would become more than half full.
+        constexpr std::size_t get_slot_count(const std::size_t capacity) noexcept
+        {
+            auto slots = std::size_t{8};
+            while (slots < 2 * capacity) {
+                slots *= 2;
+            }
+            return slots;
+        }
+
+    }  // namespace detail::hashmap
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    open_hash_map<KeyT, ValueT, HashT, EqualT>::open_hash_map(const std::size_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    void open_hash_map<KeyT, ValueT, HashT, EqualT>::clear() noexcept
+    {
+        std::fill(std::begin(_used), std::end(_used), 0);
+        _size = 0;
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    void open_hash_map<KeyT, ValueT, HashT, EqualT>::reserve(const std::size_t capacity)
+    {
+        const auto slots = detail::hashmap::get_slot_count(capacity);
+        if (slots > _slots.size()) {
+            _rehash(slots);
+        }
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    ValueT* open_hash_map<KeyT, ValueT, HashT, EqualT>::find(const KeyT& key) noexcept
+    {
+        if (_size == 0) {
+            return nullptr;
+        }
+        const auto idx = _probe(key);
+        return _used[idx] ? &_slots[idx].second : nullptr;
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    const ValueT* open_hash_map<KeyT, ValueT, HashT, EqualT>::find(const KeyT& key) const noexcept
+    {
+        if (_size == 0) {
+            return nullptr;
+        }
+        const auto idx = _probe(key);
+        return _used[idx] ? &_slots[idx].second : nullptr;
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    std::pair<ValueT*, bool> open_hash_map<KeyT, ValueT, HashT, EqualT>::try_emplace(const KeyT& key, ValueT value)
+    {
+        if (2 * (_size + 1) > _slots.size()) {
+            _rehash(detail::hashmap::get_slot_count(_size + 1));
+        }
+        const auto idx = _probe(key);
+        if (_used[idx]) {
+            return {&_slots[idx].second, false};
+        }
+        _slots[idx] = value_type{key, std::move(value)};
+        _used[idx] = 1;
+        _size += 1;
+        return {&_slots[idx].second, true};
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    template <typename FuncT>
+    void open_hash_map<KeyT, ValueT, HashT, EqualT>::for_each(FuncT&& func) const
+    {
+        for (auto idx = std::size_t{}; idx < _slots.size(); ++idx) {
+            if (_used[idx]) {
+                func(_slots[idx].first, _slots[idx].second);
+            }
+        }
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    std::size_t open_hash_map<KeyT, ValueT, HashT, EqualT>::_probe(const KeyT& key) const noexcept
+    {
+        assert(!_slots.empty() && (_size < _slots.size()));
+        const auto mask = _slots.size() - 1;
+        auto idx = _hash(key) & mask;
+        while (_used[idx] && !_equal(_slots[idx].first, key)) {
+            idx = (idx + 1) & mask;
+        }
+        return idx;
+    }
+
+    template <typename KeyT, typename ValueT, typename HashT, typename EqualT>
+    void open_hash_map<KeyT, ValueT, HashT, EqualT>::_rehash(const std::size_t slots)
+    {
+        auto oldslots = std::vector<value_type>(slots);
+        auto oldused = std::vector<unsigned char>(slots);
+        oldslots.swap(_slots);
+        oldused.swap(_used);
+        for (auto idx = std::size_t{}; idx < oldslots.size(); ++idx) {
+            if (oldused[idx]) {
+                const auto newidx = _probe(oldslots[idx].first);
+                _slots[newidx] = std::move(oldslots[idx]);
+                _used[newidx] = 1;
+            }
+        }
+    }
+
+}  // namespace msc
@@ -0,0 +1,280 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "interpolation.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include <ogdf/basic/Graph.h>
+
+#include "normalizer.hxx"
+#include "useful.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        // Coordinates of the nodes in traversal order, stored as separate arrays so the differences for a pair can be
+        // loaded without any indirection.
+        struct coordinate_arrays
+        {
+            std::vector<double> lhsx{};
+            std::vector<double> lhsy{};
+            std::vector<double> rhsx{};
+            std::vector<double> rhsy{};
+        };
+
+        // Maps the index of each node to its position in `graph.nodes`.
+        std::vector<std::size_t> get_positions(const ogdf::Graph& graph)
+        {
+            auto slots = std::vector<std::size_t>(static_cast<std::size_t>(graph.maxNodeIndex() + 1));
+            auto position = std::size_t{};
+            for (const auto v : graph.nodes) {
+                slots[static_cast<std::size_t>(v->index())] = position++;
+            }
+            return slots;
+        }
+
+        std::vector<ogdf::node> get_traversal_order(const ogdf::Graph& graph, const distance_matrix* matrix)
+        {
+            auto order = std::vector<ogdf::node>{};
+            order.reserve(static_cast<std::size_t>(graph.numberOfNodes()));
+            if (matrix != nullptr) {
+                for (auto v = matrix->first_node(); v != nullptr; v = matrix->next_node(v)) {
+                    order.push_back(v);
+                }
+            } else {
+                for (const auto v : graph.nodes) {
+                    order.push_back(v);
+                }
+            }
+            return order;
+        }
+
+        coordinate_arrays get_coordinate_arrays(const ogdf::Graph& graph,
+                                                const std::vector<ogdf::node>& order,
+                                                const std::vector<point2d>& lhs,
+                                                const std::vector<point2d>& rhs)
+        {
+            const auto slots = get_positions(graph);
+            auto coords = coordinate_arrays{};
+            for (const auto v : order) {
+                const auto i = slots[static_cast<std::size_t>(v->index())];
+                coords.lhsx.push_back(lhs[i].x());
+                coords.lhsy.push_back(lhs[i].y());
+                coords.rhsx.push_back(rhs[i].x());
+                coords.rhsy.push_back(rhs[i].y());
+            }
+            return coords;
+        }
+
+        // Computes the size of the bounding box of each interpolated layout (before normalization).
+        void assign_bounding_boxes(const coordinate_arrays& coords, std::vector<interpolated_properties>& results)
+        {
+            const auto n = coords.lhsx.size();
+            for (auto& result : results) {
+                const auto t = result.rate;
+                const auto getter = [&coords, t](const std::size_t i){
+                    const auto x = (1.0 - t) * coords.lhsx[i] + t * coords.rhsx[i];
+                    const auto y = (1.0 - t) * coords.lhsy[i] + t * coords.rhsy[i];
+                    return point2d{x, y};
+                };
+                auto sw = (n > 0) ? getter(0) : make_invalid_point<double, 2>();
+                auto ne = sw;
+                for (std::size_t i = 1; i < n; ++i) {
+                    const auto p = getter(i);
+                    sw = point2d{std::min(sw.x(), p.x()), std::min(sw.y(), p.y())};
+                    ne = point2d{std::max(ne.x(), p.x()), std::max(ne.y(), p.y())};
+                }
+                result.bbox = ne - sw;
+            }
+        }
+
+        // Returns the mean edge length of each interpolated layout (before normalization).
+        std::vector<double> get_mean_edge_lengths(const ogdf::Graph& graph,
+                                                  const std::vector<point2d>& lhs,
+                                                  const std::vector<point2d>& rhs,
+                                                  const std::vector<double>& rates)
+        {
+            const auto slots = get_positions(graph);
+            auto sums = std::vector<double>(rates.size());
+            for (const auto e : graph.edges) {
+                const auto i1 = slots[static_cast<std::size_t>(e->source()->index())];
+                const auto i2 = slots[static_cast<std::size_t>(e->target()->index())];
+                for (std::size_t r = 0; r < rates.size(); ++r) {
+                    const auto t = rates[r];
+                    const auto p1 = (1.0 - t) * lhs[i1] + t * rhs[i1];
+                    const auto p2 = (1.0 - t) * lhs[i2] + t * rhs[i2];
+                    sums[r] += distance(p1, p2);
+                }
+            }
+            for (auto& sum : sums) {
+                sum /= graph.numberOfEdges();
+            }
+            return sums;
+        }
+
+    }  // namespace /*anonymous*/
+
+    std::vector<interpolated_properties> evaluate_interpolation(const ogdf::Graph& graph,
+                                                                const std::vector<point2d>& lhs,
+                                                                const std::vector<point2d>& rhs,
+                                                                const std::vector<double>& rates,
+                                                                const distance_matrix* const matrix,
+                                                                const bool distances)
+    {
+        const auto n = static_cast<std::size_t>(graph.numberOfNodes());
+        if ((lhs.size() != n) || (rhs.size() != n)) {
+            throw std::invalid_argument{"Number of coordinates does not match the number of nodes in the graph"};
+        }
+        if ((matrix != nullptr) && (matrix->strategy() == strategies::sampled)) {
+            throw std::invalid_argument{"Interpolated layouts cannot be evaluated from a sampled distance matrix"};
+        }
+        const auto k = rates.size();
+        const auto pairs = (n > 1) ? n * (n - 1) / 2 : std::size_t{0};
+        auto results = std::vector<interpolated_properties>(k);
+        for (std::size_t r = 0; r < k; ++r) {
+            results[r].rate = rates[r];
+            if (distances) {
+                results[r].distances.reserve(pairs);
+            }
+        }
+        const auto order = get_traversal_order(graph, matrix);
+        const auto coords = get_coordinate_arrays(graph, order, lhs, rhs);
+        assign_bounding_boxes(coords, results);
+        // The distances between two nodes for all rates are computed into a scratch buffer first.  This loop has no
+        // dependencies between its iterations and is simple enough for the compiler to vectorize it.
+        auto euclid = std::vector<double>(k);
+        auto pairsums = std::vector<double>(k);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                const auto lhsdx = coords.lhsx[i] - coords.lhsx[j];
+                const auto lhsdy = coords.lhsy[i] - coords.lhsy[j];
+                const auto deltadx = (coords.rhsx[i] - coords.rhsx[j]) - lhsdx;
+                const auto deltady = (coords.rhsy[i] - coords.rhsy[j]) - lhsdy;
+                for (std::size_t r = 0; r < k; ++r) {
+                    const auto dx = lhsdx + rates[r] * deltadx;
+                    const auto dy = lhsdy + rates[r] * deltady;
+                    euclid[r] = std::sqrt(dx * dx + dy * dy);
+                    pairsums[r] += euclid[r];
+                }
+                if (distances) {
+                    for (std::size_t r = 0; r < k; ++r) {
+                        results[r].distances.push_back(euclid[r]);
+                    }
+                }
+                if (matrix != nullptr) {
+                    const auto hops = (*matrix)(order[i], order[j]);
+                    if (std::isfinite(hops)) {
+                        for (std::size_t r = 0; r < k; ++r) {
+                            const auto ratio = euclid[r] / hops;
+                            results[r].tensions.push_back(ratio);
+                            results[r].moments.count += 1.0;
+                            results[r].moments.linear += ratio;
+                            results[r].moments.quadratic += square(ratio);
+                        }
+                    }
+                }
+            }
+        }
+        // Now that the sums are known, the normalization can be applied after the fact (see `normalize_layout`).
+        const auto means = (graph.numberOfEdges() > 0)
+            ? get_mean_edge_lengths(graph, lhs, rhs, rates)
+            : std::vector<double>(k);
+        for (std::size_t r = 0; r < k; ++r) {
+            auto& result = results[r];
+            if (graph.numberOfEdges() > 0) {
+                result.scale = default_node_distance / means[r];
+            } else if (n > 1) {
+                result.scale = default_node_distance / (pairsums[r] / pairs);
+            } else {
+                result.scale = 1.0;
+            }
+            const auto s = result.scale;
+            result.bbox *= s;
+            for (auto& d : result.distances) {
+                d *= s;
+            }
+            for (auto& q : result.tensions) {
+                q *= s / default_node_distance;
+            }
+            result.moments.linear *= s;
+            result.moments.quadratic *= square(s);
+        }
+        return results;
+    }
+
+    std::size_t get_interpolation_batch_size(const std::size_t nodes,
+                                             const std::size_t rates,
+                                             const bool distances,
+                                             const bool tensions,
+                                             const std::optional<std::size_t> budget) noexcept
+    {
+        const auto pairs = (nodes > 1) ? nodes * (nodes - 1) / 2 : std::size_t{0};
+        const auto vectors = std::size_t{distances} + std::size_t{tensions};
+        const auto limit = std::max(rates, std::size_t{1});
+        if (!budget || (pairs == 0) || (vectors == 0)) {
+            return limit;
+        }
+        const auto usable = *budget - *budget / 8;
+        const auto perrate = vectors * sizeof(double);
+        if (pairs > usable / perrate) {
+            return 1;
+        }
+        return std::clamp(usable / (pairs * perrate), std::size_t{1}, limit);
+    }
+
+    json_object analyze_interpolated_properties(const interpolated_properties& props,
+                                                const data_analyzer& analyzer,
+                                                const output_file& rdf_global,
+                                                const output_file& tension,
+                                                const bool stress)
+    {
+        const auto analyze = [](data_analyzer current, const std::vector<double>& sample, const output_file& dst){
+            auto info = json_object{};
+            auto subinfo = json_object{};
+            current.set_output(dst);
+            current.analyze(sample, info, subinfo);
+            info.update(std::move(subinfo));
+            return info;
+        };
+        auto info = json_object{};
+        if (rdf_global.terminal() != terminals::null) {
+            auto current = analyzer;
+            current.set_range(0.0, abs(props.bbox));
+            info["rdf-global"] = analyze(std::move(current), props.distances, rdf_global);
+        }
+        if (tension.terminal() != terminals::null) {
+            info["tension"] = analyze(analyzer, props.tensions, tension);
+        }
+        if (stress) {
+            info["stress"] = json_real{get_stress(props.moments, default_node_distance)};
+        }
+        return info;
+    }
+
+}  // namespace msc
@@ -0,0 +1,200 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ * @file interpolation.hxx
+ *
+ * @brief
+ *     Evaluating properties of a whole family of linearly interpolated layouts at once.
+ *
+ * @warning
+ *     This header actually includes headers from the OGDF rather than just forward-declaring some types.
+ *
+ */
+
+#ifndef MSC_INTERPOLATION_HXX
+#define MSC_INTERPOLATION_HXX
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "data_analysis.hxx"
+#include "file.hxx"
+#include "json.hxx"
+#include "ogdf_fwd.hxx"
+#include "pairwise.hxx"
+#include "point.hxx"
+#include "stress.hxx"
+
+namespace msc
+{
+
+    /**
+     * @brief
+     *     Properties of a single member of a family of interpolated layouts.
+     *
+     * All values refer to the normalized layout that `normalize_layout` would produce from the interpolated one.
+     *
+     */
+    struct interpolated_properties
+    {
+        /** @brief Interpolation rate.  */
+        double rate{};
+
+        /** @brief Factor by which the interpolated layout is scaled by the normalization.  */
+        double scale{};
+
+        /** @brief Size of the bounding box of the normalized layout.  */
+        point2d bbox{};
+
+        /** @brief Euclidian distances between all pairs of nodes (empty unless requested).  */
+        std::vector<double> distances{};
+
+        /**
+         * @brief
+         *     Tension between all pairs of connected nodes (empty unless a distance matrix was given).
+         *
+         * Like the `tension` program does, the Euclidian distances are measured in units of `default_node_distance`.
+         *
+         */
+        std::vector<double> tensions{};
+
+        /** @brief Stress moments (zero unless a distance matrix was given).  */
+        stress_moments moments{};
+    };
+
+    /**
+     * @brief
+     *     Evaluates pairwise properties of the layouts obtained by linear interpolation for all given rates at once.
+     *
+     * The layout for rate <var>t</var> places node <var>i</var> at (1 - <var>t</var>) <var>a</var><sub>i</sub> +
+     * <var>t</var> <var>b</var><sub>i</sub> before it is normalized.  Since the normalization only translates and
+     * scales the layout and the scale is determined by a single pass over the edges (or, for graphs without edges,
+     * over the pairs of nodes), the properties of all layouts are obtained by a single traversal of the pairs of nodes.
+     * For each pair, the distances for all rates are computed in a tight inner loop.  This is much cheaper than
+     * evaluating each layout on its own if there are many rates.
+     *
+     * If `matrix` is not `nullptr`, the pairs are traversed in the matrix's storage order.  The tensions and stress
+     * moments are computed for all pairs of connected nodes in this case.  The matrix must have been computed for
+     * `graph` with a strategy other than `strategies::sampled`.
+     *
+     * Keeping the distances requires memory proportional to the number of rates times the square of the number of
+     * nodes.  The same is true for the tensions.  Use `get_interpolation_batch_size` to find out how many rates can be
+     * evaluated at once without exceeding the memory budget.
+     *
+     * @param graph
+     *     graph of the layouts
+     *
+     * @param lhs
+     *     coordinates of the nodes for rate 0 in the order of `graph.nodes`
+     *
+     * @param rhs
+     *     coordinates of the nodes for rate 1 in the order of `graph.nodes`
+     *
+     * @param rates
+     *     interpolation rates to evaluate
+     *
+     * @param matrix
+     *     pairwise shortest path matrix or `nullptr` to not compute the tensions and stress moments
+     *
+     * @param distances
+     *     whether to keep the Euclidian distances between all pairs of nodes
+     *
+     * @returns
+     *     properties for each rate in the order of `rates`
+     *
+     * @throws std::invalid_argument
+     *     if the number of coordinates does not match the number of nodes in the graph or the matrix was sampled
+     *
+     */
+    std::vector<interpolated_properties> evaluate_interpolation(const ogdf::Graph& graph,
+                                                                const std::vector<point2d>& lhs,
+                                                                const std::vector<point2d>& rhs,
+                                                                const std::vector<double>& rates,
+                                                                const distance_matrix* matrix,
+                                                                bool distances);
+
+    /**
+     * @brief
+     *     Returns how many rates `evaluate_interpolation` can evaluate at once within the given memory budget.
+     *
+     * Like the planner does for the distance matrix, an eighth of the `budget` is left for the rest of the computation.
+     * The result is never less than 1 so the rates can always be evaluated one at a time and never more than `rates`
+     * (unless `rates` is 0).  If the `budget` is unknown or neither the distances nor the tensions are kept, all rates
+     * are evaluated at once.
+     *
+     * @param nodes
+     *     number of nodes in the graph
+     *
+     * @param rates
+     *     total number of rates to evaluate
+     *
+     * @param distances
+     *     whether the Euclidian distances are kept
+     *
+     * @param tensions
+     *     whether the tensions are kept (that is, whether a distance matrix is passed)
+     *
+     * @param budget
+     *     number of bytes available (excluding the memory used by the distance matrix) or `std::nullopt` if unknown
+     *
+     * @returns
+     *     number of rates per pass
+     *
+     */
+    std::size_t get_interpolation_batch_size(std::size_t nodes,
+                                             std::size_t rates,
+                                             bool distances,
+                                             bool tensions,
+                                             std::optional<std::size_t> budget) noexcept;
+
+    /**
+     * @brief
+     *     Analyzes the properties of a single interpolated layout for its entry in the meta data.
+     *
+     * The returned object has an entry `rdf-global` and `tension` holding everything the `analyzer` reports about the
+     * distances and tensions of this very layout, respectively, unless the corresponding output file refers to the
+     * null terminal.  If `stress` is `true`, it also has an entry `stress` with the stress of the layout.
+     *
+     * @param props
+     *     properties of the layout as obtained from `evaluate_interpolation`
+     *
+     * @param analyzer
+     *     template for the analyzers (its range and output are adjusted on a copy)
+     *
+     * @param rdf_global
+     *     output file for the RDF data (with the rate already substituted)
+     *
+     * @param tension
+     *     output file for the tension data (with the rate already substituted)
+     *
+     * @param stress
+     *     whether to report the stress
+     *
+     * @returns
+     *     meta data for the layout
+     *
+     */
+    json_object analyze_interpolated_properties(const interpolated_properties& props,
+                                                const data_analyzer& analyzer,
+                                                const output_file& rdf_global,
+                                                const output_file& tension,
+                                                bool stress);
+
+}  // namespace msc
+
+#endif  // !defined(MSC_INTERPOLATION_HXX)
@@ -20,14 +20,26 @@
 
 #include "io.hxx"
 
+#include <cassert>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -36,6 +48,7 @@
 #include "file.hxx"
 #include "histogram.hxx"
 #include "iosupp.hxx"
+#include "profile.hxx"
 #include "stochastic.hxx"
 #include "strings.hxx"
 #include "useful.hxx"
@@ -90,6 +103,7 @@ namespace msc
                                const fileformats format,
                                const std::string_view filename = "/dev/stdin")
         {
+            const auto timer = profile_timer{"load"};
             auto graph = std::make_unique<ogdf::Graph>();
             auto status = ios_badform;
             switch (format) {
@@ -115,7 +129,9 @@ namespace msc
             case fileformats::ygraph:        status = !ogdf::GraphIO::readYGraph       (*graph, istr); break;
             }
             switch (status) {
-            case ios_success: return graph;
+            case ios_success:
+                note_profile_graph_size(graph->numberOfNodes(), graph->numberOfEdges());
+                return graph;
             case ios_badform: reject_invalid_enumeration(format, "graph file format");
             case ios_notsupp: throw unsupported_format{filename, format, 'I', false};
             default:          report_io_error(filename, "Cannot read graph data");
@@ -127,6 +143,7 @@ namespace msc
                                 const fileformats format,
                                 const std::string_view filename = "/dev/stdin")
         {
+            const auto timer = profile_timer{"load"};
             auto graph = std::make_unique<ogdf::Graph>();
             auto attrs = std::make_unique<ogdf::GraphAttributes>(*graph);
             auto status = ios_badform;
@@ -153,7 +170,9 @@ namespace msc
             case fileformats::ygraph:        status = ios_notsupp;                                        break;
             }
             switch (status) {
-            case ios_success: return {std::move(graph), std::move(attrs)};
+            case ios_success:
+                note_profile_graph_size(graph->numberOfNodes(), graph->numberOfEdges());
+                return {std::move(graph), std::move(attrs)};
             case ios_badform: reject_invalid_enumeration(format, "layout file format");
             case ios_notsupp: throw unsupported_format{filename, format, 'I', true};
             default:          report_io_error(filename, "Cannot read layout data");
@@ -165,6 +184,7 @@ namespace msc
                                    const fileformats format,
                                    const std::string_view filename = "/dev/stdout")
         {
+            const auto timer = profile_timer{"store"};
             auto status = ios_badform;
             switch (format) {
             case fileformats::bench:         status = !ogdf::GraphIO::writeGML          (graph, ostr); break;
@@ -201,6 +221,7 @@ namespace msc
                                     const fileformats format,
                                     const std::string_view filename = "/dev/stdout")
         {
+            const auto timer = profile_timer{"store"};
             auto status = ios_badform;
             switch (format) {
             case fileformats::bench:         status = !ogdf::GraphIO::writeGML     (attrs, ostr); break;
@@ -248,6 +269,20 @@ namespace msc
             return (tally == 0) && (attrs.constGraph().numberOfNodes() > 1);
         }
 
+        std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
+        load_layout_directly(const input_file& src)
+        {
+            auto stream = boost::iostreams::filtering_istream{};
+            const auto name = prepare_stream(stream, src);
+            auto result = read_layout_from_stream(stream, internal_file_format, name);
+            if (is_degenerated_layout(*result.second)) {
+                throw degenerated_layout{name};
+            }
+            return result;
+        }
+
+        layout_prefetcher::state* active_prefetcher = nullptr;
+
     }  // namespace /*anonymous*/
 
     std::unique_ptr<ogdf::Graph>
@@ -306,15 +341,124 @@ namespace msc
         return read_graph_from_stream(stream, internal_file_format, name);
     }
 
+    struct layout_prefetcher::state
+    {
+        using layout_type = std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>;
+
+        // The loader thread doesn't record anything to the profile because it would be attributed to whatever input
+        // is currently being processed.  Instead, the time it took to load a layout is kept here and accounted for
+        // when the layout is claimed.
+        struct entry
+        {
+            layout_type layout{};
+            std::exception_ptr error{};
+            double seconds{};
+        };
+
+        std::optional<layout_type> claim(const input_file& src);
+
+        void run();
+
+        std::vector<input_file> sources{};
+        std::size_t depth{};
+        std::mutex mutex{};
+        std::condition_variable wakeup{};  // signaled to the loader
+        std::condition_variable ready{};   // signaled to the consumer
+        std::deque<entry> queue{};         // loaded layouts that were not claimed yet
+        std::size_t claimed{};             // number of sources that were claimed so far
+        std::size_t loaded{};              // number of sources the loader has started to load
+        bool armed{};
+        bool stopped{};
+        std::thread loader{};
+    };
+
+    auto layout_prefetcher::state::claim(const input_file& src) -> std::optional<layout_type>
+    {
+        auto lock = std::unique_lock{this->mutex};
+        if ((this->claimed >= this->sources.size()) || (this->sources[this->claimed] != src)) {
+            return std::nullopt;
+        }
+        if (!this->armed) {
+            this->armed = true;
+            this->loaded = ++this->claimed;
+            this->loader = std::thread{&state::run, this};
+            return std::nullopt;
+        }
+        this->ready.wait(lock, [this](){ return !this->queue.empty(); });
+        auto next = std::move(this->queue.front());
+        this->queue.pop_front();
+        this->claimed += 1;
+        lock.unlock();
+        this->wakeup.notify_one();
+        note_profile_phase("load", next.seconds);
+        if (next.error) {
+            std::rethrow_exception(next.error);
+        }
+        const auto& graph = *next.layout.first;
+        note_profile_graph_size(graph.numberOfNodes(), graph.numberOfEdges());
+        return std::move(next.layout);
+    }
+
+    void layout_prefetcher::state::run()
+    {
+        auto lock = std::unique_lock{this->mutex};
+        while (true) {
+            this->wakeup.wait(lock, [this](){
+                return this->stopped || ((this->loaded < this->sources.size()) && (this->queue.size() < this->depth));
+            });
+            if (this->stopped) {
+                return;
+            }
+            const auto index = this->loaded++;
+            lock.unlock();
+            auto next = entry{};
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                const auto suspension = profile_suspension{};
+                next.layout = load_layout_directly(this->sources[index]);
+            } catch (...) {
+                next.error = std::current_exception();
+            }
+            next.seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+            lock.lock();
+            this->queue.push_back(std::move(next));
+            this->ready.notify_one();
+        }
+    }
+
+    layout_prefetcher::layout_prefetcher(std::vector<input_file> sources, const std::size_t depth)
+    {
+        assert(depth > 0);
+        if (active_prefetcher != nullptr) {
+            throw std::logic_error{"Only one layout prefetcher can be active at a time"};
+        }
+        _state = std::make_unique<state>();
+        _state->sources = std::move(sources);
+        _state->depth = depth;
+        active_prefetcher = _state.get();
+    }
+
+    layout_prefetcher::~layout_prefetcher() noexcept
+    {
+        active_prefetcher = nullptr;
+        {
+            const auto lock = std::lock_guard{_state->mutex};
+            _state->stopped = true;
+        }
+        _state->wakeup.notify_one();
+        if (_state->loader.joinable()) {
+            _state->loader.join();
+        }
+    }
+
     std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>> load_layout(const input_file& src)
     {
-        auto stream = boost::iostreams::filtering_istream{};
-        const auto name = prepare_stream(stream, src);
-        auto result = read_layout_from_stream(stream, internal_file_format, name);
-        if (is_degenerated_layout(*result.second)) {
-            throw degenerated_layout{name};
+        if (active_prefetcher != nullptr) {
+            if (auto prefetched = active_prefetcher->claim(src)) {
+                return std::move(*prefetched);
+            }
         }
-        return result;
+        return load_layout_directly(src);
     }
 
     void store_graph(const ogdf::Graph& graph, const output_file& dst)
@@ -337,32 +481,13 @@ namespace msc
     namespace /*anonymous*/
     {
 
-        void write_events(const std::vector<double>& data,
-                          const stochastic_summary& summary,
-                          std::ostream& ostr,
-                          const std::string_view name)
-        {
-            constexpr auto digits = std::numeric_limits<double>::max_digits10;
-            constexpr auto width = 26;
-            ostr << std::setprecision(digits) << std::scientific
-                 << "# Number of events:       " << std::setw(width) << summary.count << "\n"
-                 << "# Minimum:                " << std::setw(width) << summary.min   << "\n"
-                 << "# Maximum                 " << std::setw(width) << summary.max   << "\n"
-                 << "# Arithmetic mean:        " << std::setw(width) << summary.mean  << "\n"
-                 << "# Root mean square:       " << std::setw(width) << summary.rms   << "\n"
-                 << std::endl;
-            for (const auto event : data) {
-                ostr << std::setw(width) << event << '\n';
-            }
-            if (!ostr.flush().good()) {
-                report_io_error(name, "Cannot write event data");
-            }
-        }
+        constexpr auto event_width = 26;
 
-        void write_frequencies(const histogram& histo, std::ostream& ostr, const std::string_view name)
+        std::string format_frequencies(const histogram& histo)
         {
             constexpr auto digits = std::numeric_limits<double>::max_digits10;
             constexpr auto width = 26;
+            auto ostr = std::ostringstream{};
             ostr << std::setprecision(digits) << std::scientific
                  << "# Number of events:       " << std::setw(width) << histo.size()     << "\n"
                  << "# Bin count:              " << std::setw(width) << histo.bincount() << "\n"
@@ -371,21 +496,19 @@ namespace msc
                  << "# Arithmetic mean:        " << std::setw(width) << histo.mean()     << "\n"
                  << "# Root mean square:       " << std::setw(width) << histo.rms()      << "\n"
                  << "# Entropy:                " << std::setw(width) << histo.entropy()  << "\n"
-                 << std::endl;
+                 << "\n";
             for (std::size_t idx = 0; idx < histo.bincount(); ++idx) {
                 ostr << std::setw(width) << histo.center(idx) << std::setw(width) << histo.frequency(idx) << '\n';
             }
-            if (!ostr.flush().good()) {
-                report_io_error(name, "Cannot write frequency data");
-            }
+            return std::move(ostr).str();
         }
 
-        void write_density(const std::vector<std::pair<double, double>>& density,
-                           const stochastic_summary& summary,
-                           std::ostream& ostr, const std::string_view filename)
+        std::string format_density(const std::vector<std::pair<double, double>>& density,
+                                   const stochastic_summary& summary)
         {
             constexpr auto digits = std::numeric_limits<double>::max_digits10;
             constexpr auto width = 26;
+            auto ostr = std::ostringstream{};
             ostr << std::setprecision(digits) << std::scientific
                  << "# Number of events:       " << std::setw(width) << summary.count    << "\n"
                  << "# Minimum:                " << std::setw(width) << summary.min      << "\n"
@@ -393,13 +516,11 @@ namespace msc
                  << "# Arithmetic mean:        " << std::setw(width) << summary.mean     << "\n"
                  << "# Root mean square:       " << std::setw(width) << summary.rms      << "\n"
                  << "# Density step count:     " << std::setw(width) << density.size()   << "\n"
-                 << std::endl;
+                 << "\n";
             for (const auto [x, y] : density) {
                 ostr << std::setw(width) << x << std::setw(width) << y << '\n';
             }
-            if (!ostr.flush().good()) {
-                report_io_error(filename, "Cannot write density data");
-            }
+            return std::move(ostr).str();
         }
 
     }  // namespace /*anonymous*/
@@ -408,25 +529,56 @@ namespace msc
                       const stochastic_summary& summary,
                       const output_file& dst)
     {
-        auto stream = boost::iostreams::filtering_ostream{};
-        const auto name = prepare_stream(stream, dst);
-        write_events(data, summary, stream, name);
+        const auto timer = profile_timer{"store"};
+        auto writer = event_writer{summary, dst};
+        for (const auto event : data) {
+            writer(event);
+        }
+        writer.finish();
+    }
+
+    event_writer::event_writer(const stochastic_summary& summary, const output_file& dst)
+    {
+        await_deferred_writes(dst);
+        auto stream = std::make_unique<boost::iostreams::filtering_ostream>();
+        _name = prepare_stream(*stream, dst);
+        _stream = std::move(stream);
+        constexpr auto digits = std::numeric_limits<double>::max_digits10;
+        *_stream << std::setprecision(digits) << std::scientific
+                 << "# Number of events:       " << std::setw(event_width) << summary.count << "\n"
+                 << "# Minimum:                " << std::setw(event_width) << summary.min   << "\n"
+                 << "# Maximum                 " << std::setw(event_width) << summary.max   << "\n"
+                 << "# Arithmetic mean:        " << std::setw(event_width) << summary.mean  << "\n"
+                 << "# Root mean square:       " << std::setw(event_width) << summary.rms   << "\n"
+                 << std::endl;
+    }
+
+    event_writer::~event_writer() noexcept = default;
+
+    void event_writer::operator()(const double event)
+    {
+        *_stream << std::setw(event_width) << event << '\n';
+    }
+
+    void event_writer::finish()
+    {
+        if (!_stream->flush().good()) {
+            report_io_error(_name, "Cannot write event data");
+        }
     }
 
     void write_frequencies(const histogram& histo, const output_file& dst)
     {
-        auto stream = boost::iostreams::filtering_ostream{};
-        const auto name = prepare_stream(stream, dst);
-        write_frequencies(histo, stream, name);
+        const auto timer = profile_timer{"store"};
+        write_deferred(format_frequencies(histo), dst, "Cannot write frequency data");
     }
 
     void write_density(const std::vector<std::pair<double, double>>& density,
                        const stochastic_summary& summary,
                        const output_file& dst)
     {
-        auto stream = boost::iostreams::filtering_ostream{};
-        const auto name = prepare_stream(stream, dst);
-        write_density(density, summary, stream, name);
+        const auto timer = profile_timer{"store"};
+        write_deferred(format_density(density, summary), dst, "Cannot write density data");
     }
 
 }  // namespace msc
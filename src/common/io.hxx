@@ -25,8 +25,11 @@
 #ifndef MSC_IO_HXX
 #define MSC_IO_HXX
 
+#include <cstddef>
+#include <iosfwd>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -229,6 +232,66 @@ namespace msc
     std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
     load_layout(const input_file& src);
 
+    /**
+     * @brief
+     *     Loads a known sequence of layouts ahead of time on a background thread.
+     *
+     * While an object of this type exists, `load_layout` will hand out the prefetched layouts if (and only if) it is
+     * called for the sources in the order in which they were given to the constructor.  Any other call to
+     * `load_layout` is served directly and does not disturb the sequence.
+     *
+     * The background thread is only started once `load_layout` is called for the first source.  (This call is served
+     * directly.)  Thereafter, it keeps at most `depth` layouts ready.  Errors that occur while loading a layout are
+     * reported by the `load_layout` call that asks for it.  Likewise, the size of the graph and the time it took to
+     * load it are recorded to the profile (see `profile.hxx`) by that call rather than by the background thread.
+     *
+     * At most one object of this type may exist at any time and `load_layout` must only be called from the thread
+     * that created it.
+     *
+     */
+    class layout_prefetcher final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Prepares for loading the given sources.
+         *
+         * @param sources
+         *     files that will be loaded in this order
+         *
+         * @param depth
+         *     maximum number of layouts to keep ready (must be positive)
+         *
+         * @throws std::logic_error
+         *     if another object of this type exists
+         *
+         */
+        explicit layout_prefetcher(std::vector<input_file> sources, std::size_t depth = 2);
+
+        /** @brief Deleted copy constructor.  */
+        layout_prefetcher(const layout_prefetcher&) = delete;
+
+        /** @brief Deleted copy-assignment operator.  */
+        layout_prefetcher& operator=(const layout_prefetcher&) = delete;
+
+        /**
+         * @brief
+         *     Waits for the layout that is currently being loaded (if any) and discards all unclaimed layouts.
+         *
+         */
+        ~layout_prefetcher() noexcept;
+
+        /** @brief Internal state that is shared with the background thread.  */
+        struct state;
+
+    private:
+
+        /** @brief Pointer to the internal state (so the address remains stable).  */
+        std::unique_ptr<state> _state;
+
+    };  // class layout_prefetcher
+
     /**
      * @brief
      *     Stores a graph in a file using the internal format.
@@ -282,11 +345,87 @@ namespace msc
      */
     void write_events(const std::vector<double>& data, const stochastic_summary& summary, const output_file& dst);
 
+    /**
+     * @brief
+     *     Writes event data to a text file one event at a time.
+     *
+     * The output is the same as that of `write_events` but the events need not be held in memory all at once.  The
+     * header is written by the constructor, which is why the summary has to be known in advance.
+     *
+     */
+    class event_writer final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Opens the file and writes the header.
+         *
+         * @param summary
+         *     stochastic summary of the event data that will be written
+         *
+         * @param dst
+         *     file to write to
+         *
+         * @throws std::exception
+         *     if the file cannot be opened or the header cannot be written
+         *
+         */
+        event_writer(const stochastic_summary& summary, const output_file& dst);
+
+        /** @brief Deleted copy constructor.  */
+        event_writer(const event_writer&) = delete;
+
+        /** @brief Deleted copy-assignment operator.  */
+        event_writer& operator=(const event_writer&) = delete;
+
+        /**
+         * @brief
+         *     Closes the file.
+         *
+         * Errors are not reported by the destructor.  Call `finish` in order to find out whether writing succeeded.
+         *
+         */
+        ~event_writer() noexcept;
+
+        /**
+         * @brief
+         *     Writes the next event.
+         *
+         * Errors are detected only by `finish`.
+         *
+         * @param event
+         *     event to write
+         *
+         */
+        void operator()(double event);
+
+        /**
+         * @brief
+         *     Flushes all written events to the file.
+         *
+         * @throws std::exception
+         *     if the data could not be written
+         *
+         */
+        void finish();
+
+    private:
+
+        /** @brief Output stream (which is a compressing filter chain in general).  */
+        std::unique_ptr<std::ostream> _stream;
+
+        /** @brief Informal name of the file for error messages.  */
+        std::string _name;
+
+    };  // class event_writer
+
     /**
      * @brief
      *     Writes frequency data to a text file.
      *
-     * The format is such that it can be processed by Gnuplot and similar tools.
+     * The format is such that it can be processed by Gnuplot and similar tools.  Files are written in the background
+     * (see `write_deferred`) so errors might only be reported later by `finish_deferred_writes`.
      *
      * @param histo
      *     binned frequency data to write
@@ -304,7 +443,8 @@ namespace msc
      * @brief
      *     Writes density data to a text file.
      *
-     * The format is such that it can be processed by Gnuplot and similar tools.
+     * The format is such that it can be processed by Gnuplot and similar tools.  Like `write_frequencies`, this
+     * function writes files in the background.
      *
      * @param density
      *     array of (<var>x</var>, &rho;(<var>x</var>)) points describing the normalized density
@@ -21,17 +21,27 @@
 #include "iosupp.hxx"
 
 #include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/device/null.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filter/newline.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/stream.hpp>
 
+#include "bzip2.hxx"
+#include "concurrency.hxx"
 #include "strings.hxx"
 #include "useful.hxx"
 
@@ -125,7 +135,7 @@ namespace msc
             stream.push(io::gzip_decompressor{});
             break;
         case compressions::bzip2:
-            stream.push(io::bzip2_decompressor{});
+            stream.push(parallel_bzip2_decompressor{});
             break;
         case compressions::automatic:
             MSC_NOT_REACHED();
@@ -162,7 +172,7 @@ namespace msc
             stream.push(io::gzip_compressor{});
             break;
         case compressions::bzip2:
-            stream.push(io::bzip2_compressor{});
+            stream.push(parallel_bzip2_compressor{});
             break;
         case compressions::automatic:
             MSC_NOT_REACHED();
@@ -188,4 +198,158 @@ namespace msc
         return name;
     }
 
+    namespace /*anonymous*/
+    {
+
+        struct deferred_write
+        {
+            std::string text{};
+            output_file dst{};
+            std::string message{};
+        };
+
+        void write_immediately(const std::string& text, const output_file& dst, const std::string_view message)
+        {
+            auto stream = io::filtering_ostream{};
+            const auto name = prepare_stream(stream, dst);
+            stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!stream.flush().good()) {
+                report_io_error(name, message);
+            }
+        }
+
+        // Background threads that perform the deferred writes.  The threads are started on demand and joined by the
+        // destructor after the queue has been drained.  The set of busy file names keeps writes to the same file in
+        // order because a file is never queued while a previous write to it is still pending.
+        class deferred_writer final
+        {
+        public:
+
+            deferred_writer() = default;
+
+            deferred_writer(const deferred_writer&) = delete;
+
+            deferred_writer& operator=(const deferred_writer&) = delete;
+
+            ~deferred_writer() noexcept
+            {
+                {
+                    const auto lock = std::lock_guard{_mutex};
+                    _closing = true;
+                }
+                _ready.notify_all();
+                for (auto& thread : _threads) {
+                    thread.join();
+                }
+            }
+
+            void submit(deferred_write job)
+            {
+                auto lock = std::unique_lock{_mutex};
+                if (_capacity == 0) {
+                    _capacity = default_concurrency();
+                }
+                const auto& filename = job.dst.filename();
+                _idle.wait(lock, [this, &filename](){
+                    return (_busy.count(filename) == 0) && (_queue.size() < 2 * _capacity);
+                });
+                _busy.insert(filename);
+                _queue.push_back(std::move(job));
+                if ((_threads.size() < _capacity) && (_threads.size() < _busy.size())) {
+                    _threads.emplace_back([this](){ this->_work(); });
+                }
+                _ready.notify_one();
+            }
+
+            bool await(const std::string& filename) noexcept
+            {
+                auto lock = std::unique_lock{_mutex};
+                _idle.wait(lock, [this, &filename](){ return _busy.count(filename) == 0; });
+                return _failed.count(filename) == 0;
+            }
+
+            void finish()
+            {
+                auto lock = std::unique_lock{_mutex};
+                _idle.wait(lock, [this](){ return _busy.empty(); });
+                auto errors = std::exchange(_errors, {});
+                _failed.clear();
+                lock.unlock();
+                if (!errors.empty()) {
+                    std::rethrow_exception(errors.front());
+                }
+            }
+
+        private:
+
+            void _work() noexcept
+            {
+                auto lock = std::unique_lock{_mutex};
+                while (true) {
+                    _ready.wait(lock, [this](){ return _closing || !_queue.empty(); });
+                    if (_queue.empty()) {
+                        return;
+                    }
+                    auto job = std::move(_queue.front());
+                    _queue.pop_front();
+                    lock.unlock();
+                    auto error = std::exception_ptr{};
+                    try {
+                        write_immediately(job.text, job.dst, job.message);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    lock.lock();
+                    if (error) {
+                        _errors.push_back(error);
+                        _failed.insert(job.dst.filename());
+                    }
+                    _busy.erase(_busy.find(job.dst.filename()));
+                    _idle.notify_all();
+                }
+            }
+
+            std::mutex _mutex{};
+            std::condition_variable _ready{};
+            std::condition_variable _idle{};
+            std::deque<deferred_write> _queue{};
+            std::multiset<std::string> _busy{};
+            std::set<std::string> _failed{};
+            std::vector<std::exception_ptr> _errors{};
+            std::vector<std::thread> _threads{};
+            std::size_t _capacity{};
+            bool _closing{};
+
+        };  // class deferred_writer
+
+        deferred_writer& get_deferred_writer()
+        {
+            static auto writer = deferred_writer{};
+            return writer;
+        }
+
+    }  // namespace /*anonymous*/
+
+    void write_deferred(std::string text, const output_file& dst, const std::string_view message)
+    {
+        if (dst.terminal() != terminals::file) {
+            write_immediately(text, dst, message);
+            return;
+        }
+        get_deferred_writer().submit(deferred_write{std::move(text), dst, std::string{message}});
+    }
+
+    bool await_deferred_writes(const output_file& dst) noexcept
+    {
+        if (dst.terminal() != terminals::file) {
+            return true;
+        }
+        return get_deferred_writer().await(dst.filename());
+    }
+
+    void finish_deferred_writes()
+    {
+        get_deferred_writer().finish();
+    }
+
 }  // namespace msc
@@ -26,6 +26,7 @@
 #define MSC_IOSUPP_HXX
 
 #include <optional>
+#include <string>
 #include <string_view>
 
 #include <boost/iostreams/filtering_stream.hpp>
@@ -217,6 +218,58 @@ namespace msc
      */
     std::string prepare_stream(boost::iostreams::filtering_ostream& stream, const output_file& dst);
 
+    /**
+     * @brief
+     *     Writes a fully formatted text to the given destination, possibly in the background.
+     *
+     * If `dst` refers to a file, the text is handed over to a pool of background threads that compress and write it
+     * while the caller continues.  Writes to the same file are performed in the order they were requested.  Any other
+     * destination (like standard output) is written to immediately.  Errors that occur in the background are reported
+     * by `finish_deferred_writes`, which the command-line interface calls after the application returned.
+     *
+     * The number of background threads is given by `default_concurrency` and the caller is blocked if too many texts
+     * are waiting to be written.
+     *
+     * @param text
+     *     text to write
+     *
+     * @param dst
+     *     destination to write to
+     *
+     * @param message
+     *     description of the error that is reported if the text cannot be written
+     *
+     * @throws std::exception
+     *     if `dst` is not a file and the text cannot be written
+     *
+     */
+    void write_deferred(std::string text, const output_file& dst, std::string_view message);
+
+    /**
+     * @brief
+     *     Waits until all pending writes to the given file have completed.
+     *
+     * @param dst
+     *     destination to wait for
+     *
+     * @returns
+     *     whether all writes to `dst` that were requested so far succeeded
+     *
+     */
+    bool await_deferred_writes(const output_file& dst) noexcept;
+
+    /**
+     * @brief
+     *     Waits until all pending writes have completed and reports the first error that occurred.
+     *
+     * The errors are forgotten once they were reported.
+     *
+     * @throws std::exception
+     *     if any write failed (as if thrown by `report_io_error`)
+     *
+     */
+    void finish_deferred_writes();
+
 }  // namespace msc
 
 #endif  // !defined(MSC_IOSUPP_HXX)
@@ -20,19 +20,96 @@
 
 #include "meta.hxx"
 
+#include <stdexcept>
+#include <string>
+
 #include "file.hxx"
 #include "iosupp.hxx"
 #include "json.hxx"
+#include "profile.hxx"
 
 namespace msc
 {
 
+    struct meta_batch::state
+    {
+        boost::iostreams::filtering_ostream stream{};
+        std::string name{};
+        json_object item{};
+    };
+
+    namespace /*anonymous*/
+    {
+
+        meta_batch::state* active_batch = nullptr;
+
+        void write_meta(std::ostream& stream, const json_object& info, const std::string& name)
+        {
+            if (profiling_enabled()) {
+                auto profiled = info;
+                profiled["profile"] = get_profile_info();
+                stream << profiled << std::endl;
+            } else {
+                stream << info << std::endl;
+            }
+            if (!stream) {
+                report_io_error(name, "Cannot write JSON meta data data");
+            }
+        }
+
+    }  // namespace /*anonymous*/
+
     void print_meta(const json_object& info, const output_file& dst)
     {
+        if (active_batch != nullptr) {
+            auto annotated = info;
+            annotated["batch"] = active_batch->item;
+            write_meta(active_batch->stream, annotated, active_batch->name);
+            return;
+        }
         auto stream = boost::iostreams::filtering_ostream{};
         const auto name = prepare_stream(stream, dst);
-        if (!(stream << info << std::endl)) {
-            report_io_error(name, "Cannot write JSON meta data data");
+        write_meta(stream, info, name);
+    }
+
+    meta_batch::meta_batch(const output_file& dest)
+    {
+        if (active_batch != nullptr) {
+            throw std::logic_error{"Only one meta data batch can be active at a time"};
+        }
+        _state = std::make_unique<state>();
+        _state->name = prepare_stream(_state->stream, dest);
+        active_batch = _state.get();
+    }
+
+    meta_batch::~meta_batch() noexcept
+    {
+        active_batch = nullptr;
+    }
+
+    void meta_batch::select(const std::size_t index, const input_file& src)
+    {
+        _state->item = json_object{};
+        _state->item["index"] = json_size{index};
+        if (src.terminal() == terminals::file) {
+            _state->item["input"] = json_text{src.filename()};
+        } else {
+            _state->item["input"] = json_null{};
+        }
+    }
+
+    void meta_batch::report_error(const std::string_view message)
+    {
+        auto info = json_object{};
+        info["error"] = json_text{std::string{message}};
+        info["batch"] = _state->item;
+        write_meta(_state->stream, info, _state->name);
+    }
+
+    void meta_batch::finish()
+    {
+        if (!_state->stream.flush().good()) {
+            report_io_error(_state->name, "Cannot write JSON meta data data");
         }
     }
 
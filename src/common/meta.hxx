@@ -28,9 +28,14 @@
 #ifndef MSC_META_HXX
 #define MSC_META_HXX
 
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
 namespace msc
 {
 
+    struct input_file;
     struct json_object;
     struct output_file;
 
@@ -38,6 +43,8 @@ namespace msc
      * @brief
      *     Serializes and writes the meta data in `info` to `dest`.
      *
+     * If profiling is enabled (see `profile.hxx`), the profile is added as an additional attribute `"profile"`.
+     *
      * @param info
      *     JSON object to serialize and write
      *
@@ -50,6 +57,100 @@ namespace msc
      */
     void print_meta(const json_object& info, const output_file& dest);
 
+    /**
+     * @brief
+     *     Collects the meta data of a sequence of runs as one line per run.
+     *
+     * While an object of this type exists, `print_meta` ignores its `dest` argument and appends its output to the
+     * destination given to the constructor instead.  Each line gets an additional attribute `"batch"` that tells the
+     * index and file name of the input that was most recently selected via `select`.
+     *
+     * At most one object of this type may exist at any time.
+     *
+     */
+    class meta_batch final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Opens the destination for the meta data.
+         *
+         * @param dest
+         *     destination to write to
+         *
+         * @throws std::logic_error
+         *     if another object of this type exists
+         *
+         * @throws std::system_error
+         *     if the file cannot be opened
+         *
+         */
+        explicit meta_batch(const output_file& dest);
+
+        /** @brief Deleted copy constructor.  */
+        meta_batch(const meta_batch&) = delete;
+
+        /** @brief Deleted copy-assignment operator.  */
+        meta_batch& operator=(const meta_batch&) = delete;
+
+        /**
+         * @brief
+         *     Closes the destination.
+         *
+         * Errors are not reported by the destructor.  Call `finish` in order to find out whether writing succeeded.
+         *
+         */
+        ~meta_batch() noexcept;
+
+        /**
+         * @brief
+         *     Selects the input that the following calls to `print_meta` refer to.
+         *
+         * @param index
+         *     zero-based index of the input
+         *
+         * @param src
+         *     input file
+         *
+         */
+        void select(std::size_t index, const input_file& src);
+
+        /**
+         * @brief
+         *     Writes a line that reports a failure for the currently selected input.
+         *
+         * The line has the attribute `"error"` with the given message in addition to the `"batch"` attribute.
+         *
+         * @param message
+         *     error message
+         *
+         * @throws std::system_error
+         *     if there was an error writing to the file
+         *
+         */
+        void report_error(std::string_view message);
+
+        /**
+         * @brief
+         *     Flushes all meta data to the destination.
+         *
+         * @throws std::system_error
+         *     if the data could not be written
+         *
+         */
+        void finish();
+
+        /** @brief Internal state.  */
+        struct state;
+
+    private:
+
+        /** @brief Pointer to the internal state.  */
+        std::unique_ptr<state> _state;
+
+    };  // class meta_batch
+
 }  // namespace msc
 
 #endif  // !defined(MSC_META_HXX)
@@ -35,8 +35,6 @@ namespace msc
     namespace /*anonymous*/
     {
 
-        const auto default_node_size = 5.0;
-
         // We perform this check always rather than asserting on this property because programming against the OGDF is
         // already scary enough so we rather widen our contract just a little bit at this point.
         void check_layout_finite(const ogdf::GraphAttributes& attrs)
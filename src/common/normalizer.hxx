@@ -33,6 +33,9 @@ namespace msc
     /** @brief Average edge length in normalized layouts. */
     inline constexpr auto default_node_distance = 100.0;
 
+    /** @brief Width and height of the nodes in normalized layouts. */
+    inline constexpr auto default_node_size = 5.0;
+
     /**
      * @brief
      *     &ldquo;Normalizes&rdquo; a layout.
@@ -20,16 +20,40 @@
 
 #include "pairwise.hxx"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
 
-#include <ogdf/basic/EdgeArray.h>
-#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+#if HAVE_POSIX_MAPPED_FILES
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+#if HAVE_POSIX_SHARED_FILES
+#  include <sys/stat.h>
+#endif
+
+#include "cache.hxx"
+#include "fingerprint.hxx"
+#include "profile.hxx"
+#include "strings.hxx"
+#include "useful.hxx"
 
 // Make sure we've actually included the OGDF headers as advertised in the DocString instead of just forward-declaring
 // the types as we usually do.
 
 static_assert(sizeof(ogdf::Graph) > 0);
-static_assert(sizeof(ogdf::GraphAttributes) > 0);
 
 namespace msc
 {
@@ -37,21 +61,632 @@ namespace msc
     namespace /*anonymous*/
     {
 
-        std::unique_ptr<ogdf_node_array_2d<double>>
-        make_ogdf_node_array_2d_double(const ogdf::Graph& graph)
+        constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+        // Returns the representative of each node's connected component, indexed by node index.  This is a
+        // disjoint-set forest with path halving and union by size.
+        std::vector<std::size_t> get_component_roots(const ogdf::Graph& graph, const std::size_t stride)
+        {
+            auto parent = std::vector<std::size_t>(stride);
+            auto sizes = std::vector<std::size_t>(stride, 1);
+            std::iota(std::begin(parent), std::end(parent), std::size_t{});
+            const auto find = [&parent](std::size_t x){
+                while (parent[x] != x) {
+                    x = parent[x] = parent[parent[x]];
+                }
+                return x;
+            };
+            for (const auto e : graph.edges) {
+                auto a = find(static_cast<std::size_t>(e->source()->index()));
+                auto b = find(static_cast<std::size_t>(e->target()->index()));
+                if (a != b) {
+                    if (sizes[a] < sizes[b]) {
+                        std::swap(a, b);
+                    }
+                    parent[b] = a;
+                    sizes[a] += sizes[b];
+                }
+            }
+            for (auto i = std::size_t{}; i < stride; ++i) {
+                parent[i] = find(i);
+            }
+            return parent;
+        }
+
+        // Adjacency lists of a graph in compressed sparse row format, indexed by the nodes' positions in storage
+        // order.  Self-loops are dropped and edges are treated as undirected.
+        struct adjacency_lists
+        {
+            std::vector<std::size_t> offsets{};
+            std::vector<std::size_t> targets{};
+        };
+
+        adjacency_lists get_adjacency_lists(const ogdf::Graph& graph, const std::vector<std::size_t>& positions)
+        {
+            const auto position = [&positions](const ogdf::node v){
+                return positions[static_cast<std::size_t>(v->index())];
+            };
+            auto adj = adjacency_lists{};
+            adj.offsets.assign(static_cast<std::size_t>(graph.numberOfNodes()) + 1, 0);
+            for (const auto e : graph.edges) {
+                if (e->source() != e->target()) {
+                    adj.offsets[position(e->source()) + 1] += 1;
+                    adj.offsets[position(e->target()) + 1] += 1;
+                }
+            }
+            std::partial_sum(std::begin(adj.offsets), std::end(adj.offsets), std::begin(adj.offsets));
+            adj.targets.resize(adj.offsets.back());
+            auto fill = std::vector<std::size_t>(std::begin(adj.offsets), std::end(adj.offsets) - 1);
+            for (const auto e : graph.edges) {
+                const auto src = position(e->source());
+                const auto dst = position(e->target());
+                if (src != dst) {
+                    adj.targets[fill[src]++] = dst;
+                    adj.targets[fill[dst]++] = src;
+                }
+            }
+            return adj;
+        }
+
+        // Performs a breadth-first search from `source` within the component whose nodes occupy the positions
+        // starting at `first` and stores the hop counts in `row` (indexed relative to `first`) which must be filled
+        // with `unreached` initially.  The queue is provided by the caller so it can be re-used.
+        template <typename T>
+        void breadth_first_search(const adjacency_lists& adj,
+                                  const std::size_t source,
+                                  const std::size_t first,
+                                  T *const row,
+                                  const T unreached,
+                                  std::vector<std::size_t>& queue)
+        {
+            queue.clear();
+            queue.push_back(source);
+            row[source - first] = T{0};
+            for (auto head = std::size_t{}; head < queue.size(); ++head) {
+                const auto v = queue[head];
+                const auto next = static_cast<T>(row[v - first] + T{1});
+                for (auto i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i) {
+                    const auto w = adj.targets[i];
+                    if (row[w - first] == unreached) {
+                        row[w - first] = next;
+                        queue.push_back(w);
+                    }
+                }
+            }
+        }
+
+        // Computes `count` consecutive rows (starting with row `skip`) of the dense block of a component with `size`
+        // nodes starting at position `first`.  The output must be filled with `unreached` initially.
+        template <typename T>
+        void fill_block_rows(const adjacency_lists& adj,
+                             const std::size_t first,
+                             const std::size_t size,
+                             const std::size_t skip,
+                             const std::size_t count,
+                             T *const data,
+                             const T unreached,
+                             std::vector<std::size_t>& queue)
+        {
+            for (auto i = std::size_t{}; i < count; ++i) {
+                breadth_first_search(adj, first + skip + i, first, data + i * size, unreached, queue);
+            }
+        }
+
+        // Makes sure that hop counts can be stored in 16 bit (with one value reserved for unreachable nodes).
+        void check_hop_count_range(const strategies strategy, const std::size_t largest)
+        {
+            if (largest >= distance_matrix::unreachable) {
+                throw std::invalid_argument{
+                    concat(
+                        "Distance matrix cannot be stored as ", name(strategy), " for graphs with connected components"
+                        " of ", std::to_string(largest), " nodes"
+                    )
+                };
+            }
+        }
+
+#if HAVE_POSIX_MAPPED_FILES
+
+        [[noreturn]] void throw_system_error(const std::string& message)
+        {
+            const auto ec = std::error_code{errno, std::system_category()};
+            throw std::system_error{ec, message};
+        }
+
+        std::string get_temporary_directory()
+        {
+            for (const auto varname : {"MSC_TMPDIR", "TMPDIR"}) {
+                if (const auto envval = std::getenv(varname); (envval != nullptr) && (*envval != '\0')) {
+                    return envval;
+                }
+            }
+            return "/tmp";
+        }
+
+        std::size_t get_page_size() noexcept
+        {
+#if HAVE_POSIX_SYSCONF
+            if (const auto value = sysconf(_SC_PAGESIZE); value > 0) {
+                return static_cast<std::size_t>(value);
+            }
+#endif
+            return 4096;
+        }
+
+        // Creates a temporary file and unlinks it right away so it will be removed once the descriptor is closed.
+        int create_temporary_file()
+        {
+            auto filename = concat(get_temporary_directory(), "/msc-distances-XXXXXX");
+            const auto fd = mkstemp(filename.data());
+            if (fd < 0) {
+                throw_system_error(concat(filename, ": Cannot create temporary file"));
+            }
+            if (unlink(filename.c_str()) < 0) {
+                const auto ec = std::error_code{errno, std::system_category()};
+                close(fd);
+                throw std::system_error{ec, concat(filename, ": Cannot unlink temporary file")};
+            }
+#if HAVE_POSIX_FADVISE
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            return fd;
+        }
+
+        void write_fully(const int fd, const void *const data, const std::size_t size, const std::size_t offset)
         {
-            const auto initval = std::numeric_limits<double>::quiet_NaN();
-            return std::make_unique<ogdf_node_array_2d<double>>(graph, ogdf_node_array_1d<double>{graph, initval});
+            auto done = std::size_t{};
+            while (done < size) {
+                const auto count = pwrite(
+                    fd, static_cast<const char*>(data) + done, size - done, static_cast<off_t>(offset + done)
+                );
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_system_error("Cannot write distance matrix to temporary file");
+                }
+                done += static_cast<std::size_t>(count);
+            }
         }
 
+#endif  // HAVE_POSIX_MAPPED_FILES
+
+#if HAVE_POSIX_SHARED_FILES
+
+        // Header of a cached distance matrix.  It is followed by the hop counts of all blocks in storage order, using
+        // `width` bytes each.  Blocks only ever contain finite distances so no value needs to be reserved.
+        struct cache_header
+        {
+            char magic[8]{};
+            std::uint64_t nodes{};
+            std::uint64_t cells{};
+            std::uint64_t width{};
+        };
+
+        constexpr char cache_magic[8] = {'M', 'S', 'C', 'A', 'P', 'S', 'P', '1'};
+
+        // Number of bytes that are buffered before they are written to a cache entry.
+        constexpr std::size_t cache_chunk_size = std::size_t{1} << 16;
+
+#endif  // HAVE_POSIX_SHARED_FILES
+
     }  // namespace /*anonymous*/
 
-    std::unique_ptr<ogdf_node_array_2d<double>> get_pairwise_shortest_paths(const ogdf::Graph& graph)
+    std::vector<std::size_t> distance_matrix::_partition(const ogdf::Graph& graph)
+    {
+        const auto stride = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+        const auto roots = get_component_roots(graph, stride);
+        auto ids = std::vector<std::size_t>(stride, npos);
+        _slots.resize(stride);
+        for (const auto v : graph.nodes) {
+            const auto idx = static_cast<std::size_t>(v->index());
+            auto& id = ids[roots[idx]];
+            if (id == npos) {
+                id = _blocks.size();
+                _blocks.emplace_back();
+            }
+            _slots[idx] = slot{id, _blocks[id].size++};
+        }
+        auto first = std::size_t{};
+        for (auto& blk : _blocks) {
+            blk.first = first;
+            blk.cells = _squares;
+            first += blk.size;
+            _squares += blk.size * blk.size;
+            _largest = std::max(_largest, blk.size);
+        }
+        auto positions = std::vector<std::size_t>(stride, npos);
+        _order.resize(first);
+        for (const auto v : graph.nodes) {
+            const auto pos = _position(v);
+            positions[static_cast<std::size_t>(v->index())] = pos;
+            _order[pos] = v;
+        }
+        return positions;
+    }
+
+    distance_matrix::distance_matrix(const ogdf::Graph& graph, const strategies strategy) : _strategy{strategy}
+    {
+        switch (strategy) {
+        case strategies::full:
+        case strategies::compact:
+        case strategies::external:
+            break;
+        case strategies::sampled:
+            throw std::invalid_argument{"Distance matrix with strategy sampled needs a set of landmarks"};
+        default:
+            reject_invalid_enumeration(strategy, "msc::strategies");
+        }
+        const auto positions = _partition(graph);
+        _cells = _squares;
+#if HAVE_POSIX_SHARED_FILES
+        if (const auto filename = get_cache_filename(concat(graph_fingerprint(graph), ".apsp"))) {
+            if (_load_cached(*filename)) {
+                return;
+            }
+            // Concurrent processes might compute the same entry but since it is moved into place atomically, the
+            // worst that can happen is that one of them overwrites the other's identical result.
+            _compute(graph, positions);
+            _store_cached(*filename);
+            return;
+        }
+#endif
+        _compute(graph, positions);
+    }
+
+    void distance_matrix::_compute(const ogdf::Graph& graph, const std::vector<std::size_t>& positions)
+    {
+        const auto adj = get_adjacency_lists(graph, positions);
+        auto queue = std::vector<std::size_t>{};
+        queue.reserve(_largest);
+        switch (_strategy) {
+        case strategies::full:
+            _full.assign(_cells, HUGE_VAL);
+            for (const auto& blk : _blocks) {
+                fill_block_rows(adj, blk.first, blk.size, 0, blk.size, _full.data() + blk.cells, HUGE_VAL, queue);
+            }
+            return;
+        case strategies::compact:
+            check_hop_count_range(_strategy, _largest);
+            _compact.assign(_cells, unreachable);
+            for (const auto& blk : _blocks) {
+                fill_block_rows(adj, blk.first, blk.size, 0, blk.size, _compact.data() + blk.cells, unreachable, queue);
+            }
+            return;
+        case strategies::external:
+#if HAVE_POSIX_MAPPED_FILES
+            check_hop_count_range(_strategy, _largest);
+            _fd = create_temporary_file();
+            try {
+                // Only one window's worth of rows is held in memory at any time.
+                auto buffer = std::vector<std::uint16_t>{};
+                for (const auto& blk : _blocks) {
+                    for (auto skip = std::size_t{}; skip < blk.size; skip += external_window_rows) {
+                        const auto count = std::min(external_window_rows, blk.size - skip);
+                        buffer.assign(count * blk.size, unreachable);
+                        fill_block_rows(adj, blk.first, blk.size, skip, count, buffer.data(), unreachable, queue);
+                        write_fully(
+                            _fd, buffer.data(), buffer.size() * sizeof(std::uint16_t),
+                            (blk.cells + skip * blk.size) * sizeof(std::uint16_t)
+                        );
+                    }
+                }
+            } catch (...) {
+                close(_fd);
+                throw;
+            }
+            return;
+#else
+            throw std::invalid_argument{"Distance matrix cannot be stored as external on this platform"};
+#endif
+        case strategies::sampled:
+            break;
+        }
+        assert(false);  // The constructor has already rejected all other strategies.
+    }
+
+    bool distance_matrix::_load_cached(const std::string& filename) noexcept
+    {
+#if HAVE_POSIX_SHARED_FILES
+        const auto fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status{};
+        auto header = cache_header{};
+        const auto okay = (fstat(fd, &status) == 0)
+            && (pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)));
+        const auto size = okay ? static_cast<std::size_t>(status.st_size) : std::size_t{};
+        const auto width = static_cast<std::size_t>(header.width);
+        if (!okay
+            || (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0)
+            || (header.nodes != _order.size())
+            || (header.cells != _cells)
+            || ((width != 1) && (width != 2))
+            || (size != sizeof(cache_header) + _cells * width)) {
+            close(fd);
+            return false;
+        }
+        if (_strategy == strategies::external) {
+            // The planner chose external storage because the whole matrix must not be mapped at once so the entry is
+            // accessed through the same sliding window as the temporary file would be.
+            _fd = fd;
+            _window_base = sizeof(cache_header);
+            _window_width = width;
+            _cached = true;
+#if HAVE_POSIX_FADVISE
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            return true;
+        }
+        const auto addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        const auto data = static_cast<const char*>(addr) + sizeof(cache_header);
+        if (width == 1) {
+            _cached_narrow = reinterpret_cast<const std::uint8_t*>(data);
+        } else {
+            _cached_wide = reinterpret_cast<const std::uint16_t*>(data);
+        }
+        _cache_mapping = addr;
+        _cache_mapping_size = size;
+        _cached = true;
+        return true;
+#else
+        (void) filename;
+        return false;
+#endif
+    }
+
+    void distance_matrix::_store_cached(const std::string& filename) const noexcept
+    {
+#if HAVE_POSIX_SHARED_FILES
+        // Calls `callback` for every stored distance in storage order.
+        const auto visit = [this](auto&& callback){
+            for (const auto& blk : _blocks) {
+                for (auto i = std::size_t{}; i < blk.size; ++i) {
+                    const auto v1 = _order[blk.first + i];
+                    for (auto j = std::size_t{}; j < blk.size; ++j) {
+                        callback((*this)(v1, _order[blk.first + j]));
+                    }
+                }
+            }
+        };
+        auto tempname = std::string{};
+        auto fd = -1;
+        try {
+            auto largest = 0.0;
+            visit([&largest](const double distance){ largest = std::max(largest, distance); });
+            if (!(largest < UINT16_MAX)) {
+                return;
+            }
+            const auto width = (largest <= UINT8_MAX) ? std::size_t{1} : std::size_t{2};
+            // Write to a unique temporary file first and then move it into place so other processes never see a
+            // partially written entry.
+            tempname = concat(filename, ".XXXXXX");
+            fd = mkstemp(tempname.data());
+            if (fd < 0) {
+                return;
+            }
+            auto header = cache_header{};
+            std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+            header.nodes = _order.size();
+            header.cells = _cells;
+            header.width = width;
+            write_fully(fd, &header, sizeof(header), 0);
+            auto buffer = std::vector<char>{};
+            buffer.reserve(cache_chunk_size + sizeof(std::uint16_t));
+            auto offset = sizeof(header);
+            visit([&](const double distance){
+                if (width == 1) {
+                    buffer.push_back(static_cast<char>(static_cast<std::uint8_t>(distance)));
+                } else {
+                    const auto hops = static_cast<std::uint16_t>(distance);
+                    const auto bytes = reinterpret_cast<const char*>(&hops);
+                    buffer.insert(std::end(buffer), bytes, bytes + sizeof(hops));
+                }
+                if (buffer.size() >= cache_chunk_size) {
+                    write_fully(fd, buffer.data(), buffer.size(), offset);
+                    offset += buffer.size();
+                    buffer.clear();
+                }
+            });
+            write_fully(fd, buffer.data(), buffer.size(), offset);
+            if ((close(std::exchange(fd, -1)) == 0) && (std::rename(tempname.c_str(), filename.c_str()) == 0)) {
+                return;
+            }
+        } catch (const std::exception& /*e*/) {
+            // A cache that cannot be written to is not an error.
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (!tempname.empty()) {
+            unlink(tempname.c_str());
+        }
+#else
+        (void) filename;
+#endif
+    }
+
+    distance_matrix::distance_matrix(const ogdf::Graph& graph, const std::vector<ogdf::node>& landmarks)
+        : _strategy{strategies::sampled}
+    {
+        const auto positions = _partition(graph);
+        _landmarks = landmarks;
+        std::sort(std::begin(_landmarks), std::end(_landmarks), [this](const ogdf::node lhs, const ogdf::node rhs){
+            return _position(lhs) < _position(rhs);
+        });
+        _landmarks.erase(std::unique(std::begin(_landmarks), std::end(_landmarks)), std::end(_landmarks));
+        _sources.assign(_slots.size(), no_source);
+        _rows.reserve(_landmarks.size());
+        for (auto i = std::size_t{}; i < _landmarks.size(); ++i) {
+            const auto& slot = _slots[static_cast<std::size_t>(_landmarks[i]->index())];
+            _sources[static_cast<std::size_t>(_landmarks[i]->index())] = i;
+            _rows.push_back(_cells);
+            _cells += _blocks[slot.component].size;
+        }
+        const auto adj = get_adjacency_lists(graph, positions);
+        auto queue = std::vector<std::size_t>{};
+        queue.reserve(_largest);
+        _full.assign(_cells, HUGE_VAL);
+        for (auto i = std::size_t{}; i < _landmarks.size(); ++i) {
+            const auto pos = _position(_landmarks[i]);
+            const auto& block = _blocks[_slots[static_cast<std::size_t>(_landmarks[i]->index())].component];
+            breadth_first_search(adj, pos, block.first, _full.data() + _rows[i], HUGE_VAL, queue);
+        }
+    }
+
+    distance_matrix::~distance_matrix() noexcept
+    {
+#if HAVE_POSIX_MAPPED_FILES
+        if (_cache_mapping != nullptr) {
+            munmap(_cache_mapping, _cache_mapping_size);
+        }
+        if (_mapping != nullptr) {
+            munmap(_mapping, _mapping_size);
+        }
+        if (_fd >= 0) {
+            close(_fd);
+        }
+#endif
+    }
+
+    void distance_matrix::_move_window(const std::size_t row) const
+    {
+        assert(_strategy == strategies::external);
+        assert(row < _cells);
+#if HAVE_POSIX_MAPPED_FILES
+        if (_mapping != nullptr) {
+            munmap(_mapping, _mapping_size);
+            _mapping = nullptr;
+            _window_cells = 0;
+        }
+        const auto cells = std::min(_window_capacity(), _cells - row);
+        const auto begin = _window_base + row * _window_width;
+        const auto offset = begin - begin % get_page_size();
+        const auto size = begin + cells * _window_width - offset;
+        const auto addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, _fd, static_cast<off_t>(offset));
+        if (addr == MAP_FAILED) {
+            throw_system_error("Cannot map distance matrix from file");
+        }
+#if HAVE_POSIX_MADVISE
+        posix_madvise(addr, size, POSIX_MADV_SEQUENTIAL);
+#endif
+#if HAVE_POSIX_FADVISE
+        // Have the kernel read the next window while this one is being consumed.
+        if (const auto next = row + cells; next < _cells) {
+            const auto count = std::min(_window_capacity(), _cells - next);
+            posix_fadvise(_fd, static_cast<off_t>(_window_base + next * _window_width),
+                          static_cast<off_t>(count * _window_width), POSIX_FADV_WILLNEED);
+        }
+#endif
+        const auto data = static_cast<const char*>(addr) + (begin - offset);
+        _mapping = addr;
+        _mapping_size = size;
+        _window = reinterpret_cast<const std::uint16_t*>(data);
+        _window_narrow = reinterpret_cast<const std::uint8_t*>(data);
+        _window_first = row;
+        _window_cells = cells;
+#else
+        std::terminate();
+#endif
+    }
+
+    std::vector<std::size_t> get_component_sizes(const ogdf::Graph& graph)
+    {
+        const auto stride = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+        const auto roots = get_component_roots(graph, stride);
+        auto ids = std::vector<std::size_t>(stride, npos);
+        auto sizes = std::vector<std::size_t>{};
+        for (const auto v : graph.nodes) {
+            auto& id = ids[roots[static_cast<std::size_t>(v->index())]];
+            if (id == npos) {
+                id = sizes.size();
+                sizes.push_back(0);
+            }
+            sizes[id] += 1;
+        }
+        return sizes;
+    }
+
+    std::size_t get_graph_diameter(const ogdf::Graph& graph)
+    {
+        const auto stride = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+        const auto roots = get_component_roots(graph, stride);
+        // Number the nodes so that each component occupies a contiguous range of positions.
+        auto ids = std::vector<std::size_t>(stride, npos);
+        auto offsets = std::vector<std::size_t>{0};
+        for (const auto v : graph.nodes) {
+            auto& id = ids[roots[static_cast<std::size_t>(v->index())]];
+            if (id == npos) {
+                id = offsets.size() - 1;
+                offsets.push_back(0);
+            }
+            offsets[id + 1] += 1;
+        }
+        std::partial_sum(std::begin(offsets), std::end(offsets), std::begin(offsets));
+        auto positions = std::vector<std::size_t>(stride, npos);
+        auto fill = offsets;
+        for (const auto v : graph.nodes) {
+            const auto idx = static_cast<std::size_t>(v->index());
+            positions[idx] = fill[ids[roots[idx]]]++;
+        }
+        const auto adj = get_adjacency_lists(graph, positions);
+        const auto nodes = offsets.back();
+        auto lower = std::vector<std::size_t>(nodes, 0);
+        auto upper = std::vector<std::size_t>(nodes, npos);
+        auto hops = std::vector<std::size_t>(nodes, npos);
+        auto queue = std::vector<std::size_t>{};
+        auto candidates = std::vector<std::size_t>{};
+        auto diameter = std::size_t{};
+        for (auto id = std::size_t{}; id + 1 < offsets.size(); ++id) {
+            // No node in a component can be farther away from another one than there are other nodes.
+            if (offsets[id + 1] - offsets[id] - 1 <= diameter) {
+                continue;
+            }
+            candidates.resize(offsets[id + 1] - offsets[id]);
+            std::iota(std::begin(candidates), std::end(candidates), offsets[id]);
+            // Alternate between the candidate with the largest upper and the one with the smallest lower bound.
+            for (auto largest = true; !candidates.empty(); largest = !largest) {
+                const auto by_upper = [&upper](const std::size_t a, const std::size_t b){ return upper[a] < upper[b]; };
+                const auto by_lower = [&lower](const std::size_t a, const std::size_t b){ return lower[a] < lower[b]; };
+                const auto source = largest
+                    ? *std::max_element(std::begin(candidates), std::end(candidates), by_upper)
+                    : *std::min_element(std::begin(candidates), std::end(candidates), by_lower);
+                breadth_first_search(adj, source, std::size_t{}, hops.data(), npos, queue);
+                const auto eccentricity = hops[queue.back()];
+                diameter = std::max(diameter, eccentricity);
+                for (const auto w : queue) {
+                    const auto distance = std::exchange(hops[w], npos);
+                    lower[w] = std::max({lower[w], distance, eccentricity - distance});
+                    upper[w] = std::min(upper[w], eccentricity + distance);
+                    if (lower[w] == upper[w]) {
+                        diameter = std::max(diameter, lower[w]);
+                    }
+                }
+                // Nodes that cannot be farther away from any other node than the longest path found so far are done.
+                const auto done = [&upper, diameter](const std::size_t w){ return upper[w] <= diameter; };
+                const auto last = std::remove_if(std::begin(candidates), std::end(candidates), done);
+                candidates.erase(last, std::end(candidates));
+            }
+        }
+        return diameter;
+    }
+
+    std::unique_ptr<distance_matrix> get_pairwise_shortest_paths(const ogdf::Graph& graph, const strategies strategy)
+    {
+        const auto timer = profile_timer{"apsp"};
+        return std::make_unique<distance_matrix>(graph, strategy);
+    }
+
+    std::unique_ptr<distance_matrix> get_sampled_shortest_paths(const ogdf::Graph& graph,
+                                                                const std::vector<ogdf::node>& landmarks)
     {
-        auto matrix = make_ogdf_node_array_2d_double(graph);
-        const auto unitweights = ogdf::EdgeArray<double>{graph, 1.0};
-        ogdf::dijkstra_SPAP(graph, *matrix, unitweights);
-        return matrix;
+        const auto timer = profile_timer{"apsp"};
+        return std::make_unique<distance_matrix>(graph, landmarks);
     }
 
 }  // namespace msc
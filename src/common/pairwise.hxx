@@ -29,14 +29,20 @@
 #define MSC_PAIRWISE_HXX
 
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 
+#include "enums/strategies.hxx"
+
 namespace msc
 {
 
@@ -51,6 +57,674 @@ namespace msc
     /** @brief Convenient type alias for a pair of node pointers. */
     using node_pair = std::pair<ogdf::node, ogdf::node>;
 
+    /**
+     * @brief
+     *     Matrix of all pairwise graph-theoretical distances in a graph.
+     *
+     * The connected components of the graph are determined first and the distances are only stored for pairs of nodes
+     * within the same component, as one dense block per component.  The distance between two nodes in different
+     * components is infinite and needs no storage, so the memory and time needed scale with the sum of the squared
+     * component sizes rather than with the square of the number of nodes.  Consumers that are only interested in
+     * finite distances should therefore iterate over the pairs of nodes in the order given by `first_node`,
+     * `next_node` and `next_in_component` (which is what a `node_pair_iterator` constructed from the matrix does).
+     * This is also the order in which the distances are stored.
+     *
+     * Depending on the strategy the matrix was computed with, the distances are either stored as `double`s
+     * (`strategies::full`) or as 16 bit hop counts (`strategies::compact`) which need only a quarter of the memory but
+     * cannot be used for graphs with connected components of 65&nbsp;535 or more nodes.
+     *
+     * With `strategies::external`, the hop counts are written to a temporary file instead and only a small window of
+     * consecutive rows is mapped into memory at any time.  Accessing a row outside of the current window moves the
+     * window, so the matrix is best read row by row in storage order.  Moving the window is not thread-safe and if the
+     * file cannot be mapped, `std::terminate` is called.
+     *
+     * With `strategies::sampled`, only the distances from a given set of source nodes (landmarks) to all nodes in
+     * their respective components are computed, which needs time and memory proportional to the number of landmarks
+     * times the size of the graph.  The matrix then iterates over the ordered pairs of a landmark and any other node in
+     * its component (so `first_node` and `next_node` only visit the landmarks and `first_partner` and `next_partner`
+     * provide the other nodes).  If the landmarks are drawn uniformly at random, the values obtained from these pairs
+     * are an unbiased sample of the values for all pairs.  The distance between two nodes in the same component neither
+     * of which is a landmark is unknown and reported as NaN.
+     *
+     * If the environment variable `MSC_CACHE_DIR` names a directory (see `get_cache_directory`), the hop counts
+     * computed with any strategy other than `strategies::sampled` are also stored there under the graph's
+     * `graph_fingerprint` so other processes (like the tools that are run for every layout of the same graph) can map
+     * them instead of repeating the breadth-first searches.  Cached hop counts use a single byte per pair if the
+     * largest one fits.  A matrix that was loaded from the cache reads its distances directly from the shared mapping,
+     * no matter which strategy was requested, and `cached` returns `true` for it.
+     *
+     * The matrix is indexed by the nodes' indices so it must not be used any more after nodes were added to or removed
+     * from the graph.
+     *
+     */
+    class distance_matrix final
+    {
+    public:
+
+        /**
+         * @brief
+         *     A lightweight reference to a row of the matrix.
+         *
+         * This type exists only so the matrix can be indexed as `matrix[v1][v2]`.
+         *
+         */
+        class row_reference final
+        {
+        public:
+
+            /**
+             * @brief
+             *     Returns the distance from the row's node to node `v2`.
+             *
+             * @param v2
+             *     other node
+             *
+             * @returns
+             *     graph-theoretical distance
+             *
+             */
+            double operator[](const ogdf::node v2) const noexcept
+            {
+                return (*_matrix)(_v1, v2);
+            }
+
+        private:
+
+            friend class distance_matrix;
+
+            row_reference(const distance_matrix& matrix, const ogdf::node v1) noexcept : _matrix{&matrix}, _v1{v1}
+            {
+            }
+
+            /** @brief Referenced matrix.  */
+            const distance_matrix* _matrix{};
+
+            /** @brief Node of this row.  */
+            ogdf::node _v1{};
+
+        };  // class row_reference
+
+        /**
+         * @brief
+         *     Computes all pairwise distances in a graph by breadth-first search from every node.
+         *
+         * The temporary file for `strategies::external` is created in the directory named by the environment
+         * variable `MSC_TMPDIR` or, if that is not set, `TMPDIR` or, if that is not set either, `/tmp`.  It is
+         * unlinked right away so it will not outlive the process.
+         *
+         * If caching is enabled, the matrix is loaded from the cache if possible.  Otherwise, it is computed and then
+         * stored in the cache.  With `strategies::external`, a cached matrix is only ever mapped one window at a time,
+         * just like the temporary file.  Failure to use the cache is not an error.
+         *
+         * @param graph
+         *     graph to operate on
+         *
+         * @param strategy
+         *     either `strategies::full`, `strategies::compact` or `strategies::external`
+         *
+         * @throws std::invalid_argument
+         *     if `strategy` is not supported by this type or the graph is too large for it
+         *
+         * @throws std::system_error
+         *     if the temporary file for `strategies::external` cannot be created or written
+         *
+         */
+        distance_matrix(const ogdf::Graph& graph, strategies strategy);
+
+        /**
+         * @brief
+         *     Computes the distances from the given landmarks to all other nodes by breadth-first search.
+         *
+         * The resulting matrix uses `strategies::sampled`.  Duplicate landmarks are ignored.
+         *
+         * @param graph
+         *     graph to operate on
+         *
+         * @param landmarks
+         *     source nodes (all of which must belong to `graph`)
+         *
+         */
+        distance_matrix(const ogdf::Graph& graph, const std::vector<ogdf::node>& landmarks);
+
+        /** @brief Unmaps and closes the temporary file and the cache entry, if any.  */
+        ~distance_matrix() noexcept;
+
+        /**
+         * @brief
+         *     Deleted copy constructor.
+         *
+         * @param other
+         *     N/A
+         *
+         */
+        distance_matrix(const distance_matrix& other) = delete;
+
+        /**
+         * @brief
+         *     Deleted copy assignment operator.
+         *
+         * @param other
+         *     N/A
+         *
+         * @returns
+         *     N/A
+         *
+         */
+        distance_matrix& operator=(const distance_matrix& other) = delete;
+
+        /**
+         * @brief
+         *     Returns the strategy the matrix was computed with.
+         *
+         * @returns
+         *     storage strategy
+         *
+         */
+        strategies strategy() const noexcept
+        {
+            return _strategy;
+        }
+
+        /**
+         * @brief
+         *     Returns the number of bytes allocated for the distances.
+         *
+         * A mapped cache entry is not counted as it lives in the page cache and is shared with other processes.
+         *
+         * @returns
+         *     memory footprint
+         *
+         */
+        std::size_t footprint() const noexcept
+        {
+            return _full.size() * sizeof(double)
+                + _compact.size() * sizeof(std::uint16_t)
+                + (((_fd >= 0) && !_cached) ? _window_capacity() * sizeof(std::uint16_t) : 0);
+        }
+
+        /**
+         * @brief
+         *     Tells whether the distances were loaded from the cache.
+         *
+         * @returns
+         *     whether a cache entry is mapped
+         *
+         */
+        bool cached() const noexcept
+        {
+            return _cached;
+        }
+
+        /**
+         * @brief
+         *     Returns the number of connected components of the graph.
+         *
+         * @returns
+         *     number of components
+         *
+         */
+        std::size_t components() const noexcept
+        {
+            return _blocks.size();
+        }
+
+        /**
+         * @brief
+         *     Returns the number of landmarks the distances were computed from.
+         *
+         * @returns
+         *     number of landmarks (or zero unless the matrix uses `strategies::sampled`)
+         *
+         */
+        std::size_t landmarks() const noexcept
+        {
+            return _landmarks.size();
+        }
+
+        /**
+         * @brief
+         *     Returns the number of unordered pairs of distinct nodes that are in different components.
+         *
+         * These pairs have infinite distance and are skipped when iterating in storage order.
+         *
+         * @returns
+         *     number of unreachable node pairs
+         *
+         */
+        std::size_t unreachable_pairs() const noexcept
+        {
+            const auto nodes = _order.size();
+            return (nodes * nodes - _squares) / 2;
+        }
+
+        /**
+         * @brief
+         *     Returns the first node in storage order (or the first landmark with `strategies::sampled`).
+         *
+         * @returns
+         *     first node or `nullptr` if the graph is empty
+         *
+         */
+        ogdf::node first_node() const noexcept
+        {
+            if (_strategy == strategies::sampled) {
+                return _landmarks.empty() ? nullptr : _landmarks.front();
+            }
+            return _order.empty() ? nullptr : _order.front();
+        }
+
+        /**
+         * @brief
+         *     Returns the node after `v` in storage order (or the landmark after `v` with `strategies::sampled`).
+         *
+         * @param v
+         *     current node (which must be a landmark with `strategies::sampled`)
+         *
+         * @returns
+         *     next node (possibly in another component) or `nullptr` if `v` is the last node
+         *
+         */
+        ogdf::node next_node(const ogdf::node v) const noexcept
+        {
+            if (_strategy == strategies::sampled) {
+                const auto idx = _sources[static_cast<std::size_t>(v->index())] + 1;
+                assert(idx > 0);
+                return (idx < _landmarks.size()) ? _landmarks[idx] : nullptr;
+            }
+            const auto pos = _position(v) + 1;
+            return (pos < _order.size()) ? _order[pos] : nullptr;
+        }
+
+        /**
+         * @brief
+         *     Returns the node after `v` in storage order if it is in the same component as `v`.
+         *
+         * @param v
+         *     current node
+         *
+         * @returns
+         *     next node in the same component or `nullptr` if `v` is the last node of its component
+         *
+         */
+        ogdf::node next_in_component(const ogdf::node v) const noexcept
+        {
+            const auto& slot = _slots[static_cast<std::size_t>(v->index())];
+            const auto& block = _blocks[slot.component];
+            return (slot.local + 1 < block.size) ? _order[block.first + slot.local + 1] : nullptr;
+        }
+
+        /**
+         * @brief
+         *     Returns the first node that is paired with `v1` when iterating over the stored distances.
+         *
+         * This is the node after `v1` in its component or, with `strategies::sampled`, the first node other than `v1`
+         * in its component.
+         *
+         * @param v1
+         *     node obtained from `first_node` or `next_node`
+         *
+         * @returns
+         *     first partner or `nullptr` if there is none
+         *
+         */
+        ogdf::node first_partner(const ogdf::node v1) const noexcept
+        {
+            if (_strategy != strategies::sampled) {
+                return next_in_component(v1);
+            }
+            const auto& slot = _slots[static_cast<std::size_t>(v1->index())];
+            const auto& block = _blocks[slot.component];
+            const auto local = (slot.local == 0) ? std::size_t{1} : std::size_t{0};
+            return (local < block.size) ? _order[block.first + local] : nullptr;
+        }
+
+        /**
+         * @brief
+         *     Returns the node after `v2` that is paired with `v1` when iterating over the stored distances.
+         *
+         * @param v1
+         *     node obtained from `first_node` or `next_node`
+         *
+         * @param v2
+         *     current partner of `v1`
+         *
+         * @returns
+         *     next partner or `nullptr` if `v2` was the last one
+         *
+         */
+        ogdf::node next_partner(const ogdf::node v1, const ogdf::node v2) const noexcept
+        {
+            const auto next = next_in_component(v2);
+            if ((_strategy == strategies::sampled) && (next == v1)) {
+                return next_in_component(next);
+            }
+            return next;
+        }
+
+        /**
+         * @brief
+         *     Returns the distance between two nodes.
+         *
+         * The behavior is undefined unless both nodes belong to the graph the matrix was computed for.  With
+         * `strategies::sampled`, NaN is `return`ed for two nodes in the same component neither of which is a landmark.
+         *
+         * @param v1
+         *     first node
+         *
+         * @param v2
+         *     second node
+         *
+         * @returns
+         *     graph-theoretical distance (possibly infinite)
+         *
+         */
+        double operator()(const ogdf::node v1, const ogdf::node v2) const noexcept
+        {
+            assert((v1 != nullptr) && (v2 != nullptr));
+            const auto& slot1 = _slots[static_cast<std::size_t>(v1->index())];
+            const auto& slot2 = _slots[static_cast<std::size_t>(v2->index())];
+            if (slot1.component != slot2.component) {
+                return HUGE_VAL;
+            }
+            if (_strategy == strategies::sampled) {
+                if (const auto src = _sources[static_cast<std::size_t>(v1->index())]; src != no_source) {
+                    return _full[_rows[src] + slot2.local];
+                }
+                if (const auto src = _sources[static_cast<std::size_t>(v2->index())]; src != no_source) {
+                    return _full[_rows[src] + slot1.local];
+                }
+                return NAN;
+            }
+            const auto& block = _blocks[slot1.component];
+            const auto row = block.cells + slot1.local * block.size;
+            if (_cached_narrow != nullptr) {
+                return _cached_narrow[row + slot2.local];
+            }
+            if (_cached_wide != nullptr) {
+                return _cached_wide[row + slot2.local];
+            }
+            auto hops = std::uint16_t{};
+            switch (_strategy) {
+            case strategies::full:
+                assert(row + slot2.local < _full.size());
+                return _full[row + slot2.local];
+            case strategies::compact:
+                assert(row + slot2.local < _compact.size());
+                hops = _compact[row + slot2.local];
+                break;
+            default:
+                assert(_strategy == strategies::external);
+                // The subtraction wraps around for rows before the window so this also catches them.
+                if ((row - _window_first >= _window_cells) || (_window_cells - (row - _window_first) < block.size)) {
+                    _move_window(row);
+                }
+                hops = (_window_width == 1)
+                    ? _window_narrow[row - _window_first + slot2.local]
+                    : _window[row - _window_first + slot2.local];
+                break;
+            }
+            return (hops == unreachable) ? HUGE_VAL : hops;
+        }
+
+        /**
+         * @brief
+         *     Returns a reference to the row of node `v1`.
+         *
+         * @param v1
+         *     first node
+         *
+         * @returns
+         *     row reference
+         *
+         */
+        row_reference operator[](const ogdf::node v1) const noexcept
+        {
+            return row_reference{*this, v1};
+        }
+
+        /** @brief Sentinel hop count for unreachable nodes in compact and external storage.  */
+        static constexpr std::uint16_t unreachable = UINT16_MAX;
+
+        /** @brief Number of rows that are computed or mapped at once with external storage.  */
+        static constexpr std::size_t external_window_rows = 64;
+
+    private:
+
+        /** @brief Value in `_sources` for nodes that are not landmarks.  */
+        static constexpr std::size_t no_source = SIZE_MAX;
+
+        /** @brief Location of a node in the matrix.  */
+        struct slot
+        {
+            /** @brief Connected component of the node.  */
+            std::size_t component{};
+
+            /** @brief Position of the node within its component.  */
+            std::size_t local{};
+        };
+
+        /** @brief Location of a connected component in the matrix.  */
+        struct block
+        {
+            /** @brief Offset of the component's first distance.  */
+            std::size_t cells{};
+
+            /** @brief Position of the component's first node in storage order.  */
+            std::size_t first{};
+
+            /** @brief Number of nodes in the component.  */
+            std::size_t size{};
+        };
+
+        /**
+         * @brief
+         *     Returns the position of a node in storage order.
+         *
+         * @param v
+         *     node
+         *
+         * @returns
+         *     position
+         *
+         */
+        std::size_t _position(const ogdf::node v) const noexcept
+        {
+            const auto& slot = _slots[static_cast<std::size_t>(v->index())];
+            return _blocks[slot.component].first + slot.local;
+        }
+
+        /**
+         * @brief
+         *     Determines the connected components and the storage order of the nodes.
+         *
+         * @param graph
+         *     graph to operate on
+         *
+         * @returns
+         *     position of each node in storage order, indexed by node index
+         *
+         */
+        std::vector<std::size_t> _partition(const ogdf::Graph& graph);
+
+        /**
+         * @brief
+         *     Computes the distances with the strategy given to the constructor (which must not be sampled).
+         *
+         * @param graph
+         *     graph to operate on
+         *
+         * @param positions
+         *     position of each node in storage order, as `return`ed by `_partition`
+         *
+         */
+        void _compute(const ogdf::Graph& graph, const std::vector<std::size_t>& positions);
+
+        /**
+         * @brief
+         *     Maps a cache entry if it exists and matches the partition.
+         *
+         * With `strategies::external`, the entry is not mapped as a whole but accessed through the window.
+         *
+         * @param filename
+         *     name of the cache entry
+         *
+         * @returns
+         *     whether the entry was mapped
+         *
+         */
+        bool _load_cached(const std::string& filename) noexcept;
+
+        /**
+         * @brief
+         *     Stores the computed distances as a cache entry.
+         *
+         * Nothing is stored if the hop counts do not fit into 16 bit and errors are ignored.
+         *
+         * @param filename
+         *     name of the cache entry
+         *
+         */
+        void _store_cached(const std::string& filename) const noexcept;
+
+        /**
+         * @brief
+         *     Returns the number of distances that fit into a window with external storage.
+         *
+         * @returns
+         *     window capacity
+         *
+         */
+        std::size_t _window_capacity() const noexcept
+        {
+            return external_window_rows * _largest;
+        }
+
+        /**
+         * @brief
+         *     Maps a window that starts with the given row (only used with `strategies::external`).
+         *
+         * @param row
+         *     offset of the first distance in the row that is about to be accessed
+         *
+         * @throws std::system_error
+         *     if the file cannot be mapped
+         *
+         */
+        void _move_window(std::size_t row) const;
+
+        /** @brief Strategy the matrix was computed with.  */
+        strategies _strategy{};
+
+        /** @brief Location of each node, indexed by node index.  */
+        std::vector<slot> _slots{};
+
+        /** @brief Location of each connected component.  */
+        std::vector<block> _blocks{};
+
+        /** @brief All nodes in storage order (grouped by component).  */
+        std::vector<ogdf::node> _order{};
+
+        /** @brief Number of nodes in the largest component.  */
+        std::size_t _largest{};
+
+        /** @brief Total number of stored distances (except with `strategies::sampled`).  */
+        std::size_t _cells{};
+
+        /** @brief Sum of the squared sizes of the connected components.  */
+        std::size_t _squares{};
+
+        /** @brief Distances (only used with `strategies::full` and `strategies::sampled`).  */
+        std::vector<double> _full{};
+
+        /** @brief Landmarks in storage order (only used with `strategies::sampled`).  */
+        std::vector<ogdf::node> _landmarks{};
+
+        /** @brief Index into `_landmarks` for each node or `no_source` (only used with `strategies::sampled`).  */
+        std::vector<std::size_t> _sources{};
+
+        /** @brief Offset of the row of each landmark (only used with `strategies::sampled`).  */
+        std::vector<std::size_t> _rows{};
+
+        /** @brief Hop counts (only used with `strategies::compact`).  */
+        std::vector<std::uint16_t> _compact{};
+
+        /** @brief File descriptor of the temporary file or cache entry (only used with `strategies::external`).  */
+        int _fd{-1};
+
+        /** @brief Byte offset of the first distance in the file behind `_fd`.  */
+        std::size_t _window_base{};
+
+        /** @brief Number of bytes per distance in the file behind `_fd`.  */
+        std::size_t _window_width{sizeof(std::uint16_t)};
+
+        /** @brief Start of the currently mapped region (which may begin before the window).  */
+        mutable void* _mapping{};
+
+        /** @brief Size of the currently mapped region in bytes.  */
+        mutable std::size_t _mapping_size{};
+
+        /** @brief Hop counts in the current window if they are stored as 16 bit integers.  */
+        mutable const std::uint16_t* _window{};
+
+        /** @brief Hop counts in the current window if they are stored as single bytes.  */
+        mutable const std::uint8_t* _window_narrow{};
+
+        /** @brief Offset of the first distance in the current window.  */
+        mutable std::size_t _window_first{};
+
+        /** @brief Number of distances in the current window (zero if no window is mapped).  */
+        mutable std::size_t _window_cells{};
+
+        /** @brief Start of the mapped cache entry (if the matrix was loaded from the cache).  */
+        void* _cache_mapping{};
+
+        /** @brief Size of the mapped cache entry in bytes.  */
+        std::size_t _cache_mapping_size{};
+
+        /** @brief Cached hop counts if they are stored as single bytes.  */
+        const std::uint8_t* _cached_narrow{};
+
+        /** @brief Cached hop counts if they are stored as 16 bit integers.  */
+        const std::uint16_t* _cached_wide{};
+
+        /** @brief Whether the distances were loaded from the cache.  */
+        bool _cached{};
+
+    };  // class distance_matrix
+
+    /**
+     * @brief
+     *     Returns the sizes of the connected components of a graph.
+     *
+     * The components are ordered by their first node in the graph's node order.  The edges are treated as undirected.
+     *
+     * @param graph
+     *     graph to analyze
+     *
+     * @returns
+     *     number of nodes in each component
+     *
+     */
+    std::vector<std::size_t> get_component_sizes(const ogdf::Graph& graph);
+
+    /**
+     * @brief
+     *     Returns the largest finite graph-theoretical distance between any two nodes of a graph.
+     *
+     * This is the largest diameter of any connected component.  Rather than searching from every node, the bounds on
+     * the eccentricities of all nodes that each breadth-first search provides are used to rule out as many nodes as
+     * possible (Takes and Kosters, 2011).  Usually, only a handful of searches per component are needed so this takes
+     * about linear time and memory.  The edges are treated as undirected.
+     *
+     * @param graph
+     *     graph to analyze
+     *
+     * @returns
+     *     diameter (zero if the graph has no edges)
+     *
+     */
+    std::size_t get_graph_diameter(const ogdf::Graph& graph);
+
     /**
      * @brief
      *     Computes all pairwise shortest paths in a graph.
@@ -58,11 +732,87 @@ namespace msc
      * @param graph
      *     graph to operate on
      *
+     * @param strategy
+     *     storage strategy for the matrix (see `plan_pairwise_distances` for choosing one)
+     *
      * @returns
      *     pairwise shortest path matrix
      *
      */
-    std::unique_ptr<ogdf_node_array_2d<double>> get_pairwise_shortest_paths(const ogdf::Graph& graph);
+    std::unique_ptr<distance_matrix> get_pairwise_shortest_paths(const ogdf::Graph& graph,
+                                                                 strategies strategy = strategies::full);
+
+    /**
+     * @brief
+     *     Computes the shortest paths from a set of landmarks to all other nodes in a graph.
+     *
+     * @param graph
+     *     graph to operate on
+     *
+     * @param landmarks
+     *     source nodes (see `select_landmarks`)
+     *
+     * @returns
+     *     distance matrix using `strategies::sampled`
+     *
+     */
+    std::unique_ptr<distance_matrix> get_sampled_shortest_paths(const ogdf::Graph& graph,
+                                                                const std::vector<ogdf::node>& landmarks);
+
+    /**
+     * @brief
+     *     Draws a uniform random sample of distinct nodes from a graph.
+     *
+     * @tparam EngT
+     *     random engine type
+     *
+     * @param graph
+     *     graph to sample from
+     *
+     * @param count
+     *     number of nodes to select (all nodes are selected if the graph has no more than that)
+     *
+     * @param engine
+     *     random engine to use
+     *
+     * @returns
+     *     selected nodes in no particular order
+     *
+     */
+    template <typename EngT>
+    std::vector<ogdf::node> select_landmarks(const ogdf::Graph& graph, std::size_t count, EngT& engine);
+
+    /**
+     * @brief
+     *     Computes the shortest paths in a graph with the given strategy.
+     *
+     * This is `get_sampled_shortest_paths` with randomly selected landmarks if `strategy` is `strategies::sampled` and
+     * `get_pairwise_shortest_paths` otherwise.
+     *
+     * @tparam EngT
+     *     random engine type
+     *
+     * @param graph
+     *     graph to operate on
+     *
+     * @param strategy
+     *     storage strategy for the matrix
+     *
+     * @param landmarks
+     *     number of landmarks to select (only relevant for `strategies::sampled`)
+     *
+     * @param engine
+     *     random engine to select the landmarks with
+     *
+     * @returns
+     *     shortest path matrix
+     *
+     */
+    template <typename EngT>
+    std::unique_ptr<distance_matrix> get_shortest_paths(const ogdf::Graph& graph,
+                                                        strategies strategy,
+                                                        std::size_t landmarks,
+                                                        EngT& engine);
 
     /**
      * @brief
@@ -164,6 +914,10 @@ namespace msc
      *
      * The iterator is evaluated eagerly.  That is, once incremented, dereferencing it multiple times is cheap.
      *
+     * If the iterator is constructed from a `distance_matrix` rather than a graph, only pairs of nodes within the same
+     * connected component are visited, which saves the quadratic cost of rejecting all other pairs one by one.  If the
+     * matrix uses `strategies::sampled`, only the (ordered) pairs that have a landmark as their first node are visited.
+     *
      * @tparam ValueT
      *     type stored in the iterator (Requires nothrow default constructible and nothrow copyable and nothrow
      *     constructible.  However, a default-constructed `ValueT` need not have a meaningful value and will never be
@@ -278,10 +1032,38 @@ namespace msc
         {
             _v1 = _graph->firstNode();
             _v2 = (_v1 == nullptr) ? nullptr : _v1->succ();
-            if (_good()) {
-                while (!_pred()(_v1, _v2) && _advance_once()) continue;
-                if (_good()) _value = _proj()(_v1, _v2);
+            _start();
+        }
+
+        /**
+         * @brief
+         *     Constructs an iterator that points to the first pair of nodes within the same connected component that
+         *     passes the policy.
+         *
+         * Pairs of nodes in different components are skipped without consulting the predicate and the pairs are
+         * visited in the storage order of the matrix.
+         *
+         * @param matrix
+         *     distance matrix of the graph to iterate over
+         *
+         * @param pred
+         *     predicate (if stateful)
+         *
+         * @param proj
+         *     projection (if stateful)
+         *
+         */
+        explicit node_pair_iterator(const distance_matrix& matrix,
+                                    PredT pred = PredT{},
+                                    ProjT proj = ProjT{}) noexcept :
+            PredT{std::move(pred)}, ProjT{std::move(proj)}, _matrix{&matrix}
+        {
+            _v1 = _matrix->first_node();
+            _v2 = (_v1 == nullptr) ? nullptr : _matrix->first_partner(_v1);
+            while ((_v1 != nullptr) && (_v2 == nullptr)) {
+                if ((_v1 = _matrix->next_node(_v1))) _v2 = _matrix->first_partner(_v1);
             }
+            _start();
         }
 
         /**
@@ -352,6 +1134,22 @@ namespace msc
             return std::addressof(_value);
         }
 
+        /**
+         * @brief
+         *     Returns the pair of nodes the current value was computed from.
+         *
+         * The behavior of this function is undefined on a past-the-end iterator.
+         *
+         * @returns
+         *     current pair of nodes
+         *
+         */
+        node_pair nodes() const noexcept
+        {
+            assert(_good());
+            return {_v1, _v2};
+        }
+
         /**
          * @brief
          *     Tests whether the iterator is /not/ a past-the-end iterator.
@@ -386,6 +1184,7 @@ namespace msc
         friend bool operator==(const node_pair_iterator& lhs, const node_pair_iterator& rhs) noexcept
         {
             assert((lhs._graph == nullptr) || (rhs._graph == nullptr) || (lhs._graph == rhs._graph));
+            assert((lhs._matrix == nullptr) || (rhs._matrix == nullptr) || (lhs._matrix == rhs._matrix));
             if (!lhs._good()) return !rhs._good();
             if (!rhs._good()) return !lhs._good();
             return (lhs._v1 == rhs._v1) && (lhs._v2 == rhs._v2);
@@ -410,10 +1209,19 @@ namespace msc
     private:
 
         const ogdf::Graph* _graph{nullptr};
+        const distance_matrix* _matrix{nullptr};
         ogdf::node _v1{nullptr};
         ogdf::node _v2{nullptr};
         ValueT _value{};
 
+        void _start() noexcept
+        {
+            if (_good()) {
+                while (!_pred()(_v1, _v2) && _advance_once()) continue;
+                if (_good()) _value = _proj()(_v1, _v2);
+            }
+        }
+
         void _advance() noexcept
         {
             while (_advance_once() && !_pred()(_v1, _v2)) continue;
@@ -424,12 +1232,22 @@ namespace msc
         {
             if (_v1 == nullptr)       return false;  // TBD: Can this check be elided?
             if (_v2 == nullptr)       return false;  // TBD: Can this check be elided?
+            if (_matrix != nullptr)   return _advance_once_in_component();
             if ((_v2 = _v2->succ()))  return true;
             if (!(_v1 = _v1->succ())) return false;
             if (!(_v2 = _v1->succ())) return false;
             return true;
         }
 
+        bool _advance_once_in_component() noexcept
+        {
+            if ((_v2 = _matrix->next_partner(_v1, _v2))) return true;
+            do {
+                if (!(_v1 = _matrix->next_node(_v1))) return false;
+            } while (!(_v2 = _matrix->first_partner(_v1)));
+            return true;
+        }
+
         bool _good() const noexcept
         {
             return (_v1 != nullptr) && (_v2 != nullptr);
@@ -458,7 +1276,7 @@ namespace msc
      * <var>v</var><sub>2</sub>) &le; <var>x</var> holds.
      *
      * @tparam T
-     *     result type of the pre-computed function (must be nothrow default constructible and less-equal comparable)
+     *     type of the threshold (must be nothrow default constructible and less-equal comparable with `double`)
      *
      */
     template <typename T>
@@ -481,13 +1299,13 @@ namespace msc
          *     Actually useful constructor.
          *
          * @param matrix
-         *     pre-computed table of function values
+         *     pre-computed distance matrix
          *
          * @param threshold
          *     largest value to let pass
          *
          */
-        threshold_node_pair_predicate(const ogdf_node_array_2d<T>& matrix, const T threshold) noexcept
+        threshold_node_pair_predicate(const distance_matrix& matrix, const T threshold) noexcept
             : _matrix{&matrix}, _threshold{threshold}
         {
         }
@@ -515,13 +1333,13 @@ namespace msc
             assert(_matrix != nullptr);
             assert(v1 != nullptr);
             assert(v2 != nullptr);
-            return ((*_matrix)[v1][v2] <= _threshold);
+            return ((*_matrix)(v1, v2) <= _threshold);
         }
 
     private:
 
-        /** @brief Pointer to pre-computed function table.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        /** @brief Pointer to pre-computed distance matrix.  */
+        const distance_matrix* _matrix{};
 
         /** @brief Largest value to accept.  */
         T _threshold{};
@@ -530,4 +1348,8 @@ namespace msc
 
 }  // namespace msc
 
+#define MSC_INCLUDED_FROM_PAIRWISE_HXX
+#include "pairwise.txx"
+#undef MSC_INCLUDED_FROM_PAIRWISE_HXX
+
 #endif  // !defined(MSC_PAIRWISE_HXX)
@@ -0,0 +1,59 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef MSC_INCLUDED_FROM_PAIRWISE_HXX
+#  error "Never `#include <pairwise.txx>` directly; `#include <pairwise.hxx>` instead"
+#endif
+
+#include <random>
+
+namespace msc
+{
+
+    template <typename EngT>
+    std::vector<ogdf::node> select_landmarks(const ogdf::Graph& graph, const std::size_t count, EngT& engine)
+    {
+        auto nodes = std::vector<ogdf::node>{};
+        nodes.reserve(static_cast<std::size_t>(graph.numberOfNodes()));
+        for (const auto v : graph.nodes) {
+            nodes.push_back(v);
+        }
+        if (count >= nodes.size()) {
+            return nodes;
+        }
+        // Partial Fisher-Yates shuffle so only `count` random numbers are needed.
+        for (auto i = std::size_t{}; i < count; ++i) {
+            auto dist = std::uniform_int_distribution<std::size_t>{i, nodes.size() - 1};
+            std::swap(nodes[i], nodes[dist(engine)]);
+        }
+        nodes.resize(count);
+        return nodes;
+    }
+
+    template <typename EngT>
+    std::unique_ptr<distance_matrix> get_shortest_paths(const ogdf::Graph& graph,
+                                                        const strategies strategy,
+                                                        const std::size_t landmarks,
+                                                        EngT& engine)
+    {
+        if (strategy == strategies::sampled) {
+            return get_sampled_shortest_paths(graph, select_landmarks(graph, landmarks, engine));
+        }
+        return get_pairwise_shortest_paths(graph, strategy);
+    }
+
+}  // namespace msc
@@ -0,0 +1,234 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "planner.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "pairwise.hxx"
+#include "rlimits.hxx"
+#include "strings.hxx"
+#include "useful.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        constexpr auto unrepresentable = std::numeric_limits<std::size_t>::max();
+
+        // Multiplies two sizes, saturating at the largest representable value rather than wrapping around.
+        constexpr std::size_t saturating_multiply(const std::size_t a, const std::size_t b) noexcept
+        {
+            return ((a != 0) && (b > unrepresentable / a)) ? unrepresentable : a * b;
+        }
+
+        constexpr std::size_t saturating_add(const std::size_t a, const std::size_t b) noexcept
+        {
+            return (b > unrepresentable - a) ? unrepresentable : a + b;
+        }
+
+        // Adjacency lists in compressed sparse row format, the queue of a breadth-first search and the book-keeping
+        // for the connected components.
+        std::size_t get_scratch_footprint(const std::size_t nodes, const std::size_t edges) noexcept
+        {
+            const auto words = saturating_add(saturating_multiply(8, nodes), saturating_multiply(2, edges));
+            return saturating_multiply(words, sizeof(std::size_t));
+        }
+
+        // Shape of the problem: `cells` is the number of stored distances, `largest` the size of the largest connected
+        // component and `landmarks` the number of source nodes for sampling.
+        struct problem_size
+        {
+            std::size_t nodes{};
+            std::size_t edges{};
+            std::size_t cells{};
+            std::size_t largest{};
+            std::size_t components{};
+            std::size_t landmarks{};
+        };
+
+        problem_size get_problem_size(const std::vector<std::size_t>& components,
+                                      const std::size_t edges,
+                                      const std::size_t landmarks) noexcept
+        {
+            auto size = problem_size{};
+            size.edges = edges;
+            size.components = components.size();
+            for (const auto n : components) {
+                size.nodes = saturating_add(size.nodes, n);
+                size.cells = saturating_add(size.cells, saturating_multiply(n, n));
+                size.largest = std::max(size.largest, n);
+            }
+            size.landmarks = std::min(landmarks, size.nodes);
+            return size;
+        }
+
+        problem_size get_problem_size(const std::size_t nodes,
+                                      const std::size_t edges,
+                                      const std::size_t landmarks) noexcept
+        {
+            const auto components = (nodes > 0) ? std::size_t{1} : std::size_t{0};
+            return {nodes, edges, saturating_multiply(nodes, nodes), nodes, components, std::min(landmarks, nodes)};
+        }
+
+
+        bool fits(const std::size_t footprint, const std::optional<std::size_t> budget) noexcept
+        {
+            return !budget || (footprint <= *budget - *budget / 8);
+        }
+
+        std::optional<strategies> get_forced_strategy()
+        {
+            if (const auto envval = std::getenv("MSC_DISTANCES")) {
+                return value_of_strategies(envval);
+            }
+            return std::nullopt;
+        }
+
+        std::size_t estimate(const strategies strategy, const problem_size& size) noexcept
+        {
+            const auto scratch = get_scratch_footprint(size.nodes, size.edges);
+            switch (strategy) {
+            case strategies::full:
+                return saturating_add(scratch, saturating_multiply(size.cells, sizeof(double)));
+            case strategies::compact:
+                if (size.largest >= UINT16_MAX) {
+                    return unrepresentable;
+                }
+                return saturating_add(scratch, saturating_multiply(size.cells, sizeof(std::uint16_t)));
+            case strategies::external:
+                if (!HAVE_POSIX_MAPPED_FILES || (size.largest >= UINT16_MAX)) {
+                    return unrepresentable;
+                }
+                return saturating_add(
+                    scratch,
+                    saturating_multiply(distance_matrix::external_window_rows * size.largest, sizeof(std::uint16_t))
+                );
+            case strategies::sampled:
+                return saturating_add(
+                    scratch, saturating_multiply(saturating_multiply(size.landmarks, size.largest), sizeof(double))
+                );
+            }
+            return unrepresentable;
+        }
+
+        distance_plan make_plan(const problem_size& size, const std::initializer_list<strategies> candidates)
+        {
+            assert(candidates.size() > 0);
+            auto plan = distance_plan{};
+            plan.budget = get_memory_budget();
+            plan.components = size.components;
+            plan.unreachable = (saturating_multiply(size.nodes, size.nodes) - size.cells) / 2;
+            plan.landmarks = size.landmarks;
+            if (const auto forced = get_forced_strategy()) {
+                if (std::find(std::begin(candidates), std::end(candidates), *forced) == std::end(candidates)) {
+                    throw std::invalid_argument{
+                        concat(
+                            "Strategy ", name(*forced), " (requested via MSC_DISTANCES) is not supported by this tool"
+                        )
+                    };
+                }
+                plan.strategy = *forced;
+                plan.footprint = estimate(*forced, size);
+                plan.forced = true;
+                return plan;
+            }
+            for (const auto strategy : candidates) {
+                const auto footprint = estimate(strategy, size);
+                if ((footprint != unrepresentable) && fits(footprint, plan.budget)) {
+                    plan.strategy = strategy;
+                    plan.footprint = footprint;
+                    return plan;
+                }
+            }
+            auto smallest = unrepresentable;
+            for (const auto strategy : candidates) {
+                smallest = std::min(smallest, estimate(strategy, size));
+            }
+            throw std::runtime_error{
+                concat(
+                    "Pairwise distances for a graph with ", std::to_string(size.nodes), " nodes need at least ",
+                    std::to_string(smallest), " bytes of memory but only ", std::to_string(plan.budget.value_or(0)),
+                    " bytes are available"
+                )
+            };
+        }
+
+    }  // namespace /*anonymous*/
+
+    std::size_t estimate_distance_footprint(const strategies strategy,
+                                            const std::size_t nodes,
+                                            const std::size_t edges,
+                                            const std::size_t landmarks) noexcept
+    {
+        return estimate(strategy, get_problem_size(nodes, edges, landmarks));
+    }
+
+    std::size_t estimate_distance_footprint(const strategies strategy,
+                                            const std::vector<std::size_t>& components,
+                                            const std::size_t edges,
+                                            const std::size_t landmarks) noexcept
+    {
+        return estimate(strategy, get_problem_size(components, edges, landmarks));
+    }
+
+    distance_plan plan_pairwise_distances(const std::size_t nodes,
+                                          const std::size_t edges,
+                                          const std::initializer_list<strategies> candidates,
+                                          const std::size_t landmarks)
+    {
+        return make_plan(get_problem_size(nodes, edges, landmarks), candidates);
+    }
+
+    distance_plan plan_pairwise_distances(const ogdf::Graph& graph,
+                                          const std::initializer_list<strategies> candidates,
+                                          const std::size_t landmarks)
+    {
+        const auto edges = static_cast<std::size_t>(graph.numberOfEdges());
+        return make_plan(get_problem_size(get_component_sizes(graph), edges, landmarks), candidates);
+    }
+
+    json_object get_distance_plan_info(const distance_plan& plan)
+    {
+        auto info = json_object{};
+        info["strategy"] = json_text{name(plan.strategy)};
+        info["footprint"] = json_size{plan.footprint};
+        info["budget"] = plan.budget ? json_any{json_size{*plan.budget}} : json_any{json_null{}};
+        info["forced"] = json_bool{plan.forced};
+        info["components"] = json_size{plan.components};
+        info["unreachable-pairs"] = json_size{plan.unreachable};
+        info["landmarks"] = (plan.strategy == strategies::sampled)
+            ? json_any{json_size{plan.landmarks}}
+            : json_any{json_null{}};
+        return info;
+    }
+
+}  // namespace msc
@@ -0,0 +1,215 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ * @file planner.hxx
+ *
+ * @brief
+ *     Planning of algorithms with large memory requirements within the available memory budget.
+ *
+ * Tools that need all pairwise graph-theoretical distances can obtain them in several ways (see `strategies`) that
+ * trade speed for memory.  Rather than allocating an <var>n</var> &times; <var>n</var> matrix unconditionally and
+ * dying with `std::bad_alloc` (after having done much work) if the process is under a memory limit, a tool asks the
+ * planner which of the strategies it supports is the fastest one that fits into the memory budget as determined by
+ * `get_memory_budget` and records the decision in its meta data.
+ *
+ * The environment variable `MSC_DISTANCES` may be set to the name of a strategy in order to override the planner's
+ * choice.  This is mostly useful for testing and benchmarking.
+ *
+ * With `strategies::sampled`, only the distances from a number of randomly selected source nodes (landmarks) are
+ * computed, which needs time and memory proportional to the number of landmarks times the size of the graph.  Tools
+ * that support it estimate their properties from this sample.
+ *
+ */
+
+#ifndef MSC_PLANNER_HXX
+#define MSC_PLANNER_HXX
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+#include "enums/strategies.hxx"
+#include "json.hxx"
+#include "ogdf_fwd.hxx"
+
+namespace msc
+{
+
+    /** @brief Number of landmarks used with `strategies::sampled` unless requested otherwise.  */
+    inline constexpr std::size_t default_landmarks = 64;
+
+    /**
+     * @brief
+     *     Decision of the planner.
+     *
+     */
+    struct distance_plan
+    {
+
+        /** @brief Strategy to use.  */
+        strategies strategy{};
+
+        /** @brief Estimated number of bytes needed by the strategy.  */
+        std::size_t footprint{};
+
+        /** @brief Number of bytes that were available or `std::nullopt` if unknown.  */
+        std::optional<std::size_t> budget{};
+
+        /** @brief Whether the strategy was forced via the environment rather than chosen by the planner.  */
+        bool forced{};
+
+        /** @brief Number of connected components of the graph.  */
+        std::size_t components{1};
+
+        /** @brief Number of unordered pairs of nodes in different components (which need no storage).  */
+        std::size_t unreachable{};
+
+        /** @brief Number of landmarks to use with `strategies::sampled` (never more than there are nodes).  */
+        std::size_t landmarks{};
+
+    };
+
+    /**
+     * @brief
+     *     Estimates the number of bytes needed to obtain pairwise distances with a given strategy.
+     *
+     * The estimate accounts for the storage of the distances and temporary data structures that scale with the size of
+     * the graph but not for the graph itself (which is already allocated).  For strategies that cannot be used for a
+     * graph of the given size, the largest representable value is `return`ed.
+     *
+     * @param strategy
+     *     strategy to estimate
+     *
+     * @param nodes
+     *     number of nodes in the graph
+     *
+     * @param edges
+     *     number of edges in the graph
+     *
+     * @param landmarks
+     *     number of landmarks (only relevant for `strategies::sampled`)
+     *
+     * @returns
+     *     estimated memory footprint
+     *
+     */
+    std::size_t estimate_distance_footprint(strategies strategy,
+                                            std::size_t nodes,
+                                            std::size_t edges,
+                                            std::size_t landmarks = default_landmarks) noexcept;
+
+    /**
+     * @brief
+     *     Estimates the number of bytes needed to obtain pairwise distances in a graph that is not connected.
+     *
+     * Since distances are only stored for pairs of nodes within the same connected component, the estimate scales with
+     * the sum of the squared component sizes rather than the square of the total number of nodes.
+     *
+     * @param strategy
+     *     strategy to estimate
+     *
+     * @param components
+     *     number of nodes in each connected component of the graph
+     *
+     * @param edges
+     *     number of edges in the graph
+     *
+     * @param landmarks
+     *     number of landmarks (only relevant for `strategies::sampled`)
+     *
+     * @returns
+     *     estimated memory footprint
+     *
+     */
+    std::size_t estimate_distance_footprint(strategies strategy,
+                                            const std::vector<std::size_t>& components,
+                                            std::size_t edges,
+                                            std::size_t landmarks = default_landmarks) noexcept;
+
+    /**
+     * @brief
+     *     Selects the first of the given strategies that fits into the memory budget.
+     *
+     * A strategy fits if its estimated footprint leaves at least an eighth of the budget for the rest of the
+     * computation.  If the budget is unknown, the first candidate is selected.  The graph is assumed to be connected.
+     *
+     * @param nodes
+     *     number of nodes in the graph
+     *
+     * @param edges
+     *     number of edges in the graph
+     *
+     * @param candidates
+     *     strategies supported by the caller, fastest first
+     *
+     * @param landmarks
+     *     number of landmarks (only relevant for `strategies::sampled`)
+     *
+     * @returns
+     *     selected strategy
+     *
+     * @throws std::invalid_argument
+     *     if `MSC_DISTANCES` is set to an invalid value or a strategy not among the `candidates`
+     *
+     * @throws std::runtime_error
+     *     if none of the `candidates` fits into the memory budget
+     *
+     */
+    distance_plan plan_pairwise_distances(std::size_t nodes,
+                                          std::size_t edges,
+                                          std::initializer_list<strategies> candidates,
+                                          std::size_t landmarks = default_landmarks);
+
+    /**
+     * @brief
+     *     Convenience overload that takes the size and connected components from a graph.
+     *
+     * @param graph
+     *     graph to operate on
+     *
+     * @param candidates
+     *     strategies supported by the caller, fastest first
+     *
+     * @param landmarks
+     *     number of landmarks (only relevant for `strategies::sampled`)
+     *
+     * @returns
+     *     selected strategy
+     *
+     */
+    distance_plan plan_pairwise_distances(const ogdf::Graph& graph,
+                                          std::initializer_list<strategies> candidates,
+                                          std::size_t landmarks = default_landmarks);
+
+    /**
+     * @brief
+     *     Returns a JSON object that describes a plan and is suitable for inclusion in the meta data.
+     *
+     * @param plan
+     *     plan to describe
+     *
+     * @returns
+     *     JSON object with the keys `strategy`, `footprint`, `budget`, `forced`, `components`, `unreachable-pairs`
+     *     and `landmarks` (which is `null` unless the strategy is `strategies::sampled`)
+     *
+     */
+    json_object get_distance_plan_info(const distance_plan& plan);
+
+}  // namespace msc
+
+#endif  // !defined(MSC_PLANNER_HXX)
@@ -0,0 +1,205 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "profile.hxx"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#if HAVE_POSIX_GETRUSAGE
+#  include <sys/resource.h>
+#endif
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        using clock_type = std::chrono::steady_clock;
+
+        struct phase_record
+        {
+            double time{};
+            std::size_t count{};
+        };
+
+        struct profile_state
+        {
+            std::atomic<bool> enabled{};
+            std::mutex mutex{};
+            clock_type::time_point start{};
+            std::map<std::string, phase_record, std::less<>> phases{};
+            std::optional<std::pair<std::size_t, std::size_t>> graph{};
+        };
+
+        thread_local bool suspended = false;
+
+        bool read_environment() noexcept
+        {
+            const auto envval = std::getenv("MSC_PROFILE");
+            return (envval != nullptr) && (*envval != '\0') && (std::strcmp(envval, "0") != 0);
+        }
+
+        profile_state& get_state() noexcept
+        {
+            static auto state = [](){
+                auto init = std::make_unique<profile_state>();
+                init->enabled = read_environment();
+                init->start = clock_type::now();
+                return init;
+            }();
+            return *state;
+        }
+
+#if HAVE_POSIX_GETRUSAGE
+        double seconds(const timeval& tv) noexcept
+        {
+            return static_cast<double>(tv.tv_sec) + 1.0E-6 * static_cast<double>(tv.tv_usec);
+        }
+#endif
+
+        json_any get_rusage_info()
+        {
+#if HAVE_POSIX_GETRUSAGE
+            auto usage = rusage{};
+            if (getrusage(RUSAGE_SELF, &usage) == 0) {
+                auto info = json_object{};
+                // POSIX leaves the unit of `ru_maxrss` unspecified; Linux reports kibibytes.
+                info["maxrss"] = json_size{1024 * static_cast<std::size_t>(usage.ru_maxrss)};
+                info["minflt"] = json_size{static_cast<std::size_t>(usage.ru_minflt)};
+                info["majflt"] = json_size{static_cast<std::size_t>(usage.ru_majflt)};
+                info["utime"] = json_real{seconds(usage.ru_utime)};
+                info["stime"] = json_real{seconds(usage.ru_stime)};
+                return info;
+            }
+#endif
+            return json_null{};
+        }
+
+    }  // namespace /*anonymous*/
+
+    bool profiling_enabled() noexcept
+    {
+        return get_state().enabled.load(std::memory_order_relaxed);
+    }
+
+    void reset_profile()
+    {
+        auto& state = get_state();
+        const auto lock = std::lock_guard{state.mutex};
+        state.enabled = read_environment();
+        state.start = clock_type::now();
+        state.phases.clear();
+        state.graph.reset();
+    }
+
+    void note_profile_graph_size(const std::size_t nodes, const std::size_t edges) noexcept
+    {
+        auto& state = get_state();
+        if (state.enabled.load(std::memory_order_relaxed) && !suspended) {
+            const auto lock = std::lock_guard{state.mutex};
+            state.graph = std::make_pair(nodes, edges);
+        }
+    }
+
+    void note_profile_phase(const std::string_view phase, const double seconds) noexcept
+    {
+        auto& state = get_state();
+        if (!state.enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            const auto lock = std::lock_guard{state.mutex};
+            auto pos = state.phases.find(phase);
+            if (pos == state.phases.end()) {
+                pos = state.phases.emplace(std::string{phase}, phase_record{}).first;
+            }
+            pos->second.time += seconds;
+            pos->second.count += 1;
+        } catch (const std::exception& /*e*/) {
+            // Profiling is best-effort and must never make the program fail.
+        }
+    }
+
+    json_object get_profile_info()
+    {
+        auto& state = get_state();
+        const auto lock = std::lock_guard{state.mutex};
+        auto phases = json_object{};
+        for (const auto& [name, record] : state.phases) {
+            auto phase = json_object{};
+            phase["time"] = json_real{record.time};
+            phase["count"] = json_size{record.count};
+            phases[name] = std::move(phase);
+        }
+        auto info = json_object{};
+        info["wall"] = json_real{std::chrono::duration<double>{clock_type::now() - state.start}.count()};
+        info["nodes"] = state.graph ? json_any{json_size{state.graph->first}} : json_any{json_null{}};
+        info["edges"] = state.graph ? json_any{json_size{state.graph->second}} : json_any{json_null{}};
+        info["phases"] = std::move(phases);
+        info["rusage"] = get_rusage_info();
+        return info;
+    }
+
+    profile_timer::profile_timer(const std::string_view phase) noexcept : _phase{phase}
+    {
+        if (profiling_enabled() && !suspended) {
+            _start = clock_type::now();
+            _running = true;
+        }
+    }
+
+    profile_timer::~profile_timer() noexcept
+    {
+        this->stop();
+    }
+
+    void profile_timer::stop() noexcept
+    {
+        if (!_running) {
+            return;
+        }
+        _running = false;
+        note_profile_phase(_phase, std::chrono::duration<double>{clock_type::now() - _start}.count());
+    }
+
+    profile_suspension::profile_suspension() noexcept
+    {
+        assert(!suspended);
+        suspended = true;
+    }
+
+    profile_suspension::~profile_suspension() noexcept
+    {
+        suspended = false;
+    }
+
+}  // namespace msc
@@ -0,0 +1,185 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file profile.hxx
+ *
+ * @brief
+ *     Opt-in instrumentation that records where a tool spends its time and how much memory it uses.
+ *
+ * Profiling is enabled if the environment variable `MSC_PROFILE` is set to a non-empty value other than `0`.  Code
+ * that wants to be accounted for wraps a phase in a `profile_timer` and `print_meta` will then add a `"profile"`
+ * attribute with the accumulated times and the resource usage of the process to the meta data.  When profiling is
+ * disabled, timers don't even read the clock.
+ *
+ */
+
+#ifndef MSC_PROFILE_HXX
+#define MSC_PROFILE_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+#include "json.hxx"
+
+namespace msc
+{
+
+    /**
+     * @brief
+     *     Tells whether profiling is enabled.
+     *
+     * @returns
+     *     whether the environment variable `MSC_PROFILE` was set to a non-empty value other than `0` when the profile
+     *     was last reset
+     *
+     */
+    bool profiling_enabled() noexcept;
+
+    /**
+     * @brief
+     *     Discards all recorded data, re-reads the environment variable `MSC_PROFILE` and restarts the wall clock.
+     *
+     * `command_line_interface` calls this function right before it invokes the application.
+     *
+     */
+    void reset_profile();
+
+    /**
+     * @brief
+     *     Records the size of the graph the tool is working on so profiles can be compared across graph sizes.
+     *
+     * If a tool loads more than one graph, the last one wins.
+     *
+     * @param nodes
+     *     number of nodes
+     *
+     * @param edges
+     *     number of edges
+     *
+     */
+    void note_profile_graph_size(std::size_t nodes, std::size_t edges) noexcept;
+
+    /**
+     * @brief
+     *     Accounts a time that was measured elsewhere to a named phase.
+     *
+     * This is useful if some work was done ahead of time on behalf of the current run (for example by a background
+     * thread inside a `profile_suspension`).
+     *
+     * @param phase
+     *     name of the phase
+     *
+     * @param seconds
+     *     elapsed time in seconds
+     *
+     */
+    void note_profile_phase(std::string_view phase, double seconds) noexcept;
+
+    /**
+     * @brief
+     *     Returns the recorded profile as JSON.
+     *
+     * The result has the attributes `wall` (seconds since the profile was reset), `nodes` and `edges` (as passed to
+     * `note_profile_graph_size` or `null`), `phases` (an object mapping each phase to an object with the accumulated
+     * `time` in seconds and the `count` of timers) and `rusage` (an object with the peak resident set size `maxrss`
+     * in bytes, the number of `minflt` and `majflt` page faults and the `utime` and `stime` CPU time in seconds, or
+     * `null` if this information is not available).  Phases may be nested and times of timers running concurrently
+     * in several threads are summed up.
+     *
+     * @returns
+     *     JSON representation of the profile
+     *
+     */
+    json_object get_profile_info();
+
+    /**
+     * @brief
+     *     Scope guard that accounts the time between its construction and destruction to a named phase.
+     *
+     * Instances are cheap to create if profiling is disabled.
+     *
+     */
+    class profile_timer final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Starts a timer for the given phase.
+         *
+         * @param phase
+         *     name of the phase (must outlive the timer)
+         *
+         */
+        explicit profile_timer(std::string_view phase) noexcept;
+
+        /** @brief Timers cannot be copied.  */
+        profile_timer(const profile_timer&) = delete;
+
+        /** @brief Timers cannot be assigned.  */
+        profile_timer& operator=(const profile_timer&) = delete;
+
+        /** @brief Stops the timer unless it was already stopped explicitly.  */
+        ~profile_timer() noexcept;
+
+        /** @brief Stops the timer and accounts the elapsed time to its phase.  */
+        void stop() noexcept;
+
+    private:
+
+        /** @brief Name of the phase.  */
+        std::string_view _phase{};
+
+        /** @brief Time when the timer was started.  */
+        std::chrono::steady_clock::time_point _start{};
+
+        /** @brief Whether the timer is running.  */
+        bool _running{};
+
+    };  // class profile_timer
+
+    /**
+     * @brief
+     *     Scope guard that stops the current thread from recording anything to the profile.
+     *
+     * While an instance exists, timers started by the same thread and calls to `note_profile_graph_size` from it have
+     * no effect.  Instances cannot be nested.
+     *
+     */
+    class profile_suspension final
+    {
+    public:
+
+        /** @brief Suspends profiling for the current thread.  */
+        profile_suspension() noexcept;
+
+        /** @brief Suspensions cannot be copied.  */
+        profile_suspension(const profile_suspension&) = delete;
+
+        /** @brief Suspensions cannot be assigned.  */
+        profile_suspension& operator=(const profile_suspension&) = delete;
+
+        /** @brief Resumes profiling for the current thread.  */
+        ~profile_suspension() noexcept;
+
+    };  // class profile_suspension
+
+}  // namespace msc
+
+#endif  // !defined(MSC_PROFILE_HXX)
@@ -20,6 +20,7 @@
 
 #include "random.hxx"
 
+#include <cstdint>
 #include <cstdlib>
 #include <random>
 #include <utility>
@@ -42,4 +43,78 @@ namespace msc
 
     }  // namespace detail::random
 
+    namespace /*anonymous*/
+    {
+
+        // Constants from J. K. Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11.
+        constexpr std::uint32_t philox_multipliers[] = {0xD2511F53U, 0xCD9E8D57U};
+        constexpr std::uint32_t philox_weyl_constants[] = {0x9E3779B9U, 0xBB67AE85U};
+
+        // Key for deriving sub-stream identifiers (the first digits of pi) so they don't collide with regular blocks.
+        constexpr std::uint32_t substream_tweak[] = {0x243F6A88U, 0x85A308D3U};
+
+        constexpr std::uint32_t lo32(const std::uint64_t x) noexcept
+        {
+            return static_cast<std::uint32_t>(x);
+        }
+
+        constexpr std::uint32_t hi32(const std::uint64_t x) noexcept
+        {
+            return static_cast<std::uint32_t>(x >> 32);
+        }
+
+    }  // namespace /*anonymous*/
+
+    philox_engine::philox_engine(const std::uint64_t key) noexcept : _key{lo32(key), hi32(key)}
+    {
+    }
+
+    philox_engine philox_engine::substream(const std::uint64_t index) const noexcept
+    {
+        const auto key = std::array<std::uint32_t, 2>{_key[0] ^ substream_tweak[0], _key[1] ^ substream_tweak[1]};
+        const auto block = encrypt({lo32(index), hi32(index), lo32(_stream), hi32(_stream)}, key);
+        auto sub = philox_engine{};
+        sub._key = _key;
+        sub._stream = (std::uint64_t{block[1]} << 32) | block[0];
+        return sub;
+    }
+
+    void philox_engine::discard(unsigned long long count) noexcept
+    {
+        const auto available = _buffer.size() - _index;
+        if (count < available) {
+            _index += count;
+            return;
+        }
+        count -= available;
+        _block += count / _buffer.size();
+        _index = _buffer.size();
+        if (const auto rest = count % _buffer.size(); rest > 0) {
+            _refill();
+            _index = rest;
+        }
+    }
+
+    std::array<std::uint32_t, 4> philox_engine::encrypt(std::array<std::uint32_t, 4> counter,
+                                                        std::array<std::uint32_t, 2> key) noexcept
+    {
+        for (auto round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key[0] += philox_weyl_constants[0];
+                key[1] += philox_weyl_constants[1];
+            }
+            const auto p0 = std::uint64_t{philox_multipliers[0]} * counter[0];
+            const auto p1 = std::uint64_t{philox_multipliers[1]} * counter[2];
+            counter = {hi32(p1) ^ counter[1] ^ key[0], lo32(p1), hi32(p0) ^ counter[3] ^ key[1], lo32(p0)};
+        }
+        return counter;
+    }
+
+    void philox_engine::_refill() noexcept
+    {
+        _buffer = encrypt({lo32(_block), hi32(_block), lo32(_stream), hi32(_stream)}, _key);
+        _block += 1;
+        _index = 0;
+    }
+
 }  // namespace msc
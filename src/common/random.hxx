@@ -25,7 +25,10 @@
 #ifndef MSC_RANDOM_HXX
 #define MSC_RANDOM_HXX
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
 
 namespace msc
@@ -48,6 +51,26 @@ namespace msc
     template <typename EngT>
     std::string seed_random_engine(EngT& engine);
 
+    /**
+     * Seeds any random number engine using an explicitly given seed.
+     *
+     * Seeding an engine via `seed_random_engine(engine)` with the environment variable `MSC_RANDOM_SEED` set to
+     * `seed` has the exact same effect as calling this function.  This can be used to derive independent sub-streams
+     * from a master engine by passing seeds obtained via `random_hex_string`.
+     *
+     * @param engine
+     *     engine to seed
+     *
+     * @param seed
+     *     seed to use
+     *
+     * @returns
+     *     `seed`
+     *
+     */
+    template <typename EngT>
+    std::string seed_random_engine(EngT& engine, std::string seed);
+
     /**
      * @brief
      *     Deterministically returns a string with the requestd number of random bytes encoded in hex.
@@ -72,6 +95,201 @@ namespace msc
     template <typename EngineT>
     std::string random_hex_string(EngineT& engine, const std::size_t bytes = 16);
 
+    /**
+     * @brief
+     *     A counter-based random number engine (Philox4x32-10) that supports deriving independent sub-streams.
+     *
+     * The <var>i</var>-th block of four 32 bit values is obtained by encrypting the 128 bit counter made up of
+     * <var>i</var> and a 64 bit stream identifier with the 64 bit key, so the engine has no state beyond its position.
+     * This makes it cheap to derive any number of independent sub-streams via `substream` that only depend on the
+     * parent stream and the sub-stream's index.  If parallel work on item <var>i</var> draws its random numbers from
+     * `substream(i)` of a master engine that was seeded via `seed_random_engine`, the results are reproducible
+     * regardless of the number of threads or the order in which the items are processed.
+     *
+     * This type satisfies the requirements of a uniform random bit generator and can be used with the distributions
+     * from the standard library.  However, it does not satisfy all requirements of a random number engine.
+     *
+     */
+    class philox_engine final
+    {
+    public:
+
+        /** @brief Type of the generated random numbers.  */
+        using result_type = std::uint32_t;
+
+        /** @brief Constructs an engine with an all-zero key.  */
+        philox_engine() noexcept = default;
+
+        /**
+         * @brief
+         *     Constructs an engine with the given key.
+         *
+         * @param key
+         *     key to use
+         *
+         */
+        explicit philox_engine(std::uint64_t key) noexcept;
+
+        /**
+         * @brief
+         *     Re-seeds the engine from a seed sequence and rewinds it to the beginning of the main stream.
+         *
+         * @tparam SeedSeqT
+         *     seed sequence type
+         *
+         * @param seq
+         *     seed sequence to obtain the key from
+         *
+         */
+        template <typename SeedSeqT>
+        void seed(SeedSeqT& seq);
+
+        /**
+         * @brief
+         *     Returns an engine for the sub-stream with the given index.
+         *
+         * The returned engine is at the beginning of its stream, regardless of how far this engine has advanced.
+         * Sub-streams of sub-streams are independent of the sub-streams of the parent.
+         *
+         * @param index
+         *     index of the sub-stream
+         *
+         * @returns
+         *     sub-stream engine
+         *
+         */
+        philox_engine substream(std::uint64_t index) const noexcept;
+
+        /**
+         * @brief
+         *     Returns the next random number.
+         *
+         * @returns
+         *     random number
+         *
+         */
+        result_type operator()() noexcept
+        {
+            if (_index == _buffer.size()) {
+                _refill();
+            }
+            return _buffer[_index++];
+        }
+
+        /**
+         * @brief
+         *     Advances the engine as if `count` random numbers had been generated.
+         *
+         * @param count
+         *     number of random numbers to skip
+         *
+         */
+        void discard(unsigned long long count) noexcept;
+
+        /**
+         * @brief
+         *     Returns the smallest value that can be generated.
+         *
+         * @returns
+         *     0
+         *
+         */
+        static constexpr result_type min() noexcept
+        {
+            return std::numeric_limits<result_type>::min();
+        }
+
+        /**
+         * @brief
+         *     Returns the largest value that can be generated.
+         *
+         * @returns
+         *     2<sup>32</sup> - 1
+         *
+         */
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        /**
+         * @brief
+         *     Tests whether two engines will produce the same sequence from here on.
+         *
+         * @param lhs
+         *     first engine
+         *
+         * @param rhs
+         *     second engine
+         *
+         * @returns
+         *     whether the engines are equal
+         *
+         */
+        friend bool operator==(const philox_engine& lhs, const philox_engine& rhs) noexcept
+        {
+            return (lhs._key == rhs._key) && (lhs._stream == rhs._stream) && (lhs._block == rhs._block)
+                && (lhs._index == rhs._index);
+        }
+
+        /**
+         * @brief
+         *     Tests whether two engines will produce different sequences from here on.
+         *
+         * @param lhs
+         *     first engine
+         *
+         * @param rhs
+         *     second engine
+         *
+         * @returns
+         *     whether the engines are unequal
+         *
+         */
+        friend bool operator!=(const philox_engine& lhs, const philox_engine& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        /**
+         * @brief
+         *     Applies the Philox4x32-10 bijection to a counter.
+         *
+         * @param counter
+         *     counter to encrypt
+         *
+         * @param key
+         *     key to encrypt with
+         *
+         * @returns
+         *     encrypted counter
+         *
+         */
+        static std::array<std::uint32_t, 4> encrypt(std::array<std::uint32_t, 4> counter,
+                                                    std::array<std::uint32_t, 2> key) noexcept;
+
+    private:
+
+        /** @brief Encrypts the next block into the buffer.  */
+        void _refill() noexcept;
+
+        /** @brief Key of the stream family.  */
+        std::array<std::uint32_t, 2> _key{};
+
+        /** @brief Identifier of the stream.  */
+        std::uint64_t _stream{};
+
+        /** @brief Index of the next block to encrypt.  */
+        std::uint64_t _block{};
+
+        /** @brief Most recently encrypted block.  */
+        std::array<result_type, 4> _buffer{};
+
+        /** @brief Index of the next value in the buffer (the buffer is empty if this is equal to its size).  */
+        std::size_t _index{4};
+
+    };  // class philox_engine
+
 }  // namespace msc
 
 #define MSC_INCLUDED_FROM_RANDOM_HXX
@@ -18,6 +18,7 @@
 #  error "Never `#include <random.txx>` directly; `#include <random.hxx>` instead"
 #endif
 
+#include <iterator>
 #include <random>
 
 namespace msc
@@ -33,7 +34,12 @@ namespace msc
     template <typename EngT>
     std::string seed_random_engine(EngT& engine)
     {
-        const auto seed = detail::random::get_seed_string();
+        return seed_random_engine(engine, detail::random::get_seed_string());
+    }
+
+    template <typename EngT>
+    std::string seed_random_engine(EngT& engine, std::string seed)
+    {
         auto seedseq = std::seed_seq(seed.begin(), seed.end());
         engine.seed(seedseq);
         return seed;
@@ -57,4 +63,13 @@ namespace msc
         return result;
     }
 
+    template <typename SeedSeqT>
+    void philox_engine::seed(SeedSeqT& seq)
+    {
+        seq.generate(std::begin(_key), std::end(_key));
+        _stream = 0;
+        _block = 0;
+        _index = _buffer.size();
+    }
+
 }  // namespace msc
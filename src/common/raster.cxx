@@ -0,0 +1,428 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "raster.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/crc.hpp>
+#include <boost/iostreams/compose.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+
+#include "math_constants.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        namespace io = boost::iostreams;
+
+        // Discs with a smaller radius (in pixels) are splatted instead of rasterized.
+        constexpr double splat_radius = 0.5;
+
+        // Lines that are shorter (in pixels) are splatted instead of rasterized.
+        constexpr double splat_length = 1.0;
+
+        // Maximum distance (in pixels) between a polygon approximating a disc and the actual circle.
+        constexpr double disc_tolerance = 0.125;
+
+        // Pixels with less coverage are left alone because blending would not change them anyway.
+        constexpr double min_coverage = 1.0 / 512.0;
+
+        // Accumulates the coverage of the shapes of one layer.
+        //
+        // Polygon edges are rasterized by adding their signed area contribution to the cells of a row.  Summing up a
+        // row from left to right then yields the exact coverage of each pixel.  (The sums are clamped to 1 so
+        // overlapping shapes merge.)  Edges are clipped to the image horizontally and everything to the left of the
+        // image ends up in the first column, so the sums are still correct.  Each row has two extra cells for the
+        // contributions at the right border.  Splats are accumulated separately as they are no area contributions.
+        class coverage final
+        {
+        public:
+
+            coverage(const std::size_t width, const std::size_t height) :
+                _width{width},
+                _height{height},
+                _cells((width + 2) * height),
+                _splats(width * height),
+                _top{height}
+            {
+            }
+
+            bool overlaps(const point2d& lo, const point2d& hi) const noexcept
+            {
+                return (hi.x() > 0.0) && (hi.y() > 0.0) && (lo.x() < _width) && (lo.y() < _height);
+            }
+
+            void add_edge(const point2d& a, const point2d& b)
+            {
+                const auto right = static_cast<double>(_width);
+                double ts[4] = {0.0, 1.0, 1.0, 1.0};
+                auto count = std::size_t{1};
+                if (a.x() != b.x()) {
+                    for (const auto border : {0.0, right}) {
+                        if (const auto t = (border - a.x()) / (b.x() - a.x()); (t > 0.0) && (t < 1.0)) {
+                            ts[count++] = t;
+                        }
+                    }
+                }
+                std::sort(ts + 1, ts + count);
+                ts[count] = 1.0;
+                for (auto i = std::size_t{}; i < count; ++i) {
+                    const auto p = a + ts[i] * (b - a);
+                    const auto q = a + ts[i + 1] * (b - a);
+                    add_clipped_edge(
+                        std::clamp(p.x(), 0.0, right), p.y(), std::clamp(q.x(), 0.0, right), q.y()
+                    );
+                }
+            }
+
+            void splat(const point2d& p, const double weight)
+            {
+                const auto px = p.x() - 0.5;
+                const auto py = p.y() - 0.5;
+                const auto fx = std::floor(px);
+                const auto fy = std::floor(py);
+                const double wx[2] = {1.0 - (px - fx), px - fx};
+                const double wy[2] = {1.0 - (py - fy), py - fy};
+                for (auto dy = 0; dy < 2; ++dy) {
+                    const auto y = fy + dy;
+                    if ((y < 0.0) || (y >= _height)) {
+                        continue;
+                    }
+                    const auto row = static_cast<std::size_t>(y);
+                    for (auto dx = 0; dx < 2; ++dx) {
+                        const auto x = fx + dx;
+                        if ((x < 0.0) || (x >= _width)) {
+                            continue;
+                        }
+                        _splats[row * _width + static_cast<std::size_t>(x)] += weight * wx[dx] * wy[dy];
+                    }
+                    touch(row, row + 1);
+                }
+            }
+
+            void resolve(raster_image& image, const raster_color color)
+            {
+                const auto stride = _width + 2;
+                for (auto y = _top; y < _bottom; ++y) {
+                    auto acc = 0.0f;
+                    float* cells = _cells.data() + y * stride;
+                    float* splats = _splats.data() + y * _width;
+                    for (auto x = std::size_t{}; x < _width; ++x) {
+                        acc += cells[x];
+                        const auto alpha = std::min(1.0, std::abs(double{acc}) + splats[x]);
+                        if (alpha >= min_coverage) {
+                            image.blend(x, y, color, alpha);
+                        }
+                    }
+                    std::fill(cells, cells + stride, 0.0f);
+                    std::fill(splats, splats + _width, 0.0f);
+                }
+                _top = _height;
+                _bottom = 0;
+            }
+
+        private:
+
+            void touch(const std::size_t first, const std::size_t last) noexcept
+            {
+                _top = std::min(_top, first);
+                _bottom = std::max(_bottom, last);
+            }
+
+            // Expects both x coordinates to be within [0, width].
+            void add_clipped_edge(double x0, double y0, double x1, double y1)
+            {
+                if (y0 == y1) {
+                    return;
+                }
+                auto dir = 1.0;
+                if (y0 > y1) {
+                    std::swap(x0, x1);
+                    std::swap(y0, y1);
+                    dir = -1.0;
+                }
+                if ((y1 <= 0.0) || (y0 >= _height)) {
+                    return;
+                }
+                const auto right = static_cast<double>(_width);
+                const auto dxdy = (x1 - x0) / (y1 - y0);
+                auto x = std::clamp((y0 < 0.0) ? x0 - y0 * dxdy : x0, 0.0, right);
+                const auto first = static_cast<std::size_t>(std::max(0.0, std::floor(y0)));
+                const auto last = std::min(_height, static_cast<std::size_t>(std::ceil(y1)));
+                touch(first, last);
+                for (auto y = first; y < last; ++y) {
+                    float* row = _cells.data() + y * (_width + 2);
+                    const auto dy = std::min(y + 1.0, y1) - std::max(static_cast<double>(y), y0);
+                    const auto xnext = std::clamp(x + dxdy * dy, 0.0, right);
+                    const auto d = dy * dir;
+                    const auto [xa, xb] = std::minmax(x, xnext);
+                    const auto xafloor = std::floor(xa);
+                    const auto xbceil = std::ceil(xb);
+                    const auto ia = static_cast<std::size_t>(xafloor);
+                    const auto ib = static_cast<std::size_t>(xbceil);
+                    if (ib <= ia + 1) {
+                        // The edge stays within one pixel in this row.
+                        const auto xmid = 0.5 * (x + xnext) - xafloor;
+                        row[ia] += d - d * xmid;
+                        row[ia + 1] += d * xmid;
+                    } else {
+                        // The edge spans several pixels; the covered area grows linearly in between.
+                        const auto s = 1.0 / (xb - xa);
+                        const auto fa = xa - xafloor;
+                        const auto fb = xb - xbceil + 1.0;
+                        const auto a0 = 0.5 * s * (1.0 - fa) * (1.0 - fa);
+                        const auto am = 0.5 * s * fb * fb;
+                        row[ia] += d * a0;
+                        if (ib == ia + 2) {
+                            row[ia + 1] += d * (1.0 - a0 - am);
+                        } else {
+                            const auto a1 = s * (1.5 - fa);
+                            row[ia + 1] += d * (a1 - a0);
+                            for (auto i = ia + 2; i < ib - 1; ++i) {
+                                row[i] += d * s;
+                            }
+                            const auto a2 = a1 + (ib - ia - 3) * s;
+                            row[ib - 1] += d * (1.0 - a2 - am);
+                        }
+                        row[ib] += d * am;
+                    }
+                    x = xnext;
+                }
+            }
+
+            std::size_t _width{};
+            std::size_t _height{};
+            std::vector<float> _cells{};
+            std::vector<float> _splats{};
+            std::size_t _top{};
+            std::size_t _bottom{};
+
+        };  // class coverage
+
+        point2d corner_min(const point2d& a, const point2d& b) noexcept
+        {
+            return point2d{std::min(a.x(), b.x()), std::min(a.y(), b.y())};
+        }
+
+        point2d corner_max(const point2d& a, const point2d& b) noexcept
+        {
+            return point2d{std::max(a.x(), b.x()), std::max(a.y(), b.y())};
+        }
+
+        void draw_line(coverage& cov, const point2d& a, const point2d& b, const double stroke)
+        {
+            const auto half = point2d{stroke / 2.0, stroke / 2.0};
+            if (!cov.overlaps(corner_min(a, b) - half, corner_max(a, b) + half)) {
+                return;
+            }
+            const auto delta = b - a;
+            const auto length = abs(delta);
+            if (length < splat_length) {
+                cov.splat(0.5 * (a + b), length * stroke);
+                return;
+            }
+            const auto normal = (stroke / 2.0 / length) * point2d{-delta.y(), delta.x()};
+            cov.add_edge(a + normal, b + normal);
+            cov.add_edge(b + normal, b - normal);
+            cov.add_edge(b - normal, a - normal);
+            cov.add_edge(a - normal, a + normal);
+        }
+
+        void draw_disc(coverage& cov, const point2d& center, const double radius)
+        {
+            const auto extent = point2d{radius, radius};
+            if (!cov.overlaps(center - extent, center + extent)) {
+                return;
+            }
+            if (radius < splat_radius) {
+                cov.splat(center, M_PI * radius * radius);
+                return;
+            }
+            const auto step = 2.0 * std::acos(std::max(0.0, 1.0 - disc_tolerance / radius));
+            const auto corners = std::clamp(static_cast<int>(std::ceil(2.0 * M_PI / step)), 8, 256);
+            // The polygon is enlarged such that its area equals that of the disc.
+            const auto sector = 2.0 * M_PI / corners;
+            const auto outer = radius * std::sqrt(sector / std::sin(sector));
+            auto previous = center + point2d{outer, 0.0};
+            for (auto i = 1; i <= corners; ++i) {
+                const auto phi = sector * i;
+                const auto current = center + outer * point2d{std::cos(phi), std::sin(phi)};
+                cov.add_edge(previous, current);
+                previous = current;
+            }
+        }
+
+        void append_u32(std::string& buffer, const std::uint32_t value)
+        {
+            for (const auto shift : {24, 16, 8, 0}) {
+                buffer.push_back(static_cast<char>((value >> shift) & 0xff));
+            }
+        }
+
+        void append_chunk(std::string& buffer, const char (&type)[5], const std::string& data)
+        {
+            auto crc = boost::crc_32_type{};
+            crc.process_bytes(type, 4);
+            crc.process_bytes(data.data(), data.size());
+            append_u32(buffer, static_cast<std::uint32_t>(data.size()));
+            buffer.append(type, 4);
+            buffer.append(data);
+            append_u32(buffer, crc.checksum());
+        }
+
+    }  // namespace /*anonymous*/
+
+    raster_image::raster_image(const std::size_t width, const std::size_t height) :
+        _width{width}, _height{height}, _pixels(3 * width * height, std::uint8_t{0xff})
+    {
+    }
+
+    raster_color raster_image::get(const std::size_t x, const std::size_t y) const noexcept
+    {
+        assert((x < _width) && (y < _height));
+        const auto pixel = _pixels.data() + 3 * (y * _width + x);
+        return raster_color{pixel[0], pixel[1], pixel[2]};
+    }
+
+    void raster_image::blend(const std::size_t x,
+                             const std::size_t y,
+                             const raster_color color,
+                             const double alpha) noexcept
+    {
+        assert((x < _width) && (y < _height));
+        assert((alpha >= 0.0) && (alpha <= 1.0));
+        const auto mix = [alpha](std::uint8_t& channel, const std::uint8_t value){
+            channel = static_cast<std::uint8_t>(std::lround(channel + alpha * (value - channel)));
+        };
+        const auto pixel = _pixels.data() + 3 * (y * _width + x);
+        mix(pixel[0], color.red);
+        mix(pixel[1], color.green);
+        mix(pixel[2], color.blue);
+    }
+
+    raster_view fit_raster_view(const raster_scene& scene, const std::size_t size)
+    {
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        auto lo = point2d{+inf, +inf};
+        auto hi = point2d{-inf, -inf};
+        const auto include = [&lo, &hi](const point2d& p){
+            lo = corner_min(lo, p);
+            hi = corner_max(hi, p);
+        };
+        for (const auto& layer : scene.layers) {
+            std::for_each(std::begin(layer.discs), std::end(layer.discs), include);
+            for (const auto& [a, b] : layer.lines) {
+                include(a);
+                include(b);
+            }
+        }
+        const auto half = 0.5 * static_cast<double>(size);
+        if (!(lo.x() <= hi.x())) {
+            return raster_view{1.0, point2d{-half, -half}};
+        }
+        const auto margin = std::max(scene.radius, scene.stroke / 2.0);
+        const auto extent = std::max(hi.x() - lo.x(), hi.y() - lo.y()) + 2.0 * margin;
+        const auto scale = (extent > 0.0) ? size / extent : 1.0;
+        return raster_view{scale, scale * (0.5 * (lo + hi)) - point2d{half, half}};
+    }
+
+    raster_view tile_raster_view(const raster_scene& scene,
+                                 const std::size_t tilesize,
+                                 const int level,
+                                 const int x,
+                                 const int y)
+    {
+        assert((level >= 0) && (x >= 0) && (y >= 0) && (x < (1 << level)) && (y < (1 << level)));
+        auto view = fit_raster_view(scene, tilesize << level);
+        view.offset += static_cast<double>(tilesize) * point2d{static_cast<double>(x), static_cast<double>(y)};
+        return view;
+    }
+
+    raster_image render_scene(const raster_scene& scene,
+                              const raster_view& view,
+                              const std::size_t width,
+                              const std::size_t height)
+    {
+        auto image = raster_image{width, height};
+        auto cov = coverage{width, height};
+        const auto project = [&view](const point2d& p){ return view.scale * p - view.offset; };
+        const auto stroke = view.scale * scene.stroke;
+        const auto radius = view.scale * scene.radius;
+        for (const auto& layer : scene.layers) {
+            if (layer.lines.empty() || !(stroke > 0.0)) {
+                continue;
+            }
+            for (const auto& [a, b] : layer.lines) {
+                draw_line(cov, project(a), project(b), stroke);
+            }
+            cov.resolve(image, layer.color);
+        }
+        for (const auto& layer : scene.layers) {
+            if (layer.discs.empty() || !(radius > 0.0)) {
+                continue;
+            }
+            for (const auto& center : layer.discs) {
+                draw_disc(cov, project(center), radius);
+            }
+            cov.resolve(image, layer.color);
+        }
+        return image;
+    }
+
+    std::string encode_png(const raster_image& image)
+    {
+        if ((image.width() == 0) || (image.height() == 0)) {
+            throw std::invalid_argument{"Cannot encode an empty image as PNG"};
+        }
+        const auto rowsize = 3 * image.width();
+        auto raw = std::string{};
+        raw.reserve((rowsize + 1) * image.height());
+        for (auto y = std::size_t{}; y < image.height(); ++y) {
+            const auto row = image.data().data() + y * rowsize;
+            raw.push_back('\0');  // filter type "none"
+            raw.append(reinterpret_cast<const char*>(row), rowsize);
+        }
+        auto compressed = std::string{};
+        io::copy(io::array_source{raw.data(), raw.size()},
+                 io::compose(io::zlib_compressor{}, io::back_inserter(compressed)));
+        auto header = std::string{};
+        append_u32(header, static_cast<std::uint32_t>(image.width()));
+        append_u32(header, static_cast<std::uint32_t>(image.height()));
+        header.append({'\x08', '\x02', '\x00', '\x00', '\x00'});  // 8 bit RGB, no interlacing
+        auto png = std::string{"\x89PNG\r\n\x1a\n", 8};
+        append_chunk(png, "IHDR", header);
+        append_chunk(png, "IDAT", compressed);
+        append_chunk(png, "IEND", std::string{});
+        return png;
+    }
+
+}  // namespace msc
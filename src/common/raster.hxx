@@ -0,0 +1,340 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file raster.hxx
+ *
+ * @brief
+ *     Anti-aliased rendering of simple node-link drawings into RGB images and PNG encoding.
+ *
+ * A scene consists of layers of discs (nodes) and straight lines (edges) of uniform size.  Shapes are converted to
+ * polygons whose exact pixel coverage is accumulated by a scanline rasterizer.  The coverage of all shapes of a layer
+ * is summed up before it is blended into the image, so shapes that meet at a pixel boundary show no seams.  The
+ * renderer adapts the level of detail to the scale: shapes outside the image are culled and discs or lines that are
+ * smaller than a pixel are splatted as weighted points instead of being rasterized.
+ *
+ */
+
+#ifndef MSC_RASTER_HXX
+#define MSC_RASTER_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "point.hxx"
+
+namespace msc
+{
+
+    /** @brief Color of a pixel with 8 bits per channel.  */
+    struct raster_color
+    {
+        /** @brief Red channel.  */
+        std::uint8_t red{};
+
+        /** @brief Green channel.  */
+        std::uint8_t green{};
+
+        /** @brief Blue channel.  */
+        std::uint8_t blue{};
+    };
+
+    /**
+     * @brief
+     *     Compares two colors for equality.
+     *
+     * @param lhs
+     *     first color
+     *
+     * @param rhs
+     *     second color
+     *
+     * @returns
+     *     whether all channels are equal
+     *
+     */
+    constexpr bool operator==(const raster_color& lhs, const raster_color& rhs) noexcept
+    {
+        return (lhs.red == rhs.red) && (lhs.green == rhs.green) && (lhs.blue == rhs.blue);
+    }
+
+    /**
+     * @brief
+     *     Compares two colors for inequality.
+     *
+     * @param lhs
+     *     first color
+     *
+     * @param rhs
+     *     second color
+     *
+     * @returns
+     *     whether any channel differs
+     *
+     */
+    constexpr bool operator!=(const raster_color& lhs, const raster_color& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief
+     *     An RGB image that is stored row by row from top to bottom.
+     *
+     */
+    class raster_image final
+    {
+    public:
+
+        /**
+         * @brief
+         *     Creates a white image of the given size.
+         *
+         * @param width
+         *     width in pixels
+         *
+         * @param height
+         *     height in pixels
+         *
+         */
+        raster_image(std::size_t width, std::size_t height);
+
+        /**
+         * @brief
+         *     Returns the width of the image.
+         *
+         * @returns
+         *     width in pixels
+         *
+         */
+        std::size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        /**
+         * @brief
+         *     Returns the height of the image.
+         *
+         * @returns
+         *     height in pixels
+         *
+         */
+        std::size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        /**
+         * @brief
+         *     Returns the color of a pixel.
+         *
+         * @param x
+         *     column (must be less than the width)
+         *
+         * @param y
+         *     row (must be less than the height)
+         *
+         * @returns
+         *     color of the pixel
+         *
+         */
+        raster_color get(std::size_t x, std::size_t y) const noexcept;
+
+        /**
+         * @brief
+         *     Blends a color into a pixel.
+         *
+         * @param x
+         *     column (must be less than the width)
+         *
+         * @param y
+         *     row (must be less than the height)
+         *
+         * @param color
+         *     color to blend in
+         *
+         * @param alpha
+         *     opacity of `color` between 0 and 1
+         *
+         */
+        void blend(std::size_t x, std::size_t y, raster_color color, double alpha) noexcept;
+
+        /**
+         * @brief
+         *     Returns the raw pixel data.
+         *
+         * @returns
+         *     three bytes (red, green, blue) per pixel, row by row from top to bottom
+         *
+         */
+        const std::vector<std::uint8_t>& data() const noexcept
+        {
+            return _pixels;
+        }
+
+    private:
+
+        /** @brief Width in pixels.  */
+        std::size_t _width{};
+
+        /** @brief Height in pixels.  */
+        std::size_t _height{};
+
+        /** @brief Pixel data.  */
+        std::vector<std::uint8_t> _pixels{};
+
+    };  // class raster_image
+
+    /**
+     * @brief
+     *     Shapes that are drawn in the same color.
+     *
+     */
+    struct raster_layer
+    {
+        /** @brief Color of all shapes.  */
+        raster_color color{};
+
+        /** @brief Centers of discs.  */
+        std::vector<point2d> discs{};
+
+        /** @brief End-points of lines.  */
+        std::vector<std::pair<point2d, point2d>> lines{};
+    };
+
+    /**
+     * @brief
+     *     A drawing in world coordinates.
+     *
+     * All lines of all layers are drawn first (in the order of the layers) and all discs thereafter.  The world
+     * coordinate system has its <var>y</var> axis pointing downwards, like the image.
+     *
+     */
+    struct raster_scene
+    {
+        /** @brief Layers to draw.  */
+        std::vector<raster_layer> layers{};
+
+        /** @brief Radius of discs.  */
+        double radius{};
+
+        /** @brief Width of lines.  */
+        double stroke{};
+    };
+
+    /**
+     * @brief
+     *     Mapping from world coordinates to pixel coordinates.
+     *
+     * A point <var>p</var> is mapped to the pixel coordinates `scale * p - offset`.
+     *
+     */
+    struct raster_view
+    {
+        /** @brief Pixels per world unit.  */
+        double scale{1.0};
+
+        /** @brief Pixel coordinates of the world origin, negated.  */
+        point2d offset{};
+    };
+
+    /**
+     * @brief
+     *     Computes a view that fits the whole scene centered into a square image.
+     *
+     * @param scene
+     *     scene to fit
+     *
+     * @param size
+     *     width and height of the image in pixels
+     *
+     * @returns
+     *     view that maps the scene to the image
+     *
+     */
+    raster_view fit_raster_view(const raster_scene& scene, std::size_t size);
+
+    /**
+     * @brief
+     *     Computes the view for a tile of a tile pyramid.
+     *
+     * Level <var>k</var> of the pyramid consists of 2<sup><var>k</var></sup> &times; 2<sup><var>k</var></sup> tiles
+     * that together show the same image as `fit_raster_view(scene, tilesize << level)`.
+     *
+     * @param scene
+     *     scene to fit
+     *
+     * @param tilesize
+     *     width and height of a tile in pixels
+     *
+     * @param level
+     *     zoom level
+     *
+     * @param x
+     *     column of the tile (must be less than 2<sup>`level`</sup>)
+     *
+     * @param y
+     *     row of the tile (must be less than 2<sup>`level`</sup>)
+     *
+     * @returns
+     *     view that maps the scene to the tile
+     *
+     */
+    raster_view tile_raster_view(const raster_scene& scene, std::size_t tilesize, int level, int x, int y);
+
+    /**
+     * @brief
+     *     Renders a scene into a white image.
+     *
+     * @param scene
+     *     scene to render
+     *
+     * @param view
+     *     mapping from world to pixel coordinates
+     *
+     * @param width
+     *     width of the image in pixels
+     *
+     * @param height
+     *     height of the image in pixels
+     *
+     * @returns
+     *     rendered image
+     *
+     */
+    raster_image render_scene(const raster_scene& scene, const raster_view& view, std::size_t width, std::size_t height);
+
+    /**
+     * @brief
+     *     Encodes an image as a PNG file.
+     *
+     * @param image
+     *     image to encode
+     *
+     * @returns
+     *     binary contents of the PNG file
+     *
+     */
+    std::string encode_png(const raster_image& image);
+
+}  // namespace msc
+
+#endif  // !defined(MSC_RASTER_HXX)
@@ -19,3 +19,63 @@
 #endif
 
 #include "rdf.hxx"
+
+#include <algorithm>
+#include <limits>
+
+#include <ogdf/basic/Graph.h>
+
+namespace msc
+{
+
+    std::optional<vicinity_sample>
+    get_vicinity_sample(const ogdf::GraphAttributes& attrs, const double vicinity, const std::size_t capacity)
+    {
+        constexpr auto unreached = std::numeric_limits<std::size_t>::max();
+        const auto& graph = attrs.constGraph();
+        const auto distance = node_distance{attrs};
+        auto hops = std::vector<std::size_t>(static_cast<std::size_t>(graph.maxNodeIndex() + 1), unreached);
+        const auto hops_of = [&hops](const ogdf::node v) -> std::size_t& {
+            return hops[static_cast<std::size_t>(v->index())];
+        };
+        auto queue = std::vector<ogdf::node>{};
+        auto longest = std::size_t{};
+        auto sample = vicinity_sample{};
+        sample.complete = true;
+        for (const auto source : graph.nodes) {
+            queue.clear();
+            queue.push_back(source);
+            hops_of(source) = 0;
+            for (auto head = std::size_t{}; head < queue.size(); ++head) {
+                const auto v = queue[head];
+                const auto next = hops_of(v) + 1;
+                for (const auto adj : v->adjEntries) {
+                    const auto w = adj->twinNode();
+                    if (hops_of(w) != unreached) {
+                        continue;
+                    }
+                    if (!(static_cast<double>(next) <= vicinity)) {
+                        // There is a node beyond the vicinity so the search is cut short.
+                        sample.complete = false;
+                        continue;
+                    }
+                    hops_of(w) = next;
+                    queue.push_back(w);
+                }
+            }
+            longest = std::max(longest, hops_of(queue.back()));
+            for (const auto v : queue) {
+                if (v->index() > source->index()) {
+                    sample.distances.push_back(distance(source, v));
+                }
+                hops_of(v) = unreached;
+            }
+            if (sample.distances.size() > capacity) {
+                return std::nullopt;
+            }
+        }
+        sample.longest = static_cast<double>(longest);
+        return sample;
+    }
+
+}  // namespace msc
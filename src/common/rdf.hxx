@@ -28,6 +28,10 @@
 #ifndef MSC_RDF_HXX
 #define MSC_RDF_HXX
 
+#include <cstddef>
+#include <optional>
+#include <vector>
+
 #include <ogdf/basic/GraphAttributes.h>
 
 #include "pairwise.hxx"
@@ -181,7 +185,7 @@ namespace msc
          *
          */
         local_pairwise_distances(const ogdf::GraphAttributes& attrs,
-                                 const ogdf_node_array_2d<double>& matrix,
+                                 const distance_matrix& matrix,
                                  const double limit) noexcept
             : _attrs{&attrs}, _matrix{&matrix}, _limit{limit}
         {
@@ -199,7 +203,7 @@ namespace msc
         {
             const auto pred = threshold_node_pair_predicate<double>{*_matrix, _limit};
             const auto proj = node_distance{*_attrs};
-            return iterator{_attrs->constGraph(), pred, proj};
+            return iterator{*_matrix, pred, proj};
         }
 
         /**
@@ -247,13 +251,65 @@ namespace msc
         const ogdf::GraphAttributes* _attrs{};
 
         /** @brief Referenced shortest path matrix.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        const distance_matrix* _matrix{};
 
         /** @brief Longest shortest path to accept.  */
         double _limit{};
 
     };  // class local_pairwise_distances
 
+    /**
+     * @brief
+     *     Euclidian distances between the pairs of nodes that are within a given vicinity of each other.
+     *
+     */
+    struct vicinity_sample
+    {
+
+        /** @brief Euclidian distances of all unordered pairs of distinct nodes within the vicinity.  */
+        std::vector<double> distances{};
+
+        /** @brief Largest graph-theoretical distance between any of the pairs.  */
+        double longest{};
+
+        /**
+         * @brief
+         *     Whether the vicinity was at least the eccentricity of every node.
+         *
+         * If this is `true`, the sample contains all pairs of nodes in the same component and `longest` is the
+         * diameter of the graph.
+         *
+         */
+        bool complete{};
+
+    };
+
+    /**
+     * @brief
+     *     Collects the Euclidian distances between all pairs of nodes for which the shortest path does not exceed the
+     *     given vicinity.
+     *
+     * The pairs are found by a breadth-first search from every node that stops at the given depth.  This needs time
+     * and memory proportional to the number of pairs within the vicinity, which is much less than the number of all
+     * pairs if the vicinity is small and the graph sparse.  The sample contains the same values as a
+     * `local_pairwise_distances` range with the same limit (although maybe in a different order).
+     *
+     * @param attrs
+     *     layout to view the distances in
+     *
+     * @param vicinity
+     *     longest shortest path to accept
+     *
+     * @param capacity
+     *     maximum number of pairs to collect
+     *
+     * @returns
+     *     sample or `std::nullopt` if there are more than `capacity` pairs within the vicinity
+     *
+     */
+    std::optional<vicinity_sample>
+    get_vicinity_sample(const ogdf::GraphAttributes& attrs, double vicinity, std::size_t capacity);
+
 }  // namespace msc
 
 #define MSC_INCLUDED_FROM_RDF_HXX
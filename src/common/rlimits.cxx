@@ -24,8 +24,10 @@
 #include <cctype>
 #include <cerrno>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <map>
 #include <optional>
 #include <stdexcept>
@@ -40,6 +42,10 @@
 #  define RESOURCE_CONSTANT_DICT_ENTRY(RES)  {#RES, -1}
 #endif
 
+#if HAVE_POSIX_SYSCONF
+#  include <unistd.h>
+#endif
+
 #ifdef RLIM_INFINITY
 #  define RESOURCE_CONSTANT_UNLIMITED RLIM_INFINITY
 #else
@@ -122,6 +128,48 @@ namespace msc
 #endif
         }
 
+        std::optional<limit_type> get_soft_limit([[maybe_unused]] const std::string_view resname)
+        {
+#if HAVE_POSIX_GETRLIMIT && HAVE_POSIX_SETRLIMIT
+            auto spec = rlimit{};
+            if ((getrlimit(lookup_resource(resname), &spec) == 0) && (spec.rlim_cur != RLIM_INFINITY)) {
+                return spec.rlim_cur;
+            }
+#endif
+            return std::nullopt;
+        }
+
+        limit_type get_page_size() noexcept
+        {
+#if HAVE_POSIX_SYSCONF
+            if (const auto size = sysconf(_SC_PAGESIZE); size > 0) {
+                return static_cast<limit_type>(size);
+            }
+#endif
+            return 4096;
+        }
+
+        std::optional<limit_type> get_physical_memory() noexcept
+        {
+#if HAVE_POSIX_SYSCONF && HAVE_LINUX_SC_PHYS_PAGES
+            if (const auto pages = sysconf(_SC_PHYS_PAGES); pages > 0) {
+                return static_cast<limit_type>(pages) * get_page_size();
+            }
+#endif
+            return std::nullopt;
+        }
+
+        limit_type get_virtual_memory_size()
+        {
+            // The first field of this pseudo-file is the total program size in pages.
+            auto istr = std::ifstream{"/proc/self/statm"};
+            auto pages = limit_type{};
+            if (istr >> pages) {
+                return pages * get_page_size();
+            }
+            return 0;
+        }
+
     }  // namespace /*anonymous*/
 
     void set_resource_limits()
@@ -139,4 +187,20 @@ namespace msc
         }
     }
 
+    std::optional<std::size_t> get_memory_budget()
+    {
+        auto budget = get_physical_memory();
+        const auto used = get_virtual_memory_size();
+        for (const auto res : {"AS", "DATA"}) {
+            if (const auto limit = get_soft_limit(res)) {
+                const auto available = (*limit > used) ? (*limit - used) : limit_type{0};
+                budget = std::min(budget.value_or(available), available);
+            }
+        }
+        if (budget) {
+            return static_cast<std::size_t>(std::min<limit_type>(*budget, SIZE_MAX));
+        }
+        return std::nullopt;
+    }
+
 }  // namespace msc
@@ -27,6 +27,9 @@
 #ifndef MSC_RLIMITS_HXX
 #define MSC_RLIMITS_HXX
 
+#include <cstddef>
+#include <optional>
+
 namespace msc
 {
 
@@ -60,6 +63,28 @@ namespace msc
      */
     void set_resource_limits();
 
+    /**
+     * @brief
+     *     Estimates how many more bytes of memory the process can allocate.
+     *
+     * The estimate is the smallest of the following quantities (as far as they can be determined on the current
+     * system).
+     *
+     *  - The soft limit for the address space (`RLIMIT_AS`) minus the current virtual memory size of the process.
+     *  - The soft limit for the data segment (`RLIMIT_DATA`) minus the current virtual memory size of the process.
+     *  - The amount of physical memory installed in the machine.
+     *
+     * The current virtual memory size is only available on Linux (via `/proc/self/statm`) and assumed to be zero
+     * elsewhere.  This function is meant for planning algorithms with large memory requirements (see
+     * `plan_pairwise_distances`) and should be called after `set_resource_limits` so the limits requested by the user
+     * are in effect.
+     *
+     * @returns
+     *     number of bytes that can still be allocated or `std::nullopt` if nothing is known
+     *
+     */
+    std::optional<std::size_t> get_memory_budget();
+
 }  // namespace msc
 
 #endif  // !defined(MSC_RLIMITS_HXX)
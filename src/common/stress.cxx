@@ -22,12 +22,17 @@
 
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+#include <ogdf/basic/Graph.h>
+
 #include "normalizer.hxx"
+#include "point.hxx"
 #include "useful.hxx"
 
 namespace msc
@@ -137,22 +142,48 @@ namespace msc
             return result;
         }
 
+        double get_euclidian_distance(const ogdf::GraphAttributes& attrs, const ogdf::node v1, const ogdf::node v2)
+        {
+            const auto p1 = point2d{attrs.x(v1), attrs.y(v1)};
+            const auto p2 = point2d{attrs.x(v2), attrs.y(v2)};
+            return distance(p1, p2);
+        }
+
+        void add_stress_term(stress_moments& moments, const double euclid, const double hops) noexcept
+        {
+            const auto ratio = euclid / hops;
+            moments.count += 1.0;
+            moments.linear += ratio;
+            moments.quadratic += square(ratio);
+        }
+
+        parabola_result get_vertex(const double a, const double b, const double c) noexcept
+        {
+            auto result = parabola_result{};
+            result.a = a;
+            result.b = b;
+            result.c = c;
+            result.x0 = -0.5 * b / c;
+            result.y0 = a - 0.25 * square(b) / c;
+            return result;
+        }
+
     }  // namespace /*anonymous*/
 
-    double compute_stress(const ogdf::GraphAttributes& attrs, const double nodesep)
+    double compute_stress(const ogdf::GraphAttributes& attrs, const double nodesep, const strategies strategy)
     {
-        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph());
+        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph(), strategy);
         const auto infty = attrs.constGraph().numberOfNodes() + 1.0;
         const auto terms = pairwise_stress{attrs, *matrix, nodesep, infty};
         return std::accumulate(std::begin(terms), std::end(terms), 0.0);
     }
 
-    parabola_result compute_stress_fit_nodesep(const ogdf::GraphAttributes& attrs)
+    parabola_result compute_stress_fit_nodesep(const ogdf::GraphAttributes& attrs, const strategies strategy)
     {
         if (attrs.constGraph().numberOfEdges() < 1) {
             return get_default_answer();
         }
-        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph());
+        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph(), strategy);
         const auto infty = attrs.constGraph().numberOfNodes() + 1.0;
         const auto computer = [ap = &attrs, mp = matrix.get(), infty](const double nodesep){
             const auto terms = pairwise_stress{*ap, *mp, nodesep, infty};
@@ -169,12 +200,12 @@ namespace msc
         return result;
     }
 
-    parabola_result compute_stress_fit_scale(const ogdf::GraphAttributes& attrs)
+    parabola_result compute_stress_fit_scale(const ogdf::GraphAttributes& attrs, const strategies strategy)
     {
         if (attrs.constGraph().numberOfEdges() < 1) {
             return get_default_answer();
         }
-        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph());
+        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph(), strategy);
         const auto infty = attrs.constGraph().numberOfNodes() + 1.0;
         const auto computer = [ap = &attrs, mp = matrix.get(), infty](const double scale){
             const auto acopy = std::make_unique<ogdf::GraphAttributes>(*ap);
@@ -189,6 +220,92 @@ namespace msc
         return result;
     }
 
+    stress_moments compute_stress_moments(const ogdf::GraphAttributes& attrs, const strategies strategy)
+    {
+        const auto matrix = get_pairwise_shortest_paths(attrs.constGraph(), strategy);
+        auto moments = stress_moments{};
+        for (auto v1 = matrix->first_node(); v1 != nullptr; v1 = matrix->next_node(v1)) {
+            for (auto v2 = matrix->first_partner(v1); v2 != nullptr; v2 = matrix->next_partner(v1, v2)) {
+                add_stress_term(moments, get_euclidian_distance(attrs, v1, v2), (*matrix)(v1, v2));
+            }
+        }
+        return moments;
+    }
+
+    stress_moments update_stress_moments(const stress_moments& moments,
+                                         const ogdf::GraphAttributes& before,
+                                         const ogdf::GraphAttributes& after,
+                                         const std::vector<ogdf::node>& moved,
+                                         const double scale)
+    {
+        constexpr auto unreached = std::numeric_limits<std::size_t>::max();
+        const auto& graph = after.constGraph();
+        const auto slots = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+        auto hops = std::vector<std::size_t>(slots, unreached);
+        auto ismoved = std::vector<bool>(slots, false);
+        for (const auto v : moved) {
+            ismoved[static_cast<std::size_t>(v->index())] = true;
+        }
+        // The terms of the pairs that involve a moved node are removed in the coordinates of the original layout
+        // before all remaining terms are scaled and the terms are added back in the coordinates of the derived layout.
+        auto removed = stress_moments{};
+        auto added = stress_moments{};
+        auto queue = std::vector<ogdf::node>{};
+        for (const auto source : moved) {
+            queue.clear();
+            queue.push_back(source);
+            hops[static_cast<std::size_t>(source->index())] = 0;
+            for (auto head = std::size_t{}; head < queue.size(); ++head) {
+                const auto v = queue[head];
+                const auto next = hops[static_cast<std::size_t>(v->index())] + 1;
+                for (const auto adj : v->adjEntries) {
+                    const auto w = adj->twinNode();
+                    if (hops[static_cast<std::size_t>(w->index())] == unreached) {
+                        hops[static_cast<std::size_t>(w->index())] = next;
+                        queue.push_back(w);
+                    }
+                }
+            }
+            for (const auto v : queue) {
+                const auto slot = static_cast<std::size_t>(v->index());
+                // Pairs of two moved nodes are only visited from the one with the smaller index.
+                if ((v != source) && (!ismoved[slot] || (v->index() > source->index()))) {
+                    const auto spl = static_cast<double>(hops[slot]);
+                    add_stress_term(removed, get_euclidian_distance(before, source, v), spl);
+                    add_stress_term(added, get_euclidian_distance(after, source, v), spl);
+                }
+                hops[slot] = unreached;
+            }
+        }
+        auto result = stress_moments{};
+        result.count = moments.count - removed.count + added.count;
+        result.linear = scale * (moments.linear - removed.linear) + added.linear;
+        result.quadratic = square(scale) * (moments.quadratic - removed.quadratic) + added.quadratic;
+        return result;
+    }
+
+    double get_stress(const stress_moments& moments, const double nodesep) noexcept
+    {
+        return moments.quadratic - 2.0 * nodesep * moments.linear + square(nodesep) * moments.count;
+    }
+
+    parabola_result get_stress_fit_nodesep(const stress_moments& moments) noexcept
+    {
+        if (!(moments.count > 0.0)) {
+            return get_default_answer();
+        }
+        return get_vertex(moments.quadratic, -2.0 * moments.linear, moments.count);
+    }
+
+    parabola_result get_stress_fit_scale(const stress_moments& moments) noexcept
+    {
+        if (!(moments.count > 0.0)) {
+            return get_default_answer();
+        }
+        const auto nodesep = default_node_distance;
+        return get_vertex(square(nodesep) * moments.count, -2.0 * nodesep * moments.linear, moments.quadratic);
+    }
+
     std::ostream& operator<<(std::ostream& ostr, const parabola_result& pr)
     {
         const auto sign = [](const auto x){ return (x < 0) ? '-' : '+'; };
@@ -30,6 +30,7 @@
 
 #include <iosfwd>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/GraphAttributes.h>
 
@@ -88,11 +89,16 @@ namespace msc
      * @param nodesep
      *     desired node separation
      *
+     * @param strategy
+     *     storage strategy for the pairwise distances (`strategies::full` or `strategies::compact`)
+     *
      * @returns
      *     stress for the specified node distance
      *
      */
-    double compute_stress(const ogdf::GraphAttributes& attrs, double nodesep = default_node_distance);
+    double compute_stress(const ogdf::GraphAttributes& attrs,
+                          double nodesep = default_node_distance,
+                          strategies strategy = strategies::full);
 
     /**
      * @brief
@@ -103,11 +109,15 @@ namespace msc
      * @param attrs
      *     normalized layout to compute the minmal stress for
      *
+     * @param strategy
+     *     storage strategy for the pairwise distances (`strategies::full` or `strategies::compact`)
+     *
      * @returns
      *     fitted parabola (the `y0` member contains the stress value at node distance `x0`)
      *
      */
-    parabola_result compute_stress_fit_nodesep(const ogdf::GraphAttributes& attrs);
+    parabola_result compute_stress_fit_nodesep(const ogdf::GraphAttributes& attrs,
+                                               strategies strategy = strategies::full);
 
     /**
      * @brief
@@ -118,11 +128,138 @@ namespace msc
      * @param attrs
      *     normalized layout to compute the minmal stress for
      *
+     * @param strategy
+     *     storage strategy for the pairwise distances (`strategies::full` or `strategies::compact`)
+     *
      * @returns
      *     fitted parabola (the `y0` member contains the stress value at scale `x0`)
      *
      */
-    parabola_result compute_stress_fit_scale(const ogdf::GraphAttributes& attrs);
+    parabola_result compute_stress_fit_scale(const ogdf::GraphAttributes& attrs,
+                                             strategies strategy = strategies::full);
+
+    /**
+     * @brief
+     *     Sums over all pairs of connected nodes that determine the stress of a layout for any node separation.
+     *
+     * With <var>e</var> the Euclidian and <var>d</var> the graph-theoretical distance between two nodes, the stress
+     * for node separation <var>&sigma;</var> is `quadratic - 2 * sigma * linear + sigma * sigma * count`.  Unlike the
+     * stress itself, the moments can be updated cheaply if only a few nodes of a layout move (see
+     * `update_stress_moments`).
+     *
+     */
+    struct stress_moments
+    {
+        /** @brief Number of pairs of connected nodes.  */
+        double count{};
+
+        /** @brief Sum of <var>e</var> / <var>d</var> over all pairs.  */
+        double linear{};
+
+        /** @brief Sum of (<var>e</var> / <var>d</var>)<sup>2</sup> over all pairs.  */
+        double quadratic{};
+    };
+
+    /**
+     * @brief
+     *     Computes the stress moments of a layout.
+     *
+     * @param attrs
+     *     layout to compute the moments for
+     *
+     * @param strategy
+     *     storage strategy for the pairwise distances (`strategies::full`, `strategies::compact` or
+     *     `strategies::external`)
+     *
+     * @returns
+     *     stress moments
+     *
+     */
+    stress_moments compute_stress_moments(const ogdf::GraphAttributes& attrs, strategies strategy = strategies::full);
+
+    /**
+     * @brief
+     *     Derives the stress moments of a layout from those of a layout it was obtained from by moving some nodes.
+     *
+     * Apart from the nodes in `moved`, `after` must be congruent to `before` scaled by `scale`.  Only the terms for
+     * pairs that involve a moved node are recomputed, which needs a breadth-first search from each moved node.  This
+     * takes time proportional to the number of moved nodes times the size of the graph.
+     *
+     * The behavior is undefined if `before` and `after` are not layouts of the same graph or if `moved` contains
+     * duplicates.
+     *
+     * @param moments
+     *     stress moments of `before`
+     *
+     * @param before
+     *     original layout
+     *
+     * @param after
+     *     derived layout
+     *
+     * @param moved
+     *     nodes that (may) have moved
+     *
+     * @param scale
+     *     factor by which the distances between nodes that did not move were scaled
+     *
+     * @returns
+     *     stress moments of `after`
+     *
+     */
+    stress_moments update_stress_moments(const stress_moments& moments,
+                                         const ogdf::GraphAttributes& before,
+                                         const ogdf::GraphAttributes& after,
+                                         const std::vector<ogdf::node>& moved,
+                                         double scale);
+
+    /**
+     * @brief
+     *     Returns the stress for a given node separation.
+     *
+     * @param moments
+     *     stress moments of the layout
+     *
+     * @param nodesep
+     *     desired node separation
+     *
+     * @returns
+     *     stress for the specified node distance
+     *
+     */
+    double get_stress(const stress_moments& moments, double nodesep = default_node_distance) noexcept;
+
+    /**
+     * @brief
+     *     Returns the stress for the node separation that minimizes it.
+     *
+     * The stress is an exact quadratic function of the node distance so the returned parabola agrees with the one
+     * fitted by `compute_stress_fit_nodesep` up to rounding errors.
+     *
+     * @param moments
+     *     stress moments of the layout
+     *
+     * @returns
+     *     parabola (the `y0` member contains the stress value at node distance `x0`)
+     *
+     */
+    parabola_result get_stress_fit_nodesep(const stress_moments& moments) noexcept;
+
+    /**
+     * @brief
+     *     Returns the stress for the scaling of the layout that minimizes it for the default node separation.
+     *
+     * The stress is an exact quadratic function of the scale so the returned parabola agrees with the one fitted by
+     * `compute_stress_fit_scale` up to rounding errors.
+     *
+     * @param moments
+     *     stress moments of the layout
+     *
+     * @returns
+     *     parabola (the `y0` member contains the stress value at scale `x0`)
+     *
+     */
+    parabola_result get_stress_fit_scale(const stress_moments& moments) noexcept;
 
     /**
      * @brief
@@ -159,7 +296,7 @@ namespace msc
          *
          */
         node_stress(const ogdf::GraphAttributes& attrs,
-                    const ogdf_node_array_2d<double>& matrix,
+                    const distance_matrix& matrix,
                     const double nodesep) noexcept
             : _attrs{&attrs}, _matrix{&matrix}, _nodesep{nodesep}
         {
@@ -188,7 +325,7 @@ namespace msc
         const ogdf::GraphAttributes* _attrs{};
 
         /** @brief Referenced shortest path matrix.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        const distance_matrix* _matrix{};
 
         /** @brief Desired node separation.  */
         double _nodesep{};
@@ -229,7 +366,7 @@ namespace msc
          *
          */
         pairwise_stress(const ogdf::GraphAttributes& attrs,
-                        const ogdf_node_array_2d<double>& matrix,
+                        const distance_matrix& matrix,
                         const double nodesep,
                         const double infinity) noexcept
             : _attrs{&attrs}, _matrix{&matrix}, _nodesep{nodesep}, _infty{infinity}
@@ -248,7 +385,7 @@ namespace msc
         {
             const auto pred = threshold_node_pair_predicate<double>{*_matrix, _infty};
             const auto proj = node_stress{*_attrs, *_matrix, _nodesep};
-            return iterator{_attrs->constGraph(), pred, proj};
+            return iterator{*_matrix, pred, proj};
         }
 
         /**
@@ -270,7 +407,7 @@ namespace msc
         const ogdf::GraphAttributes* _attrs{};
 
         /** @brief Referenced shortest path matrix.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        const distance_matrix* _matrix{};
 
         /** @brief Desired node separation.  */
         double _nodesep{};
@@ -28,7 +28,7 @@ namespace msc
         const auto p1 = point2d{_attrs->x(v1), _attrs->y(v1)};
         const auto p2 = point2d{_attrs->x(v2), _attrs->y(v2)};
         const auto dist = distance(p1, p2);
-        const auto spl = (*_matrix)[v1][v2];
+        const auto spl = (*_matrix)(v1, v2);
         return square((dist - _nodesep * spl) / spl);
     }
 
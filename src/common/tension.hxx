@@ -67,7 +67,7 @@ namespace msc
          *     shortest path matrix
          *
          */
-        node_tension(const ogdf::GraphAttributes& attrs, const ogdf_node_array_2d<double>& matrix) noexcept
+        node_tension(const ogdf::GraphAttributes& attrs, const distance_matrix& matrix) noexcept
             : _attrs{&attrs}, _matrix{&matrix}
         {
         }
@@ -95,7 +95,7 @@ namespace msc
         const ogdf::GraphAttributes* _attrs{};
 
         /** @brief Referenced shortest path matrix.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        const distance_matrix* _matrix{};
 
     };  // struct node_tension
 
@@ -131,7 +131,7 @@ namespace msc
          *
          */
         pairwise_tension(const ogdf::GraphAttributes& attrs,
-                         const ogdf_node_array_2d<double>& matrix,
+                         const distance_matrix& matrix,
                          const double infinity) noexcept
             : _attrs{&attrs}, _matrix{&matrix}, _infty{infinity}
         {
@@ -149,7 +149,7 @@ namespace msc
         {
             const auto pred = threshold_node_pair_predicate<double>{*_matrix, _infty};
             const auto proj = node_tension{*_attrs, *_matrix};
-            return iterator{_attrs->constGraph(), pred, proj};
+            return iterator{*_matrix, pred, proj};
         }
 
         /**
@@ -171,7 +171,7 @@ namespace msc
         const ogdf::GraphAttributes* _attrs{};
 
         /** @brief Referenced shortest path matrix.  */
-        const ogdf_node_array_2d<double>* _matrix{};
+        const distance_matrix* _matrix{};
 
         /** Value larger than the longest shortest path (between connected nodes) in the graph.  */
         double _infty{};
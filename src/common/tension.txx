@@ -26,7 +26,7 @@ namespace msc
     {
         const auto p1 = point2d{_attrs->x(v1), _attrs->y(v1)};
         const auto p2 = point2d{_attrs->x(v2), _attrs->y(v2)};
-        return distance(p1, p2) / (*_matrix)[v1][v2];
+        return distance(p1, p2) / (*_matrix)(v1, v2);
     }
 
 }  // namespace msc
@@ -0,0 +1,464 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "worker.hxx"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/iostreams/device/file_descriptor.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#if HAVE_POSIX_SUBPROCESSES
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <sys/stat.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#if HAVE_POSIX_AF_UNIX
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#endif
+
+#include "strings.hxx"
+
+namespace msc
+{
+
+    namespace /*anonymous*/
+    {
+
+        namespace pt = boost::property_tree;
+
+        using clock_type = std::chrono::steady_clock;
+
+        [[noreturn]] void throw_system_error(const std::string& what)
+        {
+            throw std::system_error{errno, std::system_category(), what};
+        }
+
+        void write_json_bytes(std::ostream& ostr, const std::string& bytes)
+        {
+            static const char hexdigits[] = "0123456789abcdef";
+            ostr << '"';
+            for (const auto c : bytes) {
+                const auto u = static_cast<unsigned char>(c);
+                if ((u == '"') || (u == '\\')) {
+                    ostr << '\\' << c;
+                } else if ((u >= 0x20) && (u < 0x7f)) {
+                    ostr << c;
+                } else {
+                    ostr << "\\u00" << hexdigits[u >> 4] << hexdigits[u & 0xf];
+                }
+            }
+            ostr << '"';
+        }
+
+        template <typename T>
+        void write_json_optional(std::ostream& ostr, const std::optional<T>& value)
+        {
+            if (value) {
+                ostr << *value;
+            } else {
+                ostr << "null";
+            }
+        }
+
+        std::string get_string_value(const pt::ptree& tree, const char *const what)
+        {
+            if (!tree.empty()) {
+                throw std::invalid_argument{concat("Attribute '", what, "' of request must be a string")};
+            }
+            return tree.data();
+        }
+
+#if HAVE_POSIX_SUBPROCESSES
+
+        class file_descriptor_guard final
+        {
+        public:
+
+            explicit file_descriptor_guard(const int fd = -1) noexcept : _fd{fd} { }
+
+            file_descriptor_guard(const file_descriptor_guard&) = delete;
+            file_descriptor_guard& operator=(const file_descriptor_guard&) = delete;
+
+            ~file_descriptor_guard() noexcept
+            {
+                this->reset();
+            }
+
+            int get() const noexcept
+            {
+                return _fd;
+            }
+
+            void reset(const int fd = -1) noexcept
+            {
+                if (_fd >= 0) {
+                    ::close(_fd);
+                }
+                _fd = fd;
+            }
+
+        private:
+
+            int _fd{-1};
+
+        };  // class file_descriptor_guard
+
+        void make_pipe(file_descriptor_guard& readend, file_descriptor_guard& writeend)
+        {
+            int fds[2];
+            if (::pipe(fds) < 0) {
+                throw_system_error("Cannot create pipe");
+            }
+            readend.reset(fds[0]);
+            writeend.reset(fds[1]);
+        }
+
+        [[noreturn]] void exec_child(const worker_request& request,
+                                     const tool_main_function tool,
+                                     const int infd,
+                                     const int outfd,
+                                     const int errfd) noexcept
+        {
+            // We are in the child process and must never return into the caller's code.
+            auto status = EXIT_FAILURE;
+            try {
+                // Put the child into its own process group so a timeout can also kill any processes it spawns.
+                ::setpgid(0, 0);
+                std::signal(SIGPIPE, SIG_DFL);
+                if ((::dup2(infd, STDIN_FILENO) < 0)
+                    || (::dup2(outfd, STDOUT_FILENO) < 0)
+                    || (::dup2(errfd, STDERR_FILENO) < 0)) {
+                    ::_exit(EXIT_FAILURE);
+                }
+                for (const auto fd : {infd, outfd, errfd}) {
+                    if (fd > STDERR_FILENO) {
+                        ::close(fd);
+                    }
+                }
+                for (const auto& [key, value] : request.environ) {
+                    ::setenv(key.c_str(), value.c_str(), 1);
+                }
+                std::cin.clear();
+                std::cout.clear();
+                std::cerr.clear();
+                auto argv = std::vector<const char*>{};
+                argv.push_back(request.tool.c_str());
+                for (const auto& arg : request.args) {
+                    argv.push_back(arg.c_str());
+                }
+                argv.push_back(nullptr);
+                status = tool(static_cast<int>(argv.size() - 1), argv.data());
+            } catch (const std::exception& e) {
+                std::cerr << request.tool << ": error: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << request.tool << ": error: unknown exception" << std::endl;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            ::_exit(status);
+        }
+
+        bool drain(const int fd, std::string& buffer)
+        {
+            char chunk[4096];
+            while (true) {
+                const auto count = ::read(fd, chunk, sizeof(chunk));
+                if (count > 0) {
+                    buffer.append(chunk, static_cast<std::size_t>(count));
+                    return true;
+                } else if (count == 0) {
+                    return false;
+                } else if (errno != EINTR) {
+                    throw_system_error("Cannot read output of child process");
+                }
+            }
+        }
+
+        int get_poll_timeout(const std::optional<clock_type::time_point> deadline)
+        {
+            using namespace std::chrono;
+            if (!deadline) {
+                return -1;
+            }
+            const auto remaining = duration_cast<milliseconds>(*deadline - clock_type::now()).count();
+            return static_cast<int>(std::max(0L, std::min(static_cast<long>(remaining) + 1L, 60000L)));
+        }
+
+        worker_response run_child(const worker_request& request, const tool_main_function tool)
+        {
+            auto response = worker_response{};
+            response.id = request.id;
+            const auto infile = request.input.empty() ? std::string{"/dev/null"} : request.input;
+            auto infd = file_descriptor_guard{::open(infile.c_str(), O_RDONLY)};
+            if (infd.get() < 0) {
+                throw_system_error(infile);
+            }
+            auto outpipe = std::pair<file_descriptor_guard, file_descriptor_guard>{};
+            auto errpipe = std::pair<file_descriptor_guard, file_descriptor_guard>{};
+            make_pipe(outpipe.first, outpipe.second);
+            make_pipe(errpipe.first, errpipe.second);
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            const auto t0 = clock_type::now();
+            const auto pid = ::fork();
+            if (pid < 0) {
+                throw_system_error("Cannot create child process");
+            }
+            if (pid == 0) {
+                exec_child(request, tool, infd.get(), outpipe.second.get(), errpipe.second.get());
+            }
+            // The child does this, too, but we cannot know who gets to run first.  If the child already called
+            // `exec` or exited, this fails harmlessly.
+            ::setpgid(pid, pid);
+            infd.reset();
+            outpipe.second.reset();
+            errpipe.second.reset();
+            const auto deadline = (request.timeout > 0.0)
+                ? std::optional{t0 + std::chrono::duration_cast<clock_type::duration>(
+                      std::chrono::duration<double>{request.timeout})}
+                : std::nullopt;
+            auto killed = false;
+            auto outopen = true;
+            auto erropen = true;
+            while (outopen || erropen) {
+                if (deadline && (clock_type::now() >= *deadline)) {
+                    // Kill the whole process group and stop reading right away.  A grandchild that escaped the
+                    // group might still hold the pipes open and we must not wait for it to close them.
+                    if (::kill(-pid, SIGKILL) < 0) {
+                        ::kill(pid, SIGKILL);
+                    }
+                    killed = true;
+                    outpipe.first.reset();
+                    errpipe.first.reset();
+                    break;
+                }
+                pollfd fds[] = {
+                    {outopen ? outpipe.first.get() : -1, POLLIN, 0},
+                    {erropen ? errpipe.first.get() : -1, POLLIN, 0},
+                };
+                const auto ready = ::poll(fds, 2, get_poll_timeout(deadline));
+                if (ready < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_system_error("Cannot wait for output of child process");
+                }
+                if (fds[0].revents != 0) {
+                    outopen = drain(outpipe.first.get(), response.output);
+                }
+                if (fds[1].revents != 0) {
+                    erropen = drain(errpipe.first.get(), response.errors);
+                }
+            }
+            auto wstatus = 0;
+            while (::waitpid(pid, &wstatus, 0) < 0) {
+                if (errno != EINTR) {
+                    throw_system_error("Cannot wait for child process");
+                }
+            }
+            response.time = std::chrono::duration<double>{clock_type::now() - t0}.count();
+            response.timeout = killed;
+            if (WIFEXITED(wstatus)) {
+                response.status = WEXITSTATUS(wstatus);
+            } else if (WIFSIGNALED(wstatus)) {
+                response.signal = WTERMSIG(wstatus);
+            }
+            return response;
+        }
+
+#endif  // HAVE_POSIX_SUBPROCESSES
+
+    }  // namespace /*anonymous*/
+
+    worker_request parse_worker_request(const std::string& line)
+    {
+        auto tree = pt::ptree{};
+        try {
+            auto istr = std::istringstream{line};
+            pt::read_json(istr, tree);
+        } catch (const pt::json_parser_error& e) {
+            throw std::invalid_argument{concat("Cannot parse request: ", e.message())};
+        }
+        auto request = worker_request{};
+        for (const auto& [key, value] : tree) {
+            if (key == "id") {
+                request.id = get_string_value(value, "id");
+            } else if (key == "tool") {
+                request.tool = get_string_value(value, "tool");
+            } else if (key == "args") {
+                for (const auto& [index, arg] : value) {
+                    if (!index.empty()) {
+                        throw std::invalid_argument{"Attribute 'args' of request must be an array"};
+                    }
+                    request.args.push_back(get_string_value(arg, "args"));
+                }
+            } else if (key == "stdin") {
+                request.input = get_string_value(value, "stdin");
+            } else if (key == "environ") {
+                for (const auto& [name, envval] : value) {
+                    if (name.empty()) {
+                        throw std::invalid_argument{"Attribute 'environ' of request must be an object"};
+                    }
+                    request.environ[name] = get_string_value(envval, "environ");
+                }
+            } else if (key == "timeout") {
+                const auto timeout = value.get_value_optional<double>();
+                if (!timeout || !value.empty()) {
+                    throw std::invalid_argument{"Attribute 'timeout' of request must be a number"};
+                }
+                request.timeout = *timeout;
+            } else {
+                throw std::invalid_argument{concat("Unknown attribute in request: ", key)};
+            }
+        }
+        if (request.tool.empty()) {
+            throw std::invalid_argument{"Request does not specify a tool"};
+        }
+        return request;
+    }
+
+    worker_response run_worker_request(const worker_request& request, const tool_table& tools)
+    {
+        const auto pos = tools.find(request.tool);
+        if (pos == tools.end()) {
+            throw std::invalid_argument{concat("Unknown tool: ", request.tool)};
+        }
+#if HAVE_POSIX_SUBPROCESSES
+        return run_child(request, pos->second);
+#else
+        throw std::system_error{std::make_error_code(std::errc::function_not_supported), "Cannot run child processes"};
+#endif
+    }
+
+    void write_worker_response(std::ostream& ostr, const worker_response& response)
+    {
+        ostr << "{\"id\": ";
+        write_json_bytes(ostr, response.id);
+        ostr << ", \"status\": ";
+        write_json_optional(ostr, response.status);
+        ostr << ", \"signal\": ";
+        write_json_optional(ostr, response.signal);
+        ostr << ", \"timeout\": " << (response.timeout ? "true" : "false");
+        ostr << ", \"stdout\": ";
+        write_json_bytes(ostr, response.output);
+        ostr << ", \"stderr\": ";
+        write_json_bytes(ostr, response.errors);
+        ostr << ", \"time\": " << response.time;
+        ostr << ", \"error\": ";
+        if (response.error.empty()) {
+            ostr << "null";
+        } else {
+            write_json_bytes(ostr, response.error);
+        }
+        ostr << "}\n";
+    }
+
+    std::size_t serve_worker_requests(std::istream& istr, std::ostream& ostr, const tool_table& tools)
+    {
+        auto count = std::size_t{};
+        for (auto line = std::string{}; std::getline(istr, line);) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            auto response = worker_response{};
+            try {
+                const auto request = parse_worker_request(line);
+                response.id = request.id;
+                response = run_worker_request(request, tools);
+            } catch (const std::exception& e) {
+                response.error = e.what();
+            }
+            write_worker_response(ostr, response);
+            ostr.flush();
+            count += 1;
+        }
+        return count;
+    }
+
+    void serve_worker_socket(const std::string& filename, const tool_table& tools)
+    {
+#if HAVE_POSIX_SUBPROCESSES && HAVE_POSIX_AF_UNIX
+        namespace io = boost::iostreams;
+        auto address = sockaddr_un{};
+        address.sun_family = AF_UNIX;
+        if (filename.size() >= sizeof(address.sun_path)) {
+            throw std::system_error{
+                std::make_error_code(std::errc::filename_too_long), concat("Cannot bind socket: ", filename)
+            };
+        }
+        filename.copy(address.sun_path, filename.size());
+        struct stat info{};
+        if ((::lstat(filename.c_str(), &info) == 0) && S_ISSOCK(info.st_mode)) {
+            ::unlink(filename.c_str());
+        }
+        auto server = file_descriptor_guard{::socket(AF_UNIX, SOCK_STREAM, 0)};
+        if (server.get() < 0) {
+            throw_system_error("Cannot create socket");
+        }
+        if (::bind(server.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+            throw_system_error(concat("Cannot bind socket: ", filename));
+        }
+        if (::listen(server.get(), 8) < 0) {
+            throw_system_error(concat("Cannot listen on socket: ", filename));
+        }
+        // A client that goes away in the middle of a response must not take the worker down with it.
+        std::signal(SIGPIPE, SIG_IGN);
+        while (true) {
+            const auto client = ::accept(server.get(), nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_system_error(concat("Cannot accept connection on socket: ", filename));
+            }
+            auto istr = io::stream<io::file_descriptor_source>{client, io::close_handle};
+            auto ostr = io::stream<io::file_descriptor_sink>{::dup(client), io::close_handle};
+            serve_worker_requests(istr, ostr, tools);
+        }
+#else
+        throw std::system_error{
+            std::make_error_code(std::errc::function_not_supported), concat("Cannot listen on socket: ", filename)
+        };
+#endif
+    }
+
+}  // namespace msc
@@ -0,0 +1,212 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+/**
+ * @file worker.hxx
+ *
+ * @brief
+ *     Persistent worker process that runs tools on request without paying the process start-up cost for each call.
+ *
+ * The worker reads requests from a stream, one JSON object per line, and answers each of them with a single line of
+ * JSON in the same order.  A request has the following attributes.
+ *
+ *  - `tool` (mandatory) -- name of the tool to run
+ *  - `args` (optional) -- array of command-line arguments (excluding the program name)
+ *  - `stdin` (optional) -- name of a file to connect to the tool's standard input (default: `/dev/null`)
+ *  - `environ` (optional) -- object with additional environment variables for the tool
+ *  - `timeout` (optional) -- time limit in seconds (default: unlimited)
+ *  - `id` (optional) -- opaque string that is echoed back in the response
+ *
+ * The response has the attributes `id`, `status` (exit status or `null` if the tool did not exit normally), `signal`
+ * (number of the signal that killed the tool or `null`), `timeout` (whether the tool was killed because it exceeded
+ * the time limit), `stdout` and `stderr` (captured output), `time` (wall-clock time in seconds) and `error` (message
+ * if the request could not be processed at all or `null`).  Captured output is encoded such that each byte becomes
+ * the code point with the same value, so clients can recover binary data by encoding the strings as ISO 8859-1.
+ *
+ * Each request runs in a child process that is forked from the worker after all tools have been loaded and
+ * initialized.  Therefore, a tool that crashes, leaks resources or mutates global state cannot affect subsequent
+ * requests and the time limit can be enforced by killing the child.  The child runs in its own process group, which
+ * is killed as a whole when the time limit expires, and output that arrives after that is discarded.
+ *
+ */
+
+#ifndef MSC_WORKER_HXX
+#define MSC_WORKER_HXX
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace msc
+{
+
+    /** @brief Type of a tool's `main` function.  */
+    using tool_main_function = int (*)(int, const char *const *);
+
+    /** @brief Tools known to the worker indexed by their names.  */
+    using tool_table = std::map<std::string, tool_main_function>;
+
+    /** @brief Parsed request to the worker.  */
+    struct worker_request
+    {
+        /** @brief Opaque identifier that is echoed back in the response.  */
+        std::string id{};
+
+        /** @brief Name of the tool to run.  */
+        std::string tool{};
+
+        /** @brief Command-line arguments to pass to the tool (excluding the program name).  */
+        std::vector<std::string> args{};
+
+        /** @brief File to connect to the tool's standard input (empty for `/dev/null`).  */
+        std::string input{};
+
+        /** @brief Additional environment variables to set for the tool.  */
+        std::map<std::string, std::string> environ{};
+
+        /** @brief Time limit in seconds (non-positive for no limit).  */
+        double timeout{};
+    };
+
+    /** @brief Outcome of a request to the worker.  */
+    struct worker_response
+    {
+        /** @brief Identifier copied from the request.  */
+        std::string id{};
+
+        /** @brief Exit status if the tool terminated normally.  */
+        std::optional<int> status{};
+
+        /** @brief Number of the signal that terminated the tool, if any.  */
+        std::optional<int> signal{};
+
+        /** @brief Whether the tool was killed because it exceeded its time limit.  */
+        bool timeout{};
+
+        /** @brief Data written to standard output.  */
+        std::string output{};
+
+        /** @brief Data written to standard error output.  */
+        std::string errors{};
+
+        /** @brief Wall-clock time in seconds.  */
+        double time{};
+
+        /** @brief Error message if the request could not be processed (empty otherwise).  */
+        std::string error{};
+    };
+
+    /**
+     * @brief
+     *     Parses a single line of the request protocol.
+     *
+     * @param line
+     *     JSON text of the request
+     *
+     * @returns
+     *     parsed request
+     *
+     * @throws std::invalid_argument
+     *     if `line` is not a valid request
+     *
+     */
+    worker_request parse_worker_request(const std::string& line);
+
+    /**
+     * @brief
+     *     Runs a single request in a child process and waits for its completion.
+     *
+     * Failures of the tool (including crashes and timeouts) are reported in the response and not as exceptions.
+     *
+     * @param request
+     *     request to run
+     *
+     * @param tools
+     *     table of known tools
+     *
+     * @returns
+     *     outcome of the request
+     *
+     * @throws std::invalid_argument
+     *     if the requested tool is unknown
+     *
+     * @throws std::system_error
+     *     if the child process cannot be created or communicated with
+     *
+     */
+    worker_response run_worker_request(const worker_request& request, const tool_table& tools);
+
+    /**
+     * @brief
+     *     Writes a response as a single line of JSON.
+     *
+     * @param ostr
+     *     stream to write to
+     *
+     * @param response
+     *     response to write
+     *
+     */
+    void write_worker_response(std::ostream& ostr, const worker_response& response);
+
+    /**
+     * @brief
+     *     Answers requests read from a stream until EOF.
+     *
+     * A request that cannot be parsed or run is answered with an error response and does not stop the loop.  The
+     * output stream is flushed after each response.
+     *
+     * @param istr
+     *     stream to read requests from
+     *
+     * @param ostr
+     *     stream to write responses to
+     *
+     * @param tools
+     *     table of known tools
+     *
+     * @returns
+     *     number of requests answered
+     *
+     */
+    std::size_t serve_worker_requests(std::istream& istr, std::ostream& ostr, const tool_table& tools);
+
+    /**
+     * @brief
+     *     Listens on a Unix domain socket and answers the requests on each connection in turn.
+     *
+     * Connections are served sequentially; run several workers for parallelism.  A stale socket file left over by a
+     * previous worker is removed.  This function only returns by throwing an exception.
+     *
+     * @param filename
+     *     file name of the socket
+     *
+     * @param tools
+     *     table of known tools
+     *
+     * @throws std::system_error
+     *     if the socket cannot be set up
+     *
+     */
+    [[noreturn]] void serve_worker_socket(const std::string& filename, const tool_table& tools);
+
+}  // namespace msc
+
+#endif  // !defined(MSC_WORKER_HXX)
@@ -24,6 +24,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -31,6 +32,7 @@
 #include "cli.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "graphml.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
@@ -43,31 +45,30 @@
 namespace /*anonymous*/
 {
 
-    std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
-    make_grid(const int width, const int height, const int torus)
+    // Calls `sink.add_node(j, i)` for the node in the `j`-th column of the `i`-th row and `sink.add_edge(u, v)` for
+    // each edge, always in the same order.
+    template <typename SinkT>
+    void build_grid(SinkT& sink, const int width, const int height, const int torus)
     {
+        using node_type = decltype(sink.add_node(0, 0));
         if (torus > 2) {
             throw std::invalid_argument{"Sorry, N-torii with N > 2 are not supported"};
         }
-        auto graph = std::make_unique<ogdf::Graph>();
-        auto attrs = std::make_unique<ogdf::GraphAttributes>(*graph);
-        auto row = std::vector<ogdf::node>(width, nullptr);
-        auto top = std::vector<ogdf::node>{};
+        auto row = std::vector<node_type>(width);
+        auto top = std::vector<node_type>{};
         for (auto i = 0; i < height; ++i) {
             for (auto j = 0; j < width; ++j) {
-                const auto v = graph->newNode();
-                attrs->x(v) = j;
-                attrs->y(v) = i;
-                if (const auto u = row[j]) {
-                    graph->newEdge(u, v);
+                const auto v = sink.add_node(j, i);
+                if (i > 0) {
+                    sink.add_edge(row[j], v);
                 }
                 row[j] = v;
             }
             for (auto j = 1; j < width; ++j) {
-                graph->newEdge(row[j - 1], row[j]);
+                sink.add_edge(row[j - 1], row[j]);
             }
             if ((torus >= 1) && (width > 1)) {
-                graph->newEdge(row.back(), row.front());
+                sink.add_edge(row.back(), row.front());
             }
             if ((torus >= 2) && (i == 0)) {
                 top = row;
@@ -75,18 +76,99 @@ namespace /*anonymous*/
         }
         if ((torus >= 2) && (height > 1)) {
             for (auto j = 0; j < width; ++j) {
-                graph->newEdge(row[j], top[j]);
+                sink.add_edge(row[j], top[j]);
+            }
+        }
+    }
+
+    struct layout_sink final
+    {
+        ogdf::Graph& graph;
+        ogdf::GraphAttributes& attrs;
+
+        ogdf::node add_node(const int j, const int i)
+        {
+            const auto v = graph.newNode();
+            attrs.x(v) = j;
+            attrs.y(v) = i;
+            return v;
+        }
+
+        void add_edge(const ogdf::node u, const ogdf::node v)
+        {
+            graph.newEdge(u, v);
+        }
+    };
+
+    struct counting_sink final
+    {
+        long nodes{};
+        long edges{};
+        long add_node(const int /*j*/, const int /*i*/) noexcept { return nodes++; }
+        void add_edge(const long /*u*/, const long /*v*/) noexcept { edges += 1; }
+    };
+
+    // Writes the nodes directly with the coordinates that `msc::normalize_layout` would assign to them.  Since all
+    // edges of a grid have unit length, it will translate the grid to its center of gravity and scale it by
+    // `msc::default_node_distance` unless there is only a single node.  If `layout` is `false`, no coordinates are
+    // written at all.  The sink writes either only the nodes or (if `edges` is `true`) only the edges so the grid can
+    // be written in two passes with all nodes before the first edge, as the layout fingerprint requires.
+    struct stream_sink final
+    {
+        msc::graphml_writer& writer;
+        bool layout{};
+        double xmean{};
+        double ymean{};
+        double scale{};
+        bool edges{};
+        long next{};
+
+        long add_node(const int j, const int i)
+        {
+            if (edges) {
+                return next++;
             }
+            return layout ? writer.add_node((j - xmean) * scale, (i - ymean) * scale) : writer.add_node();
         }
+
+        void add_edge(const long u, const long v)
+        {
+            if (edges) {
+                writer.add_edge(u, v);
+            }
+        }
+    };
+
+    std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
+    make_grid(const int width, const int height, const int torus)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        auto attrs = std::make_unique<ogdf::GraphAttributes>(*graph);
+        auto sink = layout_sink{*graph, *attrs};
+        build_grid(sink, width, height, torus);
         return {std::move(graph), std::move(attrs)};
     }
 
+    void stream_grid(msc::graphml_writer& writer, const int width, const int height, const int torus)
+    {
+        const auto layout = (torus == 0);
+        const auto scale = (width * height > 1) ? msc::default_node_distance : 1.0;
+        auto counter = counting_sink{};
+        build_grid(counter, width, height, torus);
+        writer.expect(counter.nodes, counter.edges);
+        auto nodesink = stream_sink{writer, layout, 0.5 * (width - 1), 0.5 * (height - 1), scale, false};
+        build_grid(nodesink, width, height, torus);
+        auto edgesink = stream_sink{writer, layout, 0.5 * (width - 1), 0.5 * (height - 1), scale, true};
+        build_grid(edgesink, width, height, torus);
+    }
+
     struct cli_parameters
     {
         msc::output_file output{"-"};
         msc::output_file meta{};
         int nodes{100};
         int torus{0};
+        bool stream{};
     };
 
     struct application
@@ -119,6 +201,28 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::json_object get_info(const msc::graphml_writer& writer,
+                              const bool layout,
+                              const std::string& seed,
+                              const msc::output_file& dst)
+    {
+        auto info = msc::json_object{};
+        info["graph"] = writer.graph_fingerprint().value();
+        info["nodes"] = msc::json_diff{writer.nodes()};
+        info["edges"] = msc::json_diff{writer.edges()};
+        info["producer"] = PROGRAM_NAME;
+        info["seed"] = seed;
+        info["filename"] = msc::make_json(dst.filename());
+        info["native"] = msc::json_bool{layout};
+        if (layout) {
+            info["layout"] = writer.layout_fingerprint().value();
+            const auto bbox = writer.bounding_box_size();
+            info["width"] = msc::json_real{bbox.x()};
+            info["height"] = msc::json_real{bbox.y()};
+        }
+        return info;
+    }
+
     void application::operator()() const
     {
         auto rndeng = std::mt19937{};
@@ -127,6 +231,14 @@ namespace /*anonymous*/
         auto rnddst = std::uniform_int_distribution{1, maxdim};
         const auto n = rnddst(rndeng);
         const auto m = rnddst(rndeng);
+        if (this->parameters.stream) {
+            const auto layout = (this->parameters.torus == 0);
+            auto writer = msc::graphml_writer{this->parameters.output, layout};
+            stream_grid(writer, n, m, this->parameters.torus);
+            writer.close();
+            msc::print_meta(get_info(writer, layout, seed, this->parameters.output), this->parameters.meta);
+            return;
+        }
         auto [graph, attrs] = make_grid(n, m, this->parameters.torus);
         if (this->parameters.torus == 0) {
             msc::normalize_layout(*attrs);
@@ -144,5 +256,10 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Generates a regular grid.");
+    app.help.push_back(
+        "In streaming mode, the grid is written to the output file while it is generated and never held in memory as"
+        " a whole (only the coordinates of the nodes are kept for computing the layout fingerprint).  The output will"
+        " be in GraphML format."
+    );
     return app(argc, argv);
 }
@@ -18,9 +18,10 @@
 #  include <config.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <exception>
-#include <map>
 #include <memory>
 #include <random>
 #include <string>
@@ -33,6 +34,7 @@
 #include "cli.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "hashmap.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "math_constants.hxx"
@@ -78,7 +80,7 @@ namespace /*anonymous*/
 
         std::unique_ptr<ogdf::Graph> _graph{};
         std::unique_ptr<ogdf::GraphAttributes> _attrs{};
-        std::map<std::pair<ogdf::node, ogdf::node>, ogdf::node> _splitedges{};
+        msc::open_hash_map<std::uint64_t, ogdf::node> _splitedges{};
         std::vector<std::vector<ogdf::node>> _leafshapes{};
         std::vector<std::vector<ogdf::node>> _indishapes{};
 
@@ -220,21 +222,28 @@ namespace /*anonymous*/
         ogdf::node _split(const ogdf::node v1, const ogdf::node v2)
         {
             assert(v1 != v2);
-            const auto pair = std::less<ogdf::node>{}(v1, v2) ? std::make_pair(v1, v2) : std::make_pair(v2, v1);
-            const auto [iter, need] = _splitedges.insert({pair, nullptr});
+            const auto [slot, need] = _splitedges.try_emplace(_get_edge_key(v1, v2), nullptr);
             if (need) {
                 const auto v = _graph->newNode();
                 _del_edge(v1, v2);
                 _new_edge(v, v1);
                 _new_edge(v, v2);
-                iter->second = v;
+                *slot = v;
                 const auto c1 = msc::point2d{_attrs->x(v1), _attrs->y(v1)};
                 const auto c2 = msc::point2d{_attrs->x(v2), _attrs->y(v2)};
                 const auto c = 0.5 * c1 + 0.5 * c2;
                 _attrs->x(v) = c.x();
                 _attrs->y(v) = c.y();
             }
-            return iter->second;
+            return *slot;
+        }
+
+        // Packs the indices of the two (unordered) end-points of an edge into a single integer.
+        static std::uint64_t _get_edge_key(const ogdf::node v1, const ogdf::node v2) noexcept
+        {
+            const auto i1 = static_cast<std::uint64_t>(v1->index());
+            const auto i2 = static_cast<std::uint64_t>(v2->index());
+            return (std::min(i1, i2) << 32) | std::max(i1, i2);
         }
 
         msc::point2d _get_center(const std::vector<ogdf::node>& nodes) const noexcept
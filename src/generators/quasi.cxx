@@ -18,15 +18,17 @@
 #  include <config.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
-#include <map>
 #include <memory>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -34,6 +36,7 @@
 #include "cli.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "hashmap.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
@@ -49,20 +52,39 @@
 namespace /*anonymous*/
 {
 
+    // All grid points have integral coordinates so they are keyed by their rounded coordinates.
     template <std::size_t N>
-    using grid_node_map = std::map<msc::point<double, N>, ogdf::node, msc::point_order<double>>;
+    using grid_key = std::array<long, N>;
+
+    template <std::size_t N>
+    using grid_node_map = msc::open_hash_map<grid_key<N>, ogdf::node>;
+
+    template <std::size_t N>
+    grid_key<N> get_grid_key(const msc::point<double, N>& p) noexcept
+    {
+        auto key = grid_key<N>{};
+        for (std::size_t dim = 0; dim < N; ++dim) {
+            key[dim] = std::lround(p[dim]);
+        }
+        return key;
+    }
 
     template <std::size_t N>
     void add_gird_edges(ogdf::Graph& graph, const grid_node_map<N>& nodemap)
     {
-        for (const auto [grid, node] : nodemap) {
+        // The edges are inserted in lexicographic order of the grid points (as they always used to be) so the output
+        // does not depend on the hash map's iteration order.
+        auto entries = std::vector<std::pair<grid_key<N>, ogdf::node>>{};
+        entries.reserve(nodemap.size());
+        nodemap.for_each([&entries](const auto& grid, const auto node){ entries.emplace_back(grid, node); });
+        std::sort(std::begin(entries), std::end(entries));
+        for (const auto& [grid, node] : entries) {
             for (std::size_t dim = 0; dim < N; ++dim) {
-                for (auto off : {-1.0, +1.0}) {
+                for (auto off : {-1L, +1L}) {
                     auto next = grid;
                     next[dim] += off;
-                    const auto pos = nodemap.find(next);
-                    if (pos != nodemap.end()) {
-                        const auto other = pos->second;
+                    if (const auto pos = nodemap.find(next)) {
+                        const auto other = *pos;
                         if (graph.searchEdge(node, other) == nullptr) {
                             graph.newEdge(node, other);
                         }
@@ -117,12 +139,13 @@ namespace /*anonymous*/
         auto nodes = grid_node_map<N>{};
         const auto agite = [&](const point_nd& grid){
             const auto proj = project_point(grid, normal);
-            if ((distance(proj, grid) <= thickness) && !nodes.count(grid)) {
-                const auto v = graph->newNode();
-                const auto p = msc::transform2d(proj, e1, e2);
-                attrs->x(v) = p.x();
-                attrs->y(v) = p.y();
-                nodes[grid] = v;
+            if (distance(proj, grid) <= thickness) {
+                if (const auto [v, need] = nodes.try_emplace(get_grid_key(grid)); need) {
+                    *v = graph->newNode();
+                    const auto p = msc::transform2d(proj, e1, e2);
+                    attrs->x(*v) = p.x();
+                    attrs->y(*v) = p.y();
+                }
             }
         };
         for (auto r1 = 0.0; r1 <= size; r1 += 1.0) {
@@ -18,20 +18,28 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
 #include "cli.hxx"
+#include "concurrency.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "graphml.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "math_constants.hxx"
@@ -62,35 +70,187 @@ namespace /*anonymous*/
         return vecmul_impl(lhs, rhs, std::make_index_sequence<N>());
     }
 
-    template <std::size_t Dim, typename RndEngT>
-    std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
-    make_random_geometric_graph(RndEngT& engine, const int n)
+    template <std::size_t Dim>
+    using cell_index = std::array<long, Dim>;
+
+    struct cell_index_hash final
     {
+        template <std::size_t Dim>
+        std::size_t operator()(const cell_index<Dim>& cell) const noexcept
+        {
+            auto seed = std::size_t{};
+            for (const auto c : cell) {
+                seed ^= std::hash<long>{}(c) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    // Uniform grid of cubic cells that allows finding all points within a distance of `radius` from any given point by
+    // only looking at the 3^Dim cells surrounding it.  The cells are made a tiny bit larger than `radius` so rounding
+    // errors can never place two points that are close enough more than one cell apart.
+    template <std::size_t Dim>
+    class cell_grid final
+    {
+    public:
+
         using point_type = msc::point<double, Dim>;
-        const auto d = M_E / std::max(1.0, std::log(n));
+
+        cell_grid(const std::vector<point_type>& points, const double radius) : _points{points}, _radius{radius}
+        {
+            _origin.fill(HUGE_VAL);
+            for (const auto& p : _points) {
+                for (auto k = std::size_t{}; k < Dim; ++k) {
+                    _origin[k] = std::min(_origin[k], p[k]);
+                }
+            }
+            for (auto i = std::size_t{}; i < _points.size(); ++i) {
+                _cells[_get_cell(_points[i])].push_back(i);
+            }
+        }
+
+        // Appends the indices of all points with a larger index than `i` that are within `radius` from the `i`-th point
+        // to `neighbours` in ascending order.
+        void get_successors(const std::size_t i, std::vector<std::size_t>& neighbours) const
+        {
+            const auto first = neighbours.size();
+            const auto& p = _points[i];
+            const auto center = _get_cell(p);
+            auto offset = cell_index<Dim>{};
+            offset.fill(-1);
+            while (true) {
+                auto cell = center;
+                for (auto k = std::size_t{}; k < Dim; ++k) {
+                    cell[k] += offset[k];
+                }
+                if (const auto pos = _cells.find(cell); pos != _cells.end()) {
+                    for (const auto j : pos->second) {
+                        if ((j > i) && (distance(p, _points[j]) <= _radius)) {
+                            neighbours.push_back(j);
+                        }
+                    }
+                }
+                if (!_next_offset(offset)) {
+                    break;
+                }
+            }
+            std::sort(std::begin(neighbours) + first, std::end(neighbours));
+        }
+
+    private:
+
+        const std::vector<point_type>& _points;
+        double _radius{};
+        std::array<double, Dim> _origin{};
+        std::unordered_map<cell_index<Dim>, std::vector<std::size_t>, cell_index_hash> _cells{};
+
+        cell_index<Dim> _get_cell(const point_type& p) const noexcept
+        {
+            const auto size = (1.0 + 1.0E-6) * _radius;
+            auto cell = cell_index<Dim>{};
+            for (auto k = std::size_t{}; k < Dim; ++k) {
+                cell[k] = static_cast<long>(std::floor((p[k] - _origin[k]) / size));
+            }
+            return cell;
+        }
+
+        static bool _next_offset(cell_index<Dim>& offset) noexcept
+        {
+            for (auto k = std::size_t{}; k < Dim; ++k) {
+                if (offset[k] < 1) {
+                    offset[k] += 1;
+                    return true;
+                }
+                offset[k] = -1;
+            }
+            return false;
+        }
+
+    };  // class cell_grid
+
+    // Point `i` is drawn from the sub-stream `i` of `engine` so the points can be generated concurrently and the result
+    // does not depend on the number of threads.
+    template <std::size_t Dim>
+    std::vector<msc::point<double, Dim>> make_random_points(msc::philox_engine& engine, const int n)
+    {
+        constexpr auto chunksize = std::size_t{1} << 12;
         const auto scale = 0.5 * std::pow(std::max(1, n), 1.0 / Dim);
-        auto coorddist = std::uniform_real_distribution{0.0, scale};
         auto scaledist = std::normal_distribution{1.0, 0.125 * scale};
         const auto scalevec = msc::make_random_point<double, Dim>(engine, scaledist);
+        auto points = std::vector<msc::point<double, Dim>>(n);
+        const auto chunks = (points.size() + chunksize - 1) / chunksize;
+        msc::parallel_for(chunks, [&points, &engine, scale, scalevec](const std::size_t c){
+            const auto last = std::min(points.size(), (c + 1) * chunksize);
+            for (auto i = c * chunksize; i < last; ++i) {
+                auto rndeng = engine.substream(i);
+                auto coorddist = std::uniform_real_distribution{0.0, scale};
+                points[i] = vecmul(scalevec, msc::make_random_point<double, Dim>(rndeng, coorddist));
+            }
+        });
+        return points;
+    }
+
+    double get_connection_radius(const int n) noexcept
+    {
+        return M_E / std::max(1.0, std::log(n));
+    }
+
+    // Calls `func(i, j)` for each pair of points with `i < j` that are no further than `radius` apart.  The pairs are
+    // visited in lexicographic order, exactly as a naive nested loop would.  The neighbour search for a block of points
+    // is done concurrently and the callbacks for the block are then invoked sequentially on the calling thread.
+    template <std::size_t Dim, typename FuncT>
+    void for_each_geometric_edge(const std::vector<msc::point<double, Dim>>& points, const double radius, FuncT&& func)
+    {
+        struct chunk_type
+        {
+            std::size_t first{};
+            std::size_t last{};
+            std::vector<std::size_t> ends{};
+            std::vector<std::size_t> neighbours{};
+        };
+        constexpr auto chunksize = std::size_t{1} << 10;
+        const auto grid = cell_grid<Dim>{points, radius};
+        auto chunks = std::vector<chunk_type>(msc::default_concurrency());
+        for (auto first = std::size_t{}; first < points.size(); first += chunks.size() * chunksize) {
+            msc::parallel_for(chunks.size(), [&](const std::size_t t){
+                auto& chunk = chunks[t];
+                chunk.first = std::min(points.size(), first + t * chunksize);
+                chunk.last = std::min(points.size(), chunk.first + chunksize);
+                chunk.ends.clear();
+                chunk.neighbours.clear();
+                for (auto i = chunk.first; i < chunk.last; ++i) {
+                    grid.get_successors(i, chunk.neighbours);
+                    chunk.ends.push_back(chunk.neighbours.size());
+                }
+            });
+            for (const auto& chunk : chunks) {
+                auto pos = std::begin(chunk.neighbours);
+                for (auto i = chunk.first; i < chunk.last; ++i) {
+                    const auto last = std::begin(chunk.neighbours) + chunk.ends[i - chunk.first];
+                    for (; pos != last; ++pos) {
+                        func(i, *pos);
+                    }
+                }
+            }
+        }
+    }
+
+    template <std::size_t Dim, typename RndEngT>
+    std::pair<std::unique_ptr<ogdf::Graph>, std::unique_ptr<ogdf::GraphAttributes>>
+    make_random_geometric_graph(RndEngT& engine, const int n)
+    {
+        const auto points = make_random_points<Dim>(engine, n);
         auto graph = std::make_unique<ogdf::Graph>();
         auto attrs = std::make_unique<ogdf::GraphAttributes>(*graph);
-        auto points = std::vector<point_type>(n);
         auto vertices = std::vector<ogdf::node>(n);
         for (auto i = 0; i < n; ++i) {
-            const auto p = points[i] = vecmul(scalevec, msc::make_random_point<double, Dim>(engine, coorddist));
             const auto v = vertices[i] = graph->newNode();
-            attrs->x(v) = p[0];
-            attrs->y(v) = p[1];
-        }
-        for (auto it1 = std::begin(points); it1 != std::end(points); ++it1) {
-            const auto p1 = *it1;
-            for (auto it2 = std::next(it1); it2 != std::end(points); ++it2) {
-                const auto p2 = *it2;
-                if (distance(p1, p2) <= d) {
-                    graph->newEdge(vertices.at(it1 - std::begin(points)), vertices.at(it2 - std::begin(points)));
-                }
-            }
+            attrs->x(v) = points[i][0];
+            attrs->y(v) = points[i][1];
         }
+        for_each_geometric_edge(points, get_connection_radius(n), [&graph, &vertices](const auto i, const auto j){
+            graph->newEdge(vertices[i], vertices[j]);
+        });
         return {std::move(graph), std::move(attrs)};
     }
 
@@ -109,12 +269,86 @@ namespace /*anonymous*/
         }
     }
 
+    // Returns the mean distance between all pairs of points, which is what `msc::normalize_layout` scales to if a
+    // layout has no edges.  This is quadratic in the number of points but only ever needed if the neighbour search
+    // found no edge at all, which (for the connection radius used here) only happens for very small graphs.
+    template <typename FuncT>
+    double get_mean_pairwise_distance(const std::size_t n, FuncT&& get_coords)
+    {
+        assert(n > 1);
+        auto dsum = 0.0;
+        auto tally = 0L;
+        for (auto i = std::size_t{}; i < n; ++i) {
+            for (auto j = i + 1; j < n; ++j) {
+                dsum += distance(get_coords(i), get_coords(j));
+                tally += 1;
+            }
+        }
+        return dsum / tally;
+    }
+
+    // Writes the same graph as `make_random_geometric_graph` would produce directly, with the coordinates that
+    // `msc::normalize_layout` would assign.  Only the point cloud is held in memory; the edges are enumerated twice
+    // using the cell grid, first to count them and compute their mean length and then to write them.
+    template <std::size_t Dim, typename RndEngT>
+    void stream_random_geometric_graph(RndEngT& engine, const int n, msc::graphml_writer& writer)
+    {
+        const auto points = make_random_points<Dim>(engine, n);
+        const auto radius = get_connection_radius(n);
+        auto xsum = 0.0;
+        auto ysum = 0.0;
+        for (const auto& p : points) {
+            xsum += p[0];
+            ysum += p[1];
+        }
+        const auto dx = -(xsum / n);
+        const auto dy = -(ysum / n);
+        const auto get_coords = [&points, dx, dy](const std::size_t i){
+            return msc::point2d{points[i][0] + dx, points[i][1] + dy};
+        };
+        auto dsum = 0.0;
+        auto edges = 0L;
+        for_each_geometric_edge(points, radius, [&dsum, &edges, &get_coords](const auto i, const auto j){
+            dsum += distance(get_coords(i), get_coords(j));
+            edges += 1;
+        });
+        auto scale = 1.0;
+        if (edges > 0) {
+            scale = msc::default_node_distance / (dsum / edges);
+        } else if (n > 1) {
+            scale = msc::default_node_distance / get_mean_pairwise_distance(points.size(), get_coords);
+        }
+        writer.expect(n, edges);
+        for (auto i = std::size_t{}; i < points.size(); ++i) {
+            const auto p = get_coords(i);
+            writer.add_node(p.x() * scale, p.y() * scale);
+        }
+        for_each_geometric_edge(points, radius, [&writer](const auto i, const auto j){
+            writer.add_edge(static_cast<long>(i), static_cast<long>(j));
+        });
+    }
+
+    template <typename RndEngT>
+    void stream_random_geometric_graph(RndEngT& engine, const int n, const int dim, msc::graphml_writer& writer)
+    {
+        switch (dim) {
+        case 2: return stream_random_geometric_graph<2>(engine, n, writer);
+        case 3: return stream_random_geometric_graph<3>(engine, n, writer);
+        case 4: return stream_random_geometric_graph<4>(engine, n, writer);
+        case 5: return stream_random_geometric_graph<5>(engine, n, writer);
+        case 6: return stream_random_geometric_graph<6>(engine, n, writer);
+        default:
+            throw std::invalid_argument{"Invalid or unsupported dimensionality of hyper space: " + std::to_string(dim)};
+        }
+    }
+
     struct cli_parameters
     {
         msc::output_file output{"-"};
         msc::output_file meta{};
         int nodes{100};
         int hyperdim{3};
+        bool stream{};
     };
 
     struct application
@@ -140,11 +374,35 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::json_object get_info(const msc::graphml_writer& writer, const std::string& seed, const msc::output_file& dst)
+    {
+        auto info = msc::json_object{};
+        const auto bbox = writer.bounding_box_size();
+        info["graph"] = writer.graph_fingerprint().value();
+        info["layout"] = writer.layout_fingerprint().value();
+        info["nodes"] = msc::json_diff{writer.nodes()};
+        info["edges"] = msc::json_diff{writer.edges()};
+        info["native"] = msc::json_bool{true};
+        info["width"] = msc::json_real{bbox.x()};
+        info["height"] = msc::json_real{bbox.y()};
+        info["seed"] = seed;
+        info["filename"] = msc::make_json(dst.filename());
+        info["producer"] = PROGRAM_NAME;
+        return info;
+    }
+
     void application::operator()() const
     {
-        auto rndeng = std::mt19937{};
+        auto rndeng = msc::philox_engine{};
         const auto seed = msc::seed_random_engine(rndeng);
         const auto nodes = std::poisson_distribution{static_cast<double>(this->parameters.nodes)}(rndeng);
+        if (this->parameters.stream) {
+            auto writer = msc::graphml_writer{this->parameters.output, true};
+            stream_random_geometric_graph(rndeng, nodes, this->parameters.hyperdim, writer);
+            writer.close();
+            msc::print_meta(get_info(writer, seed, this->parameters.output), this->parameters.meta);
+            return;
+        }
         const auto [graph, attrs] = make_random_geometric_graph(rndeng, nodes, this->parameters.hyperdim);
         msc::normalize_layout(*attrs);
         msc::store_layout(*attrs, this->parameters.output);
@@ -159,5 +417,9 @@ int main(const int argc, const char *const *const argv)
     app.help.push_back(
         "Generates a random geometric graph using a procedure similar to the one presented by Markus Chimani at GD'18."
     );
+    app.help.push_back(
+        "In streaming mode, the graph is written to the output file while it is generated and only the node"
+        " coordinates are held in memory.  The output will be in GraphML format."
+    );
     return app(argc, argv);
 }
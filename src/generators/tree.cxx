@@ -19,6 +19,7 @@
 #endif
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
@@ -32,6 +33,7 @@
 #include "cli.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
+#include "graphml.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
@@ -43,22 +45,66 @@
 namespace /*anonymous*/
 {
 
-    template <typename EngineT, typename DegDistT>
-    void recurse_on_tree(EngineT& engine, DegDistT& degdist, ogdf::Graph& graph, const ogdf::node node, const int n)
+    // The tree generator can feed its output into different sinks that all provide the same interface as
+    // `msc::graphml_writer` which is itself a sink that writes directly to a file.
+
+    struct graph_sink final
+    {
+        ogdf::Graph& graph;
+        ogdf::node add_node() { return graph.newNode(); }
+        void add_edge(const ogdf::node u, const ogdf::node v) { graph.newEdge(u, v); }
+        long nodes() const noexcept { return graph.numberOfNodes(); }
+    };
+
+    struct counting_sink final
     {
+        long count{};
+        long add_node() noexcept { return count++; }
+        void add_edge(const long /*u*/, const long /*v*/) noexcept { }
+        long nodes() const noexcept { return count; }
+    };
+
+    // Grows the tree depth-first, consuming random numbers in the same order as the obvious recursive implementation
+    // would, but uses an explicit stack so that huge trees won't overflow the call stack.
+    template <typename EngineT, typename DegDistT, typename SinkT>
+    void grow_tree(EngineT& engine, DegDistT& degdist, SinkT& sink, const int n)
+    {
+        using node_type = decltype(sink.add_node());
+        struct frame_type
+        {
+            std::vector<node_type> children{};
+            std::size_t next{};
+            std::bernoulli_distribution recdist{};
+        };
         const auto dbl = [](const auto x)->double{ return x; };
-        auto children = std::vector<ogdf::node>(degdist(engine) - degdist.min());
-        std::generate(std::begin(children), std::end(children), [&graph](){ return graph.newNode(); });
-        std::for_each(std::begin(children), std::end(children), [&graph, node](auto v){ graph.newEdge(node, v); });
-        const auto p = std::sqrt(1.0 - std::clamp(dbl(graph.numberOfNodes()) / dbl(n), 0.0, 1.0));
-        auto recdist = std::bernoulli_distribution{p};
-        for (const auto v : children) {
-            if (recdist(engine)) {
-                recurse_on_tree(engine, degdist, graph, v, n);
+        auto stack = std::vector<frame_type>{};
+        const auto branch = [&](const node_type node){
+            auto frame = frame_type{};
+            frame.children.resize(degdist(engine) - degdist.min());
+            std::generate(std::begin(frame.children), std::end(frame.children), [&sink](){ return sink.add_node(); });
+            std::for_each(std::begin(frame.children), std::end(frame.children), [&sink, node](auto v){
+                sink.add_edge(node, v);
+            });
+            const auto p = std::sqrt(1.0 - std::clamp(dbl(sink.nodes()) / dbl(n), 0.0, 1.0));
+            frame.recdist = std::bernoulli_distribution{p};
+            stack.push_back(std::move(frame));
+        };
+        branch(sink.add_node());
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            if (frame.next == frame.children.size()) {
+                stack.pop_back();
+            } else if (const auto v = frame.children[frame.next++]; frame.recdist(engine)) {
+                branch(v);
             }
         }
     }
 
+    bool is_acceptable_size(const long actual, const int n) noexcept
+    {
+        return (actual >= n / 10.0) && (actual <= n * 10.0);
+    }
+
     template <typename EngineT>
     std::unique_ptr<ogdf::Graph> make_tree(EngineT& engine, const int n)
     {
@@ -67,10 +113,32 @@ namespace /*anonymous*/
             auto metadist = std::uniform_real_distribution{std::min(0.5, 1.0 / n), 0.5};
             auto degdist = std::geometric_distribution{metadist(engine)};
             auto graph = std::make_unique<ogdf::Graph>();
-            const auto root = graph->newNode();
-            recurse_on_tree(engine, degdist, *graph, root, n);
-            if ((graph->numberOfNodes() >= n / 10.0) && (graph->numberOfNodes() <= n * 10.0)) {
-                return std::move(graph);
+            auto sink = graph_sink{*graph};
+            grow_tree(engine, degdist, sink, n);
+            if (is_acceptable_size(graph->numberOfNodes(), n)) {
+                return graph;
+            }
+        }
+    }
+
+    // Produces exactly the same tree as `make_tree` but writes it directly.  Since output cannot be taken back once it
+    // is written, each attempt is made twice: first only counting the nodes and then, if the size is acceptable,
+    // again from the same state of the random engine, this time writing the output.
+    template <typename EngineT>
+    void stream_tree(EngineT& engine, const int n, msc::graphml_writer& writer)
+    {
+        assert(n > 0);
+        while (true) {
+            auto metadist = std::uniform_real_distribution{std::min(0.5, 1.0 / n), 0.5};
+            auto degdist = std::geometric_distribution{metadist(engine)};
+            const auto state = engine;
+            auto counter = counting_sink{};
+            grow_tree(engine, degdist, counter, n);
+            if (is_acceptable_size(counter.nodes(), n)) {
+                engine = state;
+                writer.expect(counter.nodes(), counter.nodes() - 1);
+                grow_tree(engine, degdist, writer, n);
+                return;
             }
         }
     }
@@ -80,6 +148,7 @@ namespace /*anonymous*/
         msc::output_file output{"-"};
         msc::output_file meta{};
         int nodes{100};
+        bool stream{};
     };
 
     struct application
@@ -101,15 +170,35 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::json_object get_info(const msc::graphml_writer& writer, const std::string& seed, const msc::output_file& dst)
+    {
+        auto info = msc::json_object{};
+        info["graph"] = writer.graph_fingerprint().value();
+        info["nodes"] = msc::json_diff{writer.nodes()};
+        info["edges"] = msc::json_diff{writer.edges()};
+        info["producer"] = PROGRAM_NAME;
+        info["seed"] = seed;
+        info["filename"] = msc::make_json(dst.filename());
+        info["native"] = msc::json_bool{false};
+        return info;
+    }
+
     void application::operator()() const
     {
         auto rndeng = std::mt19937{};
         const auto seed = msc::seed_random_engine(rndeng);
         std::srand(std::uniform_int_distribution<unsigned>{}(rndeng));
         ogdf::setSeed(std::uniform_int_distribution<int>{}(rndeng));
-        const auto graph = make_tree(rndeng, this->parameters.nodes);
-        msc::store_graph(*graph, this->parameters.output);
-        msc::print_meta(get_info(*graph, seed, this->parameters.output), this->parameters.meta);
+        if (this->parameters.stream) {
+            auto writer = msc::graphml_writer{this->parameters.output, false};
+            stream_tree(rndeng, this->parameters.nodes, writer);
+            writer.close();
+            msc::print_meta(get_info(writer, seed, this->parameters.output), this->parameters.meta);
+        } else {
+            const auto graph = make_tree(rndeng, this->parameters.nodes);
+            msc::store_graph(*graph, this->parameters.output);
+            msc::print_meta(get_info(*graph, seed, this->parameters.output), this->parameters.meta);
+        }
     }
 
 }  // namespace /*anonymous*/
@@ -118,5 +207,9 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Generates a random tree.");
+    app.help.push_back(
+        "In streaming mode, the tree is written to the output file while it is generated and never held in memory as"
+        " a whole.  The output will be in GraphML format."
+    );
     return app(argc, argv);
 }
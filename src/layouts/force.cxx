@@ -18,12 +18,15 @@
 #  include <config.h>
 #endif
 
+#include <cstddef>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -35,7 +38,9 @@
 #include <ogdf/energybased/SpringEmbedderKK.h>
 #include <ogdf/energybased/StressMinimization.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
+#include "concurrency.hxx"
 #include "enums/algorithms.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
@@ -44,7 +49,9 @@
 #include "meta.hxx"
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
+#include "profile.hxx"
 #include "random.hxx"
+#include "strings.hxx"
 #include "useful.hxx"
 
 #define PROGRAM_NAME "force"
@@ -57,10 +64,17 @@ namespace /*anonymous*/
     template <msc::algorithms Algo>
     struct layouter;
 
+    // Each layouter declares whether the OGDF implementation draws from the C library's `std::rand`.  The generator
+    // behind `ogdf::randomNumber` is thread-local (and re-seeded on each thread by `do_layout`) but `std::rand` is
+    // shared by the whole process so layouts that use it can only be computed reproducibly while holding the global
+    // `msc::legacy_random_mutex()`.  When in doubt, declare `true`; it only costs parallelism.
+
     template <>
     struct layouter<msc::algorithms::fmmm> final
     {
 
+        static constexpr bool uses_legacy_random = true;
+
         template <typename EngineT>
         void operator()(EngineT& engine, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs) const
         {
@@ -84,6 +98,8 @@ namespace /*anonymous*/
     struct layouter<msc::algorithms::stress> final
     {
 
+        static constexpr bool uses_legacy_random = false;
+
         template <typename EngineT>
         void operator()(EngineT& /*engine*/, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs) const
         {
@@ -102,6 +118,8 @@ namespace /*anonymous*/
     struct layouter<msc::algorithms::davidson_harel> final
     {
 
+        static constexpr bool uses_legacy_random = true;
+
         template <typename EngineT>
         void operator()(EngineT& /*engine*/, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs) const
         {
@@ -121,6 +139,8 @@ namespace /*anonymous*/
     struct layouter<msc::algorithms::spring_embedder_kk> final
     {
 
+        static constexpr bool uses_legacy_random = true;
+
         template <typename EngineT>
         void operator()(EngineT& /*engine*/, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs) const
         {
@@ -142,6 +162,8 @@ namespace /*anonymous*/
     struct layouter<msc::algorithms::pivot_mds> final
     {
 
+        static constexpr bool uses_legacy_random = false;
+
         template <typename EngineT>
         void operator()(EngineT& /*engine*/, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs) const
         {
@@ -156,33 +178,94 @@ namespace /*anonymous*/
 
     };
 
-    template <typename EngineT>
-    void do_layout(EngineT& engine, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs, const msc::algorithms algo)
+    template <msc::algorithms Algo, typename EngineT>
+    void do_layout(EngineT& engine, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs)
     {
         // Nobody knows how non-determinism works in the OGDF.  Probably, it doesn't...
-        std::srand(std::uniform_int_distribution<unsigned>{}(engine));
+        const auto srandseed = std::uniform_int_distribution<unsigned>{}(engine);
         ogdf::setSeed(std::uniform_int_distribution<int>{}(engine));
+        // The seed for `std::rand` is drawn in any case so the remaining random numbers don't depend on the algorithm.
+        // The shared generator must only be touched while holding the lock, though.
+        auto lock = std::unique_lock<std::mutex>{msc::legacy_random_mutex(), std::defer_lock};
+        if constexpr (layouter<Algo>::uses_legacy_random) {
+            lock.lock();
+            std::srand(srandseed);
+        }
+        layouter<Algo>{}(engine, graph, attrs);
+    }
+
+    template <typename EngineT>
+    void do_layout(EngineT& engine, const ogdf::Graph& graph, ogdf::GraphAttributes& attrs, const msc::algorithms algo)
+    {
+        const auto timer = msc::profile_timer{"compute"};
         switch (algo) {
         case msc::algorithms::fmmm:
-            return layouter<msc::algorithms::fmmm>{}(engine, graph, attrs);
+            return do_layout<msc::algorithms::fmmm>(engine, graph, attrs);
         case msc::algorithms::stress:
-            return layouter<msc::algorithms::stress>{}(engine, graph, attrs);
+            return do_layout<msc::algorithms::stress>(engine, graph, attrs);
         case msc::algorithms::davidson_harel:
-            return layouter<msc::algorithms::davidson_harel>{}(engine, graph, attrs);
+            return do_layout<msc::algorithms::davidson_harel>(engine, graph, attrs);
         case msc::algorithms::spring_embedder_kk:
-            return layouter<msc::algorithms::spring_embedder_kk>{}(engine, graph, attrs);
+            return do_layout<msc::algorithms::spring_embedder_kk>(engine, graph, attrs);
         case msc::algorithms::pivot_mds:
-            return layouter<msc::algorithms::pivot_mds>{}(engine, graph, attrs);
+            return do_layout<msc::algorithms::pivot_mds>(engine, graph, attrs);
         }
         msc::reject_invalid_enumeration(static_cast<int>(algo), "algorithms");
     }
 
+    // Initializes `attrs` with a quickly computed coarse placement of the graph that the regular FMMM layout will then
+    // refine via `newInitialPlacement(false)`.  The placement is seeded from `engine` so each replica still starts from
+    // its own random placement.  Since the OGDF does not expose the multilevel hierarchy of FMMM, the coarse placement
+    // is what gets cached, keyed by the graph fingerprint and the seed.  Exactly one random number is drawn from
+    // `engine` in any case and the coordinates are cached exactly so the final layout doesn't depend on whether the
+    // cache was hit.
+    template <typename EngineT>
+    void warm_start_fmmm(EngineT& engine,
+                         const ogdf::Graph& graph,
+                         const std::string& graphid,
+                         ogdf::GraphAttributes& attrs)
+    {
+        const auto seed = std::uniform_int_distribution<int>{}(engine);
+        const auto key = msc::concat("fmmm-coarse-", graphid, "-", std::to_string(seed));
+        attrs.init(graph, layout_features);
+        if (const auto cached = msc::load_cached_values(key)) {
+            if (cached->size() == 2 * static_cast<std::size_t>(graph.numberOfNodes())) {
+                auto it = std::cbegin(*cached);
+                for (const auto v : graph.nodes) {
+                    attrs.x(v) = *it++;
+                    attrs.y(v) = *it++;
+                }
+                return;
+            }
+        }
+        auto layout = ogdf::FMMMLayout{};
+        layout.randSeed(seed);
+        layout.useHighLevelOptions(true);
+        layout.qualityVersusSpeed(ogdf::FMMMOptions::QualityVsSpeed::NiceAndIncredibleSpeed);
+        layout.newInitialPlacement(true);
+        {
+            const auto lock = std::lock_guard<std::mutex>{msc::legacy_random_mutex()};
+            std::srand(static_cast<unsigned>(seed));
+            ogdf::setSeed(seed);
+            layout.call(attrs);
+        }
+        auto values = std::vector<double>{};
+        values.reserve(2 * static_cast<std::size_t>(graph.numberOfNodes()));
+        for (const auto v : graph.nodes) {
+            values.push_back(attrs.x(v));
+            values.push_back(attrs.y(v));
+        }
+        msc::store_cached_values(key, values);
+    }
+
     struct cli_parameters
     {
         msc::input_file input{"-"};
         msc::output_file output{"-"};
         msc::output_file meta{};
-        msc::algorithms algorithm{};
+        std::vector<msc::algorithms> algorithm{};
+        int replicas{1};
+        bool warm_start{};
         bool layout{};
     };
 
@@ -192,6 +275,18 @@ namespace /*anonymous*/
         void operator()() const;
     };
 
+    // A single layout to compute.  In batch mode, each task has its own seed that is derived from the master seed.  If
+    // the environment variable `MSC_RANDOM_SEED` is set to that seed and the program is run for the single algorithm,
+    // the exact same layout will be produced again.
+    struct task final
+    {
+        msc::algorithms algorithm{};
+        std::size_t replica{};
+        std::string seed{};
+        msc::output_file output{};
+        std::unique_ptr<ogdf::GraphAttributes> attrs{};
+    };
+
     msc::json_object get_info(const ogdf::GraphAttributes& attrs,
                               const msc::algorithms algo,
                               const msc::output_file& dst,
@@ -209,6 +304,14 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::json_object get_subinfo(const task& job)
+    {
+        auto info = get_info(*job.attrs, job.algorithm, job.output, job.seed);
+        info.erase("producer");
+        info["replica"] = msc::json_size{job.replica};
+        return info;
+    }
+
     void application::operator()() const
     {
         auto rndeng = std::default_random_engine{};
@@ -219,13 +322,52 @@ namespace /*anonymous*/
             std::tie(graph, attrs) = msc::load_layout(this->parameters.input);
         } else {
             graph = msc::load_graph(this->parameters.input);
-            attrs = std::make_unique<ogdf::GraphAttributes>();
         }
-        do_layout(rndeng, *graph, *attrs, this->parameters.algorithm);
-        msc::normalize_layout(*attrs);
-        msc::store_layout(*attrs, this->parameters.output);
-        const auto info = get_info(*attrs, this->parameters.algorithm, this->parameters.output, seed);
-        msc::print_meta(info, this->parameters.meta);
+        const auto replicas = static_cast<std::size_t>(this->parameters.replicas);
+        const auto batch = (this->parameters.algorithm.size() * replicas > 1);
+        auto tasks = std::vector<task>{};
+        for (const auto algo : this->parameters.algorithm) {
+            for (auto r = std::size_t{}; r < replicas; ++r) {
+                auto& job = tasks.emplace_back();
+                job.algorithm = algo;
+                job.replica = r;
+                job.seed = batch ? msc::random_hex_string(rndeng, 24) : seed;
+                job.output = batch ? msc::expand_filename(this->parameters.output, tasks.size() - 1)
+                                   : this->parameters.output;
+            }
+        }
+        const auto warm = this->parameters.warm_start && !attrs;
+        const auto graphid = warm ? msc::graph_fingerprint(*graph) : std::string{};
+        msc::parallel_for(tasks.size(), [&tasks, &graph, &attrs, warm, &graphid](const std::size_t i){
+            auto& job = tasks[i];
+            auto engine = std::default_random_engine{};
+            msc::seed_random_engine(engine, job.seed);
+            job.attrs = attrs ? std::make_unique<ogdf::GraphAttributes>(*attrs)
+                              : std::make_unique<ogdf::GraphAttributes>();
+            if (warm && (job.algorithm == msc::algorithms::fmmm)) {
+                warm_start_fmmm(engine, *graph, graphid, *job.attrs);
+            }
+            do_layout(engine, *graph, *job.attrs, job.algorithm);
+            msc::normalize_layout(*job.attrs);
+        });
+        // The layouts are written sequentially because multiple tasks might share the same output file.
+        for (const auto& job : tasks) {
+            msc::store_layout(*job.attrs, job.output);
+        }
+        if (batch) {
+            auto info = msc::json_object{};
+            auto data = msc::json_array{};
+            for (const auto& job : tasks) {
+                data.push_back(get_subinfo(job));
+            }
+            info["seed"] = seed;
+            info["producer"] = PROGRAM_NAME;
+            info["data"] = std::move(data);
+            msc::print_meta(info, this->parameters.meta);
+        } else {
+            const auto& job = tasks.front();
+            msc::print_meta(get_info(*job.attrs, job.algorithm, job.output, seed), this->parameters.meta);
+        }
     }
 
 }  // namespace /*anonymous*/
@@ -234,5 +376,20 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Computes a layout for the given graph using the specified fore-directed algorithm.");
+    app.help.push_back(
+        "If more than one algorithm is given or more than one replica is requested, the graph is only loaded once and"
+        " the layouts are computed concurrently.  Each layout is then seeded independently and the meta data will"
+        " contain one entry per layout in the 'data' array.  The 'seed' reported for each layout can be used to"
+        " reproduce it individually."
+    );
+    app.help.push_back(msc::helptext_file_name_expansion());
+    app.help.push_back(
+        "With --warm-start, each FMMM layout (that is not given an initial layout) is refined from a quick coarse"
+        " placement of its own.  If the environment variable MSC_CACHE_DIR is set, these placements are cached per"
+        " graph and seed so re-running with the same seed skips computing them.  The result is the same whether the"
+        " cache is used or not but differs from the layout computed without --warm-start."
+    );
+    app.environ["MSC_JOBS"] = "maximum number of layouts to compute concurrently";
+    app.environ["MSC_CACHE_DIR"] = "directory for caching coarse FMMM placements (only used with --warm-start)";
     return app(argc, argv);
 }
@@ -37,6 +37,7 @@
 #include "meta.hxx"
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
+#include "profile.hxx"
 #include "random.hxx"
 
 #define PROGRAM_NAME "phantom"
@@ -63,6 +64,7 @@ namespace /*anonymous*/
     std::unique_ptr<ogdf::GraphAttributes>
     make_phantom_layout(EngineT& engine, const ogdf::Graph& graph)
     {
+        const auto timer = msc::profile_timer{"compute"};
         const auto _graph = make_random_graph(engine, graph.numberOfNodes(), graph.numberOfEdges());
         auto _attrs = std::make_unique<ogdf::GraphAttributes>(*_graph);
         auto layout = ogdf::FMMMLayout{};
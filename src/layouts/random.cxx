@@ -35,6 +35,7 @@
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
 #include "point.hxx"
+#include "profile.hxx"
 #include "random.hxx"
 #include "useful.hxx"
 
@@ -59,6 +60,7 @@ namespace /*anonymous*/
     std::unique_ptr<ogdf::GraphAttributes>
     make_random_layout(const ogdf::Graph& graph, EngineT& engine, const msc::distributions dist)
     {
+        const auto timer = msc::profile_timer{"compute"};
         switch (dist) {
         case msc::distributions::uniform:
             return make_random_layout_with_distribution(graph, std::uniform_real_distribution<>{}, engine);
@@ -20,8 +20,10 @@
 
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -29,6 +31,7 @@
 #include <ogdf/layered/SugiyamaLayout.h>
 
 #include "cli.hxx"
+#include "concurrency.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
 #include "io.hxx"
@@ -36,6 +39,7 @@
 #include "meta.hxx"
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
+#include "profile.hxx"
 #include "random.hxx"
 
 #define PROGRAM_NAME "sugiyama"
@@ -43,12 +47,22 @@
 namespace /*anonymous*/
 {
 
-    auto do_layout(const ogdf::Graph& graph) -> std::unique_ptr<ogdf::GraphAttributes>
+    template <typename EngineT>
+    auto do_layout(EngineT& engine, const ogdf::Graph& graph) -> std::unique_ptr<ogdf::GraphAttributes>
     {
+        const auto timer = msc::profile_timer{"compute"};
         auto attrs = std::make_unique<ogdf::GraphAttributes>(graph);
         attrs->directed() = false;
-        auto layout = ogdf::SugiyamaLayout{};
-        layout.call(*attrs);
+        const auto srandseed = std::uniform_int_distribution<unsigned>{}(engine);
+        ogdf::setSeed(std::uniform_int_distribution<int>{}(engine));
+        {
+            // The crossing minimization might use `std::rand` which is shared by all threads.  It cannot be separated
+            // from the other phases of the OGDF's implementation so the whole layout is computed under the lock.
+            const auto lock = std::lock_guard<std::mutex>{msc::legacy_random_mutex()};
+            std::srand(srandseed);
+            auto layout = ogdf::SugiyamaLayout{};
+            layout.call(*attrs);
+        }
         msc::normalize_layout(*attrs);
         return attrs;
     }
@@ -58,6 +72,7 @@ namespace /*anonymous*/
         msc::input_file input{"-"};
         msc::output_file output{"-"};
         msc::output_file meta{};
+        int replicas{1};
     };
 
     struct application final
@@ -83,12 +98,39 @@ namespace /*anonymous*/
     {
         auto rndeng = std::default_random_engine{};
         const auto seed = msc::seed_random_engine(rndeng);
-        std::srand(std::uniform_int_distribution<unsigned>{}(rndeng));
-        ogdf::setSeed(std::uniform_int_distribution<int>{}(rndeng));
         const auto graph = msc::load_graph(this->parameters.input);
-        const auto attrs = do_layout(*graph);
-        msc::store_layout(*attrs, this->parameters.output);
-        const auto info = get_info(*attrs, this->parameters.output, seed);
+        const auto replicas = static_cast<std::size_t>(this->parameters.replicas);
+        if (replicas == 1) {
+            const auto attrs = do_layout(rndeng, *graph);
+            msc::store_layout(*attrs, this->parameters.output);
+            const auto info = get_info(*attrs, this->parameters.output, seed);
+            msc::print_meta(info, this->parameters.meta);
+            return;
+        }
+        auto seeds = std::vector<std::string>(replicas);
+        for (auto& subseed : seeds) {
+            subseed = msc::random_hex_string(rndeng, 24);
+        }
+        // The layouts are computed one after another because `do_layout` would serialize them anyway.
+        auto layouts = std::vector<std::unique_ptr<ogdf::GraphAttributes>>(replicas);
+        for (auto i = std::size_t{}; i < replicas; ++i) {
+            auto engine = std::default_random_engine{};
+            msc::seed_random_engine(engine, seeds[i]);
+            layouts[i] = do_layout(engine, *graph);
+        }
+        auto data = msc::json_array{};
+        for (auto i = std::size_t{}; i < replicas; ++i) {
+            const auto dst = msc::expand_filename(this->parameters.output, i);
+            msc::store_layout(*layouts[i], dst);
+            auto subinfo = get_info(*layouts[i], dst, seeds[i]);
+            subinfo.erase("producer");
+            subinfo["replica"] = msc::json_size{i};
+            data.push_back(std::move(subinfo));
+        }
+        auto info = msc::json_object{};
+        info["seed"] = seed;
+        info["producer"] = PROGRAM_NAME;
+        info["data"] = std::move(data);
         msc::print_meta(info, this->parameters.meta);
     }
 
@@ -98,5 +140,12 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Computes a Sugiyama layout for the given graph.");
+    app.help.push_back(
+        "If more than one replica is requested, the graph is only loaded once and the layouts are computed one after"
+        " another with independent seeds.  (They cannot run concurrently because the OGDF's implementation uses the"
+        " C library's global random number generator.)  The meta data will then contain one entry per layout in the"
+        " 'data' array."
+    );
+    app.help.push_back(msc::helptext_file_name_expansion());
     return app(argc, argv);
 }
@@ -33,6 +33,7 @@
 #include "json.hxx"
 #include "math_constants.hxx"
 #include "meta.hxx"
+#include "profile.hxx"
 #include "stochastic.hxx"
 
 #define PROGRAM_NAME "huang"
@@ -67,6 +68,7 @@ namespace /*anonymous*/
     void application::operator()() const
     {
         const auto [graph, attrs] = msc::load_layout(this->parameters.input);
+        auto compute = msc::profile_timer{"compute"};
         const auto crossings = msc::find_edge_crossings(*attrs);
         const auto cross_count = crossings.size();
         const auto cross_resolution = [&attrs, &crossings]()->double{
@@ -82,6 +84,7 @@ namespace /*anonymous*/
         const auto angular_resolution = *std::min_element(std::begin(angular), std::end(angular));
         const auto edge_lengths = msc::get_all_edge_lengths(*attrs);
         const auto edge_length_stdev = msc::mean_stdev(edge_lengths).second;
+        compute.stop();
         msc::print_meta(get_info(cross_count, cross_resolution, angular_resolution, edge_length_stdev),
                         this->parameters.meta);
     }
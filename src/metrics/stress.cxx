@@ -18,14 +18,21 @@
 #  include <config.h>
 #endif
 
+#include <optional>
+#include <string>
+
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
+#include "planner.hxx"
+#include "profile.hxx"
 #include "stress.hxx"
+#include "useful.hxx"
 
 #define PROGRAM_NAME "stress"
 
@@ -65,17 +72,84 @@ namespace /*anonymous*/
         return info;
     }
 
-    void application::operator()() const
+    std::optional<msc::stress_moments> load_moments(const std::optional<std::string>& key)
     {
-        const auto [graph, attrs] = msc::load_layout(this->parameters.input);
-        switch (this->parameters.stress_modus) {
+        if (const auto values = key ? msc::load_cached_values(*key) : std::nullopt) {
+            if (values->size() == 3) {
+                return msc::stress_moments{(*values)[0], (*values)[1], (*values)[2]};
+            }
+        }
+        return std::nullopt;
+    }
+
+    // If the layout was derived from another one by moving only a few nodes (see `flip-nodes`) and the stress moments
+    // of that layout are cached, the moments are updated incrementally.  Otherwise, they are computed from scratch.
+    msc::stress_moments get_moments(const ogdf::GraphAttributes& attrs,
+                                    const msc::strategies strategy,
+                                    const std::string& key,
+                                    std::string& method)
+    {
+        if (const auto cached = load_moments(key)) {
+            method = "cached";
+            return *cached;
+        }
+        auto parent = ogdf::GraphAttributes{attrs.constGraph(), attrs.attributes()};
+        if (const auto lineage = msc::load_cached_lineage(attrs, parent)) {
+            if (2 * lineage->moved.size() < static_cast<std::size_t>(attrs.constGraph().numberOfNodes())) {
+                if (const auto original = load_moments(msc::get_property_cache_key(PROGRAM_NAME, lineage->parent))) {
+                    method = "incremental";
+                    return msc::update_stress_moments(*original, parent, attrs, lineage->moved, lineage->scale);
+                }
+            }
+        }
+        method = "full";
+        return msc::compute_stress_moments(attrs, strategy);
+    }
+
+    msc::json_object get_info(const msc::stress_moments& moments, const msc::stress_modi modus)
+    {
+        switch (modus) {
         case msc::stress_modi::fixed:
-            return msc::print_meta(get_info(msc::compute_stress(*attrs)), this->parameters.meta);
+            return get_info(msc::get_stress(moments, msc::default_node_distance));
         case msc::stress_modi::fit_nodesep:
-            return msc::print_meta(get_info(msc::compute_stress_fit_nodesep(*attrs), "nodesep"), this->parameters.meta);
+            return get_info(msc::get_stress_fit_nodesep(moments), "nodesep");
         case msc::stress_modi::fit_scale:
-            return msc::print_meta(get_info(msc::compute_stress_fit_scale(*attrs), "scale"), this->parameters.meta);
+            return get_info(msc::get_stress_fit_scale(moments), "scale");
+        }
+        msc::reject_invalid_enumeration(modus, "msc::stress_modi");
+    }
+
+    void application::operator()() const
+    {
+        const auto [graph, attrs] = msc::load_layout(this->parameters.input);
+        const auto plan = msc::plan_pairwise_distances(
+            *graph, {msc::strategies::full, msc::strategies::compact, msc::strategies::external}
+        );
+        auto compute = msc::profile_timer{"compute"};
+        auto info = msc::json_object{};
+        if (const auto key = msc::get_property_cache_key(PROGRAM_NAME, *attrs)) {
+            // The stress moments are cached so the stress of layouts derived from this one can be updated cheaply.
+            auto method = std::string{};
+            const auto moments = get_moments(*attrs, plan.strategy, *key, method);
+            msc::store_cached_values(*key, {moments.count, moments.linear, moments.quadratic});
+            info = get_info(moments, this->parameters.stress_modus);
+            info["moments"] = method;
+        } else {
+            switch (this->parameters.stress_modus) {
+            case msc::stress_modi::fixed:
+                info = get_info(msc::compute_stress(*attrs, msc::default_node_distance, plan.strategy));
+                break;
+            case msc::stress_modi::fit_nodesep:
+                info = get_info(msc::compute_stress_fit_nodesep(*attrs, plan.strategy), "nodesep");
+                break;
+            case msc::stress_modi::fit_scale:
+                info = get_info(msc::compute_stress_fit_scale(*attrs, plan.strategy), "scale");
+                break;
+            }
         }
+        compute.stop();
+        info["distances"] = msc::get_distance_plan_info(plan);
+        msc::print_meta(info, this->parameters.meta);
     }
 
 }  // namespace /*anonymous*/
@@ -84,5 +158,10 @@ int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
     app.help.push_back("Computes the stress function for a normalized layout.");
+    app.help.push_back(
+        "If caching is enabled, the sums that determine the stress are cached.  For a layout that was derived by"
+        " flip-nodes from a layout whose stress is already cached, only the terms for pairs involving a moved node are"
+        " then recomputed."
+    );
     return app(argc, argv);
 }
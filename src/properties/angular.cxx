@@ -26,12 +26,14 @@
 #include <ogdf/basic/GraphAttributes.h>
 
 #include "angular.hxx"
+#include "cache.hxx"
 #include "cli.hxx"
 #include "data_analysis.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "math_constants.hxx"
 #include "meta.hxx"
+#include "profile.hxx"
 #include "useful.hxx"
 
 #define PROGRAM_NAME "angular"
@@ -57,8 +59,11 @@ namespace /*anonymous*/
         const auto [graph, attrs] = msc::load_layout(this->parameters.input);
         auto info = basic_info();
         auto subinfos = msc::json_array{};
+        auto compute = msc::profile_timer{"compute"};
         auto angles = msc::get_all_angles_between_adjacent_incident_edges(*attrs, msc::treatments::ignore);
+        compute.stop();
         auto analyzer = msc::data_analyzer{this->parameters.kernel};
+        analyzer.set_cache_key(msc::get_property_cache_key(PROGRAM_NAME, *attrs));
         auto entropies = msc::initialize_entropies();
         analyzer.set_range(0.0, 2.0 * M_PI);
         for (std::size_t i = 0; i < this->parameters.iterations(); ++i) {
@@ -24,12 +24,14 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
 #include "data_analysis.hxx"
 #include "edge_length.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
+#include "profile.hxx"
 #include "useful.hxx"
 
 #define PROGRAM_NAME "edge-length"
@@ -55,8 +57,11 @@ namespace /*anonymous*/
         const auto [graph, attrs] = msc::load_layout(this->parameters.input);
         auto info = basic_info();
         auto subinfos = msc::json_array{};
+        auto compute = msc::profile_timer{"compute"};
         auto lengths = msc::get_all_edge_lengths(*attrs);
+        compute.stop();
         auto analyzer = msc::data_analyzer{this->parameters.kernel};
+        analyzer.set_cache_key(msc::get_property_cache_key(PROGRAM_NAME, *attrs));
         auto entropies = msc::initialize_entropies();
         for (std::size_t i = 0; i < this->parameters.iterations(); ++i) {
             auto subinfo = msc::json_object{};
@@ -37,6 +37,7 @@
 #include "meta.hxx"
 #include "point.hxx"
 #include "princomp.hxx"
+#include "profile.hxx"
 #include "random.hxx"
 
 #define PROGRAM_NAME "princomp"
@@ -141,7 +142,9 @@ namespace /*anonymous*/
         auto engine = std::mt19937{};
         const auto seed = msc::seed_random_engine(engine);
         const auto coords = load_layout_as_point_cloud(this->parameters.input);
+        auto compute = msc::profile_timer{"compute"};
         const auto axis = find_axis(coords, engine, this->parameters.component);
+        compute.stop();
         auto info = basic_info(seed);
         info["component"] = point2json(axis);
         auto subinfos = msc::json_array{};
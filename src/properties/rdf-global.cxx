@@ -24,6 +24,7 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
 #include "data_analysis.hxx"
 #include "io.hxx"
@@ -59,6 +60,7 @@ namespace /*anonymous*/
         auto subinfos = msc::json_array{};
         auto distances = msc::global_pairwise_distances{*attrs};
         auto analyzer = msc::data_analyzer{this->parameters.kernel};
+        analyzer.set_cache_key(msc::get_property_cache_key(PROGRAM_NAME, *attrs));
         auto entropies = msc::initialize_entropies();
         analyzer.set_range(0.0, maxdist);
         for (std::size_t i = 0; i < this->parameters.iterations(); ++i) {
@@ -18,45 +18,58 @@
 #  include <config.h>
 #endif
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "bootstrap.hxx"
+#include "cache.hxx"
 #include "cli.hxx"
 #include "data_analysis.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
 #include "ogdf_fix.hxx"
+#include "planner.hxx"
 #include "point.hxx"
+#include "random.hxx"
 #include "rdf.hxx"
+#include "strings.hxx"
 
 #define PROGRAM_NAME "rdf-local"
 
 namespace /*anonymous*/
 {
 
-    double get_longest_path(const msc::ogdf_node_array_2d<double>& matrix, const ogdf::Graph& graph) noexcept
+    double get_longest_path(const msc::distance_matrix& matrix) noexcept
     {
+        // Only pairs within the same component are visited so all distances are finite.
         auto longest = 0.0;
-        for (auto v1 = graph.firstNode(); v1 != nullptr; v1 = v1->succ()) {
-            for (auto v2 = v1->succ(); v2 != nullptr; v2 = v2->succ()) {
-                const auto v1tov2 = matrix[v1][v2];
-                // OGDF inserts nonsensical large but finite values into the matrix for unreachable nodes.
-                if ((v1tov2 <= graph.numberOfNodes()) && (v1tov2 > longest)) {
-                    longest = v1tov2;
-                }
+        for (auto v1 = matrix.first_node(); v1 != nullptr; v1 = matrix.next_node(v1)) {
+            for (auto v2 = matrix.first_partner(v1); v2 != nullptr; v2 = matrix.next_partner(v1, v2)) {
+                longest = std::max(longest, matrix(v1, v2));
             }
         }
         return longest;
     }
 
+    struct cli_parameters : msc::cli_parameters_property_local
+    {
+        std::optional<int> landmarks{};
+    };
+
     struct application final
     {
-        msc::cli_parameters_property_local parameters{};
+        cli_parameters parameters{};
         void operator()() const;
     };
 
@@ -67,15 +80,40 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::distance_plan plan_distances(const ogdf::Graph& graph, const std::optional<int> landmarks)
+    {
+        if (landmarks) {
+            return msc::plan_pairwise_distances(graph, {msc::strategies::sampled}, *landmarks);
+        }
+        using msc::strategies;
+        return msc::plan_pairwise_distances(
+            graph, {strategies::full, strategies::compact, strategies::external, strategies::sampled}
+        );
+    }
+
+    std::optional<std::string> get_vicinity_cache_key(const std::optional<std::string>& cachekey, const double vicinity)
+    {
+        if (!cachekey) {
+            return std::nullopt;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%a", vicinity);
+        return msc::concat(*cachekey, "-", buffer);
+    }
+
+    template <typename RangeT>
     msc::json_object
     do_local_rdf_for_vicinity(const msc::cli_parameters_property& params,
-                              const msc::local_pairwise_distances& distances,
-                              const int counter)
+                              const RangeT& distances,
+                              const double vicinity,
+                              const int counter,
+                              const std::optional<std::string>& cachekey)
     {
         auto info = msc::json_object{};
         auto data = msc::json_array{};
         auto entropies = msc::initialize_entropies();
         auto analyzer = msc::data_analyzer{params.kernel};
+        analyzer.set_cache_key(get_vicinity_cache_key(cachekey, vicinity));
         for (std::size_t i = 0; i < params.iterations(); ++i) {
             auto subinfo = msc::json_object{};
             analyzer.set_width(msc::get_item(params.width, i));
@@ -91,11 +129,105 @@ namespace /*anonymous*/
             throw std::runtime_error{"Not enough data for a statistical analysis"};
         }
         msc::assign_entropy_regression(entropies, info);
-        info["vicinity"] = msc::json_real{distances.limit()};
+        info["vicinity"] = msc::json_real{vicinity};
         info["data"] = std::move(data);
         return info;
     }
 
+    // Computes the local RDF for one vicinity after another.  Unless landmarks were requested explicitly, the pairs
+    // within each vicinity are collected by depth-limited breadth-first searches, which only need time and memory
+    // proportional to their number.  The distance matrix (with the planned strategy) is only computed once a vicinity
+    // contains more pairs than fit into the memory budget.  Unless the distances are sampled, the analyses are cached
+    // under the given key.
+    class vicinity_analyzer final
+    {
+    public:
+
+        vicinity_analyzer(const cli_parameters& params,
+                          const ogdf::GraphAttributes& attrs,
+                          const msc::distance_plan& plan,
+                          msc::philox_engine& engine,
+                          std::optional<std::string> cachekey)
+            : _params{&params}, _attrs{&attrs}, _plan{&plan}, _engine{&engine}, _cachekey{std::move(cachekey)}
+        {
+            if (plan.budget) {
+                _capacity = (*plan.budget - *plan.budget / 8) / sizeof(double);
+            }
+            if (params.landmarks) {
+                _compute_matrix();
+            }
+        }
+
+        msc::json_object operator()(const double vicinity, const int counter)
+        {
+            if (_matrix == nullptr) {
+                if (const auto sample = msc::get_vicinity_sample(*_attrs, vicinity, _capacity)) {
+                    if (sample->complete) {
+                        _diameter = sample->longest;
+                    }
+                    return do_local_rdf_for_vicinity(*_params, sample->distances, vicinity, counter, _cachekey);
+                }
+                _compute_matrix();
+            }
+            const auto sampled = (_plan->strategy == msc::strategies::sampled);
+            const auto distances = msc::local_pairwise_distances{*_attrs, *_matrix, vicinity};
+            auto info = do_local_rdf_for_vicinity(
+                *_params, distances, vicinity, counter, sampled ? std::nullopt : _cachekey
+            );
+            // With landmarks, the distances are a sample and their errors are estimated by the bootstrap using the
+            // sub-stream of the engine for the vicinity.
+            if (sampled) {
+                const auto groups = msc::group_by_first_node(std::begin(distances), std::end(distances));
+                msc::assign_bootstrap_error(msc::get_bootstrap_error(groups, _engine->substream(counter)), info);
+            }
+            return info;
+        }
+
+        // Tells whether the vicinity is known to be at least the diameter.
+        bool reaches_diameter(const double vicinity) const noexcept
+        {
+            return _diameter && (vicinity >= *_diameter);
+        }
+
+        // Tells whether the vicinity is known to exceed the diameter.
+        bool exceeds_diameter(const double vicinity) const noexcept
+        {
+            return _diameter && (vicinity > *_diameter);
+        }
+
+        double diameter()
+        {
+            if (!_diameter) {
+                _diameter = static_cast<double>(msc::get_graph_diameter(_attrs->constGraph()));
+            }
+            return *_diameter;
+        }
+
+        bool has_matrix() const noexcept
+        {
+            return (_matrix != nullptr);
+        }
+
+    private:
+
+        void _compute_matrix()
+        {
+            const auto& graph = _attrs->constGraph();
+            _matrix = msc::get_shortest_paths(graph, _plan->strategy, _plan->landmarks, *_engine);
+            _diameter = get_longest_path(*_matrix);
+        }
+
+        const cli_parameters* _params{};
+        const ogdf::GraphAttributes* _attrs{};
+        const msc::distance_plan* _plan{};
+        msc::philox_engine* _engine{};
+        std::size_t _capacity{std::numeric_limits<std::size_t>::max()};
+        std::optional<std::string> _cachekey{};
+        std::unique_ptr<msc::distance_matrix> _matrix{};
+        std::optional<double> _diameter{};
+
+    };  // class vicinity_analyzer
+
     struct file_name_nullifier final
     {
         template <typename JsonT>
@@ -140,33 +272,38 @@ namespace /*anonymous*/
     void application::operator()() const
     {
         const auto [graph, attrs] = msc::load_layout(this->parameters.input);
-        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
-        const auto longestpath = get_longest_path(*matrix, *graph);
-        auto distances = msc::local_pairwise_distances{*attrs, *matrix, NAN};
+        const auto plan = plan_distances(*graph, this->parameters.landmarks);
+        auto engine = msc::philox_engine{};
+        const auto seed = msc::seed_random_engine(engine);
+        const auto cachekey = msc::get_property_cache_key(PROGRAM_NAME, *attrs);
+        auto analyzer = vicinity_analyzer{this->parameters, *attrs, plan, engine, cachekey};
         auto sequence = msc::json_array{};
         if (this->parameters.vicinity.empty()) {
             for (auto vicinity = 1.0; true; vicinity *= 2.0) {
-                distances.set_limit(vicinity);
-                sequence.push_back(do_local_rdf_for_vicinity(this->parameters, distances, sequence.size()));
-                if (vicinity >= longestpath) { break; }
+                sequence.push_back(analyzer(vicinity, sequence.size()));
+                if (analyzer.reaches_diameter(vicinity)) { break; }
             }
         } else {
             auto global = msc::json_object{};
             for (const auto vicinity : this->parameters.vicinity) {
-                if ((vicinity > longestpath) && !global.empty()) {
+                if (analyzer.exceeds_diameter(vicinity) && !global.empty()) {
                     sequence.push_back(make_local_info(global, vicinity));
                     continue;
                 }
-                distances.set_limit(vicinity);
-                sequence.push_back(do_local_rdf_for_vicinity(this->parameters, distances, sequence.size()));
-                if ((vicinity > longestpath) && global.empty()) {
+                sequence.push_back(analyzer(vicinity, sequence.size()));
+                if (analyzer.exceeds_diameter(vicinity) && global.empty()) {
                     global = make_global_info(std::get<msc::json_object>(sequence.back()));
                 }
             }
         }
         auto info = basic_info();
         info["data"] = std::move(sequence);
-        info["diameter"] = msc::json_real{longestpath};
+        info["diameter"] = msc::json_real{analyzer.diameter()};
+        info["distances"] = msc::get_distance_plan_info(plan);
+        std::get<msc::json_object>(info["distances"])["matrix"] = msc::json_bool{analyzer.has_matrix()};
+        if (plan.strategy == msc::strategies::sampled) {
+            info["seed"] = seed;
+        }
         msc::print_meta(info, this->parameters.meta);
     }
 
@@ -179,6 +316,16 @@ int main(const int argc, const char *const *const argv)
         "Computes the local radial distribution function (RDF) for a graph layout.  Local means that only pairs of"
         " nodes will be considered for which the shortest path does not exceed a given vicinity."
     );
+    app.help.push_back(
+        "The pairs of nodes within a vicinity are found by breadth-first searches from every node that stop at the"
+        " vicinity.  The matrix of all pairwise distances is only computed if there are more such pairs than fit into"
+        " memory."
+    );
+    app.help.push_back(
+        "If the pairwise distances don't fit into memory or --landmarks is given, the distribution is estimated from"
+        " the pairs that involve a random sample of nodes and the standard errors of the mean and entropy are estimated"
+        " by the bootstrap.  The reported diameter is then the largest eccentricity of any sampled node."
+    );
     app.help.push_back(msc::helptext_file_name_expansion());
     return app(argc, argv);
 }
@@ -19,17 +19,22 @@
 #endif
 
 #include <cstddef>
+#include <optional>
 #include <utility>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "bootstrap.hxx"
+#include "cache.hxx"
 #include "cli.hxx"
 #include "data_analysis.hxx"
 #include "io.hxx"
 #include "json.hxx"
 #include "meta.hxx"
 #include "normalizer.hxx"
+#include "planner.hxx"
+#include "random.hxx"
 #include "tension.hxx"
 #include "useful.hxx"
 
@@ -38,9 +43,14 @@
 namespace /*anonymous*/
 {
 
+    struct cli_parameters : msc::cli_parameters_property
+    {
+        std::optional<int> landmarks{};
+    };
+
     struct application final
     {
-        msc::cli_parameters_property parameters{};
+        cli_parameters parameters{};
         void operator()() const;
     };
 
@@ -51,15 +61,37 @@ namespace /*anonymous*/
         return info;
     }
 
+    msc::distance_plan plan_distances(const ogdf::Graph& graph, const std::optional<int> landmarks)
+    {
+        if (landmarks) {
+            return msc::plan_pairwise_distances(graph, {msc::strategies::sampled}, *landmarks);
+        }
+        using msc::strategies;
+        return msc::plan_pairwise_distances(
+            graph, {strategies::full, strategies::compact, strategies::external, strategies::sampled}
+        );
+    }
+
     void application::operator()() const
     {
         const auto [graph, attrs] = msc::load_layout(this->parameters.input);
+        const auto cachekey = msc::get_property_cache_key(PROGRAM_NAME, *attrs);
         attrs->scale(1.0 / msc::default_node_distance);
-        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
+        const auto plan = plan_distances(*graph, this->parameters.landmarks);
+        auto engine = msc::philox_engine{};
+        const auto seed = msc::seed_random_engine(engine);
+        const auto matrix = msc::get_shortest_paths(*graph, plan.strategy, plan.landmarks, engine);
         auto info = basic_info();
+        info["distances"] = msc::get_distance_plan_info(plan);
+        if (plan.strategy == msc::strategies::sampled) {
+            info["seed"] = seed;
+        }
         auto subinfos = msc::json_array{};
         const auto tension = msc::pairwise_tension{*attrs, *matrix, graph->numberOfNodes() + 1.0};
         auto analyzer = msc::data_analyzer{this->parameters.kernel};
+        if (plan.strategy != msc::strategies::sampled) {
+            analyzer.set_cache_key(cachekey);
+        }
         auto entropies = msc::initialize_entropies();
         for (std::size_t i = 0; i < this->parameters.iterations(); ++i) {
             auto subinfo = msc::json_object{};
@@ -73,6 +105,10 @@ namespace /*anonymous*/
         }
         info["data"] = std::move(subinfos);
         msc::assign_entropy_regression(entropies, info);
+        if (plan.strategy == msc::strategies::sampled) {
+            const auto groups = msc::group_by_first_node(std::begin(tension), std::end(tension));
+            msc::assign_bootstrap_error(msc::get_bootstrap_error(groups, engine), info);
+        }
         msc::print_meta(info, this->parameters.meta);
     }
 
@@ -84,6 +120,11 @@ int main(const int argc, const char *const *const argv)
     app.help.push_back(
         "Computes the distribution of the quotients of Euclidian distance in the layout and graph theoretical distance."
     );
+    app.help.push_back(
+        "If the pairwise distances don't fit into memory or --landmarks is given, the distribution is estimated from"
+        " the pairs that involve a random sample of nodes and the standard errors of the mean and entropy are estimated"
+        " by the bootstrap."
+    );
     app.help.push_back(msc::helptext_file_name_expansion());
     return app(argc, argv);
 }
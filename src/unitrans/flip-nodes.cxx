@@ -26,6 +26,7 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
 #include "cli.hxx"
 #include "file.hxx"
 #include "fingerprint.hxx"
@@ -34,6 +35,7 @@
 #include "meta.hxx"
 #include "normalizer.hxx"
 #include "ogdf_fix.hxx"
+#include "point.hxx"
 #include "random.hxx"
 
 #define PROGRAM_NAME "flip-nodes"
@@ -54,6 +56,24 @@ namespace /*anonymous*/
         return nodes;
     }
 
+    // Returns the sum of the distances of all nodes from their centroid, which is scaled by the same factor as the
+    // layout.
+    double get_spread(const ogdf::GraphAttributes& attrs)
+    {
+        auto centroid = msc::point2d{};
+        for (const auto v : attrs.constGraph().nodes) {
+            centroid += msc::point2d{attrs.x(v), attrs.y(v)};
+        }
+        if (!attrs.constGraph().empty()) {
+            centroid /= attrs.constGraph().numberOfNodes();
+        }
+        auto spread = 0.0;
+        for (const auto v : attrs.constGraph().nodes) {
+            spread += distance(msc::point2d{attrs.x(v), attrs.y(v)}, centroid);
+        }
+        return spread;
+    }
+
     template <typename EngineT>
     std::unique_ptr<ogdf::GraphAttributes>
     worsen(EngineT /*by-value*/ engine, const ogdf::GraphAttributes& attrs, const double rate)
@@ -64,13 +84,22 @@ namespace /*anonymous*/
             ? std::uniform_int_distribution<std::size_t>{}
             : std::uniform_int_distribution<std::size_t>{0, nodes.size() - 1};
         auto worse = std::make_unique<ogdf::GraphAttributes>(attrs.constGraph());
+        auto moved = std::vector<ogdf::node>{};
         for (const auto v : nodes) {
             const auto other = nodes[nodedist(engine)];
             const auto u = (flipdist(engine) < rate) ? other : v;
             worse->x(v) = attrs.x(u);
             worse->y(v) = attrs.y(u);
+            if (u != v) {
+                moved.push_back(v);
+            }
         }
+        // Normalization only translates and scales the layout so the distances between the nodes that were not moved
+        // are all scaled by the same factor.  Recording this allows properties to be updated incrementally.
+        const auto before = get_spread(*worse);
         msc::normalize_layout(*worse);
+        const auto after = get_spread(*worse);
+        msc::store_cached_lineage(attrs, *worse, moved, (before > 0.0) ? after / before : 1.0);
         return worse;
     }
 
@@ -0,0 +1,90 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <string>
+
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "cli.hxx"
+#include "file.hxx"
+#include "iosupp.hxx"
+#include "worker.hxx"
+#include "worker-tools.hxx"
+
+#define PROGRAM_NAME "graphstudy-worker"
+
+namespace /*anonymous*/
+{
+
+    struct cli_parameters
+    {
+        msc::input_file input{"-"};
+        msc::output_file output{"-"};
+        std::string socket{};
+    };
+
+    struct application final
+    {
+        cli_parameters parameters{};
+        void operator()() const;
+    };
+
+    void application::operator()() const
+    {
+        const auto tools = get_worker_tools();
+        if (!this->parameters.socket.empty()) {
+            msc::serve_worker_socket(this->parameters.socket, tools);
+        }
+        auto istr = boost::iostreams::filtering_istream{};
+        auto ostr = boost::iostreams::filtering_ostream{};
+        msc::prepare_stream(istr, this->parameters.input);
+        const auto name = msc::prepare_stream(ostr, this->parameters.output);
+        msc::serve_worker_requests(istr, ostr, tools);
+        if (!ostr.flush()) {
+            msc::report_io_error(name, "Cannot write response");
+        }
+    }
+
+}  // namespace /*anonymous*/
+
+int main(const int argc, const char *const *const argv)
+{
+    auto app = msc::command_line_interface<application>{PROGRAM_NAME};
+    app.help.push_back(
+        "Runs the other tools on request without starting a new process for each call.  Requests are read from the"
+        " input, one JSON object per line, and each is answered with one line of JSON on the output in the same order."
+        "  A request has the attributes 'tool' (name of the tool), 'args' (array of command-line arguments), 'stdin'"
+        " (file to connect to the tool's standard input), 'environ' (object with additional environment variables),"
+        " 'timeout' (time limit in seconds) and 'id' (opaque string that is echoed back).  All but 'tool' are optional."
+    );
+    app.help.push_back(
+        "The response has the attributes 'id', 'status' (exit status or null), 'signal' (number of the signal that"
+        " killed the tool or null), 'timeout' (whether the time limit was exceeded), 'stdout' and 'stderr' (captured"
+        " output with each byte mapped to the code point of the same value), 'time' (wall-clock time in seconds) and"
+        " 'error' (message if the request could not be processed or null).  Each request runs in a child process that"
+        " is forked from the worker so a tool that fails or crashes does not affect subsequent requests."
+    );
+    app.help.push_back(
+        "If the --socket option is given, the worker listens on a Unix domain socket instead and serves the requests"
+        " on each connection in turn until it is killed."
+    );
+    return app(argc, argv);
+}
@@ -19,10 +19,16 @@
 #endif
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <optional>
+#include <random>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -32,13 +38,17 @@
 #include <ogdf/fileformats/GraphIO.h>
 
 #include "cli.hxx"
+#include "concurrency.hxx"
 #include "file.hxx"
+#include "fingerprint.hxx"
 #include "io.hxx"
 #include "iosupp.hxx"
 #include "json.hxx"
 #include "meta.hxx"
 #include "ogdf_fix.hxx"
 #include "point.hxx"
+#include "random.hxx"
+#include "raster.hxx"
 #include "strings.hxx"
 
 #define PROGRAM_NAME "picture"
@@ -46,6 +56,14 @@
 namespace /*anonymous*/
 {
 
+    // Diameter of the nodes and width of the edges relative to the size of the picture (1000).
+    constexpr double node_size = 5.0;
+    constexpr double edge_stroke = 1.0;
+
+    // Width and height of the tiles and number of levels of the tile pyramid.
+    constexpr std::size_t tile_size = 256;
+    constexpr int tile_levels = 4;
+
     void reshape_layout(ogdf::GraphAttributes& attrs)
     {
         attrs.translateToNonNeg();
@@ -56,8 +74,8 @@ namespace /*anonymous*/
         attrs.scale(scale, false);
         for (const auto v : attrs.constGraph().nodes) {
             attrs.shape(v) = ogdf::Shape::Ellipse;
-            attrs.width(v) = 5.0;
-            attrs.height(v) = 5.0;
+            attrs.width(v) = node_size;
+            attrs.height(v) = node_size;
         }
     }
 
@@ -107,6 +125,99 @@ namespace /*anonymous*/
         }
     }
 
+    msc::raster_scene make_raster_scene(const ogdf::GraphAttributes& attrs)
+    {
+        auto scene = msc::raster_scene{};
+        scene.radius = node_size / 2.0;
+        scene.stroke = edge_stroke;
+        const auto layer = [&scene](const ogdf::Color& color) -> msc::raster_layer& {
+            const auto rgb = msc::raster_color{color.red(), color.green(), color.blue()};
+            const auto pos = std::find_if(
+                std::begin(scene.layers), std::end(scene.layers), [rgb](const auto& l){ return l.color == rgb; }
+            );
+            if (pos != std::end(scene.layers)) {
+                return *pos;
+            }
+            return scene.layers.emplace_back(msc::raster_layer{rgb});
+        };
+        for (const auto e : attrs.constGraph().edges) {
+            const auto src = msc::get_coords(attrs, e->source());
+            const auto dst = msc::get_coords(attrs, e->target());
+            layer(attrs.strokeColor(e)).lines.emplace_back(src, dst);
+        }
+        for (const auto v : attrs.constGraph().nodes) {
+            layer(attrs.fillColor(v)).discs.push_back(msc::get_coords(attrs, v));
+        }
+        return scene;
+    }
+
+    void write_picture_png(const msc::raster_scene& scene, const std::size_t size, const msc::output_file& dst)
+    {
+        const auto image = msc::render_scene(scene, msc::fit_raster_view(scene, size), size, size);
+        msc::write_deferred(msc::encode_png(image), dst, "Cannot write PNG data");
+    }
+
+    // Tiles are named "DIR/KEY-LEVEL-X-Y.png" and only drawn if no such file exists yet.  Each tile is written to a
+    // unique temporary file first and then moved into place so a tile that exists is always complete, even if a
+    // process was killed or several processes draw the same tiles concurrently.
+    void write_picture_tiles(const msc::raster_scene& scene, const std::string& key, const std::string& directory)
+    {
+        struct tile_info
+        {
+            int level;
+            int x;
+            int y;
+            std::string filename;
+            msc::output_file dst;
+        };
+        auto rnddev = std::random_device{};
+        auto pending = std::vector<tile_info>{};
+        for (auto level = 0; level < tile_levels; ++level) {
+            for (auto y = 0; y < (1 << level); ++y) {
+                for (auto x = 0; x < (1 << level); ++x) {
+                    auto filename = msc::concat(
+                        directory, "/", key, "-", std::to_string(level), "-", std::to_string(x), "-", std::to_string(y),
+                        ".png"
+                    );
+                    if (!std::ifstream{filename}) {
+                        const auto tempname = msc::concat(filename, ".", msc::random_hex_string(rnddev, 8), ".tmp");
+                        auto dst = msc::file::from_filename(tempname, msc::compressions::none);
+                        pending.push_back({level, x, y, std::move(filename), std::move(dst)});
+                    }
+                }
+            }
+        }
+        auto images = std::vector<std::string>(pending.size());
+        msc::parallel_for(pending.size(), [&scene, &pending, &images](const std::size_t i){
+            const auto& tile = pending[i];
+            const auto view = msc::tile_raster_view(scene, tile_size, tile.level, tile.x, tile.y);
+            images[i] = msc::encode_png(msc::render_scene(scene, view, tile_size, tile_size));
+        });
+        for (auto i = std::size_t{}; i < pending.size(); ++i) {
+            msc::write_deferred(std::move(images[i]), pending[i].dst, "Cannot write PNG tile");
+        }
+        // Failed writes are reported by `msc::finish_deferred_writes` later; their temporary files are just removed.
+        for (const auto& tile : pending) {
+            const auto& tempname = tile.dst.filename();
+            if (!msc::await_deferred_writes(tile.dst) || (std::rename(tempname.c_str(), tile.filename.c_str()) != 0)) {
+                std::remove(tempname.c_str());
+            }
+        }
+    }
+
+    // The tiles are keyed by the fingerprint of the layout as it was loaded (before it was reshaped) so they can be
+    // found by anyone who knows the layout.  The colors are not covered by the fingerprint so they go into the key,
+    // too, but the color of the axes only if they are drawn.
+    std::string get_tile_key(const std::string& layout,
+                             const ogdf::Color nc,
+                             const ogdf::Color ec,
+                             const std::optional<ogdf::Color> ac)
+    {
+        const auto hex = [](const ogdf::Color color){ return color.toString().substr(1); };
+        return ac ? msc::concat(layout, "-", hex(nc), hex(ec), "-axes", hex(*ac))
+                  : msc::concat(layout, "-", hex(nc), hex(ec));
+    }
+
     void write_picture_tikz(const ogdf::GraphAttributes& attrs,
                             const msc::point2d& major,
                             const msc::point2d& minor,
@@ -160,6 +271,8 @@ namespace /*anonymous*/
         ogdf::Color edge_color{};
         ogdf::Color axis_color{};
         bool tikz{};
+        std::optional<int> png{};
+        std::string tiles{};
     };
 
     struct application final
@@ -185,12 +298,31 @@ namespace /*anonymous*/
         if (this->parameters.tikz) {
             write_picture_tikz(*attrs, this->parameters.major, this->parameters.minor, this->parameters.output);
         } else {
+            const auto& tiles = this->parameters.tiles;
+            const auto layout = tiles.empty() ? std::string{} : msc::layout_fingerprint(*attrs);
+            const auto [major, minor] = std::tie(this->parameters.major, this->parameters.minor);
+            const auto axes = major && minor;
             colorize_layout(*attrs, this->parameters.node_color, this->parameters.edge_color);
-            if (const auto [major, minor] = std::tie(this->parameters.major, this->parameters.minor); major && minor) {
+            if (axes) {
                 add_principial_axes(*graph, *attrs, major, minor, this->parameters.axis_color);
             }
             reshape_layout(*attrs);
-            write_picture_svg(*attrs, this->parameters.output);
+            const auto& png = this->parameters.png;
+            const auto scene = (png || !tiles.empty()) ? make_raster_scene(*attrs) : msc::raster_scene{};
+            if (png) {
+                write_picture_png(scene, static_cast<std::size_t>(*png), this->parameters.output);
+            } else {
+                write_picture_svg(*attrs, this->parameters.output);
+            }
+            if (!tiles.empty()) {
+                const auto key = get_tile_key(
+                    layout,
+                    this->parameters.node_color,
+                    this->parameters.edge_color,
+                    axes ? std::optional{this->parameters.axis_color} : std::nullopt
+                );
+                write_picture_tiles(scene, key, tiles);
+            }
         }
         const auto info = get_info(*attrs, this->parameters.node_color, this->parameters.edge_color);
         msc::print_meta(info, this->parameters.meta);
@@ -201,6 +333,6 @@ namespace /*anonymous*/
 int main(const int argc, const char *const *const argv)
 {
     auto app = msc::command_line_interface<application>{PROGRAM_NAME};
-    app.help.push_back("Draws a layout as an SVG picture.");
+    app.help.push_back("Draws a layout as an SVG picture or renders it as a PNG image.");
     return app(argc, argv);
 }
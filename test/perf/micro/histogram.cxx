@@ -0,0 +1,100 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hxx"
+#include "histogram.hxx"
+#include "sliding.hxx"
+
+#define PROGRAM_NAME "histogram"
+
+namespace /*anonymous*/
+{
+
+    constexpr auto density_points = 100;
+
+    std::vector<double> make_events(const std::size_t n)
+    {
+        auto engine = msc::benchmark::get_random_engine();
+        auto dist = std::normal_distribution<double>{};
+        auto events = std::vector<double>(n);
+        std::generate(std::begin(events), std::end(events), [&engine, &dist](){ return dist(engine); });
+        return events;
+    }
+
+    void benchmark_boxed(const std::vector<double>& events)
+    {
+        const auto histo = msc::histogram{events};
+        msc::benchmark::clobber_memory(&histo);
+    }
+
+    void benchmark_gaussian(const std::vector<double>& events)
+    {
+        const auto [min, max] = std::minmax_element(std::begin(events), std::end(events));
+        const auto kernel = msc::gaussian_kernel{std::begin(events), std::end(events), 0.1};
+        const auto density = msc::make_density(kernel, *min, *max, density_points);
+        msc::benchmark::clobber_memory(density.data());
+    }
+
+}  // namespace /*anonymous*/
+
+int main(const int argc, const char *const *const argv)
+{
+    try {
+        const auto t0 = msc::benchmark::clock_type::now();
+        auto setup = msc::benchmark::benchmark_setup(
+            PROGRAM_NAME,
+            "Benchmark for building a histogram or a Gaussian kernel density estimate from random events"
+        );
+        setup.add_cmd_arg("nodes", "number of events");
+        setup.add_cmd("kernel", "kernel to use ('boxed' or 'gaussian')", "boxed");
+        if (!setup.process(argc, argv)) {
+            return EXIT_SUCCESS;
+        }
+        const auto events = make_events(setup.get_cmd_arg("nodes"));
+        const auto kernel = setup.get_cmd("kernel");
+        auto constr = setup.get_constraints();
+        if (constr.timeout.count() > 0) {
+            constr.timeout -= msc::benchmark::duration_type{msc::benchmark::clock_type::now() - t0};
+        }
+        const auto res = [&](){
+            if (kernel == "boxed") {
+                return msc::benchmark::run_benchmark(constr, benchmark_boxed, events);
+            } else if (kernel == "gaussian") {
+                return msc::benchmark::run_benchmark(constr, benchmark_gaussian, events);
+            } else {
+                throw std::invalid_argument{"Unknown kernel: " + kernel};
+            }
+        }();
+        msc::benchmark::print_result(res);
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << PROGRAM_NAME << ": error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,140 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hxx"
+#include "hashmap.hxx"
+
+#define PROGRAM_NAME "lattice"
+
+namespace /*anonymous*/
+{
+
+    // This mimics what the quasi-crystal generator does: insert a patch of a 4-dimensional integer lattice into a map
+    // and then look up the two neighbours of every point along every axis.
+
+    constexpr std::size_t dimensions = 4;
+
+    using key_type = std::array<long, dimensions>;
+
+    std::vector<key_type> make_keys(const std::size_t n)
+    {
+        const auto side = static_cast<long>(std::ceil(std::pow(static_cast<double>(n), 1.0 / dimensions)));
+        auto keys = std::vector<key_type>{};
+        keys.reserve(n);
+        for (auto key = key_type{}; keys.size() < n;) {
+            keys.push_back(key);
+            for (auto dim = dimensions; dim > 0; --dim) {
+                if (++key[dim - 1] < side) {
+                    break;
+                }
+                key[dim - 1] = 0;
+            }
+        }
+        return keys;
+    }
+
+    void benchmark_tree(const std::vector<key_type>& keys)
+    {
+        auto map = std::map<key_type, std::size_t>{};
+        for (const auto& key : keys) {
+            map.insert({key, map.size()});
+        }
+        auto tally = std::size_t{};
+        for (const auto& key : keys) {
+            for (auto dim = std::size_t{}; dim < dimensions; ++dim) {
+                for (const auto off : {-1L, +1L}) {
+                    auto next = key;
+                    next[dim] += off;
+                    tally += map.count(next);
+                }
+            }
+        }
+        msc::benchmark::clobber_memory(&tally);
+    }
+
+    void benchmark_hash(const std::vector<key_type>& keys)
+    {
+        auto map = msc::open_hash_map<key_type, std::size_t>{};
+        for (const auto& key : keys) {
+            map.try_emplace(key, map.size());
+        }
+        auto tally = std::size_t{};
+        for (const auto& key : keys) {
+            for (auto dim = std::size_t{}; dim < dimensions; ++dim) {
+                for (const auto off : {-1L, +1L}) {
+                    auto next = key;
+                    next[dim] += off;
+                    tally += map.contains(next);
+                }
+            }
+        }
+        msc::benchmark::clobber_memory(&tally);
+    }
+
+}  // namespace /*anonymous*/
+
+int main(const int argc, const char *const *const argv)
+{
+    try {
+        const auto t0 = msc::benchmark::clock_type::now();
+        auto setup = msc::benchmark::benchmark_setup(
+            PROGRAM_NAME,
+            "Benchmark for inserting and looking up lattice points in a std::map versus an open-addressing hash map"
+        );
+        setup.add_cmd_arg("size", "number of lattice points");
+        setup.add_cmd("container", "container to use ('tree' or 'hash')", "hash");
+        if (!setup.process(argc, argv)) {
+            return EXIT_SUCCESS;
+        }
+        const auto size = setup.get_cmd_arg("size");
+        const auto container = setup.get_cmd("container");
+        const auto keys = make_keys(size);
+        auto constr = setup.get_constraints();
+        if (constr.timeout.count() > 0) {
+            constr.timeout -= msc::benchmark::duration_type{msc::benchmark::clock_type::now() - t0};
+        }
+        const auto absres = [&](){
+            if (container == "tree") {
+                return msc::benchmark::run_benchmark(constr, benchmark_tree, keys);
+            } else if (container == "hash") {
+                return msc::benchmark::run_benchmark(constr, benchmark_hash, keys);
+            } else {
+                throw std::invalid_argument{"Unknown container: " + container};
+            }
+        }();
+        const auto relres = msc::benchmark::result{absres.mean / size, absres.stdev / size, absres.n};
+        msc::benchmark::print_result(relres);
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << PROGRAM_NAME << ": error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
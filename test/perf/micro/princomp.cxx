@@ -0,0 +1,81 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "benchmark.hxx"
+#include "point.hxx"
+#include "princomp.hxx"
+
+#define PROGRAM_NAME "princomp"
+
+namespace /*anonymous*/
+{
+
+    std::vector<msc::point2d> make_points(const std::size_t n)
+    {
+        auto engine = msc::benchmark::get_random_engine();
+        auto xdist = std::normal_distribution<double>{0.0, 100.0};
+        auto ydist = std::normal_distribution<double>{0.0, 10.0};
+        auto points = std::vector<msc::point2d>(n);
+        for (auto& p : points) {
+            p = msc::point2d{xdist(engine), ydist(engine)};
+        }
+        return points;
+    }
+
+    void benchmark(const std::vector<msc::point2d>& points, std::default_random_engine& engine)
+    {
+        const auto axes = msc::find_primary_axes_nondestructive(points, engine);
+        msc::benchmark::clobber_memory(axes.data());
+    }
+
+}  // namespace /*anonymous*/
+
+int main(const int argc, const char *const *const argv)
+{
+    try {
+        const auto t0 = msc::benchmark::clock_type::now();
+        auto setup = msc::benchmark::benchmark_setup(
+            PROGRAM_NAME,
+            "Benchmark for the principal component analysis of a random point cloud"
+        );
+        setup.add_cmd_arg("nodes", "number of points");
+        if (!setup.process(argc, argv)) {
+            return EXIT_SUCCESS;
+        }
+        const auto points = make_points(setup.get_cmd_arg("nodes"));
+        auto engine = msc::benchmark::get_random_engine();
+        auto constr = setup.get_constraints();
+        if (constr.timeout.count() > 0) {
+            constr.timeout -= msc::benchmark::duration_type{msc::benchmark::clock_type::now() - t0};
+        }
+        const auto res = msc::benchmark::run_benchmark(constr, benchmark, points, engine);
+        msc::benchmark::print_result(res);
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << PROGRAM_NAME << ": error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,131 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "bootstrap.hxx"
+
+#include <cmath>
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "pairwise.hxx"
+#include "testaux/cube.hxx"
+#include "testaux/envguard.hxx"
+#include "unittest.hxx"
+
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
+namespace /*anonymous*/
+{
+
+    struct distance_projection
+    {
+        const msc::distance_matrix* matrix{};
+
+        double operator()(const ogdf::node v1, const ogdf::node v2) const noexcept
+        {
+            return (*matrix)(v1, v2);
+        }
+    };
+
+    MSC_AUTO_TEST_CASE(group_sampled_pairs)
+    {
+        const auto graph = msc::test::make_cube_graph();
+        const auto landmarks = std::vector<ogdf::node>{graph->firstNode(), graph->lastNode()};
+        const auto matrix = msc::get_sampled_shortest_paths(*graph, landmarks);
+        using iterator = msc::node_pair_iterator<double, msc::tautology_node_pair_predicate, distance_projection>;
+        const auto first = iterator{*matrix, {}, distance_projection{matrix.get()}};
+        const auto groups = msc::group_by_first_node(first, iterator{});
+        MSC_REQUIRE_EQ(std::size_t{2}, groups.size());
+        for (const auto& group : groups) {
+            MSC_REQUIRE_EQ(std::size_t{7}, group.size());
+            auto sum = 0.0;
+            for (const auto x : group) {
+                sum += x;
+            }
+            MSC_REQUIRE_CLOSE(1.0E-10, 12.0, sum);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(error_too_few_groups)
+    {
+        const auto engine = msc::philox_engine{};
+        const auto groups = std::vector<std::vector<double>>{{1.0, 2.0, 3.0, 4.0}};
+        const auto error = msc::get_bootstrap_error(groups, engine);
+        MSC_REQUIRE(std::isnan(error.mean));
+        MSC_REQUIRE(std::isnan(error.entropy));
+        MSC_REQUIRE_EQ(std::size_t{0}, error.replicas);
+    }
+
+    MSC_AUTO_TEST_CASE(error_identical_groups)
+    {
+        const auto engine = msc::philox_engine{};
+        const auto groups = std::vector<std::vector<double>>(10, {1.0, 2.0, 3.0, 5.0, 8.0});
+        const auto error = msc::get_bootstrap_error(groups, engine, 20);
+        MSC_REQUIRE_EQ(std::size_t{20}, error.replicas);
+        MSC_REQUIRE_CLOSE(1.0E-10, 0.0, error.mean);
+        MSC_REQUIRE_CLOSE(1.0E-10, 0.0, error.entropy);
+    }
+
+    MSC_AUTO_TEST_CASE(error_mean)
+    {
+        // The groups have the means 0, 1, ..., 99 so the standard error of the mean is about sqrt(833.25 / 100).
+        const auto engine = msc::philox_engine{};
+        auto groups = std::vector<std::vector<double>>{};
+        for (auto i = 0; i < 100; ++i) {
+            groups.push_back({i - 0.5, i + 0.5});
+        }
+        const auto error = msc::get_bootstrap_error(groups, engine, 1000);
+        MSC_REQUIRE_CLOSE(0.5, std::sqrt(8.3325), error.mean);
+        MSC_REQUIRE_GT(error.entropy, 0.0);
+    }
+
+    MSC_AUTO_TEST_CASE(error_reproducible)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto engine = msc::philox_engine{42};
+        auto groups = std::vector<std::vector<double>>{};
+        for (auto i = 0; i < 50; ++i) {
+            groups.push_back({std::sin(i), std::cos(i), std::sin(i) * std::cos(i)});
+        }
+        auto guard = msc::test::envguard{"MSC_JOBS"};
+        guard.set("1");
+        const auto sequential = msc::get_bootstrap_error(groups, engine);
+        guard.set("4");
+        const auto concurrent = msc::get_bootstrap_error(groups, engine);
+        MSC_REQUIRE_EQ(sequential.mean, concurrent.mean);
+        MSC_REQUIRE_EQ(sequential.entropy, concurrent.entropy);
+        MSC_REQUIRE_EQ(sequential.replicas, concurrent.replicas);
+    }
+
+    MSC_AUTO_TEST_CASE(assign_info)
+    {
+        auto info = msc::json_object{};
+        msc::assign_bootstrap_error(msc::bootstrap_error{0.5, 0.25, 32}, info);
+        MSC_REQUIRE_EQ(0.5, std::get<msc::json_real>(info.at("mean-error")).value);
+        MSC_REQUIRE_EQ(0.25, std::get<msc::json_real>(info.at("entropy-error")).value);
+        MSC_REQUIRE_EQ(std::size_t{32}, std::get<msc::json_size>(info.at("bootstrap-replicas")).value);
+    }
+
+}  // namespace /*anonymous*/
@@ -0,0 +1,133 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "bzip2.hxx"
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+#include <boost/iostreams/compose.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    namespace io = boost::iostreams;
+
+    // Text that compresses reasonably well but not too well, so it spans several blocks.
+    std::string make_text(const std::size_t size)
+    {
+        static const std::string words[] = {"node ", "edge ", "layout ", "graph ", "stress ", "\n"};
+        auto engine = std::mt19937{};
+        auto dist = std::uniform_int_distribution<std::size_t>{0, std::size(words) - 1};
+        auto digits = std::uniform_int_distribution<int>{0, 9999};
+        auto text = std::string{};
+        while (text.size() < size) {
+            text.append(words[dist(engine)]);
+            text.append(std::to_string(digits(engine)));
+        }
+        text.resize(size);
+        return text;
+    }
+
+    template <typename FilterT>
+    std::string filter_all(FilterT filter, const std::string& input)
+    {
+        auto output = std::string{};
+        io::copy(io::array_source{input.data(), input.size()}, io::compose(filter, io::back_inserter(output)));
+        return output;
+    }
+
+    std::string decompress(const std::string& input, const std::size_t jobs)
+    {
+        auto output = std::string{};
+        const auto filter = msc::parallel_bzip2_decompressor{jobs};
+        io::copy(io::compose(filter, io::array_source{input.data(), input.size()}), io::back_inserter(output));
+        return output;
+    }
+
+    std::string decompress_standard(const std::string& input)
+    {
+        auto output = std::string{};
+        const auto filter = io::bzip2_decompressor{};
+        io::copy(io::compose(filter, io::array_source{input.data(), input.size()}), io::back_inserter(output));
+        return output;
+    }
+
+    MSC_AUTO_TEST_CASE(decompress_single_stream_many_blocks)
+    {
+        const auto text = make_text(1500000);
+        const auto packed = filter_all(io::bzip2_compressor{io::bzip2_params{1}}, text);
+        for (const std::size_t jobs : {1, 3, 8}) {
+            MSC_REQUIRE_EQ(text, decompress(packed, jobs));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(decompress_concatenated_streams)
+    {
+        const auto text1st = make_text(300000);
+        const auto text2nd = std::string{};
+        const auto text3rd = std::string{"The quick brown fox jumps over the lazy dog.\n"};
+        const auto packed = filter_all(io::bzip2_compressor{io::bzip2_params{1}}, text1st)
+            + filter_all(io::bzip2_compressor{}, text2nd)
+            + filter_all(io::bzip2_compressor{io::bzip2_params{4}}, text3rd);
+        MSC_REQUIRE_EQ(text1st + text2nd + text3rd, decompress(packed, 2));
+    }
+
+    MSC_AUTO_TEST_CASE(decompress_errors)
+    {
+        const auto text = make_text(250000);
+        const auto packed = filter_all(io::bzip2_compressor{io::bzip2_params{1}}, text);
+        auto corrupt = packed;
+        corrupt[corrupt.size() / 2] ^= 0x10;
+        MSC_REQUIRE_EXCEPTION(io::bzip2_error, decompress(std::string{}, 2));
+        MSC_REQUIRE_EXCEPTION(io::bzip2_error, decompress(packed.substr(0, packed.size() - 5), 2));
+        MSC_REQUIRE_EXCEPTION(io::bzip2_error, decompress(packed + "garbage", 2));
+        MSC_REQUIRE_EXCEPTION(io::bzip2_error, decompress("BZh0" + packed.substr(4), 2));
+        MSC_REQUIRE_EXCEPTION(io::bzip2_error, decompress(corrupt, 2));
+    }
+
+    MSC_AUTO_TEST_CASE(compress_standard_compatible)
+    {
+        const auto text = make_text(2000000);
+        for (const std::size_t jobs : {1, 4}) {
+            const auto packed = filter_all(msc::parallel_bzip2_compressor{jobs}, text);
+            MSC_REQUIRE_EQ(text, decompress_standard(packed));
+            MSC_REQUIRE_EQ(text, decompress(packed, jobs));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(compress_empty)
+    {
+        const auto packed = filter_all(msc::parallel_bzip2_compressor{2}, std::string{});
+        MSC_REQUIRE_EQ(filter_all(io::bzip2_compressor{}, std::string{}), packed);
+        MSC_REQUIRE_EQ(std::string{}, decompress(packed, 2));
+    }
+
+}  // namespace /*anonymous*/
@@ -0,0 +1,275 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "cache.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "file.hxx"
+#include "fingerprint.hxx"
+#include "json.hxx"
+#include "testaux/cube.hxx"
+#include "testaux/envguard.hxx"
+#include "testaux/tempfile.hxx"
+#include "unittest.hxx"
+
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
+namespace /*anonymous*/
+{
+
+    // Points `MSC_CACHE_DIR` to the directory that contains a fresh temporary file and uses that file's base name as
+    // the cache key.  The cache entry is removed again when the object is destroyed.
+    struct cache_fixture final
+    {
+        msc::test::envguard guard{"MSC_CACHE_DIR"};
+        msc::test::tempfile tmp{};
+        std::string key{};
+
+        cache_fixture()
+        {
+            const auto pos = tmp.filename().rfind('/');
+            MSC_REQUIRE_NE(std::string::npos, pos);
+            guard.set(tmp.filename().substr(0, pos));
+            key = tmp.filename().substr(pos + 1);
+        }
+
+        ~cache_fixture() noexcept
+        {
+            std::remove((tmp.filename() + ".xml.gz").c_str());
+            std::remove((tmp.filename() + ".analysis").c_str());
+            std::remove((tmp.filename() + ".analysis.none").c_str());
+            std::remove((tmp.filename() + ".values").c_str());
+        }
+    };
+
+    std::string read_file(const std::string& filename)
+    {
+        auto istr = std::ifstream{filename};
+        return std::string{std::istreambuf_iterator<char>{istr}, std::istreambuf_iterator<char>{}};
+    }
+
+    void write_file(const std::string& filename, const std::string& text)
+    {
+        auto ostr = std::ofstream{filename};
+        ostr << text;
+    }
+
+    MSC_AUTO_TEST_CASE(disabled)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_CACHE_DIR"};
+        guard.unset();
+        MSC_REQUIRE(!msc::get_cache_directory());
+        MSC_REQUIRE(!msc::get_cache_filename("whatever"));
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        msc::store_cached_layout("cube", *attrs);
+        MSC_REQUIRE(!msc::load_cached_layout("cube", *attrs));
+    }
+
+    MSC_AUTO_TEST_CASE(disabled_empty)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_CACHE_DIR"};
+        guard.set("");
+        MSC_REQUIRE(!msc::get_cache_directory());
+    }
+
+    MSC_AUTO_TEST_CASE(filename)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_CACHE_DIR"};
+        guard.set("/var/cache/msc");
+        MSC_REQUIRE_EQ(std::string{"/var/cache/msc"}, msc::get_cache_directory().value());
+        MSC_REQUIRE_EQ(std::string{"/var/cache/msc/key.txt"}, msc::get_cache_filename("key.txt").value());
+    }
+
+    MSC_AUTO_TEST_CASE(layout_miss)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto x = attrs->x(graph->firstNode());
+        MSC_REQUIRE(!msc::load_cached_layout(fixture.key, *attrs));
+        MSC_REQUIRE_EQ(x, attrs->x(graph->firstNode()));
+    }
+
+    MSC_AUTO_TEST_CASE(layout_roundtrip)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        msc::store_cached_layout(fixture.key, *attrs);
+        auto other = ogdf::GraphAttributes{*graph, attrs->attributes()};
+        MSC_REQUIRE(msc::load_cached_layout(fixture.key, other));
+        for (const auto v : graph->nodes) {
+            MSC_REQUIRE_CLOSE(1.0E-10, attrs->x(v), other.x(v));
+            MSC_REQUIRE_CLOSE(1.0E-10, attrs->y(v), other.y(v));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(layout_mismatch)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto [cube, cubeattrs] = msc::test::make_cube_layout();
+        const auto [square, squareattrs] = msc::test::make_square_layout();
+        msc::store_cached_layout(fixture.key, *cubeattrs);
+        MSC_REQUIRE(!msc::load_cached_layout(fixture.key, *squareattrs));
+    }
+
+    MSC_AUTO_TEST_CASE(property_key)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_CACHE_DIR"};
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        guard.unset();
+        MSC_REQUIRE(!msc::get_property_cache_key("tool", *attrs));
+        guard.set("/var/cache/msc");
+        const auto key = msc::get_property_cache_key("tool", *attrs).value();
+        MSC_REQUIRE_EQ(0, key.find("tool-"));
+        MSC_REQUIRE_NE(key, msc::get_property_cache_key("other", *attrs).value());
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_miss)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        auto info = msc::json_object{};
+        auto subinfo = msc::json_object{};
+        MSC_REQUIRE(!msc::load_cached_analysis(fixture.key, info, subinfo, msc::output_file{}));
+        MSC_REQUIRE(info.empty());
+        MSC_REQUIRE(subinfo.empty());
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_roundtrip)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto source = msc::test::tempfile{".dat"};
+        const auto destination = msc::test::tempfile{".dat"};
+        write_file(source.filename(), "# histogram\n1 2\n3 4\n");
+        auto info = msc::json_object{};
+        auto subinfo = msc::json_object{};
+        info["size"] = msc::json_size{42};
+        info["mean"] = msc::json_real{0.1};
+        info["offset"] = msc::json_diff{-7};
+        subinfo["filename"] = msc::json_text{source.filename()};
+        subinfo["binning"] = msc::json_text{"scott normal reference"};
+        subinfo["exact"] = msc::json_bool{true};
+        subinfo["entropy"] = msc::json_null{};
+        msc::store_cached_analysis(fixture.key, info, subinfo, msc::output_file::from_filename(source.filename()));
+        auto cachedinfo = msc::json_object{};
+        auto cachedsubinfo = msc::json_object{};
+        const auto dst = msc::output_file::from_filename(destination.filename());
+        MSC_REQUIRE(msc::load_cached_analysis(fixture.key, cachedinfo, cachedsubinfo, dst));
+        MSC_REQUIRE_EQ(read_file(source.filename()), read_file(destination.filename()));
+        MSC_REQUIRE_EQ(42, std::get<msc::json_size>(cachedinfo["size"]).value);
+        MSC_REQUIRE_EQ(0.1, std::get<msc::json_real>(cachedinfo["mean"]).value);
+        MSC_REQUIRE_EQ(-7, std::get<msc::json_diff>(cachedinfo["offset"]).value);
+        MSC_REQUIRE_EQ(destination.filename(), std::get<msc::json_text>(cachedsubinfo["filename"]).value);
+        MSC_REQUIRE_EQ(std::string{"scott normal reference"}, std::get<msc::json_text>(cachedsubinfo["binning"]).value);
+        MSC_REQUIRE(std::get<msc::json_bool>(cachedsubinfo["exact"]).value);
+        MSC_REQUIRE(std::holds_alternative<msc::json_null>(cachedsubinfo["entropy"]));
+        MSC_REQUIRE_EQ(3, cachedinfo.size());
+        MSC_REQUIRE_EQ(4, cachedsubinfo.size());
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_terminal)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto destination = msc::test::tempfile{".dat"};
+        auto info = msc::json_object{};
+        auto subinfo = msc::json_object{};
+        info["size"] = msc::json_size{42};
+        msc::store_cached_analysis(fixture.key, info, subinfo, msc::output_file{});
+        const auto dst = msc::output_file::from_filename(destination.filename());
+        MSC_REQUIRE(!msc::load_cached_analysis(fixture.key, info, subinfo, dst));
+        MSC_REQUIRE(subinfo.empty());
+        MSC_REQUIRE(msc::load_cached_analysis(fixture.key, info, subinfo, msc::output_file{}));
+        MSC_REQUIRE(std::holds_alternative<msc::json_null>(subinfo["filename"]));
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_structured)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        auto info = msc::json_object{};
+        auto subinfo = msc::json_object{};
+        info["data"] = msc::json_array{};
+        msc::store_cached_analysis(fixture.key, info, subinfo, msc::output_file{});
+        MSC_REQUIRE(!msc::load_cached_analysis(fixture.key, info, subinfo, msc::output_file{}));
+    }
+
+    MSC_AUTO_TEST_CASE(values_roundtrip)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        MSC_REQUIRE(!msc::load_cached_values(fixture.key));
+        const auto values = std::vector<double>{0.1, -0.0, 1.0E300, std::numeric_limits<double>::infinity()};
+        msc::store_cached_values(fixture.key, values);
+        MSC_REQUIRE_EQ(values, msc::load_cached_values(fixture.key).value());
+        msc::store_cached_values(fixture.key, {});
+        MSC_REQUIRE(msc::load_cached_values(fixture.key).value().empty());
+    }
+
+    MSC_AUTO_TEST_CASE(lineage_roundtrip)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto fixture = cache_fixture{};
+        const auto [graph, parent] = msc::test::make_cube_layout();
+        auto child = ogdf::GraphAttributes{*parent};
+        const auto moved = std::vector<ogdf::node>{graph->firstNode(), graph->lastNode()};
+        for (const auto v : moved) {
+            child.x(v) += 10.0;
+        }
+        child.scale(3.0, false);
+        const auto parentfile = msc::get_cache_filename("layout-" + msc::isometry_fingerprint(*parent)).value();
+        const auto childfile = msc::get_cache_filename("layout-" + msc::isometry_fingerprint(child)).value();
+        auto restored = ogdf::GraphAttributes{*graph, parent->attributes()};
+        MSC_REQUIRE(!msc::load_cached_lineage(child, restored));
+        msc::store_cached_lineage(*parent, child, moved, 3.0);
+        const auto lineage = msc::load_cached_lineage(child, restored);
+        std::remove((parentfile + ".xml.gz").c_str());
+        std::remove((childfile + ".lineage").c_str());
+        MSC_REQUIRE(lineage.has_value());
+        MSC_REQUIRE_EQ(msc::isometry_fingerprint(*parent), lineage->parent);
+        MSC_REQUIRE_EQ(3.0, lineage->scale);
+        MSC_REQUIRE_EQ(moved, lineage->moved);
+        for (const auto v : graph->nodes) {
+            MSC_REQUIRE_CLOSE(1.0E-10, parent->x(v), restored.x(v));
+            MSC_REQUIRE_CLOSE(1.0E-10, parent->y(v), restored.y(v));
+        }
+    }
+
+}  // namespace /*anonymous*/
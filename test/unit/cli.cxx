@@ -33,7 +33,10 @@
 #include <memory>
 #include <random>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #if __has_include(<sys/stat.h>)
 #  include <sys/stat.h>
@@ -50,8 +53,11 @@
 #include <ogdf/basic/graphics.h>
 
 #include "file.hxx"
+#include "json.hxx"
+#include "meta.hxx"
 #include "testaux/envguard.hxx"
 #include "testaux/stdio.hxx"
+#include "testaux/tempfile.hxx"
 #include "unittest.hxx"
 
 using namespace std::string_literals;
@@ -383,6 +389,7 @@ namespace /*anonymous*/
             //msc::point2d major{};
             //msc::point2d minor{};
             std::vector<double> vicinity{};
+            std::optional<int> landmarks{};
             ogdf::Color node_color{};
             ogdf::Color edge_color{};
             ogdf::Color axis_color{};
@@ -435,6 +442,7 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(std::nullopt, app->parameters.points);
         MSC_REQUIRE_EQ(0, app->parameters.component);
         MSC_REQUIRE(app->parameters.vicinity.empty());
+        MSC_REQUIRE_EQ(std::nullopt, app->parameters.landmarks);
         MSC_REQUIRE_EQ(ogdf::Color{}, app->parameters.node_color);
         MSC_REQUIRE_EQ(ogdf::Color{}, app->parameters.edge_color);
         MSC_REQUIRE_EQ(ogdf::Color{}, app->parameters.axis_color);
@@ -482,6 +490,7 @@ namespace /*anonymous*/
             "--vicinity=0.0",
             "--vicinity=13.5",
             "--vicinity=29.0",
+            "--landmarks=64",
             "--node-color=#75507b",
             "--edge-color=#5c3566",
             "--axis-color=#cc0000",
@@ -519,6 +528,7 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(0.0, app->parameters.vicinity.at(0));
         MSC_REQUIRE_EQ(13.5, app->parameters.vicinity.at(1));
         MSC_REQUIRE_EQ(29.0, app->parameters.vicinity.at(2));
+        MSC_REQUIRE_EQ(64, app->parameters.landmarks.value());
         MSC_REQUIRE_EQ((ogdf::Color{0x75, 0x50, 0x7b}), app->parameters.node_color);
         MSC_REQUIRE_EQ((ogdf::Color{0x5c, 0x35, 0x66}), app->parameters.edge_color);
         MSC_REQUIRE_EQ((ogdf::Color{0xcc, 0x00, 0x00}), app->parameters.axis_color);
@@ -555,6 +565,7 @@ namespace /*anonymous*/
             "-p", "42",
             "-2",
             "-v", "5",
+            "-L", "8",
             "input.xml",
             nullptr,
         };
@@ -588,10 +599,170 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(2, app->parameters.component);
         MSC_REQUIRE_EQ(1, app->parameters.vicinity.size());
         MSC_REQUIRE_EQ(5.0, app->parameters.vicinity.at(0));
+        MSC_REQUIRE_EQ(8, app->parameters.landmarks);
         MSC_REQUIRE_EQ(ogdf::Color{ogdf::Color::Name::Aqua}, app->parameters.node_color);
         MSC_REQUIRE_EQ(ogdf::Color{ogdf::Color::Name::Azure}, app->parameters.edge_color);
         MSC_REQUIRE_EQ(ogdf::Color{ogdf::Color::Name::Olive}, app->parameters.axis_color);
         MSC_REQUIRE_EQ(msc::input_file::from_filename("input.xml"), app->parameters.input);
     }
 
+
+    struct batchapp
+    {
+        struct
+        {
+            std::vector<msc::algorithms> algorithm{};
+            int replicas{1};
+            bool warm_start{};
+        } parameters{};
+        void operator()() { /* empty */ }
+    };
+
+    MSC_AUTO_TEST_CASE(cli_batch_default)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        auto app = msc::command_line_interface<batchapp>{"demo"};
+        const char *const argv[] = {__FILE__, "-a", "STRESS", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(EXIT_SUCCESS, status);
+        MSC_REQUIRE_EQ(std::string{}, guard.get_stderr());
+        MSC_REQUIRE_EQ(1, app->parameters.algorithm.size());
+        MSC_REQUIRE_EQ(msc::algorithms::stress, app->parameters.algorithm.at(0));
+        MSC_REQUIRE_EQ(1, app->parameters.replicas);
+        MSC_REQUIRE_EQ(false, app->parameters.warm_start);
+    }
+
+    MSC_AUTO_TEST_CASE(cli_batch_multiple)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        auto app = msc::command_line_interface<batchapp>{"demo"};
+        const char *const argv[] = {__FILE__, "--algorithm=FMMM", "-a", "PIVOT_MDS", "--replicas=3", "--warm-start", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(EXIT_SUCCESS, status);
+        MSC_REQUIRE_EQ(std::string{}, guard.get_stderr());
+        MSC_REQUIRE_EQ(2, app->parameters.algorithm.size());
+        MSC_REQUIRE_EQ(msc::algorithms::fmmm, app->parameters.algorithm.at(0));
+        MSC_REQUIRE_EQ(msc::algorithms::pivot_mds, app->parameters.algorithm.at(1));
+        MSC_REQUIRE_EQ(3, app->parameters.replicas);
+        MSC_REQUIRE_EQ(true, app->parameters.warm_start);
+    }
+
+    MSC_AUTO_TEST_CASE(cli_batch_bad_replicas)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        auto app = msc::command_line_interface<batchapp>{"demo"};
+        const char *const argv[] = {__FILE__, "-a", "FMMM", "-R", "0", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(EXIT_FAILURE, status);
+        MSC_REQUIRE_NE(std::string{}, guard.get_stderr());
+    }
+
+    MSC_AUTO_TEST_CASE(expand_filename_batch_first_only)
+    {
+        const auto pattern = msc::output_file::from_filename("data-%-%.txt");
+        MSC_REQUIRE_EQ(msc::output_file::from_filename("data-7-%.txt"), msc::expand_filename_batch(pattern, 7));
+        MSC_REQUIRE_EQ(msc::output_file::from_stdio(), msc::expand_filename_batch(msc::output_file::from_stdio(), 7));
+        MSC_REQUIRE_EXCEPTION(
+            std::invalid_argument, msc::expand_filename_batch(msc::output_file::from_filename("data.txt"), 7)
+        );
+    }
+
+    MSC_AUTO_TEST_CASE(read_batch_list_skips_comments)
+    {
+        const auto tempfile = msc::test::tempfile{".txt"};
+        std::ofstream{tempfile.filename()} << "# layouts\n" << "alpha.xml\n" << "\n" << "beta.xml.gz\n";
+        const auto inputs = msc::read_batch_list(msc::input_file::from_filename(tempfile.filename()));
+        MSC_REQUIRE_EQ(2, inputs.size());
+        MSC_REQUIRE_EQ(msc::input_file::from_filename("alpha.xml"), inputs.at(0));
+        MSC_REQUIRE_EQ(msc::input_file::from_filename("beta.xml.gz"), inputs.at(1));
+    }
+
+    struct listapp
+    {
+        std::shared_ptr<std::vector<std::string>> seen{std::make_shared<std::vector<std::string>>()};
+        struct
+        {
+            msc::input_file input{"-"};
+            msc::output_file output{"-"};
+            msc::output_file meta{};
+            msc::input_file batch{};
+        } parameters{};
+        void operator()()
+        {
+            this->seen->push_back(this->parameters.input.filename() + " " + this->parameters.output.filename());
+            if (this->parameters.input.filename() == "broken.xml") {
+                throw std::runtime_error{"This input is broken"};
+            }
+            auto info = msc::json_object{};
+            info["producer"] = msc::json_text{"demo"};
+            msc::print_meta(info, this->parameters.meta);
+        }
+    };
+
+    MSC_AUTO_TEST_CASE(cli_batch_list)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        const auto listfile = msc::test::tempfile{".txt"};
+        const auto metafile = msc::test::tempfile{".json"};
+        std::ofstream{listfile.filename()} << "alpha.xml\n" << "beta.xml\n";
+        const auto listarg = "--batch=" + listfile.filename();
+        const auto metaarg = "--meta=" + metafile.filename();
+        auto app = msc::command_line_interface<listapp>{"demo"};
+        const char *const argv[] = {__FILE__, listarg.c_str(), metaarg.c_str(), "--output=out-%.txt", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(std::string{}, guard.get_stderr());
+        MSC_REQUIRE_EQ(EXIT_SUCCESS, status);
+        MSC_REQUIRE_EQ(2, app->seen->size());
+        MSC_REQUIRE_EQ("alpha.xml out-0.txt"s, app->seen->at(0));
+        MSC_REQUIRE_EQ("beta.xml out-1.txt"s, app->seen->at(1));
+        MSC_REQUIRE_EQ(msc::output_file::from_filename("out-%.txt"), app->parameters.output);
+        auto lines = std::istringstream{metafile.read()};
+        auto line = std::string{};
+        for (const auto expected : {"alpha.xml", "beta.xml"}) {
+            MSC_REQUIRE(std::getline(lines, line));
+            MSC_REQUIRE_NE(std::string::npos, line.find("\"producer\""));
+            MSC_REQUIRE_NE(std::string::npos, line.find(expected));
+        }
+        MSC_REQUIRE(!std::getline(lines, line));
+    }
+
+    MSC_AUTO_TEST_CASE(cli_batch_list_continues_after_error)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        const auto listfile = msc::test::tempfile{".txt"};
+        const auto metafile = msc::test::tempfile{".json"};
+        std::ofstream{listfile.filename()} << "alpha.xml\n" << "broken.xml\n" << "gamma.xml\n";
+        const auto listarg = "--batch=" + listfile.filename();
+        const auto metaarg = "--meta=" + metafile.filename();
+        auto app = msc::command_line_interface<listapp>{"demo"};
+        const char *const argv[] = {__FILE__, listarg.c_str(), metaarg.c_str(), "--output=out-%.txt", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(EXIT_FAILURE, status);
+        MSC_REQUIRE_NE(std::string::npos, guard.get_stderr().find("broken.xml: This input is broken"));
+        MSC_REQUIRE_NE(std::string::npos, guard.get_stderr().find("1 of 3 inputs failed"));
+        MSC_REQUIRE_EQ(3, app->seen->size());
+        MSC_REQUIRE_EQ("gamma.xml out-2.txt"s, app->seen->at(2));
+        auto lines = std::istringstream{metafile.read()};
+        auto line = std::string{};
+        for (const auto expected : {"alpha.xml", "broken.xml", "gamma.xml"}) {
+            const auto broken = (expected == "broken.xml"sv);
+            MSC_REQUIRE(std::getline(lines, line));
+            MSC_REQUIRE_NE(std::string::npos, line.find(expected));
+            MSC_REQUIRE_EQ(broken, line.find("\"producer\"") == std::string::npos);
+            MSC_REQUIRE_EQ(broken, line.find("This input is broken") != std::string::npos);
+        }
+        MSC_REQUIRE(!std::getline(lines, line));
+    }
+
+    MSC_AUTO_TEST_CASE(cli_batch_list_with_input)
+    {
+        const auto guard = msc::test::capture_stdio{};
+        auto app = msc::command_line_interface<listapp>{"demo"};
+        const char *const argv[] = {__FILE__, "--batch=list.txt", "input.xml", nullptr};
+        const auto status = app(cmdlen(argv), argv);
+        MSC_REQUIRE_EQ(EXIT_FAILURE, status);
+        MSC_REQUIRE_NE(std::string{}, guard.get_stderr());
+        MSC_REQUIRE(app->seen->empty());
+    }
+
 }  // namespace /*anonymous*/
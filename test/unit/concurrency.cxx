@@ -0,0 +1,114 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "concurrency.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "unittest.hxx"
+#include "testaux/envguard.hxx"
+
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
+namespace /*anonymous*/
+{
+
+    MSC_AUTO_TEST_CASE(default_concurrency_positive)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_JOBS"};
+        guard.unset();
+        MSC_REQUIRE_GE(msc::default_concurrency(), 1);
+    }
+
+    MSC_AUTO_TEST_CASE(default_concurrency_environment)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_JOBS"};
+        guard.set("7");
+        MSC_REQUIRE_EQ(7, msc::default_concurrency());
+    }
+
+    MSC_AUTO_TEST_CASE(default_concurrency_environment_bad)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_JOBS"};
+        for (const auto value : {"", "0", "-1", "many"}) {
+            guard.set(value);
+            MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::default_concurrency());
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(parallel_for_empty)
+    {
+        auto tally = 0;
+        msc::parallel_for(0, [&tally](std::size_t){ ++tally; });
+        MSC_REQUIRE_EQ(0, tally);
+    }
+
+    MSC_AUTO_TEST_CASE(parallel_for_each_once)
+    {
+        for (const auto jobs : {1, 2, 3, 16}) {
+            const auto n = std::size_t{1000};
+            auto visits = std::vector<std::atomic<int>>(n);
+            msc::parallel_for(n, [&visits](const std::size_t i){ visits[i].fetch_add(1); }, jobs);
+            MSC_REQUIRE(std::all_of(std::begin(visits), std::end(visits), [](auto&& x){ return x.load() == 1; }));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(parallel_for_result_independent_of_jobs)
+    {
+        const auto n = std::size_t{500};
+        const auto compute = [n](const std::size_t jobs){
+            auto results = std::vector<std::size_t>(n);
+            msc::parallel_for(n, [&results](const std::size_t i){ results[i] = i * i; }, jobs);
+            return results;
+        };
+        const auto expected = compute(1);
+        MSC_REQUIRE(expected == compute(4));
+        MSC_REQUIRE(expected == compute(n));
+    }
+
+    MSC_AUTO_TEST_CASE(parallel_for_exception)
+    {
+        for (const auto jobs : {1, 4}) {
+            const auto func = [](const std::size_t i){
+                if (i == 17) {
+                    throw std::runtime_error{std::to_string(i)};
+                }
+            };
+            try {
+                msc::parallel_for(100, func, jobs);
+                MSC_REQUIRE(false);
+            } catch (const std::runtime_error& e) {
+                MSC_REQUIRE_EQ(std::string{"17"}, std::string{e.what()});
+            }
+        }
+    }
+
+}  // namespace /*anonymous*/
@@ -30,7 +30,10 @@
 #include <utility>
 #include <vector>
 
+#include "file.hxx"
+#include "io.hxx"
 #include "json.hxx"
+#include "stochastic.hxx"
 
 #include "testaux/tempfile.hxx"
 #include "unittest.hxx"
@@ -126,6 +129,21 @@ namespace /*anonymous*/
         MSC_REQUIRE_EXCEPTION(std::invalid_argument, analyzer.analyze(data, info, info));
     }
 
+    MSC_AUTO_TEST_CASE(raw_same_as_write_events)
+    {
+        const auto streamed = msc::test::tempfile{"-streamed.dat"};
+        const auto direct = msc::test::tempfile{"-direct.dat"};
+        const auto data = make_random_data(1000);
+        auto analyzer = msc::data_analyzer{msc::kernels::raw};
+        analyzer.set_output(msc::output_file::from_filename(streamed.filename()));
+        auto info = msc::json_object{};
+        analyzer.analyze(data, info, info);
+        MSC_REQUIRE_EQ(data.size(), std::get<msc::json_size>(info["size"]).value);
+        const auto summary = msc::get_stochastic_summary(data);
+        msc::write_events(data, summary, msc::output_file::from_filename(direct.filename()));
+        MSC_REQUIRE_EQ(msc::test::readfile(direct.filename()), msc::test::readfile(streamed.filename()));
+    }
+
     msc::kernels random_kernel(std::mt19937& rndeng) noexcept
     {
         auto rnddst = std::uniform_int_distribution<std::size_t>{0, msc::all_kernels().size() - 1};
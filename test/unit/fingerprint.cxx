@@ -22,13 +22,20 @@
 
 #include "fingerprint.hxx"
 
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
 #include "point.hxx"
+#include "random.hxx"
 #include "testaux/cube.hxx"
 #include "unittest.hxx"
 
@@ -67,4 +74,129 @@ namespace /*anonynmous*/
         MSC_REQUIRE_NE(layout_before, layout_after);
     }
 
+    MSC_AUTO_TEST_CASE(isometry)
+    {
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto before = msc::isometry_fingerprint(*attrs);
+        MSC_REQUIRE_NE(msc::graph_fingerprint(*graph), before);
+        MSC_REQUIRE_NE(msc::layout_fingerprint(*attrs), before);
+        const auto phi = 0.4;
+        for (const auto v : graph->nodes) {
+            const auto x = attrs->x(v);
+            const auto y = attrs->y(v);
+            attrs->x(v) = 17.0 + std::cos(phi) * x - std::sin(phi) * y;
+            attrs->y(v) = -3.0 - std::sin(phi) * x - std::cos(phi) * y;
+        }
+        MSC_REQUIRE_EQ(before, msc::isometry_fingerprint(*attrs));
+    }
+
+    MSC_AUTO_TEST_CASE(isometry_not_congruent)
+    {
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto before = msc::isometry_fingerprint(*attrs);
+        attrs->x(graph->lastNode()) += 1.0;
+        const auto moved = msc::isometry_fingerprint(*attrs);
+        attrs->x(graph->lastNode()) -= 1.0;
+        attrs->scale(2.0, 2.0);
+        const auto scaled = msc::isometry_fingerprint(*attrs);
+        MSC_REQUIRE_NE(before, moved);
+        MSC_REQUIRE_NE(before, scaled);
+        MSC_REQUIRE_NE(moved, scaled);
+    }
+
+    // All nodes but four are on a line through the centroid.  Mirroring two of the others across that line keeps all
+    // distances to the centroid and between consecutive nodes but the layouts are not congruent.
+    MSC_AUTO_TEST_CASE(isometry_collinear_mirror)
+    {
+        auto graph = ogdf::Graph{};
+        for (auto i = 0; i < 12; ++i) {
+            graph.newNode();
+        }
+        auto attrs = ogdf::GraphAttributes{graph, ogdf::GraphAttributes::nodeGraphics};
+        for (const auto v : graph.nodes) {
+            const auto i = v->index();
+            attrs.x(v) = i - 3.0;
+            attrs.y(v) = (i % 3 != 2) ? 0.0 : (i % 2 == 0) ? 1.0 : -1.0;
+        }
+        const auto before = msc::isometry_fingerprint(attrs);
+        for (const auto v : graph.nodes) {
+            if ((v->index() == 2) || (v->index() == 5)) {
+                attrs.y(v) = -attrs.y(v);
+            }
+        }
+        MSC_REQUIRE_NE(before, msc::isometry_fingerprint(attrs));
+        for (const auto v : graph.nodes) {
+            attrs.y(v) = -attrs.y(v);
+        }
+        MSC_REQUIRE_NE(before, msc::isometry_fingerprint(attrs));
+    }
+
+    template <typename T>
+    std::string get_reference_fingerprint(const std::vector<T>& values)
+    {
+        auto seedseq = std::seed_seq(std::cbegin(values), std::cend(values));
+        auto rndeng = std::mt19937{seedseq};
+        return msc::random_hex_string(rndeng);
+    }
+
+    template <typename T>
+    std::string get_built_fingerprint(const std::vector<T>& values)
+    {
+        auto builder = msc::fingerprint_builder{values.size()};
+        for (const auto value : values) {
+            builder.add(value);
+        }
+        return builder.finish();
+    }
+
+    MSC_AUTO_TEST_CASE(builder_same_as_seed_seq)
+    {
+        for (const auto size : {0, 1, 2, 623, 624, 625, 2000}) {
+            auto integers = std::vector<int>{};
+            auto reals = std::vector<double>{};
+            for (auto i = 0; i < size; ++i) {
+                integers.push_back(i * 7919 - 1000);
+                reals.push_back(i * 12.5 - 3000.25);
+            }
+            MSC_REQUIRE_EQ(get_reference_fingerprint(integers), get_built_fingerprint(integers));
+            MSC_REQUIRE_EQ(get_reference_fingerprint(reals), get_built_fingerprint(reals));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(builder_same_as_graph_and_layout)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(50, 120);
+        auto graphfp = msc::fingerprint_builder{std::size_t(2 + graph->numberOfNodes() + 2 * graph->numberOfEdges())};
+        auto layoutfp = msc::fingerprint_builder{std::size_t(2 * graph->numberOfNodes() + 4 * graph->numberOfEdges())};
+        graphfp.add(graph->numberOfNodes());
+        graphfp.add(graph->numberOfEdges());
+        for (const auto v : graph->nodes) {
+            graphfp.add(v->index());
+            layoutfp.add(attrs->x(v));
+            layoutfp.add(attrs->y(v));
+        }
+        for (const auto e : graph->edges) {
+            graphfp.add(e->source()->index());
+            graphfp.add(e->target()->index());
+            for (const auto v : {e->source(), e->target()}) {
+                layoutfp.add(attrs->x(v));
+                layoutfp.add(attrs->y(v));
+            }
+        }
+        MSC_REQUIRE_EQ(msc::graph_fingerprint(*graph), graphfp.finish());
+        MSC_REQUIRE_EQ(msc::layout_fingerprint(*attrs), layoutfp.finish());
+    }
+
+    MSC_AUTO_TEST_CASE(builder_wrong_count)
+    {
+        auto builder = msc::fingerprint_builder{3};
+        builder.add(1);
+        builder.add(2);
+        MSC_REQUIRE_EXCEPTION(std::logic_error, builder.finish());
+        builder.add(3);
+        MSC_REQUIRE_EQ(get_reference_fingerprint(std::vector<int>{1, 2, 3}), builder.finish());
+        builder.add(4);
+        MSC_REQUIRE_EXCEPTION(std::logic_error, builder.finish());
+    }
+
 }  // namespace /*anonymous*/
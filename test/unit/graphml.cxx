@@ -0,0 +1,141 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "graphml.hxx"
+
+#include <stdexcept>
+#include <string>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "file.hxx"
+#include "fingerprint.hxx"
+#include "io.hxx"
+#include "ogdf_fix.hxx"
+#include "testaux/tempfile.hxx"
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    MSC_AUTO_TEST_CASE(empty_graph)
+    {
+        const auto tmp = msc::test::tempfile{".xml"};
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), false};
+        writer.close();
+        MSC_REQUIRE_EQ(0, writer.nodes());
+        MSC_REQUIRE_EQ(0, writer.edges());
+        const auto graph = msc::load_graph(msc::input_file::from_filename(tmp.filename()));
+        MSC_REQUIRE_EQ(0, graph->numberOfNodes());
+        MSC_REQUIRE_EQ(0, graph->numberOfEdges());
+    }
+
+    MSC_AUTO_TEST_CASE(graph_roundtrip)
+    {
+        const auto tmp = msc::test::tempfile{".xml.gz"};
+        auto expected = ogdf::Graph{};
+        const ogdf::node nodes[] = {expected.newNode(), expected.newNode(), expected.newNode()};
+        expected.newEdge(nodes[2], nodes[0]);
+        expected.newEdge(nodes[0], nodes[1]);
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), false};
+        MSC_REQUIRE_EQ(0, writer.add_node());
+        MSC_REQUIRE_EQ(1, writer.add_node());
+        MSC_REQUIRE_EQ(2, writer.add_node());
+        writer.add_edge(2, 0);
+        writer.add_edge(0, 1);
+        writer.close();
+        MSC_REQUIRE_EQ(3, writer.nodes());
+        MSC_REQUIRE_EQ(2, writer.edges());
+        const auto actual = msc::load_graph(msc::input_file::from_filename(tmp.filename()));
+        MSC_REQUIRE_EQ(msc::graph_fingerprint(expected), msc::graph_fingerprint(*actual));
+    }
+
+    MSC_AUTO_TEST_CASE(layout_roundtrip)
+    {
+        const auto tmp = msc::test::tempfile{".xml"};
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), true};
+        writer.add_node(0.0, 0.0);
+        writer.add_node(1.0, 0.5);
+        writer.add_edge(0, 1);
+        writer.add_node(-2.0, 1.0 / 3.0);
+        writer.add_edge(1, 2);
+        writer.close();
+        MSC_REQUIRE_CLOSE(1.0E-10, 3.0, writer.bounding_box_size().x());
+        MSC_REQUIRE_CLOSE(1.0E-10, 0.5, writer.bounding_box_size().y());
+        const auto [graph, attrs] = msc::load_layout(msc::input_file::from_filename(tmp.filename()));
+        MSC_REQUIRE_EQ(3, graph->numberOfNodes());
+        MSC_REQUIRE_EQ(2, graph->numberOfEdges());
+        const auto v = graph->lastNode();
+        MSC_REQUIRE_EQ(-2.0, attrs->x(v));
+        MSC_REQUIRE_EQ(1.0 / 3.0, attrs->y(v));
+        MSC_REQUIRE_EQ(writer.bounding_box_size(), msc::get_bounding_box_size(*attrs));
+    }
+
+    MSC_AUTO_TEST_CASE(graph_fingerprint_streamed)
+    {
+        const auto tmp = msc::test::tempfile{".xml"};
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), false};
+        writer.expect(4, 3);
+        for (auto i = 0; i < 4; ++i) {
+            writer.add_node();
+        }
+        writer.add_edge(0, 1);
+        writer.add_edge(3, 1);
+        writer.add_edge(2, 0);
+        MSC_REQUIRE_EQ(false, writer.graph_fingerprint().has_value());
+        writer.close();
+        MSC_REQUIRE_EQ(false, writer.layout_fingerprint().has_value());
+        const auto graph = msc::load_graph(msc::input_file::from_filename(tmp.filename()));
+        MSC_REQUIRE_EQ(msc::graph_fingerprint(*graph), writer.graph_fingerprint().value());
+    }
+
+    MSC_AUTO_TEST_CASE(layout_fingerprint_streamed)
+    {
+        const auto tmp = msc::test::tempfile{".xml"};
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), true};
+        writer.expect(3, 2);
+        writer.add_node(0.0, 0.0);
+        writer.add_node(1.0, 0.5);
+        writer.add_node(-2.0, 1.0 / 3.0);
+        writer.add_edge(0, 1);
+        writer.add_edge(2, 1);
+        writer.close();
+        const auto [graph, attrs] = msc::load_layout(msc::input_file::from_filename(tmp.filename()));
+        MSC_REQUIRE_EQ(msc::graph_fingerprint(*graph), writer.graph_fingerprint().value());
+        MSC_REQUIRE_EQ(msc::layout_fingerprint(*attrs), writer.layout_fingerprint().value());
+    }
+
+    MSC_AUTO_TEST_CASE(fingerprint_wrong_size)
+    {
+        const auto tmp = msc::test::tempfile{".xml"};
+        auto writer = msc::graphml_writer{msc::output_file::from_filename(tmp.filename()), true};
+        writer.expect(2, 1);
+        writer.add_node(0.0, 0.0);
+        MSC_REQUIRE_EXCEPTION(std::logic_error, writer.add_edge(0, 0));
+        writer.add_node(1.0, 1.0);
+        MSC_REQUIRE_EXCEPTION(std::logic_error, writer.add_node(2.0, 2.0));
+        MSC_REQUIRE_EXCEPTION(std::logic_error, writer.close());
+    }
+
+}  // namespace /*anonymous*/
@@ -0,0 +1,115 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "hashmap.hxx"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    MSC_AUTO_TEST_CASE(mix_bits_bijective)
+    {
+        auto seen = std::set<std::uint64_t>{};
+        for (auto x = std::uint64_t{}; x < 1000; ++x) {
+            MSC_REQUIRE(seen.insert(msc::mix_bits(x)).second);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(integer_hash_array)
+    {
+        const auto hash = msc::integer_hash<std::array<long, 3>>{};
+        MSC_REQUIRE_EQ(hash({1, 2, 3}), hash({1, 2, 3}));
+        MSC_REQUIRE_NE(hash({1, 2, 3}), hash({3, 2, 1}));
+        MSC_REQUIRE_NE(hash({0, 0, 1}), hash({0, 1, 0}));
+    }
+
+    MSC_AUTO_TEST_CASE(empty)
+    {
+        const auto map = msc::open_hash_map<int, std::string>{};
+        MSC_REQUIRE(map.empty());
+        MSC_REQUIRE_EQ(0, map.size());
+        MSC_REQUIRE(!map.contains(42));
+        MSC_REQUIRE(map.find(42) == nullptr);
+    }
+
+    MSC_AUTO_TEST_CASE(try_emplace)
+    {
+        auto map = msc::open_hash_map<int, std::string>{};
+        const auto [first, inserted1st] = map.try_emplace(1, "one");
+        MSC_REQUIRE(inserted1st);
+        MSC_REQUIRE_EQ(std::string{"one"}, *first);
+        const auto [second, inserted2nd] = map.try_emplace(1, "uno");
+        MSC_REQUIRE(!inserted2nd);
+        MSC_REQUIRE_EQ(std::string{"one"}, *second);
+        MSC_REQUIRE_EQ(1, map.size());
+        *map.find(1) = "eins";
+        MSC_REQUIRE_EQ(std::string{"eins"}, *map.find(1));
+    }
+
+    MSC_AUTO_TEST_CASE(clear)
+    {
+        auto map = msc::open_hash_map<int, int>{10};
+        for (auto i = 0; i < 10; ++i) {
+            map.try_emplace(i, i);
+        }
+        MSC_REQUIRE_EQ(10, map.size());
+        map.clear();
+        MSC_REQUIRE(map.empty());
+        for (auto i = 0; i < 10; ++i) {
+            MSC_REQUIRE(!map.contains(i));
+        }
+        map.try_emplace(3, 4);
+        MSC_REQUIRE_EQ(4, *map.find(3));
+    }
+
+    MSC_AUTO_TEST_CASE(same_as_std_map)
+    {
+        auto engine = std::mt19937{};
+        auto keydist = std::uniform_int_distribution<long>{-500, 500};
+        auto expected = std::map<std::array<long, 2>, int>{};
+        auto actual = msc::open_hash_map<std::array<long, 2>, int>{};
+        for (auto i = 0; i < 10000; ++i) {
+            const auto key = std::array<long, 2>{keydist(engine), keydist(engine) / 10};
+            const auto [pos, need] = expected.insert({key, i});
+            const auto [value, inserted] = actual.try_emplace(key, i);
+            MSC_REQUIRE_EQ(need, inserted);
+            MSC_REQUIRE_EQ(pos->second, *value);
+        }
+        MSC_REQUIRE_EQ(expected.size(), actual.size());
+        auto tally = std::size_t{};
+        actual.for_each([&expected, &tally](const auto& key, const auto value){
+            MSC_REQUIRE_EQ(expected.at(key), value);
+            tally += 1;
+        });
+        MSC_REQUIRE_EQ(expected.size(), tally);
+    }
+
+}  // namespace /*anonymous*/
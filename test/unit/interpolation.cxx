@@ -0,0 +1,248 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "interpolation.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "normalizer.hxx"
+#include "ogdf_fix.hxx"
+#include "rdf.hxx"
+#include "tension.hxx"
+#include "testaux/cube.hxx"
+#include "testaux/tempfile.hxx"
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    std::vector<msc::point2d> get_all_coordinates(const ogdf::GraphAttributes& attrs)
+    {
+        auto coords = std::vector<msc::point2d>{};
+        for (const auto v : attrs.constGraph().nodes) {
+            coords.push_back(msc::get_coords(attrs, v));
+        }
+        return coords;
+    }
+
+    std::unique_ptr<ogdf::GraphAttributes> interpolate(const ogdf::GraphAttributes& lhs,
+                                                       const ogdf::GraphAttributes& rhs,
+                                                       const double rate)
+    {
+        auto inter = std::make_unique<ogdf::GraphAttributes>(lhs);
+        for (const auto v : lhs.constGraph().nodes) {
+            const auto p = (1.0 - rate) * msc::get_coords(lhs, v) + rate * msc::get_coords(rhs, v);
+            inter->x(v) = p.x();
+            inter->y(v) = p.y();
+        }
+        msc::normalize_layout(*inter);
+        return inter;
+    }
+
+    template <typename RangeT>
+    std::vector<double> get_sorted(const RangeT& range)
+    {
+        auto values = std::vector<double>(std::begin(range), std::end(range));
+        std::sort(std::begin(values), std::end(values));
+        return values;
+    }
+
+    void require_same_values(std::vector<double> expected, std::vector<double> actual)
+    {
+        std::sort(std::begin(actual), std::end(actual));
+        MSC_REQUIRE_EQ(expected.size(), actual.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            MSC_REQUIRE_CLOSE(1.0E-9 * (1.0 + expected[i]), expected[i], actual[i]);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(no_rates)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(10, 20);
+        const auto coords = get_all_coordinates(*attrs);
+        const auto results = msc::evaluate_interpolation(*graph, coords, coords, {}, nullptr, true);
+        MSC_REQUIRE(results.empty());
+    }
+
+    MSC_AUTO_TEST_CASE(wrong_size)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(10, 20);
+        const auto coords = get_all_coordinates(*attrs);
+        const auto fewer = std::vector<msc::point2d>(std::begin(coords), std::end(coords) - 1);
+        MSC_REQUIRE_EXCEPTION(
+            std::invalid_argument, msc::evaluate_interpolation(*graph, coords, fewer, {0.5}, nullptr, false)
+        );
+    }
+
+    MSC_AUTO_TEST_CASE(no_edges)
+    {
+        const auto graph = std::make_unique<ogdf::Graph>();
+        const auto v1 = graph->newNode();
+        const auto v2 = graph->newNode();
+        const auto lhs = std::vector<msc::point2d>{{0.0, 0.0}, {10.0, 0.0}};
+        const auto rhs = std::vector<msc::point2d>{{0.0, 0.0}, {0.0, 30.0}};
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
+        const auto results = msc::evaluate_interpolation(*graph, lhs, rhs, {0.0, 1.0}, matrix.get(), true);
+        MSC_REQUIRE_EQ(std::size_t{2}, results.size());
+        for (const auto& result : results) {
+            MSC_REQUIRE_EQ(std::size_t{1}, result.distances.size());
+            MSC_REQUIRE_CLOSE(1.0E-10, msc::default_node_distance, result.distances.front());
+            MSC_REQUIRE(result.tensions.empty());
+            MSC_REQUIRE_EQ(0.0, result.moments.count);
+        }
+        MSC_REQUIRE_CLOSE(1.0E-10, 10.0, results[0].scale);
+        MSC_REQUIRE_CLOSE(1.0E-10, 10.0 / 3.0, results[1].scale);
+        (void) v1;
+        (void) v2;
+    }
+
+    MSC_AUTO_TEST_CASE(same_as_individually)
+    {
+        const auto [graph, lhs] = msc::test::make_test_layout(60, 150, "lhs");
+        auto rhs = std::make_unique<ogdf::GraphAttributes>(*lhs);
+        auto rndeng = std::mt19937{};
+        auto coorddist = std::uniform_real_distribution<double>{-500.0, 500.0};
+        for (const auto v : graph->nodes) {
+            rhs->x(v) = coorddist(rndeng);
+            rhs->y(v) = coorddist(rndeng);
+        }
+        const auto rates = std::vector<double>{0.0, 0.1, 0.25, 0.5, 0.75, 0.9, 1.0};
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
+        const auto results = msc::evaluate_interpolation(
+            *graph, get_all_coordinates(*lhs), get_all_coordinates(*rhs), rates, matrix.get(), true
+        );
+        MSC_REQUIRE_EQ(rates.size(), results.size());
+        for (std::size_t r = 0; r < rates.size(); ++r) {
+            const auto& result = results[r];
+            MSC_REQUIRE_EQ(rates[r], result.rate);
+            const auto inter = interpolate(*lhs, *rhs, rates[r]);
+            const auto bbox = msc::get_bounding_box_size(*inter);
+            MSC_REQUIRE_CLOSE(1.0E-9 * bbox.x(), bbox.x(), result.bbox.x());
+            MSC_REQUIRE_CLOSE(1.0E-9 * bbox.y(), bbox.y(), result.bbox.y());
+            require_same_values(get_sorted(msc::global_pairwise_distances{*inter}), result.distances);
+            auto scaled = ogdf::GraphAttributes{*inter};
+            scaled.scale(1.0 / msc::default_node_distance);
+            const auto tension = msc::pairwise_tension{scaled, *matrix, graph->numberOfNodes() + 1.0};
+            require_same_values(get_sorted(tension), result.tensions);
+            const auto moments = msc::compute_stress_moments(*inter);
+            MSC_REQUIRE_EQ(moments.count, result.moments.count);
+            MSC_REQUIRE_CLOSE(1.0E-9 * moments.linear, moments.linear, result.moments.linear);
+            MSC_REQUIRE_CLOSE(1.0E-9 * moments.quadratic, moments.quadratic, result.moments.quadratic);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(without_matrix)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(20, 30);
+        const auto coords = get_all_coordinates(*attrs);
+        const auto results = msc::evaluate_interpolation(*graph, coords, coords, {0.3}, nullptr, false);
+        MSC_REQUIRE_EQ(std::size_t{1}, results.size());
+        MSC_REQUIRE(results.front().distances.empty());
+        MSC_REQUIRE(results.front().tensions.empty());
+        MSC_REQUIRE_EQ(0.0, results.front().moments.count);
+        MSC_REQUIRE_GT(results.front().scale, 0.0);
+    }
+
+    MSC_AUTO_TEST_CASE(batch_size_unlimited)
+    {
+        MSC_REQUIRE_EQ(std::size_t{7}, msc::get_interpolation_batch_size(1000, 7, true, true, std::nullopt));
+        MSC_REQUIRE_EQ(std::size_t{7}, msc::get_interpolation_batch_size(1000, 7, false, false, std::size_t{1}));
+        MSC_REQUIRE_EQ(std::size_t{7}, msc::get_interpolation_batch_size(1, 7, true, true, std::size_t{1}));
+        MSC_REQUIRE_EQ(std::size_t{1}, msc::get_interpolation_batch_size(1000, 0, true, true, std::nullopt));
+    }
+
+    MSC_AUTO_TEST_CASE(batch_size_limited)
+    {
+        // 100 nodes have 4950 pairs which need 39600 bytes per vector.
+        const auto perrate = std::size_t{4950} * sizeof(double);
+        const auto budget = [](const std::size_t usable){ return std::optional<std::size_t>{usable + usable / 7}; };
+        MSC_REQUIRE_EQ(std::size_t{10}, msc::get_interpolation_batch_size(100, 10, true, false, budget(10 * perrate)));
+        MSC_REQUIRE_EQ(std::size_t{3}, msc::get_interpolation_batch_size(100, 10, true, false, budget(3 * perrate)));
+        MSC_REQUIRE_EQ(std::size_t{3}, msc::get_interpolation_batch_size(100, 10, false, true, budget(3 * perrate)));
+        MSC_REQUIRE_EQ(std::size_t{1}, msc::get_interpolation_batch_size(100, 10, true, true, budget(3 * perrate)));
+        MSC_REQUIRE_EQ(std::size_t{1}, msc::get_interpolation_batch_size(100, 10, true, true, std::size_t{0}));
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_per_rate)
+    {
+        const auto [graph, lhs] = msc::test::make_test_layout(40, 80, "lhs");
+        auto rhs = std::make_unique<ogdf::GraphAttributes>(*lhs);
+        auto rndeng = std::mt19937{};
+        auto coorddist = std::uniform_real_distribution<double>{-500.0, 500.0};
+        for (const auto v : graph->nodes) {
+            rhs->x(v) = coorddist(rndeng);
+            rhs->y(v) = coorddist(rndeng);
+        }
+        const auto rates = std::vector<double>{0.0, 0.5, 1.0};
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
+        const auto results = msc::evaluate_interpolation(
+            *graph, get_all_coordinates(*lhs), get_all_coordinates(*rhs), rates, matrix.get(), true
+        );
+        const auto rdffile = msc::test::tempfile{".txt"};
+        const auto tensionfile = msc::test::tempfile{".txt"};
+        const auto rdfdst = msc::output_file::from_filename(rdffile.filename());
+        const auto tensiondst = msc::output_file::from_filename(tensionfile.filename());
+        const auto analyzer = msc::data_analyzer{msc::kernels::boxed};
+        const auto get_mean = [](const std::vector<double>& values){
+            return std::accumulate(std::begin(values), std::end(values), 0.0) / values.size();
+        };
+        const auto get_real = [](const msc::json_object& info, const std::string& key, const std::string& subkey){
+            const auto& sub = std::get<msc::json_object>(info.at(key));
+            return std::get<msc::json_real>(sub.at(subkey)).value;
+        };
+        auto means = std::vector<double>{};
+        for (const auto& result : results) {
+            const auto info = msc::analyze_interpolated_properties(result, analyzer, rdfdst, tensiondst, true);
+            const auto expected = get_mean(result.distances);
+            MSC_REQUIRE_CLOSE(1.0E-9 * expected, expected, get_real(info, "rdf-global", "mean"));
+            const auto expectedtension = get_mean(result.tensions);
+            MSC_REQUIRE_CLOSE(1.0E-9 * expectedtension, expectedtension, get_real(info, "tension", "mean"));
+            MSC_REQUIRE(std::get<msc::json_object>(info.at("rdf-global")).count("bincount"));
+            const auto stress = msc::get_stress(result.moments, msc::default_node_distance);
+            MSC_REQUIRE_CLOSE(1.0E-9 * stress, stress, std::get<msc::json_real>(info.at("stress")).value);
+            means.push_back(expected);
+        }
+        MSC_REQUIRE_NE(means.front(), means.back());
+    }
+
+    MSC_AUTO_TEST_CASE(analysis_not_requested)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(20, 30);
+        const auto coords = get_all_coordinates(*attrs);
+        const auto results = msc::evaluate_interpolation(*graph, coords, coords, {0.3}, nullptr, false);
+        const auto null = msc::output_file::from_null();
+        const auto analyzer = msc::data_analyzer{msc::kernels::boxed};
+        const auto info = msc::analyze_interpolated_properties(results.front(), analyzer, null, null, false);
+        MSC_REQUIRE(info.empty());
+    }
+
+}  // namespace /*anonymous*/
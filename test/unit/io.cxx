@@ -26,9 +26,12 @@
 #include <map>
 #include <memory>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -36,7 +39,9 @@
 #include "file.hxx"
 #include "fingerprint.hxx"
 #include "ogdf_fix.hxx"
+#include "profile.hxx"
 #include "testaux/cube.hxx"
+#include "testaux/envguard.hxx"
 #include "testaux/tempfile.hxx"
 #include "unittest.hxx"
 
@@ -194,4 +199,75 @@ namespace /*anonymous*/
         msc::import_graph(file, msc::internal_file_format);  // this should be fine
     }
 
+    MSC_AUTO_TEST_CASE(prefetch_layouts_in_order)
+    {
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto tmp1st = msc::test::tempfile{".xml"};
+        const auto tmp2nd = msc::test::tempfile{".xml.gz"};
+        const auto tmp3rd = msc::test::tempfile{".xml"};
+        const auto files = std::vector<msc::input_file>{
+            msc::input_file::from_filename(tmp1st.filename()),
+            msc::input_file::from_filename(tmp2nd.filename()),
+            msc::input_file::from_filename(tmp3rd.filename()),
+        };
+        msc::store_layout(*attrs, msc::output_file::from_filename(tmp1st.filename()));
+        msc::store_layout(*attrs, msc::output_file::from_filename(tmp2nd.filename()));
+        msc::store_graph(*graph, msc::output_file::from_filename(tmp3rd.filename()));
+        const auto prefetcher = msc::layout_prefetcher{files, 1};
+        for (std::size_t i = 0; i < 2; ++i) {
+            const auto [graph2nd, attrs2nd] = msc::load_layout(files.at(i));
+            MSC_REQUIRE_EQ(msc::layout_fingerprint(*attrs), msc::layout_fingerprint(*attrs2nd));
+        }
+        MSC_REQUIRE_EXCEPTION(msc::degenerated_layout, msc::load_layout(files.at(2)));
+        MSC_REQUIRE_EXCEPTION(std::logic_error, msc::layout_prefetcher{files});
+    }
+
+    MSC_AUTO_TEST_CASE(prefetch_layouts_profile)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        guard.set("1");
+        const auto sizes = std::vector<std::pair<int, int>>{{10, 20}, {30, 40}, {50, 60}, {70, 80}};
+        auto tempfiles = std::vector<msc::test::tempfile>{};
+        auto files = std::vector<msc::input_file>{};
+        tempfiles.reserve(sizes.size());  // tempfiles must not be moved
+        for (const auto& [nodes, edges] : sizes) {
+            const auto [graph, attrs] = msc::test::make_test_layout(nodes, edges);
+            const auto& tmp = tempfiles.emplace_back(".xml");
+            msc::store_layout(*attrs, msc::output_file::from_filename(tmp.filename()));
+            files.push_back(msc::input_file::from_filename(tmp.filename()));
+        }
+        const auto prefetcher = msc::layout_prefetcher{files, 2};
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            msc::reset_profile();
+            const auto layout = msc::load_layout(files.at(i));
+            const auto info = msc::get_profile_info();
+            MSC_REQUIRE_EQ(sizes.at(i).first, std::get<msc::json_size>(info.at("nodes")).value);
+            MSC_REQUIRE_EQ(sizes.at(i).second, std::get<msc::json_size>(info.at("edges")).value);
+            const auto& phases = std::get<msc::json_object>(info.at("phases"));
+            const auto& load = std::get<msc::json_object>(phases.at("load"));
+            MSC_REQUIRE_EQ(1, std::get<msc::json_size>(load.at("count")).value);
+        }
+        guard.unset();
+        msc::reset_profile();
+    }
+
+    MSC_AUTO_TEST_CASE(prefetch_layouts_out_of_order)
+    {
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto tmp1st = msc::test::tempfile{".xml"};
+        const auto tmp2nd = msc::test::tempfile{".xml"};
+        const auto files = std::vector<msc::input_file>{
+            msc::input_file::from_filename(tmp1st.filename()),
+            msc::input_file::from_filename(tmp2nd.filename()),
+        };
+        msc::store_layout(*attrs, msc::output_file::from_filename(tmp1st.filename()));
+        msc::store_layout(*attrs, msc::output_file::from_filename(tmp2nd.filename()));
+        const auto prefetcher = msc::layout_prefetcher{files};
+        for (const auto index : {1, 0, 0, 1, 1}) {
+            const auto [graph2nd, attrs2nd] = msc::load_layout(files.at(index));
+            MSC_REQUIRE_EQ(msc::layout_fingerprint(*attrs), msc::layout_fingerprint(*attrs2nd));
+        }
+    }
+
 }  // namespace /*anonymous*/
@@ -22,6 +22,11 @@
 
 #include "iosupp.hxx"
 
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "testaux/tempfile.hxx"
 #include "unittest.hxx"
 
 namespace /*anonymous*/
@@ -213,4 +218,41 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(msc::compressions::gzip, msc::guess_compression("good/file.gz"));
     }
 
+    MSC_AUTO_TEST_CASE(write_deferred)
+    {
+        auto temps = std::vector<msc::test::tempfile>{};
+        temps.reserve(20);
+        for (auto i = 0; i < 20; ++i) {
+            temps.emplace_back(".txt");
+            const auto dst = msc::output_file::from_filename(temps.back().filename());
+            msc::write_deferred(std::to_string(i), dst, "Cannot write test data");
+        }
+        msc::finish_deferred_writes();
+        for (auto i = 0; i < 20; ++i) {
+            MSC_REQUIRE_EQ(std::to_string(i), msc::test::readfile(temps[i].filename()));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(write_deferred_same_file)
+    {
+        const auto temp = msc::test::tempfile{".txt"};
+        const auto dst = msc::output_file::from_filename(temp.filename());
+        for (auto i = 0; i < 100; ++i) {
+            msc::write_deferred(std::to_string(i), dst, "Cannot write test data");
+        }
+        MSC_REQUIRE(msc::await_deferred_writes(dst));
+        MSC_REQUIRE_EQ("99", msc::test::readfile(temp.filename()));
+        msc::finish_deferred_writes();
+    }
+
+    MSC_AUTO_TEST_CASE(write_deferred_error)
+    {
+        const auto temp = msc::test::tempfile{};
+        const auto dst = msc::output_file::from_filename(temp.filename() + "/no/such/directory/file.txt");
+        msc::write_deferred("Hello, World!\n", dst, "Cannot write test data");
+        MSC_REQUIRE(!msc::await_deferred_writes(dst));
+        MSC_REQUIRE_THROWS(msc::finish_deferred_writes());
+        msc::finish_deferred_writes();
+    }
+
 }  // namespace /*anonymous*/
@@ -23,11 +23,14 @@
 #include "meta.hxx"
 
 #include <cstdio>
+#include <cstddef>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
 
 #if __has_include(<unistd.h>)
 #  include <unistd.h>
@@ -124,4 +127,50 @@ namespace /*anonymous*/
         MSC_REQUIRE_EXCEPTION(std::system_error, msc::print_meta(get_silly_info(), msc::file::from_descriptor(12345)));
     }
 
+    MSC_AUTO_TEST_CASE(meta_batch_lines)
+    {
+        const auto tempfile = msc::test::tempfile{".json"};
+        const auto ignored = msc::test::tempfile{".json"};
+        const auto info = get_silly_info();
+        auto expected = std::string{};
+        {
+            auto batch = msc::meta_batch{msc::file::from_filename(tempfile.filename())};
+            MSC_REQUIRE_EXCEPTION(std::logic_error, msc::meta_batch{msc::file{}});
+            for (std::size_t i = 0; i < 3; ++i) {
+                const auto input = msc::input_file::from_filename("input-" + std::to_string(i) + ".xml");
+                batch.select(i, input);
+                msc::print_meta(info, msc::file::from_filename(ignored.filename()));
+                auto batchinfo = msc::json_object{};
+                batchinfo["index"] = msc::json_size{i};
+                batchinfo["input"] = msc::json_text{input.filename()};
+                auto annotated = info;
+                annotated["batch"] = std::move(batchinfo);
+                expected.append(stringize(annotated));
+            }
+            batch.finish();
+        }
+        MSC_REQUIRE_EQ(expected, tempfile.read());
+        MSC_REQUIRE_EQ(std::string{}, ignored.read());
+        msc::print_meta(info, msc::file::from_filename(tempfile.filename()));
+        MSC_REQUIRE_EQ(stringize(info), tempfile.read());
+    }
+
+    MSC_AUTO_TEST_CASE(meta_batch_error)
+    {
+        const auto tempfile = msc::test::tempfile{".json"};
+        {
+            auto batch = msc::meta_batch{msc::file::from_filename(tempfile.filename())};
+            batch.select(3, msc::input_file::from_filename("input.xml"));
+            batch.report_error("Something went wrong");
+            batch.finish();
+        }
+        auto batchinfo = msc::json_object{};
+        batchinfo["index"] = msc::json_size{3};
+        batchinfo["input"] = msc::json_text{"input.xml"};
+        auto expected = msc::json_object{};
+        expected["error"] = msc::json_text{"Something went wrong"};
+        expected["batch"] = std::move(batchinfo);
+        MSC_REQUIRE_EQ(stringize(expected), tempfile.read());
+    }
+
 }  // namespace /*anonymous*/
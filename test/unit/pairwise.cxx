@@ -22,21 +22,35 @@
 
 #include "pairwise.hxx"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <random>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 
+#include "cache.hxx"
+#include "fingerprint.hxx"
 #include "testaux/cube.hxx"
+#include "testaux/envguard.hxx"
+#include "testaux/tempfile.hxx"
 #include "unittest.hxx"
 
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
 namespace /*anonymous*/
 {
 
@@ -354,6 +368,372 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(0, remembers_everything::history.size());
     }
 
+    MSC_AUTO_TEST_CASE(shortest_compact)
+    {
+        const auto graph = msc::test::make_test_graph(50, 60);
+        graph->newNode();  // isolated
+        const auto full = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        const auto compact = msc::get_pairwise_shortest_paths(*graph, msc::strategies::compact);
+        MSC_REQUIRE_EQ(msc::strategies::full, full->strategy());
+        MSC_REQUIRE_EQ(msc::strategies::compact, compact->strategy());
+        MSC_REQUIRE_LT(compact->footprint(), full->footprint());
+        for (const auto v1 : graph->nodes) {
+            for (const auto v2 : graph->nodes) {
+                MSC_REQUIRE_EQ((*full)(v1, v2), (*compact)(v1, v2));
+            }
+        }
+        MSC_REQUIRE_GE((*compact)(graph->firstNode(), graph->lastNode()), huge_distance);
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_external)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_MAPPED_FILES);
+        // Enough nodes so the matrix spans several windows.
+        const auto graph = msc::test::make_test_graph(200, 300);
+        graph->newNode();  // isolated
+        const auto full = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        const auto external = msc::get_pairwise_shortest_paths(*graph, msc::strategies::external);
+        MSC_REQUIRE_EQ(msc::strategies::external, external->strategy());
+        MSC_REQUIRE_LT(external->footprint(), full->footprint());
+        for (const auto v1 : graph->nodes) {
+            for (const auto v2 : graph->nodes) {
+                MSC_REQUIRE_EQ((*full)(v1, v2), (*external)(v1, v2));
+            }
+        }
+        // Going backwards moves the window every time.
+        for (auto v1 = graph->lastNode(); v1 != nullptr; v1 = v1->pred()) {
+            MSC_REQUIRE_EQ((*full)(v1, graph->firstNode()), (*external)(v1, graph->firstNode()));
+        }
+        MSC_REQUIRE_GE((*external)(graph->firstNode(), graph->lastNode()), huge_distance);
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_external_no_tmpdir)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_MAPPED_FILES);
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_TMPDIR"};
+        guard.set("/no/such/directory");
+        const auto graph = msc::test::make_cube_graph();
+        MSC_REQUIRE_EXCEPTION(
+            std::system_error,
+            msc::get_pairwise_shortest_paths(*graph, msc::strategies::external)
+        );
+    }
+
+    // Points `MSC_CACHE_DIR` to the directory that contains a fresh temporary file.  The cache entry for the given
+    // graph is removed when the object is created and again when it is destroyed.
+    struct cache_fixture final
+    {
+        msc::test::envguard guard{"MSC_CACHE_DIR"};
+        msc::test::tempfile tmp{};
+        std::string filename{};
+
+        explicit cache_fixture(const ogdf::Graph& graph)
+        {
+            const auto pos = tmp.filename().rfind('/');
+            MSC_REQUIRE_NE(std::string::npos, pos);
+            guard.set(tmp.filename().substr(0, pos));
+            filename = msc::get_cache_filename(msc::graph_fingerprint(graph) + ".apsp").value();
+            std::remove(filename.c_str());
+        }
+
+        ~cache_fixture() noexcept
+        {
+            std::remove(filename.c_str());
+        }
+    };
+
+    void require_same_distances(const ogdf::Graph& graph,
+                                const msc::distance_matrix& expected,
+                                const msc::distance_matrix& actual)
+    {
+        for (const auto v1 : graph.nodes) {
+            for (const auto v2 : graph.nodes) {
+                MSC_REQUIRE_EQ(expected(v1, v2), actual(v1, v2));
+            }
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_cached)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SHARED_FILES);
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto graph = msc::test::make_test_graph(50, 60);
+        graph->newNode();  // isolated
+        const auto fixture = cache_fixture{*graph};
+        const auto first = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        MSC_REQUIRE(!first->cached());
+        MSC_REQUIRE(std::ifstream{fixture.filename});
+        for (const auto strategy : {msc::strategies::full, msc::strategies::compact, msc::strategies::external}) {
+            const auto again = msc::get_pairwise_shortest_paths(*graph, strategy);
+            MSC_REQUIRE(again->cached());
+            MSC_REQUIRE_EQ(strategy, again->strategy());
+            MSC_REQUIRE_EQ(0, again->footprint());
+            MSC_REQUIRE_EQ(first->components(), again->components());
+            require_same_distances(*graph, *first, *again);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_cached_wide)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SHARED_FILES);
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        // The diameter of the path is too large for single-byte hop counts.
+        auto graph = std::make_unique<ogdf::Graph>();
+        auto previous = graph->newNode();
+        for (auto i = 1; i < 300; ++i) {
+            const auto current = graph->newNode();
+            graph->newEdge(previous, current);
+            previous = current;
+        }
+        const auto fixture = cache_fixture{*graph};
+        const auto first = msc::get_pairwise_shortest_paths(*graph, msc::strategies::compact);
+        const auto again = msc::get_pairwise_shortest_paths(*graph, msc::strategies::compact);
+        MSC_REQUIRE(!first->cached());
+        MSC_REQUIRE(again->cached());
+        MSC_REQUIRE_EQ(299, (*again)(graph->firstNode(), graph->lastNode()));
+        require_same_distances(*graph, *first, *again);
+    }
+
+    // The paths need several windows and their hop counts are stored as single bytes and 16 bit integers, respectively.
+    MSC_AUTO_TEST_CASE(shortest_cached_external)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SHARED_FILES);
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        for (const auto n : {200, 300}) {
+            auto graph = std::make_unique<ogdf::Graph>();
+            auto previous = graph->newNode();
+            for (auto i = 1; i < n; ++i) {
+                const auto current = graph->newNode();
+                graph->newEdge(previous, current);
+                previous = current;
+            }
+            const auto fixture = cache_fixture{*graph};
+            const auto first = msc::get_pairwise_shortest_paths(*graph, msc::strategies::external);
+            const auto again = msc::get_pairwise_shortest_paths(*graph, msc::strategies::external);
+            MSC_REQUIRE(!first->cached());
+            MSC_REQUIRE(again->cached());
+            MSC_REQUIRE_EQ(0, again->footprint());
+            MSC_REQUIRE_EQ(n - 1, (*again)(graph->lastNode(), graph->firstNode()));
+            require_same_distances(*graph, *first, *again);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_cached_corrupt)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SHARED_FILES);
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        const auto graph = msc::test::make_cube_graph();
+        const auto fixture = cache_fixture{*graph};
+        std::ofstream{fixture.filename} << "This is not a distance matrix.\n";
+        const auto first = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        MSC_REQUIRE(!first->cached());
+        // The broken entry was replaced.
+        const auto again = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        MSC_REQUIRE(again->cached());
+        require_same_distances(*graph, *first, *again);
+    }
+
+    // The graph has the components {1, 3, 5}, {2, 4} and {6} with interleaved node indices.
+    MSC_AUTO_TEST_CASE(shortest_components)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        const auto v1 = graph->newNode();
+        const auto v2 = graph->newNode();
+        const auto v3 = graph->newNode();
+        const auto v4 = graph->newNode();
+        const auto v5 = graph->newNode();
+        const auto v6 = graph->newNode();
+        graph->newEdge(v1, v3);
+        graph->newEdge(v3, v5);
+        graph->newEdge(v4, v2);
+        for (const auto strategy : {msc::strategies::full, msc::strategies::compact}) {
+            const auto matrix = msc::get_pairwise_shortest_paths(std::as_const(*graph), strategy);
+            MSC_REQUIRE_EQ(3, matrix->components());
+            MSC_REQUIRE_EQ(11, matrix->unreachable_pairs());
+            MSC_REQUIRE_EQ(2, (*matrix)[v1][v5]);
+            MSC_REQUIRE_EQ(1, (*matrix)[v2][v4]);
+            MSC_REQUIRE_EQ(0, (*matrix)[v6][v6]);
+            MSC_REQUIRE_GE((*matrix)[v1][v2], huge_distance);
+            MSC_REQUIRE_GE((*matrix)[v4][v5], huge_distance);
+            MSC_REQUIRE_GE((*matrix)[v6][v3], huge_distance);
+            MSC_REQUIRE_EQ(v1, matrix->first_node());
+            MSC_REQUIRE_EQ(v3, matrix->next_in_component(v1));
+            MSC_REQUIRE_EQ(v5, matrix->next_in_component(v3));
+            MSC_REQUIRE(matrix->next_in_component(v5) == nullptr);
+            MSC_REQUIRE_EQ(v2, matrix->next_node(v5));
+            MSC_REQUIRE(matrix->next_in_component(v6) == nullptr);
+            MSC_REQUIRE(matrix->next_node(v6) == nullptr);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_components_footprint)
+    {
+        // The blocks of ten disjoint copies of a graph need a tenth of the memory that a dense matrix would.
+        auto graph = std::make_unique<ogdf::Graph>();
+        for (auto i = 0; i < 10; ++i) {
+            auto previous = graph->newNode();
+            for (auto j = 1; j < 10; ++j) {
+                const auto current = graph->newNode();
+                graph->newEdge(previous, current);
+                previous = current;
+            }
+        }
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+        MSC_REQUIRE_EQ(10, matrix->components());
+        MSC_REQUIRE_EQ(10 * 10 * 10 * sizeof(double), matrix->footprint());
+        MSC_REQUIRE_EQ((100 * 100 - 10 * 10 * 10) / 2, matrix->unreachable_pairs());
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_compact_many_components)
+    {
+        // Far too many nodes for 16 bit hop counts but every component is small.
+        auto graph = std::make_unique<ogdf::Graph>();
+        for (auto i = 0; i < 70000; ++i) {
+            graph->newNode();
+        }
+        graph->newEdge(graph->firstNode(), graph->lastNode());
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph, msc::strategies::compact);
+        MSC_REQUIRE_EQ(69999, matrix->components());
+        MSC_REQUIRE_EQ(1, (*matrix)(graph->firstNode(), graph->lastNode()));
+        MSC_REQUIRE_GE((*matrix)(graph->firstNode(), graph->firstNode()->succ()), huge_distance);
+    }
+
+    MSC_AUTO_TEST_CASE(npi_components)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        const auto v1 = graph->newNode();
+        const auto v2 = graph->newNode();
+        const auto v3 = graph->newNode();
+        const auto v4 = graph->newNode();
+        const auto v5 = graph->newNode();
+        graph->newEdge(v1, v4);
+        graph->newEdge(v2, v5);
+        graph->newEdge(v5, v3);
+        const auto matrix = msc::get_pairwise_shortest_paths(std::as_const(*graph));
+        using iterator = msc::node_pair_iterator<>;
+        const auto expected = std::vector<msc::node_pair>{{v1, v4}, {v2, v3}, {v2, v5}, {v3, v5}};
+        const auto actual = std::vector<msc::node_pair>(iterator{*matrix}, iterator{});
+        MSC_REQUIRE_EQ(expected, actual);
+    }
+
+    MSC_AUTO_TEST_CASE(npi_components_none)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        graph->newNode();
+        graph->newNode();
+        const auto matrix = msc::get_pairwise_shortest_paths(std::as_const(*graph));
+        using iterator = msc::node_pair_iterator<>;
+        MSC_REQUIRE(!iterator{*matrix});
+        MSC_REQUIRE(iterator{*matrix} == iterator{});
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_sampled_all)
+    {
+        const auto graph = msc::test::make_cube_graph();
+        const auto full = msc::get_pairwise_shortest_paths(*graph);
+        auto engine = std::mt19937{};
+        const auto landmarks = msc::select_landmarks(*graph, 100, engine);
+        MSC_REQUIRE_EQ(8, landmarks.size());
+        const auto sampled = msc::get_sampled_shortest_paths(*graph, landmarks);
+        MSC_REQUIRE_EQ(msc::strategies::sampled, sampled->strategy());
+        MSC_REQUIRE_EQ(8, sampled->landmarks());
+        for (const auto v1 : graph->nodes) {
+            for (const auto v2 : graph->nodes) {
+                MSC_REQUIRE_EQ((*full)[v1][v2], (*sampled)[v1][v2]);
+            }
+        }
+        using iterator = msc::node_pair_iterator<>;
+        MSC_REQUIRE_EQ(56, std::distance(iterator{*sampled}, iterator{}));
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_sampled_few)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        const auto v1 = graph->newNode();
+        const auto v2 = graph->newNode();
+        const auto v3 = graph->newNode();
+        const auto v4 = graph->newNode();
+        const auto v5 = graph->newNode();
+        graph->newEdge(v1, v2);
+        graph->newEdge(v2, v3);
+        graph->newEdge(v4, v5);
+        const auto matrix = msc::get_sampled_shortest_paths(std::as_const(*graph), {v2, v4, v2});
+        MSC_REQUIRE_EQ(2, matrix->landmarks());
+        MSC_REQUIRE_EQ(2, matrix->components());
+        MSC_REQUIRE_EQ(5 * sizeof(double), matrix->footprint());
+        MSC_REQUIRE_EQ(1, (*matrix)[v1][v2]);
+        MSC_REQUIRE_EQ(1, (*matrix)[v3][v2]);
+        MSC_REQUIRE_EQ(1, (*matrix)[v4][v5]);
+        MSC_REQUIRE_GE((*matrix)[v2][v5], huge_distance);
+        MSC_REQUIRE(std::isnan((*matrix)[v1][v3]));
+        MSC_REQUIRE_EQ(v2, matrix->first_node());
+        MSC_REQUIRE_EQ(v4, matrix->next_node(v2));
+        MSC_REQUIRE(matrix->next_node(v4) == nullptr);
+        using iterator = msc::node_pair_iterator<>;
+        const auto expected = std::vector<msc::node_pair>{{v2, v1}, {v2, v3}, {v4, v5}};
+        const auto actual = std::vector<msc::node_pair>(iterator{*matrix}, iterator{});
+        MSC_REQUIRE_EQ(expected, actual);
+    }
+
+    MSC_AUTO_TEST_CASE(select_landmarks_distinct)
+    {
+        const auto graph = msc::test::make_cube_graph();
+        auto engine = std::mt19937{};
+        const auto landmarks = msc::select_landmarks(*graph, 5, engine);
+        MSC_REQUIRE_EQ(5, landmarks.size());
+        MSC_REQUIRE_EQ(5, std::set<ogdf::node>(std::begin(landmarks), std::end(landmarks)).size());
+    }
+
+    MSC_AUTO_TEST_CASE(diameter_empty)
+    {
+        auto graph = std::make_unique<ogdf::Graph>();
+        MSC_REQUIRE_EQ(0, msc::get_graph_diameter(*graph));
+        graph->newNode();
+        graph->newNode();
+        MSC_REQUIRE_EQ(0, msc::get_graph_diameter(*graph));
+    }
+
+    MSC_AUTO_TEST_CASE(diameter_components)
+    {
+        // A cube (diameter 3) and a path of length 5 with interleaved node indices.
+        const auto graph = msc::test::make_cube_graph();
+        auto previous = graph->newNode();
+        for (auto i = 0; i < 5; ++i) {
+            graph->newNode();
+            const auto current = graph->newNode();
+            graph->newEdge(previous, current);
+            previous = current;
+        }
+        MSC_REQUIRE_EQ(5, msc::get_graph_diameter(*graph));
+    }
+
+    MSC_AUTO_TEST_CASE(diameter_random)
+    {
+        for (const auto seed : {"a", "b", "c", "d"}) {
+            const auto graph = msc::test::make_test_graph(100, 110, seed);
+            const auto matrix = msc::get_pairwise_shortest_paths(*graph, msc::strategies::full);
+            auto expected = 0.0;
+            for (const auto v1 : graph->nodes) {
+                for (const auto v2 : graph->nodes) {
+                    if (const auto distance = (*matrix)(v1, v2); distance < huge_distance) {
+                        expected = std::max(expected, distance);
+                    }
+                }
+            }
+            MSC_REQUIRE_EQ(expected, msc::get_graph_diameter(*graph));
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(shortest_unsupported)
+    {
+        const auto graph = msc::test::make_cube_graph();
+        MSC_REQUIRE_EXCEPTION(
+            std::invalid_argument,
+            msc::get_pairwise_shortest_paths(*graph, msc::strategies::sampled)
+        );
+    }
+
     MSC_AUTO_TEST_CASE(vicinity_npp_negative)
     {
         const double limits[] = {-1.0E-10, -1.0, -1.0E100, -HUGE_VAL, -INFINITY};
@@ -0,0 +1,189 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "planner.hxx"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "rlimits.hxx"
+#include "testaux/cube.hxx"
+#include "testaux/envguard.hxx"
+#include "unittest.hxx"
+
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
+namespace /*anonymous*/
+{
+
+    using msc::strategies;
+
+    constexpr auto huge_graph = std::size_t{1} << 24;
+
+    MSC_AUTO_TEST_CASE(footprint_ordering)
+    {
+        const auto n = std::size_t{1000};
+        const auto m = std::size_t{3000};
+        const auto full = msc::estimate_distance_footprint(strategies::full, n, m);
+        const auto compact = msc::estimate_distance_footprint(strategies::compact, n, m);
+        const auto external = msc::estimate_distance_footprint(strategies::external, n, m);
+        const auto sampled = msc::estimate_distance_footprint(strategies::sampled, n, m);
+        MSC_REQUIRE_GE(full, n * n * sizeof(double));
+        MSC_REQUIRE_LT(compact, full);
+        MSC_REQUIRE_LT(external, compact);
+        MSC_REQUIRE_LT(sampled, compact);
+    }
+
+    MSC_AUTO_TEST_CASE(footprint_compact_too_large)
+    {
+        const auto unrepresentable = std::numeric_limits<std::size_t>::max();
+        MSC_REQUIRE_EQ(unrepresentable, msc::estimate_distance_footprint(strategies::compact, 70000, 100000));
+    }
+
+    MSC_AUTO_TEST_CASE(footprint_saturates)
+    {
+        const auto unrepresentable = std::numeric_limits<std::size_t>::max();
+        const auto n = unrepresentable / 2;
+        MSC_REQUIRE_EQ(unrepresentable, msc::estimate_distance_footprint(strategies::full, n, n));
+    }
+
+    MSC_AUTO_TEST_CASE(footprint_components)
+    {
+        const auto unrepresentable = std::numeric_limits<std::size_t>::max();
+        const auto components = std::vector<std::size_t>(10, 7000);
+        const auto disconnected = msc::estimate_distance_footprint(strategies::full, components, 60000);
+        const auto connected = msc::estimate_distance_footprint(strategies::full, 70000, 60000);
+        MSC_REQUIRE_LT(disconnected, connected / 5);
+        MSC_REQUIRE_NE(unrepresentable, msc::estimate_distance_footprint(strategies::compact, components, 60000));
+    }
+
+    MSC_AUTO_TEST_CASE(plan_small)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.unset();
+        const auto graph = msc::test::make_cube_graph();
+        const auto plan = msc::plan_pairwise_distances(*graph, {strategies::full, strategies::compact});
+        MSC_REQUIRE_EQ(strategies::full, plan.strategy);
+        MSC_REQUIRE_EQ(msc::estimate_distance_footprint(strategies::full, 8, 12), plan.footprint);
+        MSC_REQUIRE(!plan.forced);
+    }
+
+    MSC_AUTO_TEST_CASE(plan_huge_degrades)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        MSC_SKIP_UNLESS(msc::get_memory_budget().has_value());
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.unset();
+        const auto candidates = {strategies::full, strategies::compact, strategies::sampled};
+        const auto plan = msc::plan_pairwise_distances(huge_graph, 2 * huge_graph, candidates, 1);
+        MSC_REQUIRE_EQ(strategies::sampled, plan.strategy);
+        MSC_REQUIRE_EQ(1, plan.landmarks);
+        MSC_REQUIRE(plan.budget.has_value());
+    }
+
+    MSC_AUTO_TEST_CASE(plan_huge_fails_early)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        MSC_SKIP_UNLESS(msc::get_memory_budget().has_value());
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.unset();
+        MSC_REQUIRE_EXCEPTION(
+            std::runtime_error,
+            msc::plan_pairwise_distances(huge_graph, 2 * huge_graph, {strategies::full, strategies::compact})
+        );
+    }
+
+    MSC_AUTO_TEST_CASE(plan_forced)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.set("compact");
+        const auto plan = msc::plan_pairwise_distances(10, 20, {strategies::full, strategies::compact});
+        MSC_REQUIRE_EQ(strategies::compact, plan.strategy);
+        MSC_REQUIRE(plan.forced);
+    }
+
+    MSC_AUTO_TEST_CASE(plan_forced_unsupported)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.set("sampled");
+        MSC_REQUIRE_EXCEPTION(
+            std::invalid_argument,
+            msc::plan_pairwise_distances(10, 20, {strategies::full, strategies::compact})
+        );
+    }
+
+    MSC_AUTO_TEST_CASE(plan_forced_invalid)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.set("cheap");
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::plan_pairwise_distances(10, 20, {strategies::full}));
+    }
+
+    MSC_AUTO_TEST_CASE(plan_info)
+    {
+        auto plan = msc::distance_plan{};
+        plan.strategy = strategies::compact;
+        plan.footprint = 42;
+        const auto info = msc::get_distance_plan_info(plan);
+        MSC_REQUIRE_EQ(std::string{"compact"}, std::get<msc::json_text>(info.at("strategy")).value);
+        MSC_REQUIRE_EQ(42, std::get<msc::json_size>(info.at("footprint")).value);
+        MSC_REQUIRE(std::holds_alternative<msc::json_null>(info.at("budget")));
+        MSC_REQUIRE_EQ(false, std::get<msc::json_bool>(info.at("forced")).value);
+        MSC_REQUIRE_EQ(1, std::get<msc::json_size>(info.at("components")).value);
+        MSC_REQUIRE_EQ(0, std::get<msc::json_size>(info.at("unreachable-pairs")).value);
+        MSC_REQUIRE(std::holds_alternative<msc::json_null>(info.at("landmarks")));
+    }
+
+    MSC_AUTO_TEST_CASE(footprint_landmarks)
+    {
+        const auto n = std::size_t{1000};
+        const auto m = std::size_t{3000};
+        const auto few = msc::estimate_distance_footprint(strategies::sampled, n, m, 10);
+        const auto many = msc::estimate_distance_footprint(strategies::sampled, n, m, 100);
+        const auto all = msc::estimate_distance_footprint(strategies::sampled, n, m, 2 * n);
+        MSC_REQUIRE_EQ(90 * n * sizeof(double), many - few);
+        MSC_REQUIRE_EQ(msc::estimate_distance_footprint(strategies::full, n, m), all);
+    }
+
+    MSC_AUTO_TEST_CASE(plan_components)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_DISTANCES"};
+        guard.unset();
+        auto graph = std::make_unique<ogdf::Graph>();
+        graph->newEdge(graph->newNode(), graph->newNode());
+        graph->newNode();
+        const auto plan = msc::plan_pairwise_distances(*graph, {strategies::full});
+        MSC_REQUIRE_EQ(2, plan.components);
+        MSC_REQUIRE_EQ(2, plan.unreachable);
+    }
+
+}  // namespace /*anonymous*/
@@ -0,0 +1,160 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "profile.hxx"
+
+#include <chrono>
+#include <thread>
+#include <variant>
+
+#include "testaux/envguard.hxx"
+#include "unittest.hxx"
+
+#define CAN_RESTORE_ENVIRONMENT  (HAVE_POSIX_GETENV && HAVE_POSIX_SETENV && HAVE_POSIX_UNSETENV)
+
+namespace /*anonymous*/
+{
+
+    const msc::json_object& get_object(const msc::json_object& info, const char *const key)
+    {
+        return std::get<msc::json_object>(info.at(key));
+    }
+
+    MSC_AUTO_TEST_CASE(disabled_by_default)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        for (const auto value : {"", "0"}) {
+            guard.set(value);
+            msc::reset_profile();
+            MSC_REQUIRE(!msc::profiling_enabled());
+            {
+                const auto timer = msc::profile_timer{"alpha"};
+            }
+            msc::note_profile_graph_size(10, 20);
+            const auto info = msc::get_profile_info();
+            MSC_REQUIRE(get_object(info, "phases").empty());
+            MSC_REQUIRE(std::holds_alternative<msc::json_null>(info.at("nodes")));
+        }
+        guard.unset();
+        msc::reset_profile();
+        MSC_REQUIRE(!msc::profiling_enabled());
+    }
+
+    MSC_AUTO_TEST_CASE(phases_accumulate)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        guard.set("1");
+        msc::reset_profile();
+        MSC_REQUIRE(msc::profiling_enabled());
+        for (auto i = 0; i < 3; ++i) {
+            const auto timer = msc::profile_timer{"alpha"};
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        }
+        {
+            auto timer = msc::profile_timer{"beta"};
+            timer.stop();
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        const auto info = msc::get_profile_info();
+        const auto& phases = get_object(info, "phases");
+        MSC_REQUIRE_EQ(2, phases.size());
+        const auto& alpha = std::get<msc::json_object>(phases.at("alpha"));
+        const auto& beta = std::get<msc::json_object>(phases.at("beta"));
+        MSC_REQUIRE_EQ(3, std::get<msc::json_size>(alpha.at("count")).value);
+        MSC_REQUIRE_EQ(1, std::get<msc::json_size>(beta.at("count")).value);
+        const auto alphatime = std::get<msc::json_real>(alpha.at("time")).value;
+        const auto betatime = std::get<msc::json_real>(beta.at("time")).value;
+        const auto wall = std::get<msc::json_real>(info.at("wall")).value;
+        MSC_REQUIRE_GE(alphatime, 0.006);
+        MSC_REQUIRE_LT(betatime, 0.020);
+        MSC_REQUIRE_GE(wall, alphatime + 0.020);
+        msc::reset_profile();
+        MSC_REQUIRE(get_object(msc::get_profile_info(), "phases").empty());
+    }
+
+    MSC_AUTO_TEST_CASE(graph_size)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        guard.set("yes");
+        msc::reset_profile();
+        msc::note_profile_graph_size(10, 20);
+        msc::note_profile_graph_size(30, 40);
+        const auto info = msc::get_profile_info();
+        MSC_REQUIRE_EQ(30, std::get<msc::json_size>(info.at("nodes")).value);
+        MSC_REQUIRE_EQ(40, std::get<msc::json_size>(info.at("edges")).value);
+    }
+
+    MSC_AUTO_TEST_CASE(explicit_phase)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        guard.set("1");
+        msc::reset_profile();
+        msc::note_profile_phase("alpha", 0.5);
+        msc::note_profile_phase("alpha", 0.25);
+        const auto info = msc::get_profile_info();
+        const auto& alpha = std::get<msc::json_object>(get_object(info, "phases").at("alpha"));
+        MSC_REQUIRE_EQ(2, std::get<msc::json_size>(alpha.at("count")).value);
+        MSC_REQUIRE_CLOSE(1.0E-10, 0.75, std::get<msc::json_real>(alpha.at("time")).value);
+    }
+
+    MSC_AUTO_TEST_CASE(suspended_thread)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_PROFILE"};
+        guard.set("1");
+        msc::reset_profile();
+        msc::note_profile_graph_size(10, 20);
+        auto worker = std::thread{[](){
+            const auto suspension = msc::profile_suspension{};
+            const auto timer = msc::profile_timer{"alpha"};
+            msc::note_profile_graph_size(30, 40);
+        }};
+        worker.join();
+        {
+            const auto timer = msc::profile_timer{"beta"};
+        }
+        const auto info = msc::get_profile_info();
+        const auto& phases = get_object(info, "phases");
+        MSC_REQUIRE_EQ(1, phases.size());
+        MSC_REQUIRE_EQ(1, phases.count("beta"));
+        MSC_REQUIRE_EQ(10, std::get<msc::json_size>(info.at("nodes")).value);
+        MSC_REQUIRE_EQ(20, std::get<msc::json_size>(info.at("edges")).value);
+    }
+
+    MSC_AUTO_TEST_CASE(rusage)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_GETRUSAGE);
+        const auto info = msc::get_profile_info();
+        const auto& rusage = get_object(info, "rusage");
+        MSC_REQUIRE_GT(std::get<msc::json_size>(rusage.at("maxrss")).value, 0);
+        MSC_REQUIRE(std::holds_alternative<msc::json_size>(rusage.at("minflt")));
+        MSC_REQUIRE(std::holds_alternative<msc::json_size>(rusage.at("majflt")));
+        MSC_REQUIRE_GE(std::get<msc::json_real>(rusage.at("utime")).value, 0.0);
+        MSC_REQUIRE_GE(std::get<msc::json_real>(rusage.at("stime")).value, 0.0);
+    }
+
+}  // namespace /*anonymous*/
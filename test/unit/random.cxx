@@ -22,9 +22,12 @@
 
 #include "random.hxx"
 
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <ios>
 #include <random>
+#include <set>
 #include <sstream>
 
 #include "unittest.hxx"
@@ -64,6 +67,31 @@ namespace /*anonymous*/
         MSC_REQUIRE_NE(engine1st, engine2nd);
     }
 
+    MSC_AUTO_TEST_CASE(seed_explicit)
+    {
+        using namespace std::string_literals;
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_RANDOM_SEED"};
+        guard.set("Hay un camino a la cima de las mas altas montanas");
+        auto engine1st = std::mt19937{};
+        auto engine2nd = std::mt19937{};
+        const auto seed1st = msc::seed_random_engine(engine1st);
+        const auto seed2nd = msc::seed_random_engine(engine2nd, "Hay un camino a la cima de las mas altas montanas");
+        MSC_REQUIRE_EQ(seed1st, seed2nd);
+        MSC_REQUIRE_EQ(engine1st, engine2nd);
+    }
+
+    MSC_AUTO_TEST_CASE(seed_substreams)
+    {
+        auto master = std::mt19937{};
+        auto engine1st = std::mt19937{};
+        auto engine2nd = std::mt19937{};
+        const auto seed1st = msc::seed_random_engine(engine1st, msc::random_hex_string(master, 24));
+        const auto seed2nd = msc::seed_random_engine(engine2nd, msc::random_hex_string(master, 24));
+        MSC_REQUIRE_NE(seed1st, seed2nd);
+        MSC_REQUIRE_NE(engine1st, engine2nd);
+    }
+
     MSC_AUTO_TEST_CASE(random_hex_string_1st)
     {
         using namespace std::string_literals;
@@ -116,4 +144,94 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(expected, actual);
     }
 
+    MSC_AUTO_TEST_CASE(philox_known_answers)
+    {
+        // Known-answer tests from the Random123 distribution.
+        using block_type = std::array<std::uint32_t, 4>;
+        using key_type = std::array<std::uint32_t, 2>;
+        MSC_REQUIRE_EQ(
+            (block_type{0x6627E8D5U, 0xE169C58DU, 0xBC57AC4CU, 0x9B00DBD8U}),
+            msc::philox_engine::encrypt(block_type{}, key_type{})
+        );
+        MSC_REQUIRE_EQ(
+            (block_type{0x408F276DU, 0x41C83B0EU, 0xA20BC7C6U, 0x6D5451FDU}),
+            msc::philox_engine::encrypt(
+                block_type{0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU}, key_type{0xFFFFFFFFU, 0xFFFFFFFFU}
+            )
+        );
+        MSC_REQUIRE_EQ(
+            (block_type{0xD16CFE09U, 0x94FDCCEBU, 0x5001E420U, 0x24126EA1U}),
+            msc::philox_engine::encrypt(
+                block_type{0x243F6A88U, 0x85A308D3U, 0x13198A2EU, 0x03707344U}, key_type{0xA4093822U, 0x299F31D0U}
+            )
+        );
+    }
+
+    MSC_AUTO_TEST_CASE(philox_sequence)
+    {
+        auto engine = msc::philox_engine{};
+        const auto first = msc::philox_engine::encrypt({0, 0, 0, 0}, {0, 0});
+        const auto second = msc::philox_engine::encrypt({1, 0, 0, 0}, {0, 0});
+        for (const auto expected : first) {
+            MSC_REQUIRE_EQ(expected, engine());
+        }
+        for (const auto expected : second) {
+            MSC_REQUIRE_EQ(expected, engine());
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(philox_discard)
+    {
+        for (const auto before : {0, 1, 3, 4, 5}) {
+            for (const auto count : {0ULL, 1ULL, 3ULL, 4ULL, 7ULL, 100ULL}) {
+                auto engine1st = msc::philox_engine{42};
+                auto engine2nd = msc::philox_engine{42};
+                for (auto i = 0; i < before; ++i) {
+                    engine1st();
+                    engine2nd();
+                }
+                engine1st.discard(count);
+                for (auto i = 0ULL; i < count; ++i) {
+                    engine2nd();
+                }
+                MSC_REQUIRE_EQ(engine2nd(), engine1st());
+            }
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(philox_seeded)
+    {
+        MSC_SKIP_UNLESS(CAN_RESTORE_ENVIRONMENT);
+        auto guard = msc::test::envguard{"MSC_RANDOM_SEED"};
+        guard.set("1492");
+        auto engine1st = msc::philox_engine{};
+        auto engine2nd = msc::philox_engine{};
+        msc::seed_random_engine(engine1st);
+        MSC_REQUIRE_NE(engine1st, engine2nd);
+        msc::seed_random_engine(engine2nd);
+        MSC_REQUIRE_EQ(engine1st, engine2nd);
+        auto dist = std::uniform_real_distribution<double>{0.0, 1.0};
+        MSC_REQUIRE_EQ(dist(engine1st), dist(engine2nd));
+    }
+
+    MSC_AUTO_TEST_CASE(philox_substreams)
+    {
+        auto master = msc::philox_engine{42};
+        const auto sub0 = master.substream(0);
+        const auto sub1 = master.substream(1);
+        MSC_REQUIRE_NE(sub0, sub1);
+        MSC_REQUIRE_NE(master, sub0);
+        MSC_REQUIRE_NE(sub0, sub0.substream(0));
+        MSC_REQUIRE_NE(sub1.substream(0), sub0.substream(1));
+        master.discard(1000);
+        MSC_REQUIRE_EQ(sub0, master.substream(0));
+        auto copy = sub1;
+        auto values = std::set<std::uint32_t>{};
+        for (auto i = 0; i < 100; ++i) {
+            values.insert(copy());
+            values.insert(master.substream(i + 2)());
+        }
+        MSC_REQUIRE_GT(values.size(), 190);
+    }
+
 }  // namespace /*anonymous*/
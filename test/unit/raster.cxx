@@ -0,0 +1,285 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "raster.hxx"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include <boost/iostreams/compose.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+
+#include "math_constants.hxx"
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    namespace io = boost::iostreams;
+
+    constexpr auto black = msc::raster_color{0, 0, 0};
+    constexpr auto white = msc::raster_color{255, 255, 255};
+
+    // Total coverage of all pixels (in pixels) assuming that everything was drawn in black.
+    double darkness(const msc::raster_image& image)
+    {
+        auto total = 0.0;
+        for (auto y = std::size_t{}; y < image.height(); ++y) {
+            for (auto x = std::size_t{}; x < image.width(); ++x) {
+                total += (255 - image.get(x, y).red) / 255.0;
+            }
+        }
+        return total;
+    }
+
+    msc::raster_scene make_scene(const double radius, const double stroke)
+    {
+        auto scene = msc::raster_scene{};
+        scene.layers.emplace_back();
+        scene.layers.back().color = black;
+        scene.radius = radius;
+        scene.stroke = stroke;
+        return scene;
+    }
+
+    std::uint32_t read_u32(const std::string& buffer, const std::size_t pos)
+    {
+        auto value = std::uint32_t{};
+        for (auto i = pos; i < pos + 4; ++i) {
+            value = (value << 8) | static_cast<unsigned char>(buffer.at(i));
+        }
+        return value;
+    }
+
+    MSC_AUTO_TEST_CASE(blank_image)
+    {
+        const auto image = msc::raster_image{3, 2};
+        MSC_REQUIRE_EQ(3, image.width());
+        MSC_REQUIRE_EQ(2, image.height());
+        MSC_REQUIRE_EQ(18, image.data().size());
+        for (const auto byte : image.data()) {
+            MSC_REQUIRE_EQ(255, byte);
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(blend_pixel)
+    {
+        auto image = msc::raster_image{2, 2};
+        image.blend(1, 0, msc::raster_color{0, 100, 255}, 0.5);
+        MSC_REQUIRE_EQ(white, image.get(0, 0));
+        MSC_REQUIRE_EQ((msc::raster_color{128, 178, 255}), image.get(1, 0));
+        image.blend(0, 1, black, 1.0);
+        MSC_REQUIRE_EQ(black, image.get(0, 1));
+    }
+
+    MSC_AUTO_TEST_CASE(empty_scene)
+    {
+        const auto scene = make_scene(5.0, 1.0);
+        const auto image = msc::render_scene(scene, msc::fit_raster_view(scene, 16), 16, 16);
+        MSC_REQUIRE_EQ(0.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(disc_area)
+    {
+        auto scene = make_scene(10.0, 0.0);
+        scene.layers.back().discs.emplace_back(0.0, 0.0);
+        const auto view = msc::raster_view{1.0, msc::point2d{-32.0, -32.0}};
+        const auto image = msc::render_scene(scene, view, 64, 64);
+        MSC_REQUIRE_EQ(black, image.get(32, 32));
+        MSC_REQUIRE_EQ(black, image.get(25, 32));
+        MSC_REQUIRE_EQ(white, image.get(32, 20));
+        MSC_REQUIRE_EQ(white, image.get(0, 0));
+        MSC_REQUIRE_NE(black, image.get(32, 22));
+        MSC_REQUIRE_NE(white, image.get(32, 22));
+        MSC_REQUIRE_CLOSE(2.0, M_PI * 100.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(adjacent_shapes_have_no_seams)
+    {
+        auto scene = make_scene(0.0, 2.0);
+        scene.layers.back().lines.emplace_back(msc::point2d{0.0, 8.5}, msc::point2d{16.0, 8.5});
+        scene.layers.back().lines.emplace_back(msc::point2d{0.0, 10.5}, msc::point2d{16.0, 10.5});
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 16, 16);
+        MSC_REQUIRE_EQ(black, image.get(5, 8));
+        MSC_REQUIRE_EQ(black, image.get(5, 9));
+        MSC_REQUIRE_EQ(black, image.get(5, 10));
+        MSC_REQUIRE_CLOSE(0.1, 64.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(line_area)
+    {
+        auto scene = make_scene(0.0, 4.0);
+        scene.layers.back().lines.emplace_back(msc::point2d{8.0, 16.0}, msc::point2d{56.0, 16.0});
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 64, 32);
+        MSC_REQUIRE_EQ(black, image.get(8, 14));
+        MSC_REQUIRE_EQ(black, image.get(55, 17));
+        MSC_REQUIRE_EQ(white, image.get(7, 16));
+        MSC_REQUIRE_EQ(white, image.get(56, 16));
+        MSC_REQUIRE_EQ(white, image.get(30, 13));
+        MSC_REQUIRE_EQ(white, image.get(30, 18));
+        MSC_REQUIRE_CLOSE(1.0E-6, 192.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(thin_line_is_anti_aliased)
+    {
+        auto scene = make_scene(0.0, 0.5);
+        scene.layers.back().lines.emplace_back(msc::point2d{0.0, 8.0}, msc::point2d{16.0, 8.0});
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 16, 16);
+        MSC_REQUIRE_EQ((msc::raster_color{191, 191, 191}), image.get(5, 7));
+        MSC_REQUIRE_EQ((msc::raster_color{191, 191, 191}), image.get(5, 8));
+        MSC_REQUIRE_CLOSE(0.1, 8.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(shapes_are_clipped)
+    {
+        auto scene = make_scene(3.0, 2.0);
+        scene.layers.back().lines.emplace_back(msc::point2d{-100.0, 16.0}, msc::point2d{200.0, 16.0});
+        scene.layers.back().lines.emplace_back(msc::point2d{16.0, -100.0}, msc::point2d{16.0, 200.0});
+        scene.layers.back().lines.emplace_back(msc::point2d{-50.0, -60.0}, msc::point2d{90.0, 80.0});
+        scene.layers.back().discs.emplace_back(-20.0, 16.0);
+        scene.layers.back().discs.emplace_back(1000.0, 1000.0);
+        scene.layers.back().discs.emplace_back(0.0, 0.0);
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 32, 32);
+        MSC_REQUIRE_EQ(black, image.get(0, 16));
+        MSC_REQUIRE_EQ(black, image.get(31, 15));
+        MSC_REQUIRE_EQ(black, image.get(16, 0));
+        MSC_REQUIRE_EQ(black, image.get(15, 31));
+        MSC_REQUIRE_EQ(black, image.get(0, 0));
+        MSC_REQUIRE_EQ(white, image.get(31, 0));
+        MSC_REQUIRE_EQ(white, image.get(0, 31));
+    }
+
+    MSC_AUTO_TEST_CASE(tiny_discs_are_splatted)
+    {
+        auto scene = make_scene(0.25, 0.0);
+        scene.layers.back().discs.emplace_back(4.5, 4.5);
+        scene.layers.back().discs.emplace_back(10.0, 10.0);
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 16, 16);
+        const auto value = static_cast<std::uint8_t>(255 - std::lround(255.0 * M_PI / 16.0));
+        MSC_REQUIRE_EQ((msc::raster_color{value, value, value}), image.get(4, 4));
+        MSC_REQUIRE_EQ(white, image.get(5, 4));
+        MSC_REQUIRE_NE(white, image.get(9, 9));
+        MSC_REQUIRE_NE(white, image.get(10, 10));
+        MSC_REQUIRE_CLOSE(0.02, 2.0 * M_PI / 16.0, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(short_lines_are_splatted)
+    {
+        auto scene = make_scene(0.0, 0.5);
+        scene.layers.back().lines.emplace_back(msc::point2d{4.25, 4.5}, msc::point2d{4.75, 4.5});
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 8, 8);
+        MSC_REQUIRE_EQ((msc::raster_color{191, 191, 191}), image.get(4, 4));
+        MSC_REQUIRE_CLOSE(0.01, 0.25, darkness(image));
+    }
+
+    MSC_AUTO_TEST_CASE(layers_are_drawn_in_order)
+    {
+        auto scene = make_scene(2.0, 2.0);
+        scene.layers.back().discs.emplace_back(8.0, 8.0);
+        scene.layers.emplace_back();
+        scene.layers.back().color = msc::raster_color{255, 0, 0};
+        scene.layers.back().lines.emplace_back(msc::point2d{0.0, 8.0}, msc::point2d{16.0, 8.0});
+        const auto image = msc::render_scene(scene, msc::raster_view{}, 16, 16);
+        MSC_REQUIRE_EQ(black, image.get(8, 8));
+        MSC_REQUIRE_EQ((msc::raster_color{255, 0, 0}), image.get(1, 8));
+    }
+
+    MSC_AUTO_TEST_CASE(fit_view)
+    {
+        auto scene = make_scene(1.0, 0.5);
+        scene.layers.back().lines.emplace_back(msc::point2d{-3.0, 2.0}, msc::point2d{7.0, 4.0});
+        const auto view = msc::fit_raster_view(scene, 60);
+        MSC_REQUIRE_CLOSE(1.0E-10, 5.0, view.scale);
+        const auto center = view.scale * msc::point2d{2.0, 3.0} - view.offset;
+        MSC_REQUIRE_CLOSE(1.0E-10, 30.0, center.x());
+        MSC_REQUIRE_CLOSE(1.0E-10, 30.0, center.y());
+        const auto left = view.scale * msc::point2d{-3.0, 2.0} - view.offset;
+        MSC_REQUIRE_CLOSE(1.0E-10, 5.0, left.x());
+    }
+
+    MSC_AUTO_TEST_CASE(tiles_match_whole_image)
+    {
+        auto engine = std::mt19937{};
+        auto coord = std::uniform_real_distribution<double>{-50.0, 50.0};
+        auto scene = make_scene(1.5, 0.75);
+        for (auto i = 0; i < 20; ++i) {
+            scene.layers.back().discs.emplace_back(coord(engine), coord(engine));
+            scene.layers.back().lines.emplace_back(scene.layers.back().discs.back(), msc::point2d{0.0, 0.0});
+        }
+        const auto tilesize = std::size_t{32};
+        const auto level = 2;
+        const auto whole = msc::render_scene(scene, msc::fit_raster_view(scene, tilesize << level), 128, 128);
+        for (auto ty = 0; ty < (1 << level); ++ty) {
+            for (auto tx = 0; tx < (1 << level); ++tx) {
+                const auto view = msc::tile_raster_view(scene, tilesize, level, tx, ty);
+                const auto tile = msc::render_scene(scene, view, tilesize, tilesize);
+                for (auto y = std::size_t{}; y < tilesize; ++y) {
+                    for (auto x = std::size_t{}; x < tilesize; ++x) {
+                        const auto expected = whole.get(tx * tilesize + x, ty * tilesize + y);
+                        const auto actual = tile.get(x, y);
+                        MSC_REQUIRE_CLOSE(1.0, static_cast<double>(expected.red), static_cast<double>(actual.red));
+                    }
+                }
+            }
+        }
+    }
+
+    MSC_AUTO_TEST_CASE(png_encoding)
+    {
+        auto image = msc::raster_image{3, 2};
+        image.blend(2, 1, msc::raster_color{10, 20, 30}, 1.0);
+        const auto png = msc::encode_png(image);
+        MSC_REQUIRE_EQ((std::string{"\x89PNG\r\n\x1a\n", 8}), png.substr(0, 8));
+        MSC_REQUIRE_EQ(13, read_u32(png, 8));
+        MSC_REQUIRE_EQ("IHDR", png.substr(12, 4));
+        MSC_REQUIRE_EQ(3, read_u32(png, 16));
+        MSC_REQUIRE_EQ(2, read_u32(png, 20));
+        MSC_REQUIRE_EQ((std::string{"\x08\x02\x00\x00\x00", 5}), png.substr(24, 5));
+        const auto idatsize = read_u32(png, 33);
+        MSC_REQUIRE_EQ("IDAT", png.substr(37, 4));
+        const auto compressed = png.substr(41, idatsize);
+        auto raw = std::string{};
+        io::copy(io::compose(io::zlib_decompressor{}, io::array_source{compressed.data(), compressed.size()}),
+                 io::back_inserter(raw));
+        const auto expected = std::string{
+            "\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+            "\x00\xff\xff\xff\xff\xff\xff\x0a\x14\x1e", 20
+        };
+        MSC_REQUIRE_EQ(expected, raw);
+        MSC_REQUIRE_EQ((std::string{"\x00\x00\x00\x00IEND\xae\x42\x60\x82", 12}), png.substr(png.size() - 12));
+        MSC_REQUIRE_EQ(45 + idatsize + 12, png.size());
+    }
+
+    MSC_AUTO_TEST_CASE(png_empty_image)
+    {
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::encode_png(msc::raster_image{0, 7}));
+    }
+
+}  // namespace /*anonymous*/
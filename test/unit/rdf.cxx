@@ -24,8 +24,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -98,4 +100,43 @@ namespace /*anonymous*/
         MSC_REQUIRE_EQ(2, std::count_if(std::begin(lpd), std::end(lpd), closeto{100.0 * std::sqrt(2.0)}));
     }
 
+    MSC_AUTO_TEST_CASE(vicinity_sample_square)
+    {
+        const auto [graph, attrs] = msc::test::make_square_layout();
+        const auto none = msc::get_vicinity_sample(*attrs, 0.5, SIZE_MAX).value();
+        MSC_REQUIRE(none.distances.empty());
+        MSC_REQUIRE(!none.complete);
+        const auto near = msc::get_vicinity_sample(*attrs, 1.5, SIZE_MAX).value();
+        MSC_REQUIRE_EQ(4, near.distances.size());
+        MSC_REQUIRE_EQ(4, std::count_if(std::begin(near.distances), std::end(near.distances), closeto{100.0}));
+        MSC_REQUIRE(!near.complete);
+        const auto all = msc::get_vicinity_sample(*attrs, 2.5, SIZE_MAX).value();
+        MSC_REQUIRE_EQ(6, all.distances.size());
+        MSC_REQUIRE(all.complete);
+        MSC_REQUIRE_EQ(2.0, all.longest);
+        (void) graph.get();
+    }
+
+    MSC_AUTO_TEST_CASE(vicinity_sample_capacity)
+    {
+        const auto [graph, attrs] = msc::test::make_square_layout();
+        MSC_REQUIRE(!msc::get_vicinity_sample(*attrs, 1.5, 3));
+        MSC_REQUIRE(msc::get_vicinity_sample(*attrs, 1.5, 4));
+        (void) graph.get();
+    }
+
+    MSC_AUTO_TEST_CASE(vicinity_sample_same_as_matrix)
+    {
+        const auto [graph, attrs] = msc::test::make_cube_layout();
+        const auto matrix = msc::get_pairwise_shortest_paths(*graph);
+        for (const auto vicinity : {1.0, 2.0, 3.0}) {
+            const auto lpd = msc::local_pairwise_distances{*attrs, *matrix, vicinity};
+            auto expected = std::vector<double>(std::begin(lpd), std::end(lpd));
+            auto actual = msc::get_vicinity_sample(*attrs, vicinity, SIZE_MAX).value().distances;
+            std::sort(std::begin(expected), std::end(expected));
+            std::sort(std::begin(actual), std::end(actual));
+            MSC_REQUIRE_EQ(expected, actual);
+        }
+    }
+
 }  // namespace /*anonymous*/
@@ -186,4 +186,21 @@ namespace /*anonymous*/
         }
     }
 
+    MSC_AUTO_TEST_CASE(memory_budget_respects_limit)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_GETRLIMIT && HAVE_POSIX_SETRLIMIT);
+        MSC_SKIP_UNLESS(HAVE_POSIX_ENVIRON && HAVE_POSIX_UNSETENV);
+        MSC_SKIP_UNLESS(msc::test::envguard::can_be_used());
+        clear_environment();
+        constexpr auto limit = std::size_t{1} << 40;
+        auto guard = msc::test::envguard{"MSC_LIMIT_AS"};
+        guard.set(std::to_string(limit));
+        msc::set_resource_limits();
+        const auto budget = msc::get_memory_budget();
+        guard.set("NONE");
+        msc::set_resource_limits();
+        MSC_REQUIRE(budget.has_value());
+        MSC_REQUIRE_LE(*budget, limit);
+    }
+
 }  // namespace /*anonymous*/
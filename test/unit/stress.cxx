@@ -22,12 +22,14 @@
 
 #include "stress.hxx"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <numeric>
 #include <random>
+#include <vector>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
@@ -95,6 +97,19 @@ namespace /*anonymous*/
         }
     }
 
+    MSC_AUTO_TEST_CASE(compact_distances)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(42, 100);
+        msc::normalize_layout(*attrs);
+        const auto full = msc::compute_stress(*attrs, 27.0, msc::strategies::full);
+        const auto compact = msc::compute_stress(*attrs, 27.0, msc::strategies::compact);
+        MSC_REQUIRE_EQ(full, compact);
+        const auto fullfit = msc::compute_stress_fit_nodesep(*attrs, msc::strategies::full);
+        const auto compactfit = msc::compute_stress_fit_nodesep(*attrs, msc::strategies::compact);
+        MSC_REQUIRE_EQ(fullfit.x0, compactfit.x0);
+        MSC_REQUIRE_EQ(fullfit.y0, compactfit.y0);
+    }
+
     MSC_AUTO_TEST_CASE(imperfect_layout)
     {
         const auto [graph, attrs] = msc::test::make_test_layout(42, 100);
@@ -110,6 +125,57 @@ namespace /*anonymous*/
         }
     }
 
+    MSC_AUTO_TEST_CASE(moments_same_as_direct)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(42, 100);
+        msc::normalize_layout(*attrs);
+        const auto moments = msc::compute_stress_moments(*attrs);
+        const auto stress = msc::compute_stress(*attrs, 27.0);
+        MSC_REQUIRE_CLOSE(1.0E-9 * stress, stress, msc::get_stress(moments, 27.0));
+        const auto nodesep = msc::compute_stress_fit_nodesep(*attrs);
+        const auto nodesepmom = msc::get_stress_fit_nodesep(moments);
+        MSC_REQUIRE_CLOSE(1.0E-6 * nodesep.x0, nodesep.x0, nodesepmom.x0);
+        MSC_REQUIRE_CLOSE(1.0E-6 * nodesep.y0, nodesep.y0, nodesepmom.y0);
+        const auto scale = msc::compute_stress_fit_scale(*attrs);
+        const auto scalemom = msc::get_stress_fit_scale(moments);
+        MSC_REQUIRE_CLOSE(1.0E-6 * scale.x0, scale.x0, scalemom.x0);
+        MSC_REQUIRE_CLOSE(1.0E-6 * scale.y0, scale.y0, scalemom.y0);
+    }
+
+    MSC_AUTO_TEST_CASE(moments_incremental)
+    {
+        const auto [graph, attrs] = msc::test::make_test_layout(50, 120);
+        msc::normalize_layout(*attrs);
+        auto nodes = std::vector<ogdf::node>{};
+        for (const auto v : graph->nodes) {
+            nodes.push_back(v);
+        }
+        auto rndeng = std::default_random_engine{};
+        auto nodedist = std::uniform_int_distribution<std::size_t>{0, nodes.size() - 1};
+        for (auto i = 0; i < 10; ++i) {
+            auto moments = msc::compute_stress_moments(*attrs);
+            auto worse = ogdf::GraphAttributes{*attrs};
+            auto moved = std::vector<ogdf::node>{};
+            for (auto k = 0; k < 5; ++k) {
+                const auto v = nodes[nodedist(rndeng)];
+                const auto u = nodes[nodedist(rndeng)];
+                if (std::find(std::begin(moved), std::end(moved), v) == std::end(moved)) {
+                    worse.x(v) = attrs->x(u);
+                    worse.y(v) = attrs->y(u);
+                    moved.push_back(v);
+                }
+            }
+            worse.translate(12.0, -34.0);
+            worse.scale(0.75, false);
+            const auto expected = msc::compute_stress_moments(worse);
+            const auto actual = msc::update_stress_moments(moments, *attrs, worse, moved, 0.75);
+            MSC_REQUIRE_EQ(expected.count, actual.count);
+            MSC_REQUIRE_CLOSE(1.0E-9 * expected.linear, expected.linear, actual.linear);
+            MSC_REQUIRE_CLOSE(1.0E-9 * expected.quadratic, expected.quadratic, actual.quadratic);
+            *attrs = worse;
+        }
+    }
+
     MSC_AUTO_TEST_CASE(sanity_check_fit_nodesep)
     {
         using namespace std::string_literals;
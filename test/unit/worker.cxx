@@ -0,0 +1,308 @@
+// -*- coding:utf-8; mode:c++; -*-
+
+// Copyright (C) 2018 Karlsruhe Institute of Technology
+// Copyright (C) 2018 Moritz Klammler <moritz.klammler@alumni.kit.edu>
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#define MSC_RUN_ALL_UNIT_TESTS_IN_MAIN
+
+#include "worker.hxx"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if HAVE_POSIX_SUBPROCESSES
+#  include <unistd.h>
+#endif
+
+#include "testaux/tempfile.hxx"
+#include "unittest.hxx"
+
+namespace /*anonymous*/
+{
+
+    int tool_echo(const int argc, const char *const *const argv)
+    {
+        for (auto i = 0; i < argc; ++i) {
+            std::cout << argv[i] << "\n";
+        }
+        return EXIT_SUCCESS;
+    }
+
+    int tool_fail(const int /*argc*/, const char *const *const /*argv*/)
+    {
+        std::cerr << "something went wrong\n";
+        return 3;
+    }
+
+    int tool_crash(const int /*argc*/, const char *const *const /*argv*/)
+    {
+        std::raise(SIGTERM);
+        return EXIT_SUCCESS;
+    }
+
+    int tool_throw(const int /*argc*/, const char *const *const /*argv*/)
+    {
+        throw std::runtime_error{"oops"};
+    }
+
+    int tool_sleep(const int /*argc*/, const char *const *const /*argv*/)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds{30});
+        return EXIT_SUCCESS;
+    }
+
+    // Leaves a grandchild behind that inherits (and keeps open) the standard output and error.
+    int tool_spawn(const int /*argc*/, const char *const *const /*argv*/)
+    {
+#if HAVE_POSIX_SUBPROCESSES
+        if (::fork() == 0) {
+            std::this_thread::sleep_for(std::chrono::seconds{30});
+            ::_exit(EXIT_SUCCESS);
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::seconds{30});
+        return EXIT_SUCCESS;
+    }
+
+    int tool_cat(const int /*argc*/, const char *const *const /*argv*/)
+    {
+        std::cout << std::cin.rdbuf();
+        return EXIT_SUCCESS;
+    }
+
+    int tool_getenv(const int argc, const char *const *const argv)
+    {
+        for (auto i = 1; i < argc; ++i) {
+            const auto envval = std::getenv(argv[i]);
+            std::cout << ((envval != nullptr) ? envval : "(null)") << "\n";
+        }
+        return EXIT_SUCCESS;
+    }
+
+    const msc::tool_table& get_tools()
+    {
+        static const auto tools = msc::tool_table{
+            {"echo", tool_echo},
+            {"fail", tool_fail},
+            {"crash", tool_crash},
+            {"throw", tool_throw},
+            {"sleep", tool_sleep},
+            {"spawn", tool_spawn},
+            {"cat", tool_cat},
+            {"getenv", tool_getenv},
+        };
+        return tools;
+    }
+
+    msc::worker_response run(const std::string& tool, const std::vector<std::string>& args = {})
+    {
+        auto request = msc::worker_request{};
+        request.tool = tool;
+        request.args = args;
+        return msc::run_worker_request(request, get_tools());
+    }
+
+    MSC_AUTO_TEST_CASE(parse_minimal)
+    {
+        const auto request = msc::parse_worker_request(R"({"tool": "echo"})");
+        MSC_REQUIRE_EQ("echo", request.tool);
+        MSC_REQUIRE(request.id.empty());
+        MSC_REQUIRE(request.args.empty());
+        MSC_REQUIRE(request.input.empty());
+        MSC_REQUIRE(request.environ.empty());
+        MSC_REQUIRE_LE(request.timeout, 0.0);
+    }
+
+    MSC_AUTO_TEST_CASE(parse_complete)
+    {
+        const auto request = msc::parse_worker_request(
+            R"({"id": "42", "tool": "echo", "args": ["-a", "b c"], "stdin": "/tmp/data", )"
+            R"("environ": {"ALPHA": "1", "BETA": ""}, "timeout": 2.5})"
+        );
+        MSC_REQUIRE_EQ("42", request.id);
+        MSC_REQUIRE_EQ("echo", request.tool);
+        MSC_REQUIRE_EQ(2, request.args.size());
+        MSC_REQUIRE_EQ("-a", request.args.at(0));
+        MSC_REQUIRE_EQ("b c", request.args.at(1));
+        MSC_REQUIRE_EQ("/tmp/data", request.input);
+        MSC_REQUIRE_EQ(2, request.environ.size());
+        MSC_REQUIRE_EQ("1", request.environ.at("ALPHA"));
+        MSC_REQUIRE_EQ("", request.environ.at("BETA"));
+        MSC_REQUIRE_CLOSE(1.0E-10, 2.5, request.timeout);
+    }
+
+    MSC_AUTO_TEST_CASE(parse_invalid)
+    {
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request(""));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request("{"));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request("{}"));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request(R"({"tool": ["echo"]})"));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request(R"({"tool": "a", "args": {"b": "c"}})"));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request(R"({"tool": "a", "timeout": "soon"})"));
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, msc::parse_worker_request(R"({"tool": "a", "color": "red"})"));
+    }
+
+    MSC_AUTO_TEST_CASE(write_escapes_bytes)
+    {
+        auto response = msc::worker_response{};
+        response.id = "x";
+        response.status = 0;
+        response.output = std::string{"a\"b\\c\n\xff", 7};
+        auto ostr = std::ostringstream{};
+        msc::write_worker_response(ostr, response);
+        const auto text = ostr.str();
+        MSC_REQUIRE_EQ('\n', text.back());
+        MSC_REQUIRE_EQ(text.size() - 1, text.find('\n'));
+        MSC_REQUIRE_NE(std::string::npos, text.find(R"("stdout": "a\"b\\c\u000a\u00ff")"));
+        MSC_REQUIRE_NE(std::string::npos, text.find(R"("status": 0, "signal": null, "timeout": false)"));
+        MSC_REQUIRE_NE(std::string::npos, text.find(R"("error": null)"));
+    }
+
+    MSC_AUTO_TEST_CASE(unknown_tool)
+    {
+        MSC_REQUIRE_EXCEPTION(std::invalid_argument, run("nonesuch"));
+    }
+
+    MSC_AUTO_TEST_CASE(run_success)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        const auto response = run("echo", {"alpha", "beta"});
+        MSC_REQUIRE(response.status.has_value());
+        MSC_REQUIRE_EQ(EXIT_SUCCESS, *response.status);
+        MSC_REQUIRE(!response.signal.has_value());
+        MSC_REQUIRE(!response.timeout);
+        MSC_REQUIRE_EQ("echo\nalpha\nbeta\n", response.output);
+        MSC_REQUIRE_EQ("", response.errors);
+        MSC_REQUIRE_GE(response.time, 0.0);
+    }
+
+    MSC_AUTO_TEST_CASE(run_failure)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        const auto response = run("fail");
+        MSC_REQUIRE(response.status.has_value());
+        MSC_REQUIRE_EQ(3, *response.status);
+        MSC_REQUIRE_EQ("something went wrong\n", response.errors);
+    }
+
+    MSC_AUTO_TEST_CASE(run_exception)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        const auto response = run("throw");
+        MSC_REQUIRE(response.status.has_value());
+        MSC_REQUIRE_EQ(EXIT_FAILURE, *response.status);
+        MSC_REQUIRE_NE(std::string::npos, response.errors.find("oops"));
+    }
+
+    MSC_AUTO_TEST_CASE(run_crash)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        const auto response = run("crash");
+        MSC_REQUIRE(!response.status.has_value());
+        MSC_REQUIRE(response.signal.has_value());
+        MSC_REQUIRE_EQ(SIGTERM, *response.signal);
+        MSC_REQUIRE(!response.timeout);
+    }
+
+    MSC_AUTO_TEST_CASE(run_timeout)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        auto request = msc::worker_request{};
+        request.tool = "sleep";
+        request.timeout = 0.1;
+        const auto response = msc::run_worker_request(request, get_tools());
+        MSC_REQUIRE(response.timeout);
+        MSC_REQUIRE(!response.status.has_value());
+        MSC_REQUIRE(response.signal.has_value());
+        MSC_REQUIRE_LT(response.time, 10.0);
+    }
+
+    MSC_AUTO_TEST_CASE(run_timeout_grandchild)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        auto request = msc::worker_request{};
+        request.tool = "spawn";
+        request.timeout = 0.1;
+        const auto response = msc::run_worker_request(request, get_tools());
+        MSC_REQUIRE(response.timeout);
+        MSC_REQUIRE(response.signal.has_value());
+        MSC_REQUIRE_LT(response.time, 10.0);
+    }
+
+    MSC_AUTO_TEST_CASE(run_stdin)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        const auto tmp = msc::test::tempfile{};
+        std::ofstream{tmp.filename()} << "hello, world\n";
+        auto request = msc::worker_request{};
+        request.tool = "cat";
+        request.input = tmp.filename();
+        const auto response = msc::run_worker_request(request, get_tools());
+        MSC_REQUIRE_EQ("hello, world\n", response.output);
+        request.input.clear();
+        MSC_REQUIRE_EQ("", msc::run_worker_request(request, get_tools()).output);
+    }
+
+    MSC_AUTO_TEST_CASE(run_environ)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        auto request = msc::worker_request{};
+        request.tool = "getenv";
+        request.args = {"MSC_TEST_WORKER_1", "MSC_TEST_WORKER_2"};
+        request.environ["MSC_TEST_WORKER_1"] = "sesame";
+        const auto response = msc::run_worker_request(request, get_tools());
+        MSC_REQUIRE_EQ("sesame\n(null)\n", response.output);
+        MSC_REQUIRE(std::getenv("MSC_TEST_WORKER_1") == nullptr);
+    }
+
+    MSC_AUTO_TEST_CASE(serve_keeps_going)
+    {
+        MSC_SKIP_UNLESS(HAVE_POSIX_SUBPROCESSES);
+        auto istr = std::istringstream{
+            R"({"id": "1", "tool": "echo", "args": ["a"]})" "\n"
+            "\n"
+            "this is not json\n"
+            R"({"id": "3", "tool": "crash"})" "\n"
+            R"({"id": "4", "tool": "nonesuch"})" "\n"
+            R"({"id": "5", "tool": "echo"})" "\n"
+        };
+        auto ostr = std::ostringstream{};
+        MSC_REQUIRE_EQ(5, msc::serve_worker_requests(istr, ostr, get_tools()));
+        auto lines = std::vector<std::string>{};
+        auto iss = std::istringstream{ostr.str()};
+        for (auto line = std::string{}; std::getline(iss, line);) {
+            lines.push_back(line);
+        }
+        MSC_REQUIRE_EQ(5, lines.size());
+        MSC_REQUIRE_MATCH(R"(\{"id": "1", "status": 0, .*"stdout": "echo\\u000aa\\u000a", .*"error": null\})", lines[0]);
+        MSC_REQUIRE_MATCH(R"(\{"id": "", "status": null, .*"error": "Cannot parse request: .*"\})", lines[1]);
+        MSC_REQUIRE_MATCH(R"(\{"id": "3", "status": null, "signal": [0-9]+, .*)", lines[2]);
+        MSC_REQUIRE_MATCH(R"(\{"id": "4", .*"error": "Unknown tool: nonesuch"\})", lines[3]);
+        MSC_REQUIRE_MATCH(R"(\{"id": "5", "status": 0, .*)", lines[4]);
+    }
+
+}  // namespace /*anonymous*/
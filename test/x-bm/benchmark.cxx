@@ -21,13 +21,25 @@
 
 #include "benchmark.hxx"
 
+#include <algorithm>
 #include <cerrno>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <tuple>
+#include <utility>
+
+#if HAVE_LINUX_PERF_EVENT_OPEN
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
@@ -123,6 +135,7 @@ namespace msc::benchmark
         c.quantile = get_quantile("BENCHMARK_QUANTILE");
         c.significance = get_significance("BENCHMARK_SIGNIFICANCE");
         c.verbose = get_bool("BENCHMARK_VERBOSE");
+        c.counters = get_bool("BENCHMARK_COUNTERS");
         return c;
     }
 
@@ -141,7 +154,21 @@ namespace msc::benchmark
         if (!std::isfinite(m) || (m < 0.0) || !std::isfinite(s) || (s < 0.0) || (n == 0)) {
             throw std::invalid_argument{"Obtained garbage results"};
         }
-        if ((std::printf("%18.8E  %18.8E  %18zu\n", m, s, n) < 0) || (std::fflush(stdout) < 0)) {
+        auto status = std::printf("%18.8E  %18.8E  %18zu", m, s, n);
+        if (res.counters) {
+            const std::pair<const char*, double> extra[] = {
+                {"cycles", res.counters->cycles},
+                {"instructions", res.counters->instructions},
+                {"cache-misses", res.counters->cache_misses},
+                {"branch-misses", res.counters->branch_misses},
+            };
+            for (const auto& [key, value] : extra) {
+                if ((status >= 0) && std::isfinite(value)) {
+                    status = std::printf("  %s=%.6E", key, value);
+                }
+            }
+        }
+        if ((status < 0) || (std::printf("\n") < 0) || (std::fflush(stdout) < 0)) {
             const auto ec = std::error_code{errno, std::system_category()};
             throw std::system_error{ec, "Cannot write data to file"};
         }
@@ -150,6 +177,104 @@ namespace msc::benchmark
     namespace benchmark_detail
     {
 
+#if HAVE_LINUX_PERF_EVENT_OPEN
+
+        namespace /* anonymous */
+        {
+
+            int open_hardware_counter(const std::uint64_t config) noexcept
+            {
+                auto attr = perf_event_attr{};
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = config;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                const auto fd = ::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0UL);
+                return static_cast<int>(fd);
+            }
+
+        }  // namespace /* anonymous */
+
+        counter_group::counter_group(const bool enabled)
+        {
+            if (!enabled) {
+                return;
+            }
+            const std::uint64_t configs[] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES,
+            };
+            static_assert(std::size(configs) == std::tuple_size_v<decltype(_fds)>);
+            for (auto i = std::size_t{}; i < _fds.size(); ++i) {
+                _fds[i] = open_hardware_counter(configs[i]);
+            }
+        }
+
+        counter_group::~counter_group() noexcept
+        {
+            for (const auto fd : _fds) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        }
+
+        void counter_group::start() noexcept
+        {
+            for (const auto fd : _fds) {
+                if (fd >= 0) {
+                    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+        }
+
+        void counter_group::stop(const bool record) noexcept
+        {
+            for (auto i = std::size_t{}; i < _fds.size(); ++i) {
+                if (_fds[i] < 0) {
+                    continue;
+                }
+                ::ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+                auto value = std::uint64_t{};
+                if (::read(_fds[i], &value, sizeof(value)) != sizeof(value)) {
+                    ::close(_fds[i]);
+                    _fds[i] = -1;
+                } else if (record) {
+                    _totals[i] += value;
+                }
+            }
+            _runs += record;
+        }
+
+#else  // HAVE_LINUX_PERF_EVENT_OPEN
+
+        counter_group::counter_group(const bool) { }
+
+        counter_group::~counter_group() noexcept { }
+
+        void counter_group::start() noexcept { }
+
+        void counter_group::stop(const bool) noexcept { }
+
+#endif  // HAVE_LINUX_PERF_EVENT_OPEN
+
+        std::optional<hardware_counters> counter_group::average() const
+        {
+            const auto isopen = [](const int fd){ return fd >= 0; };
+            if ((_runs == 0) || std::none_of(std::begin(_fds), std::end(_fds), isopen)) {
+                return std::nullopt;
+            }
+            const auto get = [this](const std::size_t i){
+                return (_fds[i] >= 0) ? static_cast<double>(_totals[i]) / static_cast<double>(_runs) : NAN;
+            };
+            return hardware_counters{get(0), get(1), get(2), get(3)};
+        }
+
         void print_verbose_progress(const std::size_t i, const duration_type t)
         {
             std::fprintf(stderr, "%18zu  %18.8E s\n", i, t.count());
@@ -171,6 +296,7 @@ namespace msc::benchmark
             std::fprintf(stderr, "quantile:      %16.6f\n", c.quantile);
             std::fprintf(stderr, "significance:  %16.6f\n", c.significance);
             std::fprintf(stderr, "verbose:       %16s\n", c.verbose ? "yes" : "no");
+            std::fprintf(stderr, "counters:      %16s\n", c.counters ? "yes" : "no");
         }
 
     }  // namespace benchmark_detail
@@ -184,6 +310,7 @@ namespace msc::benchmark
                 "help",
                 "version",
                 "verbose",
+                "counters",
                 "timeout",
                 "repetitions",
                 "warmup",
@@ -198,6 +325,9 @@ namespace msc::benchmark
             if (varmap.count("verbose")) {
                 constr.verbose = true;
             }
+            if (varmap.count("counters")) {
+                constr.counters = true;
+            }
             if (varmap.count("timeout")) {
                 const auto value = varmap["timeout"].as<double>();
                 if (value <= 0.0) {
@@ -283,7 +413,8 @@ namespace msc::benchmark
             ("warmup", po::value<std::ptrdiff_t>(), "number of initial samples to throw away")
             ("quantile", po::value<double>(), "fraction of (best) samples to use")
             ("significance", po::value<double>(), "desired relative standard deviation")
-            ("verbose", "print status messages to standard error output");
+            ("verbose", "print status messages to standard error output")
+            ("counters", "capture hardware performance counters (if available)");
         auto specific = po::options_description{"Specific Options for this Benchmark"};
         for (auto& kv : _cmd_vals) {
             if (kv.second.empty()) {
@@ -27,8 +27,10 @@
 #define MSC_BENCHMARK_HXX
 
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <map>
+#include <optional>
 #include <random>
 #include <set>
 #include <stdexcept>
@@ -83,6 +85,30 @@ namespace msc::benchmark
     /** @brief Duration type used for benchmarking. */
     using duration_type = std::chrono::duration<double>;
 
+    /**
+     * @brief
+     *     Average hardware event counts per invocation of a benchmark.
+     *
+     * Counters that could not be read are NaN.
+     *
+     */
+    struct hardware_counters
+    {
+
+        /** @brief CPU cycles.  */
+        double cycles{NAN};
+
+        /** @brief Retired instructions.  */
+        double instructions{NAN};
+
+        /** @brief Last-level cache misses.  */
+        double cache_misses{NAN};
+
+        /** @brief Mispredicted branches.  */
+        double branch_misses{NAN};
+
+    };
+
     /**
      * @brief
      *     Statistical result of running a benchmark.
@@ -100,6 +126,9 @@ namespace msc::benchmark
         /** @brief Number of samples used to compute the statistics (at least 3). */
         std::size_t n{};
 
+        /** @brief Hardware event counts averaged over all but the warmup samples (if requested and available). */
+        std::optional<hardware_counters> counters{};
+
     };
 
     /**
@@ -150,6 +179,9 @@ namespace msc::benchmark
         /** @brief Whether to produce verbose output. */
         bool verbose{};
 
+        /** @brief Whether to capture hardware performance counters (if supported by the system). */
+        bool counters{};
+
     };
 
     /**
@@ -164,6 +196,7 @@ namespace msc::benchmark
      *  - `BENCHMARK_QUANTILE` (default: 1)
      *  - `BENCHMARK_SIGNIFICANCE` (default: 20 %)
      *  - `BENCHMARK_VERBOSE` (default: no)
+     *  - `BENCHMARK_COUNTERS` (default: no)
      *
      * @returns
      *     `constraints` initialized from environment and defaults
@@ -181,6 +214,10 @@ namespace msc::benchmark
      *
      * If a constraint limit is exceeded before at least three data points could be sampled, an exception is `throw`n.
      *
+     * If `c.counters` is set, hardware performance counters are captured around each invocation of `bench` using the
+     * Linux `perf_event_open` system call.  If this is not supported or not permitted, the result simply won't have
+     * any counters.
+     *
      * @tparam CallT
      *     callable type that can be invoked with arguments `args`
      *
@@ -212,9 +249,11 @@ namespace msc::benchmark
      *
      * The output format is
      *
-     *     MEAN STDEV N
+     *     MEAN STDEV N [KEY=VALUE ...]
      *
-     * where times are in seconds.  This is meant to be an easily parseable format.
+     * where times are in seconds.  This is meant to be an easily parseable format.  If the result has hardware
+     * counters, they are appended as `cycles`, `instructions`, `cache-misses` and `branch-misses` key-value pairs,
+     * omitting those that are not available.
      *
      * @param res
      *     result to print
@@ -20,8 +20,10 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <numeric>
 #include <utility>
@@ -64,6 +66,42 @@ namespace msc::benchmark
             return mean_stdev_n(std::begin(data), std::end(data));
         }
 
+        /**
+         * @brief
+         *     A group of hardware performance counters that is read around each invocation of a benchmark.
+         *
+         * If the group is not enabled or the system does not allow opening any counter, all operations are no-ops
+         * and `average` returns `std::nullopt`.
+         *
+         */
+        class counter_group final
+        {
+        public:
+
+            explicit counter_group(bool enabled);
+
+            ~counter_group() noexcept;
+
+            counter_group(const counter_group&) = delete;
+
+            counter_group& operator=(const counter_group&) = delete;
+
+            void start() noexcept;
+
+            void stop(bool record) noexcept;
+
+            std::optional<hardware_counters> average() const;
+
+        private:
+
+            std::array<int, 4> _fds{-1, -1, -1, -1};
+
+            std::array<std::uint64_t, 4> _totals{};
+
+            std::size_t _runs{};
+
+        };
+
         void print_verbose_progress(std::size_t i, duration_type t);
 
         void print_constraints(const constraints& c);
@@ -75,6 +113,11 @@ namespace msc::benchmark
     {
         const auto minruns = c.warmup + static_cast<std::size_t>(std::ceil(3.0 / c.quantile));
         auto timings = std::vector<duration_type>{};
+        auto counters = benchmark_detail::counter_group{c.counters};
+        const auto finish = [&counters](result res){
+            res.counters = counters.average();
+            return res;
+        };
         const auto t0 = clock_type::now();
         if (c.verbose) {
             benchmark_detail::print_constraints(c);
@@ -83,6 +126,7 @@ namespace msc::benchmark
             throw failure{"Timeout expired before I could do anything useful"};
         }
         while (true) {
+            counters.start();
             compiler_barrier();
             const auto t1 = clock_type::now();
             compiler_barrier();
@@ -93,6 +137,7 @@ namespace msc::benchmark
             compiler_barrier();
             const auto t2 = clock_type::now();
             compiler_barrier();
+            counters.stop(timings.size() >= c.warmup);
             const auto t = std::chrono::duration_cast<duration_type>(t2 - t1);
             timings.push_back(t);
             if (c.verbose) {
@@ -106,11 +151,11 @@ namespace msc::benchmark
                     std::begin(timings),  std::end(timings), c.warmup, c.quantile
                 );
                 if (res.stdev.count() == 0.0) {
-                    return res;
+                    return finish(res);
                 } else if (res.stdev.count() / res.mean.count() < c.significance) {
-                    return res;
+                    return finish(res);
                 } else if (too_long || too_often) {
-                    return res;
+                    return finish(res);
                 }
             } else if (too_long) {
                 throw failure{"Timeout expired"};